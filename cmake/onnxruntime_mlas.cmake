@@ -5,6 +5,9 @@ set(mlas_common_srcs
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/platform.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/threading.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/sgemm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/halfconvert.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/quantize.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/convolve.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/pooling.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/reorder.cpp
@@ -13,6 +16,11 @@ set(mlas_common_srcs
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/logistic.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/tanh.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/erf.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/exp.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/log.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/transcendental.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/lstm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/normalize.cpp
 )
 
 if(MSVC)
@@ -78,6 +86,21 @@ if(MSVC)
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/ErfKernelFma3.asm
     )
 
+    # The compiler accepts AVX512F intrinsics without the matching /arch
+    # option, so build the intrinsic kernels with VEX encoding enabled.
+
+    set(mlas_platform_srcs_avx2
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/transcendental_fma3.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/transcendental_avx512f.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/qgemm_avx2.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/halfconvert_f16c.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/qgemm_avx512bw.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/qgemm_avx512vnni.cpp
+    )
+    set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+
+    list(APPEND mlas_platform_srcs ${mlas_platform_srcs_avx2})
+
   endif()
 
 elseif(CMAKE_SYSTEM_NAME STREQUAL "Android")
@@ -174,21 +197,37 @@ else()
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/LogisticKernelFma3.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/TanhKernelFma3.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/ErfKernelFma3.S
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/transcendental_fma3.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/qgemm_avx2.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx2/halfconvert_f16c.cpp
     )
-    set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
+    set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mf16c")
 
     set(mlas_platform_srcs_avx512f
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/SgemmKernelAvx512F.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/SconvKernelAvx512F.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/SpoolKernelAvx512F.S
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/transcendental_avx512f.cpp
     )
     set_source_files_properties(${mlas_platform_srcs_avx512f} PROPERTIES COMPILE_FLAGS "-mavx512f")
 
+    set(mlas_platform_srcs_avx512bw
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/qgemm_avx512bw.cpp
+    )
+    set_source_files_properties(${mlas_platform_srcs_avx512bw} PROPERTIES COMPILE_FLAGS "-mavx512bw")
+
+    set(mlas_platform_srcs_avx512vnni
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/intrinsics/avx512/qgemm_avx512vnni.cpp
+    )
+    set_source_files_properties(${mlas_platform_srcs_avx512vnni} PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512vnni")
+
     set(mlas_platform_srcs
       ${mlas_platform_srcs_sse2}
       ${mlas_platform_srcs_avx}
       ${mlas_platform_srcs_avx2}
       ${mlas_platform_srcs_avx512f}
+      ${mlas_platform_srcs_avx512bw}
+      ${mlas_platform_srcs_avx512vnni}
     )
 
   endif()
@@ -11,6 +11,7 @@
 
 #include "core/common/common.h"
 #include "core/common/exceptions.h"
+#include "core/framework/map_sequence.h"
 
 namespace ONNX_NAMESPACE {
 class TypeProto;
@@ -32,8 +33,8 @@ using VectorString = std::vector<std::string>;
 using VectorInt64 = std::vector<int64_t>;
 using VectorFloat = std::vector<float>;
 using VectorDouble = std::vector<double>;
-using VectorMapStringToFloat = std::vector<MapStringToFloat>;
-using VectorMapInt64ToFloat = std::vector<MapInt64ToFloat>;
+using VectorMapStringToFloat = MapSequence<std::string, float>;
+using VectorMapInt64ToFloat = MapSequence<int64_t, float>;
 
 class DataTypeImpl;
 class TensorTypeBase;
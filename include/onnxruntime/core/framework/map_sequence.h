@@ -0,0 +1,230 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+/**
+ * Compact storage for a sequence of maps, the seq(map(TKey, TValue)) type produced by ZipMap.
+ *
+ * Instead of one heap allocated std::map per element, the keys and the values of all maps are stored in two
+ * contiguous arrays. The keys of each map are sorted in increasing order without duplicates, which is the order a
+ * std::map iterates in, and its values are stored in the same order. Maps that have the same keys, such as the rows
+ * of a ZipMap output, share a single copy of them (see AddKeys and AppendMap), so a sequence of N maps over K keys
+ * costs N * K values and K keys.
+ *
+ * The elements are read through Map, a view with the read only part of the std::map interface.
+ */
+template <typename TKey, typename TValue>
+class MapSequence final {
+ public:
+  using key_type = TKey;
+  using mapped_type = TValue;
+  // the ONNX type of the elements, used to register the sequence as seq(map(TKey, TValue))
+  using value_type = std::map<TKey, TValue>;
+
+  /**
+   * View of one map of the sequence. It is valid until the sequence is modified.
+   */
+  class Map final {
+   public:
+    using value_type = std::pair<const TKey&, const TValue&>;
+
+    class const_iterator final {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Map::value_type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const value_type*;
+      using reference = value_type;
+
+      const_iterator(const TKey* key, const TValue* value) : key_(key), value_(value) {}
+
+      value_type operator*() const { return value_type(*key_, *value_); }
+
+      // the pair is built on access, so -> returns it through a proxy that owns it
+      struct ArrowProxy {
+        value_type pair;
+        const value_type* operator->() const { return &pair; }
+      };
+
+      ArrowProxy operator->() const { return ArrowProxy{**this}; }
+
+      const_iterator& operator++() {
+        ++key_;
+        ++value_;
+        return *this;
+      }
+
+      const_iterator operator++(int) {
+        const_iterator it = *this;
+        ++(*this);
+        return it;
+      }
+
+      bool operator==(const const_iterator& other) const { return key_ == other.key_; }
+      bool operator!=(const const_iterator& other) const { return key_ != other.key_; }
+
+     private:
+      const TKey* key_;
+      const TValue* value_;
+    };
+
+    Map(const TKey* keys, const TValue* values, size_t size) : keys_(keys), values_(values), size_(size) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * The sorted keys and the values in key order, size() of each.
+     */
+    const TKey* keys() const { return keys_; }
+    const TValue* values() const { return values_; }
+
+    const_iterator begin() const { return const_iterator(keys_, values_); }
+    const_iterator end() const { return const_iterator(keys_ + size_, values_ + size_); }
+
+    const_iterator find(const TKey& key) const {
+      const TKey* it = std::lower_bound(keys_, keys_ + size_, key);
+      if (it == keys_ + size_ || key < *it) {
+        return end();
+      }
+      return const_iterator(it, values_ + (it - keys_));
+    }
+
+    const TValue& at(const TKey& key) const {
+      auto it = find(key);
+      ORT_ENFORCE(it != end(), "Key not found in map");
+      return it->second;
+    }
+
+    std::map<TKey, TValue> ToStdMap() const {
+      std::map<TKey, TValue> map;
+      for (size_t i = 0; i < size_; ++i) {
+        map.emplace_hint(map.end(), keys_[i], values_[i]);
+      }
+      return map;
+    }
+
+    bool operator==(const Map& other) const {
+      return size_ == other.size_ && std::equal(keys_, keys_ + size_, other.keys_) &&
+             std::equal(values_, values_ + size_, other.values_);
+    }
+
+    bool operator!=(const Map& other) const { return !(*this == other); }
+
+   private:
+    const TKey* keys_;
+    const TValue* values_;
+    size_t size_;
+  };
+
+  size_t size() const { return maps_.size(); }
+  bool empty() const { return maps_.empty(); }
+
+  void clear() {
+    keys_.clear();
+    values_.clear();
+    key_sets_.clear();
+    maps_.clear();
+  }
+
+  /**
+   * Reserves room for 'num_maps' maps with a total of 'num_values' values.
+   */
+  void reserve(size_t num_maps, size_t num_values) {
+    maps_.reserve(num_maps);
+    values_.reserve(num_values);
+  }
+
+  Map operator[](size_t index) const {
+    const MapInfo& map = maps_[index];
+    return Map(keys_.data() + map.keys_offset, values_.data() + map.values_offset, map.size);
+  }
+
+  Map at(size_t index) const {
+    ORT_ENFORCE(index < maps_.size(), "Index ", index, " is out of range for a sequence of ", maps_.size(), " maps");
+    return (*this)[index];
+  }
+
+  /**
+   * Adds a set of 'count' keys, sorted in increasing order without duplicates, that maps appended with AppendMap can
+   * share. Returns the id of the key set.
+   */
+  size_t AddKeys(const TKey* keys, size_t count) {
+    key_sets_.push_back(KeySet{keys_.size(), count});
+    keys_.insert(keys_.end(), keys, keys + count);
+    return key_sets_.size() - 1;
+  }
+
+  /**
+   * Appends a map over the keys of the key set 'keys_id' and returns the storage of its values, one per key in key
+   * order, which the caller must fill before the sequence is modified again.
+   */
+  TValue* AppendMap(size_t keys_id) {
+    const KeySet& key_set = key_sets_[keys_id];
+    const size_t values_offset = values_.size();
+    values_.resize(values_offset + key_set.size);
+    maps_.push_back(MapInfo{key_set.offset, values_offset, key_set.size});
+    return values_.data() + values_offset;
+  }
+
+  void push_back(const std::map<TKey, TValue>& map) {
+    maps_.push_back(MapInfo{keys_.size(), values_.size(), map.size()});
+    for (const auto& entry : map) {
+      keys_.push_back(entry.first);
+      values_.push_back(entry.second);
+    }
+  }
+
+  /**
+   * Appends a copy of a map, which must not be a view of this sequence.
+   */
+  void push_back(const Map& map) {
+    maps_.push_back(MapInfo{keys_.size(), values_.size(), map.size()});
+    keys_.insert(keys_.end(), map.keys(), map.keys() + map.size());
+    values_.insert(values_.end(), map.values(), map.values() + map.size());
+  }
+
+  bool operator==(const MapSequence& other) const {
+    if (size() != other.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < size(); ++i) {
+      if ((*this)[i] != other[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(const MapSequence& other) const { return !(*this == other); }
+
+ private:
+  struct KeySet {
+    size_t offset;
+    size_t size;
+  };
+
+  struct MapInfo {
+    size_t keys_offset;
+    size_t values_offset;
+    size_t size;
+  };
+
+  std::vector<TKey> keys_;
+  std::vector<TValue> values_;
+  std::vector<KeySet> key_sets_;
+  std::vector<MapInfo> maps_;
+};
+
+}  // namespace onnxruntime
@@ -500,6 +500,11 @@ class Graph {
   /** Removes all initializer tensors from this Graph and releases the memory they were using. */
   void CleanAllInitializedTensors() noexcept;
 
+  /** Releases the memory used by the data of the initializer tensor with the provided name, once it has been copied
+  to where it is used. The initializer keeps its name, type and shape, but has no data anymore.
+  */
+  void ReleaseInitializedTensorData(const std::string& tensor_name);
+
   /** Returns true if an initializer value can be overridden by a graph input with the same name. */
   bool CanOverrideInitializer() const noexcept { return ir_version_ >= 4; }
 
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
@@ -43,6 +44,40 @@ class ThreadPool {
 
   int CurrentThreadId() const;
 
+  /*
+  Minimum work of one block for the block helpers below, so that each dispatched block hides the scheduling
+  overhead. The unit of the work is given by the name.
+  */
+  // elements read or written by a simple loop, or bytes copied
+  static constexpr int64_t kMinElementsPerBlock = 16384;
+  // elements scanned by a selection or sort
+  static constexpr int64_t kMinSortElementsPerBlock = 32768;
+  // bytes of string data scanned by a text kernel
+  static constexpr int64_t kMinStringBytesPerBlock = 4096;
+  // candidate boxes of a non max suppression
+  static constexpr int64_t kMinBoxesPerBlock = 1024;
+  // strings or keys looked up in a hash table
+  static constexpr int64_t kMinLookupsPerBlock = 256;
+
+  /*
+  Returns the number of contiguous blocks to split 'total' items of 'total_work' work into: at most one per thread
+  of 'tp' including the calling thread, each with at least 'min_block_work' work, and 1 if 'tp' is nullptr.
+  */
+  static int64_t NumBlocks(const ThreadPool* tp, int64_t total, int64_t total_work, int64_t min_block_work);
+
+  /*
+  Calls fn(block, first, last) for 'num_blocks' contiguous blocks that cover [0, total), where 'num_blocks' was
+  returned by NumBlocks. The blocks run on 'tp' if there is more than one, otherwise on the calling thread.
+  */
+  static void ParallelForBlocks(ThreadPool* tp, int64_t total, int64_t num_blocks,
+                                const std::function<void(int64_t, int64_t, int64_t)>& fn);
+
+  /*
+  Calls fn(first, last) for the blocks NumBlocks splits [0, total) into.
+  */
+  static void TryParallelForBlocks(ThreadPool* tp, int64_t total, int64_t total_work, int64_t min_block_work,
+                                   const std::function<void(int64_t, int64_t)>& fn);
+
   /*
   Ensure that the pool has terminated and cleaned up all threads cleanly.
   */
@@ -224,6 +224,12 @@ ORT_API_STATUS(OrtDisableMemPattern, _In_ OrtSessionOptions* options);
 ORT_API_STATUS(OrtEnableCpuMemArena, _In_ OrtSessionOptions* options);
 ORT_API_STATUS(OrtDisableCpuMemArena, _In_ OrtSessionOptions* options);
 
+// Quantize the activations of MatMul, Gemm, LSTM and GRU nodes with constant weights on every call
+// and use integer GEMM with the weights quantized once at load time. Disabled by default.
+// The setting is captured by OrtSessionOptionsAppendExecutionProvider_CPU, so set it before appending the CPU provider.
+ORT_API_STATUS(OrtEnableDynamicQuantization, _In_ OrtSessionOptions* options);
+ORT_API_STATUS(OrtDisableDynamicQuantization, _In_ OrtSessionOptions* options);
+
 // < logger id to use for session output
 ORT_API_STATUS(OrtSetSessionLogId, _In_ OrtSessionOptions* options, const char* logid);
 
@@ -334,6 +340,28 @@ ORT_API_STATUS(OrtGetStringTensorDataLength, _In_ const OrtValue* value, _Out_ s
 ORT_API_STATUS(OrtGetStringTensorContent, _In_ const OrtValue* value, _Out_ void* s, size_t s_len,
                _Out_ size_t* offsets, size_t offsets_len);
 
+/**
+ * Fills a string tensor from strings packed in the layout returned by OrtGetStringTensorContent.
+ * \param value A tensor created from OrtCreateTensor... function.
+ * \param s string contents. Each string is NOT null-terminated.
+ * \param s_len total data length
+ * \param offsets the start of each string in s. The string at index i ends at offsets[i + 1], or at s_len for the last one.
+ * \param offsets_len number of strings, which must not be less than the number of elements of the tensor
+ */
+ORT_API_STATUS(OrtFillStringTensorFromBuffer, _Inout_ OrtValue* value, _In_ const void* s, size_t s_len,
+               _In_ const size_t* offsets, size_t offsets_len);
+
+/**
+ * Returns one element of a string tensor without copying it.
+ * \param value A string tensor.
+ * \param index the index of the element in the flattened tensor.
+ * \param s receives a pointer to the characters of the element, which are NOT null-terminated. The pointer stays valid
+ *          until the element is modified or the tensor is released.
+ * \param len receives the length of the element.
+ */
+ORT_API_STATUS(OrtGetStringTensorElement, _In_ const OrtValue* value, size_t index, _Out_ const char** s,
+               _Out_ size_t* len);
+
 /**
  * Create an OrtValue in CPU memory from a serialized TensorProto
  * @param input           serialized TensorProto object
@@ -499,8 +527,14 @@ ORT_ALL_ARGS_NONNULL;
    * std::vector<int64_t>
    * std::vector<float>
    * std::vector<double>
-   * std::vector<std::map<std::string, float>>
-   * std::vector<std::map<int64_t, float>
+   * MapSequence<std::string, float> (seq(map(string, float)))
+   * MapSequence<int64_t, float> (seq(map(int64, float)))
+   *
+   * A MapSequence stores the keys and values of all its maps in two contiguous arrays (see map_sequence.h).
+   * OrtGetValue on one of its elements returns a map OrtValue that is a view of that element
+   * (MapSequenceElement): it keeps the sequence alive and reads its keys and values from the sequence instead of
+   * copying them into a std::map. The keys and values of the view are fetched with OrtGetValue like for any map.
+   * OrtCreateValue accepts both std::map values and these views as the elements of a sequence of maps.
    */
 
 /**
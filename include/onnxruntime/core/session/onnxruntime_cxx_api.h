@@ -139,6 +139,9 @@ struct SessionOptions : Base<OrtSessionOptions> {
   SessionOptions& EnableCpuMemArena();
   SessionOptions& DisableCpuMemArena();
 
+  SessionOptions& EnableDynamicQuantization();
+  SessionOptions& DisableDynamicQuantization();
+
   SessionOptions& EnableProfiling(const ORTCHAR_T* profile_file_prefix);
   SessionOptions& DisableProfiling();
 
@@ -216,6 +219,8 @@ struct Value : Base<OrtValue> {
 
   size_t GetStringTensorDataLength() const;
   void GetStringTensorContent(void* buffer, size_t buffer_length, size_t* offsets, size_t offsets_count) const;
+  const char* GetStringTensorElement(size_t index, size_t* length) const;  // Not null terminated, no copy is made
+  void FillStringTensor(const void* buffer, size_t buffer_length, const size_t* offsets, size_t offsets_count);
 
   template <typename T>
   T* GetTensorMutableData();
@@ -167,6 +167,16 @@ inline SessionOptions& SessionOptions::DisableCpuMemArena() {
   return *this;
 }
 
+inline SessionOptions& SessionOptions::EnableDynamicQuantization() {
+  ORT_THROW_ON_ERROR(OrtEnableDynamicQuantization(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::DisableDynamicQuantization() {
+  ORT_THROW_ON_ERROR(OrtDisableDynamicQuantization(p_));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::EnableSequentialExecution() {
   ORT_THROW_ON_ERROR(OrtEnableSequentialExecution(p_));
   return *this;
@@ -356,6 +366,16 @@ inline void Value::GetStringTensorContent(void* buffer, size_t buffer_length, si
   ORT_THROW_ON_ERROR(OrtGetStringTensorContent(p_, buffer, buffer_length, offsets, offsets_count));
 }
 
+inline const char* Value::GetStringTensorElement(size_t index, size_t* length) const {
+  const char* out;
+  ORT_THROW_ON_ERROR(OrtGetStringTensorElement(p_, index, &out, length));
+  return out;
+}
+
+inline void Value::FillStringTensor(const void* buffer, size_t buffer_length, const size_t* offsets, size_t offsets_count) {
+  ORT_THROW_ON_ERROR(OrtFillStringTensorFromBuffer(p_, buffer, buffer_length, offsets, offsets_count));
+}
+
 template <typename T>
 T* Value::GetTensorMutableData() {
   T* out;
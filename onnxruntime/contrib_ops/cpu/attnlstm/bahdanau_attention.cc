@@ -2,8 +2,12 @@
 // Licensed under the MIT License.
 
 #include "bahdanau_attention.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
 #include <memory.h>
 
@@ -15,11 +19,12 @@ namespace contrib {
 template <typename T>
 BahdanauAttention<T>::BahdanauAttention(AllocatorPtr allocator, const logging::Logger& logger,
                                         int batch_size, int max_memory_step, int memory_depth,
-                                        int query_depth, int attn_depth, bool normalize)
-    : allocator_(allocator), logger_(logger), batch_size_(batch_size), max_memory_steps_(max_memory_step), memory_depth_(memory_depth), query_depth_(query_depth), attn_depth_(attn_depth), normalize_(normalize) {
-  values_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * memory_depth_, values_ptr_, true);
+                                        int query_depth, int attn_depth, bool normalize,
+                                        concurrency::ThreadPool* thread_pool)
+    : allocator_(allocator), logger_(logger), batch_size_(batch_size), max_memory_steps_(max_memory_step), memory_depth_(memory_depth), query_depth_(query_depth), attn_depth_(attn_depth), normalize_(normalize), thread_pool_(thread_pool) {
   keys_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * attn_depth_, keys_ptr_, true);
   processed_query_ = Allocate(allocator_, batch_size_ * attn_depth_, processed_query_ptr_, true);
+  scores_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * attn_depth_, scores_ptr_, false);
   mem_seq_lengths_ = Allocate(allocator_, batch_size_, mem_seq_lengths_ptr_, true);
 
   ORT_ENFORCE(!normalize_, "not support normalize yet.");
@@ -59,7 +64,7 @@ template <typename T>
 void BahdanauAttention<T>::PrepareMemory(
     const gsl::span<const T>& memory,
     const gsl::span<const int>& memory_sequence_lengths) {
-  std::copy(memory.cbegin(), memory.cend(), values_.begin());
+  values_ = memory;
   if (memory_sequence_lengths.empty()) {
     std::fill(mem_seq_lengths_.begin(), mem_seq_lengths_.end(), max_memory_steps_);
   } else {
@@ -72,33 +77,77 @@ void BahdanauAttention<T>::PrepareMemory(
                 "Real memory steps ", mem_steps, " is not in (0, ", max_memory_steps_, "]");
   }
 
-  math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
-                               batch_size_ * max_memory_steps_, attn_depth_, memory_depth_, T{1.0},
-                               memory.data(), memory_depth_,
-                               memory_layer_weights_.data(), attn_depth_, T{0.0},
-                               keys_.data(), attn_depth_, &CPUMathUtil::Instance());
+  // the memory layer is applied once per sequence, to all the memory steps of the batch in a single GEMM
+  MlasSgemm(CblasNoTrans, CblasNoTrans,
+            batch_size_ * max_memory_steps_, attn_depth_, memory_depth_, T{1.0},
+            memory.data(), memory_depth_,
+            memory_layer_weights_.data(), attn_depth_, T{0.0},
+            keys_.data(), attn_depth_, thread_pool_);
 }
 
+/**
+  * Computes the alignments and the context of the batch rows [first_batch, last_batch), from the processed query.
+  * For each row the score of a memory step is reduce_sum(v * tanh(keys[step] + query)), the alignments are the
+  * softmax of the scores of the real memory steps (zero past them), and the context is the sum of the values of the
+  * real memory steps weighted by their alignments.
+  */
 template <typename T>
-static void SoftmaxInplace(const gsl::span<T>& alignments) {
-  T* x = alignments.data();
-  size_t len = alignments.size();
+void BahdanauAttention<T>::ComputeContext(
+    const gsl::span<T>& output,
+    const gsl::span<T>& aligns,
+    int first_batch,
+    int last_batch) const {
+  for (int b = first_batch; b < last_batch; b++) {
+    T* alignments = aligns.data() + b * max_memory_steps_;
+    const T* keys = keys_.data() + b * max_memory_steps_ * attn_depth_;
+    const T* query = processed_query_.data() + b * attn_depth_;
+    const T* values = values_.data() + b * max_memory_steps_ * memory_depth_;
+    T* scores = scores_.data() + b * max_memory_steps_ * attn_depth_;
+    T* context = output.data() + b * memory_depth_;
+    const T* v = attention_v_.data();
 
-  double sum = 0.0;
+    const int mem_steps = mem_seq_lengths_[b];
 
-  for (size_t i = 0; i < len; i++) {
-    T e = exp(x[i]);
-    sum += e;
-    x[i] = e;
-  }
+    // tanh(keys + query) of all the real memory steps of the row at once
+    for (int step = 0; step < mem_steps; step++) {
+      const T* keys_on_step = keys + step * attn_depth_;
+      T* scores_on_step = scores + step * attn_depth_;
+      for (int i = 0; i < attn_depth_; i++) {
+        scores_on_step[i] = keys_on_step[i] + query[i];
+      }
+    }
+    MlasComputeTanh(scores, scores, static_cast<size_t>(mem_steps) * attn_depth_);
 
-  if (sum == 0.0) {
-    for (size_t i = 0; i < len; i++) {
-      x[i] = static_cast<T>(1.0 / len);
+    T max_score = std::numeric_limits<T>::lowest();
+    for (int step = 0; step < mem_steps; step++) {
+      const T* scores_on_step = scores + step * attn_depth_;
+      T score = T{0.0};
+      for (int i = 0; i < attn_depth_; i++) {
+        score += v[i] * scores_on_step[i];
+      }
+      alignments[step] = score;
+      max_score = std::max(max_score, score);
     }
-  } else {
-    for (size_t i = 0; i < len; i++) {
-      x[i] = static_cast<T>(x[i] / sum);
+
+    // softmax over the real memory steps, the steps past them are masked out
+    double sum = 0.0;
+    for (int step = 0; step < mem_steps; step++) {
+      T e = std::exp(alignments[step] - max_score);
+      sum += e;
+      alignments[step] = e;
+    }
+    for (int step = 0; step < mem_steps; step++) {
+      alignments[step] = static_cast<T>(alignments[step] / sum);
+    }
+    std::fill(alignments + mem_steps, alignments + max_memory_steps_, T{});
+
+    std::fill(context, context + memory_depth_, T{});
+    for (int step = 0; step < mem_steps; step++) {
+      const T alignment = alignments[step];
+      const T* values_on_step = values + step * memory_depth_;
+      for (int i = 0; i < memory_depth_; i++) {
+        context[i] += alignment * values_on_step[i];
+      }
     }
   }
 }
@@ -115,43 +164,19 @@ void BahdanauAttention<T>::Compute(
     const gsl::span<T>& output,
     const gsl::span<T>& aligns) const {
   //process query in dense query layer without bias
-  math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
-                               batch_size_, attn_depth_, query_depth_, T{1.0},
-                               queries.data(), query_depth_,
-                               query_layer_weights_.data(), attn_depth_, T{0.0},
-                               processed_query_.data(), attn_depth_, &CPUMathUtil::Instance());
-
-  std::fill(aligns.begin(), aligns.end(), T{});
-
-  // return math_ops.reduce_sum(v * math_ops.tanh(keys + processed_query), [2])
-  for (int b = 0; b < batch_size_; b++) {
-    T* alignments = aligns.data() + b * max_memory_steps_;
-    const T* keys = keys_.data() + b * max_memory_steps_ * attn_depth_;
-    const T* query = processed_query_.data() + b * attn_depth_;
-
-    int mem_steps = mem_seq_lengths_[b];
-    for (int step = 0; step < mem_steps; step++) {
-      const T* keys_on_step = keys + step * attn_depth_;
-      T* dest = alignments + step;
-
-      // reduce_sum(v * tanh(keys[step] + query)) on last dimension
-      *dest = T(0.0);
-      for (int i = 0; i < attn_depth_; i++) {
-        *dest += (attention_v_[i] * tanh(keys_on_step[i] + query[i]));
-      }
-    }
-
-    SoftmaxInplace(gsl::span<T>{alignments, mem_steps});
-
-    // Calculate the context
-    auto outspan = output.subspan(b * memory_depth_);
-    auto values = values_.subspan(b * max_memory_steps_ * memory_depth_);
-    math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
-                                 1, memory_depth_, max_memory_steps_, T{1.0},
-                                 alignments, max_memory_steps_,
-                                 values.data(), memory_depth_, T{0.0},
-                                 outspan.data(), memory_depth_, &CPUMathUtil::Instance());
-  }
+  MlasSgemm(CblasNoTrans, CblasNoTrans,
+            batch_size_, attn_depth_, query_depth_, T{1.0},
+            queries.data(), query_depth_,
+            query_layer_weights_.data(), attn_depth_, T{0.0},
+            processed_query_.data(), attn_depth_, thread_pool_);
+
+  // a batch row only attends over its own memory steps; the work of a row is its score and context over them
+  const int64_t row_work = static_cast<int64_t>(max_memory_steps_) * (attn_depth_ + memory_depth_);
+  concurrency::ThreadPool::TryParallelForBlocks(
+      thread_pool_, batch_size_, batch_size_ * row_work, concurrency::ThreadPool::kMinElementsPerBlock,
+      [&](int64_t first, int64_t last) {
+        ComputeContext(output, aligns, static_cast<int>(first), static_cast<int>(last));
+      });
 }
 
 template class BahdanauAttention<float>;
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "core/framework/allocator.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
 #include "attention_mechanism.h"
@@ -14,6 +17,8 @@ namespace contrib {
 // Please refer to: https://arxiv.org/pdf/1409.0473.pdf
 template <typename T>
 class BahdanauAttention : public IAttentionMechanism<T> {
+  static_assert(std::is_same<T, float>::value, "BahdanauAttention runs on MlasSgemm and MlasComputeTanh, float only");
+
  public:
   BahdanauAttention(
       AllocatorPtr allocator,
@@ -23,7 +28,8 @@ class BahdanauAttention : public IAttentionMechanism<T> {
       int memory_depth,
       int query_depth,
       int attn_depth,
-      bool normalize);
+      bool normalize,
+      concurrency::ThreadPool* thread_pool = nullptr);
 
   void SetWeights(
       const gsl::span<const T>& attn_weights,
@@ -51,6 +57,12 @@ class BahdanauAttention : public IAttentionMechanism<T> {
   bool NeedPrevAlignment() const override;
 
  private:
+  void ComputeContext(
+      const gsl::span<T>& output,
+      const gsl::span<T>& aligns,
+      int first_batch,
+      int last_batch) const;
+
   AllocatorPtr allocator_;
   const logging::Logger& logger_;
 
@@ -67,16 +79,22 @@ class BahdanauAttention : public IAttentionMechanism<T> {
   IAllocatorUniquePtr<T> keys_ptr_;
   gsl::span<T> keys_;
 
-  IAllocatorUniquePtr<T> values_ptr_;
-  gsl::span<T> values_;
+  // the memory itself, which outlives the attention mechanism
+  gsl::span<const T> values_;
 
   IAllocatorUniquePtr<T> processed_query_ptr_;
   gsl::span<T> processed_query_;
 
+  // tanh(keys + processed query) of every memory step, shape [batch_size_, max_memory_steps_, attn_depth_]
+  IAllocatorUniquePtr<T> scores_ptr_;
+  gsl::span<T> scores_;
+
   IAllocatorUniquePtr<int> mem_seq_lengths_ptr_;
   gsl::span<int> mem_seq_lengths_;
 
   bool normalize_;
+
+  concurrency::ThreadPool* thread_pool_;
 };
 
 }  // namespace contrib
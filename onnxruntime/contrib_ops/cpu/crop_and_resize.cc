@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "contrib_ops/cpu/crop_and_resize.h"
 
+#include <algorithm>
 #include <cmath>
 #include "core/util/math_cpuonly.h"
 #include "core/common/common.h"
@@ -43,6 +44,48 @@ namespace contrib {
 
 ADD_TYPED_CROPANDRESIZE_OP(float);
 
+// Sample position along one axis of a crop. The positions only depend on the ROI, so they are computed once per ROI
+// and shared by all the channels.
+struct CropSample {
+  bool valid;
+  int low_index;
+  int high_index;
+  int nearest_index;
+  float lerp;
+};
+
+template <typename T>
+static void ComputeCropSamples(T roi_start, T roi_end, int64_t size, int32_t pooled_size, CropSample* samples) {
+  T scale = (pooled_size > 1) ? (roi_end - roi_start) * (size - 1) / (pooled_size - 1) : 0;
+
+  for (int32_t p = 0; p < pooled_size; p++) {
+    T in = static_cast<T>((pooled_size > 1)
+                              ? roi_start * (size - 1) + p * scale
+                              : 0.5 * (roi_start + roi_end) * (size - 1));
+    if (p == pooled_size - 1) {
+      in = static_cast<T>((pooled_size > 1)
+                              ? roi_end * (size - 1)
+                              : 0.5 * (roi_start + roi_end) * (size - 1));
+    }
+    if (p == 0) {
+      in = static_cast<T>((pooled_size > 1)
+                              ? roi_start * (size - 1)
+                              : 0.5 * (roi_start + roi_end) * (size - 1));
+    }
+
+    CropSample& sample = samples[p];
+    sample.valid = !(in < 0 || in > size - 1);
+    if (!sample.valid) {
+      continue;
+    }
+
+    sample.low_index = static_cast<int>(floorf(static_cast<float>(in)));
+    sample.high_index = static_cast<int>(ceilf(static_cast<float>(in)));
+    sample.nearest_index = static_cast<int>(roundf(static_cast<float>(in)));
+    sample.lerp = static_cast<float>(in - sample.low_index);
+  }
+}
+
 template <typename T>
 void CropAndResizeForward(
     int64_t nthreads,
@@ -58,126 +101,67 @@ void CropAndResizeForward(
     T* top_data,
     const std::string& mode,
     const int32_t* batch_indices_ptr,
-    const ThreadPool* ttp) {
+    ThreadPool* tp) {
   int64_t n_rois = nthreads / channels / pooled_width / pooled_height;
+  const bool bilinear_mode = mode == "bilinear";
+
+  // The ROIs are split into one contiguous block per thread rather than one task per ROI. Within a ROI the sample
+  // tables are computed once and each channel is then written as a contiguous plane.
+  auto work_object = [&](int64_t first_roi, int64_t last_roi) {
+    std::vector<CropSample> y_samples(pooled_height);
+    std::vector<CropSample> x_samples(pooled_width);
 
-  std::function<void(int32_t)> work_object = [&](int32_t n) {
-    int64_t index_n = n * channels * pooled_width * pooled_height;
-
-    const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
-    const auto roi_batch_ind = batch_indices_ptr[n];
-
-    T roi_start_w = offset_bottom_rois[1];
-    T roi_start_h = offset_bottom_rois[0];
-    T roi_end_w = offset_bottom_rois[3];
-    T roi_end_h = offset_bottom_rois[2];
-
-    T height_scale =
-        (pooled_height > 1)
-        ? (roi_end_h - roi_start_h) * (height - 1) / (pooled_height - 1)
-        : 0;
-    T width_scale =
-        (pooled_width > 1) ? (roi_end_w - roi_start_w) * (width - 1) / (pooled_width - 1)
-        : 0;
-
-    for (auto ph = 0; ph < pooled_height; ph++) {
-      T in_y = static_cast<T>((pooled_height > 1)
-        ? roi_start_h * (height - 1) + ph * height_scale
-        : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      if (ph == pooled_height - 1) {
-        in_y = static_cast<T>((pooled_height > 1)
-        ? roi_end_h * (height - 1)
-        : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      }
-      if (ph == 0) {
-        in_y = static_cast<T>((pooled_height > 1)
-        ? roi_start_h * (height - 1)
-        : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      }
-      if (in_y < 0 || in_y > height - 1) {
-        for (int64_t pw = 0; pw < pooled_width; pw++) {
-        for (int64_t c = 0; c < channels; c++)
-        {
-          int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-          int64_t index = index_n_c + ph * pooled_width + pw;
-          top_data[index] = extrapolation_value;
-        }
-        }
-        continue;
-      }
-
-      const int top_y_index = static_cast<int>(floorf(static_cast<float>(in_y)));
-      const int bottom_y_index = static_cast<int>(ceilf(static_cast<float>(in_y)));
-      const float y_lerp = static_cast<float>(in_y - top_y_index);
-
-      for (auto pw = 0; pw < pooled_width; pw++) {
-        T in_x = static_cast<T>((pooled_width > 1)
-        ? roi_start_w * (width - 1) + pw * width_scale
-        : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        if (pw == pooled_width - 1) {
-        in_x = static_cast<T>((pooled_width > 1)
-          ? roi_end_w * (width - 1)
-          : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        }
-        if (pw == 0) {
-        in_x = static_cast<T>((pooled_width > 1)
-          ? roi_start_w * (width - 1)
-          : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        }
-        if (in_x < 0 || in_x > width - 1) {
-        for (int64_t c = 0; c < channels; c++)
-        {
-          int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-          int64_t index = index_n_c + ph * pooled_width + pw;
-          top_data[index] = extrapolation_value;
-        }
-        continue;
-        }
-
-        T output_val = extrapolation_value;
-        if (mode == "bilinear") {
-          const int left_x_index = static_cast<int>(floorf(static_cast<float>(in_x)));
-          const int right_x_index = static_cast<int>(ceilf(static_cast<float>(in_x)));
-          const float x_lerp = static_cast<float>(in_x - left_x_index);
-          auto top_left_index = top_y_index * width + left_x_index;
-          auto top_right_index = top_y_index * width + right_x_index;
-          auto bottom_left_index = bottom_y_index * width + left_x_index;
-          auto bottom_right_index = bottom_y_index * width + right_x_index;
-
-          for (auto c = 0; c < channels; c++)
-          {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            const T* offset_bottom_data =
+    for (int64_t n = first_roi; n < last_roi; n++) {
+      const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+      const auto roi_batch_ind = batch_indices_ptr[n];
+
+      ComputeCropSamples(offset_bottom_rois[0], offset_bottom_rois[2], height, pooled_height, y_samples.data());
+      ComputeCropSamples(offset_bottom_rois[1], offset_bottom_rois[3], width, pooled_width, x_samples.data());
+
+      T* output = top_data + n * channels * pooled_width * pooled_height;
+      for (int64_t c = 0; c < channels; c++) {
+        const T* offset_bottom_data =
             bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-            const float top_left(static_cast<float>(offset_bottom_data[top_left_index]));
-            const float top_right(static_cast<float>(offset_bottom_data[top_right_index]));
-            const float bottom_left(static_cast<float>(offset_bottom_data[bottom_left_index]));
-            const float bottom_right(static_cast<float>(offset_bottom_data[bottom_right_index]));
-            const float top = top_left + (top_right - top_left) * x_lerp;
-            const float bottom = bottom_left + (bottom_right - bottom_left) * x_lerp;
-            output_val = top + (bottom - top) * y_lerp;
-            top_data[index] = output_val;
+
+        for (int32_t ph = 0; ph < pooled_height; ph++) {
+          const CropSample& ys = y_samples[ph];
+          if (!ys.valid) {
+            std::fill_n(output, pooled_width, static_cast<T>(extrapolation_value));
+            output += pooled_width;
+            continue;
           }
-        }
-        else {  // mode == "nearest"
-          const int closest_x_index = static_cast<int>(roundf(static_cast<float>(in_x)));
-          const int closest_y_index = static_cast<int>(roundf(static_cast<float>(in_y)));
-          auto closest_index = closest_y_index * width + closest_x_index;
-
-          for (auto c = 0; c < channels; c++)
-          {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            const T* offset_bottom_data =
-              bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-            top_data[index] = static_cast<float>(offset_bottom_data[closest_index]);
+
+          if (bilinear_mode) {
+            const T* top_row = offset_bottom_data + ys.low_index * width;
+            const T* bottom_row = offset_bottom_data + ys.high_index * width;
+            for (int32_t pw = 0; pw < pooled_width; pw++) {
+              const CropSample& xs = x_samples[pw];
+              if (!xs.valid) {
+                output[pw] = extrapolation_value;
+                continue;
+              }
+              const float top_left(static_cast<float>(top_row[xs.low_index]));
+              const float top_right(static_cast<float>(top_row[xs.high_index]));
+              const float bottom_left(static_cast<float>(bottom_row[xs.low_index]));
+              const float bottom_right(static_cast<float>(bottom_row[xs.high_index]));
+              const float top = top_left + (top_right - top_left) * xs.lerp;
+              const float bottom = bottom_left + (bottom_right - bottom_left) * xs.lerp;
+              output[pw] = top + (bottom - top) * ys.lerp;
+            }
+          } else {  // mode == "nearest"
+            const T* nearest_row = offset_bottom_data + ys.nearest_index * width;
+            for (int32_t pw = 0; pw < pooled_width; pw++) {
+              const CropSample& xs = x_samples[pw];
+              output[pw] = xs.valid ? static_cast<float>(nearest_row[xs.nearest_index]) : extrapolation_value;
+            }
           }
-        }
-      }  // for pw
-    }    // for ph
-  };     // for n
-  const_cast<ThreadPool*>(ttp)->ParallelFor(static_cast<int32_t>(n_rois), work_object);
+          output += pooled_width;
+        }  // for ph
+      }    // for c
+    }      // for n
+  };
+
+  ThreadPool::TryParallelForBlocks(tp, n_rois, nthreads, ThreadPool::kMinElementsPerBlock, work_object);
 }
 
 template <typename T>
@@ -232,7 +216,7 @@ Status CropAndResize<T>::Compute(OpKernelContext* context) const {
       Y.template MutableData<T>(),
       mode_,
       batch_indices_ptr->Data<int32_t>(),
-      static_cast<OpKernelContextInternal*>(context)->GetOperatorThreadPool());
+      GetOperatorThreadPool(context));
 
   return Status::OK();
 }
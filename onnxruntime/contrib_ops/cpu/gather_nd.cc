@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "contrib_ops/cpu/gather_nd.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
+#include "core/util/prefetch.h"
+
+#include <algorithm>
 
 namespace onnxruntime {
 namespace contrib     {
@@ -44,20 +49,15 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
                input_shape.GetDims().end());
   auto output_tensor = context->Output(0,TensorShape(shape));
   std::vector<int64_t> element_counts(last_indice_dimension, 0LL); // Number of elements for each input dimension
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
   for (int64_t i = 0; i < last_indice_dimension; ++i) {
     element_counts[i] = input_shape.SizeFromDimension(i + 1);
-}
+  }
 
-  int64_t err_indice = 0;
   p.element_bytes    = input_tensor->DataType()->Size();
   p.element_to_copy  = input_shape.SizeFromDimension(last_indice_dimension);
   p.bytes_to_copy    = p.element_bytes * p.element_to_copy;
   auto indice_offset = indice_tensor->Data<Tind>();
-  auto offset_count  = indice_shape.Size() / last_indice_dimension; // Times to copy
+  auto offset_count  = indice_shape.SizeToDimension(indice_shape.NumDimensions() - 1); // Times to copy
   p.element_offsets.assign(offset_count, 0LL);
 
   if (input_tensor->DataType() == DataTypeImpl::GetType<std::string>()) {
@@ -68,56 +68,86 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
     p.output_base     = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
+  // Compute the offsets with a branch free bounds check and only search for the offending indice to report
+  // when any of them is out of range.
+  bool invalid = false;
   for (int64_t i = 0; i < offset_count; ++i) {
+    const Tind* indice = indice_offset + i * last_indice_dimension;
+    int64_t offset = 0;
     for (int64_t j = 0; j < last_indice_dimension; ++j) {
-      auto indice = *(indice_offset + i * last_indice_dimension + j);
-      if (indice < 0 || indice >= input_shape[j]) {
-        err_indice = indice;
+      invalid |= (indice[j] < 0) | (indice[j] >= input_shape[j]);
+      offset += indice[j] * element_counts[j];
+    }
+    p.element_offsets[i] = static_cast<uint64_t>(offset);
+  }
+
+  if (invalid) {
+    for (int64_t i = 0; i < offset_count * last_indice_dimension; ++i) {
+      auto indice = indice_offset[i];
+      if (indice < 0 || indice >= input_shape[i % last_indice_dimension]) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", indice);
       }
-      p.element_offsets[i] += indice * element_counts[j];
     }
   }
 
-  return err_indice == 0 ? Status::OK() :
-    ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", err_indice);
+  return Status::OK();
 }
 
 template Status GatherNDBase::PrepareForCompute<int32_t>(OpKernelContext*, Prepare&) const;
 template Status GatherNDBase::PrepareForCompute<int64_t>(OpKernelContext*, Prepare&) const;
 
+namespace {
+
+// Slices are prefetched ahead of the copy when they are large enough for the miss latency to matter.
+constexpr int64_t kPrefetchMinBytes = 64;
+
+// Copies the slices in contiguous blocks, weighted by the bytes they move.
+template <typename TCopy>
+void CopySlices(concurrency::ThreadPool* tp, int64_t slice_count, int64_t slice_bytes, TCopy copy_slices) {
+  concurrency::ThreadPool::TryParallelForBlocks(tp, slice_count, slice_count * std::max<int64_t>(slice_bytes, 1),
+                                                concurrency::ThreadPool::kMinElementsPerBlock, copy_slices);
+}
+
+}  // namespace
+
 Status GatherND::Compute(OpKernelContext* context) const {
   Prepare p;
   ORT_RETURN_IF_ERROR(context->Input<Tensor>(1)->DataType() == DataTypeImpl::GetType<int32_t>() ? 
                               PrepareForCompute<int32_t>(context, p) : PrepareForCompute<int64_t>(context, p));
 
-  return nullptr == p.input_str_base ? GatherNumber(p) : GatherString(p);
+  auto* tp = GetOperatorThreadPool(context);
+
+  return nullptr == p.input_str_base ? GatherNumber(p, tp) : GatherString(p, tp);
 }
 
-Status GatherND::GatherNumber(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    memcpy(p.output_base + i * p.bytes_to_copy,
-           p.input_base + p.element_offsets[i] * p.element_bytes,
-           p.bytes_to_copy);
-  }
+Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
+  const int64_t slice_bytes = static_cast<int64_t>(p.bytes_to_copy);
+  const bool prefetch = slice_bytes >= kPrefetchMinBytes;
+
+  CopySlices(tp, static_cast<int64_t>(p.element_offsets.size()), slice_bytes, [&](int64_t first, int64_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      if (prefetch && i + kPrefetchDistance < last) {
+        PrefetchRow(p.input_base + p.element_offsets[i + kPrefetchDistance] * p.element_bytes, slice_bytes);
+      }
+      memcpy(p.output_base + i * p.bytes_to_copy,
+             p.input_base + p.element_offsets[i] * p.element_bytes,
+             p.bytes_to_copy);
+    }
+  });
 
   return Status::OK();
 }
 
-Status GatherND::GatherString(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
-      p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
-    }
-  }
+Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) const {
+  const int64_t element_to_copy = static_cast<int64_t>(p.element_to_copy);
+
+  CopySlices(tp, static_cast<int64_t>(p.element_offsets.size()), static_cast<int64_t>(p.bytes_to_copy),
+             [&](int64_t first, int64_t last) {
+               for (int64_t i = first; i < last; ++i) {
+                 const std::string* src = p.input_str_base + p.element_offsets[i];
+                 std::copy(src, src + element_to_copy, p.output_str_base + i * element_to_copy);
+               }
+             });
 
   return Status::OK();
 }
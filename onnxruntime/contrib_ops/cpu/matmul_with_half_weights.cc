@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/matmul_with_half_weights.h"
+#include "core/framework/op_kernel_context_internal.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulWithHalfWeights,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", {DataTypeImpl::GetTensorType<MLFloat16>(),
+                               DataTypeImpl::GetTensorType<BFloat16>()}),
+    MatMulWithHalfWeights);
+
+Status MatMulWithHalfWeights::Compute(OpKernelContext* context) const {
+  const auto* A = context->Input<Tensor>(0);
+  const auto* B = context->Input<Tensor>(1);
+  const auto* C = context->Input<Tensor>(2);
+
+  const auto& a_shape = A->Shape();
+  const auto& b_shape = B->Shape();
+  if (a_shape.NumDimensions() < 1 || b_shape.NumDimensions() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "A must have at least rank 1 and B must have rank 2. A: ", a_shape, " B: ", b_shape);
+  }
+
+  const size_t last_axis = a_shape.NumDimensions() - 1;
+  const int64_t M = a_shape.SizeToDimension(last_axis);
+  const int64_t K = a_shape[last_axis];
+  const int64_t N = b_shape[trans_B_ == CblasNoTrans ? 1 : 0];
+  if (b_shape[trans_B_ == CblasNoTrans ? 0 : 1] != K) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "A and B dimensions are not compatible. A: ", a_shape, " B: ", b_shape);
+  }
+
+  std::vector<int64_t> output_dims = a_shape.GetDims();
+  output_dims[last_axis] = N;
+  Tensor* Y = context->Output(0, TensorShape(output_dims));
+  if (M == 0 || N == 0) {
+    return Status::OK();
+  }
+
+  float* y_data = Y->MutableData<float>();
+
+  // the bias is broadcast to each row of Y and then accumulated by the GEMM
+  float beta = 0.0f;
+  if (C != nullptr) {
+    if (C->Shape().Size() != N) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "C must have N elements. C: ", C->Shape(), " N: ", N);
+    }
+    const float* c_data = C->Data<float>();
+    for (int64_t m = 0; m < M; m++) {
+      std::copy(c_data, c_data + N, y_data + m * N);
+    }
+    beta = 1.0f;
+  }
+
+  auto* thread_pool = GetOperatorThreadPool(context);
+
+  if (B->DataType() == DataTypeImpl::GetType<MLFloat16>()) {
+    MlasSgemm(CblasNoTrans, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), alpha_,
+              A->Data<float>(), static_cast<size_t>(K),
+              reinterpret_cast<const MLAS_FP16*>(B->Data<MLFloat16>()), static_cast<size_t>(b_shape[1]),
+              beta, y_data, static_cast<size_t>(N), thread_pool);
+  } else {
+    MlasSgemm(CblasNoTrans, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), alpha_,
+              A->Data<float>(), static_cast<size_t>(K),
+              reinterpret_cast<const MLAS_BFLOAT16*>(B->Data<BFloat16>()), static_cast<size_t>(b_shape[1]),
+              beta, y_data, static_cast<size_t>(N), thread_pool);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
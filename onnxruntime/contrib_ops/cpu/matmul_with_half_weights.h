@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Computes Y = alpha * A * B + C with float16 or bfloat16 weights B, which are converted to float while MLAS packs
+// each panel of B, so only the 16-bit copy of the weights is kept resident.
+class MatMulWithHalfWeights final : public OpKernel {
+ public:
+  explicit MatMulWithHalfWeights(const OpKernelInfo& info) : OpKernel(info) {
+    trans_B_ = info.GetAttrOrDefault<int64_t>("transB", 0) == 0 ? CblasNoTrans : CblasTrans;
+    alpha_ = info.GetAttrOrDefault<float>("alpha", 1.0f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  CBLAS_TRANSPOSE trans_B_;
+  float alpha_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -4,11 +4,16 @@
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/op_kernel_context_internal.h"
 #include "core/graph/onnx_protobuf.h"
 #include "onnx/defs/schema.h"
 
 #include "core/common/utf8_util.h"
+#include "core/platform/threadpool.h"
 #include "re2/re2.h"
+#include "re2/set.h"
+
+#include <algorithm>
 
 namespace onnxruntime {
 namespace contrib {
@@ -23,21 +28,36 @@ class Tokenizer final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  Status CharTokenize(OpKernelContext* context, size_t N, size_t C,
-                      const std::vector<int64_t>& input_dims) const;
+  // The tokens of a block of consecutive rows, as spans into the input strings, along with the scratch buffers
+  // reused by every row of the block.
+  struct TokenizedRows {
+    std::vector<re2::StringPiece> tokens;
+    std::vector<size_t> counts;  // number of tokens of each row
+    size_t max_tokens = 0;
+    std::vector<re2::StringPiece> pieces;
+    std::vector<re2::StringPiece> split_pieces;
+    std::vector<int> matched_separators;
+    std::vector<char> active_separators;
+  };
+
+  Status CharTokenize(const std::string& s, std::vector<re2::StringPiece>& tokens) const;
+
+  Status SeparatorTokenize(const std::string& s, TokenizedRows& rows) const;
 
-  Status SeparatorExpressionTokenizer(OpKernelContext* context, size_t N, size_t C,
-                                      const std::vector<int64_t>& input_dims) const;
+  Status ExpressionTokenize(const std::string& s, std::vector<re2::StringPiece>& tokens) const;
 
-  Status TokenExpression(OpKernelContext* ctx,
-                         size_t N, size_t C,
-                         const std::vector<int64_t>& input_dims) const;
+  Status TokenizeRows(const std::string* input, size_t first, size_t last, TokenizedRows& rows) const;
 
   bool mark_{false};
   std::string pad_value_;
   int64_t mincharnum_{0};
   bool char_tokenezation_{false};
   std::vector<std::unique_ptr<re2::RE2>> separators_;
+  // All separators compiled into one automaton, used to skip the separators that do not occur in a string.
+  std::unique_ptr<re2::RE2::Set> separator_set_;
+  // Separators with empty width assertions can match in a piece of a string without matching the whole string,
+  // so they are never skipped.
+  std::vector<char> separator_has_assertion_;
   std::unique_ptr<re2::RE2> regex_;
 };
 
@@ -54,6 +74,26 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 namespace tokenizer_details {
 const char start_text = 0x2;
 const char end_text = 0x3;
+
+
+// Returns true if the pattern contains an empty width assertion (^, $, \b, \B, \A or \z). Other patterns only
+// match in a piece of a string if they match in the whole string at the same position. The check is conservative:
+// a ^ that negates a character class also counts.
+bool HasEmptyWidthAssertion(const std::string& pattern) {
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == '^' || c == '$') {
+      return true;
+    }
+    if (c == '\\' && i + 1 < pattern.size()) {
+      const char escaped = pattern[++i];
+      if (escaped == 'b' || escaped == 'B' || escaped == 'A' || escaped == 'z') {
+        return true;
+      }
+    }
+  }
+  return false;
+}
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
@@ -101,6 +141,16 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
           ORT_THROW("Can not digest separators: ", sep, " ", regex->error());
         }
         separators_.push_back(std::move(regex));
+        separator_has_assertion_.push_back(HasEmptyWidthAssertion(sep));
+      }
+      if (separators_.size() > 1) {
+        std::unique_ptr<re2::RE2::Set> separator_set(new re2::RE2::Set(options, re2::RE2::UNANCHORED));
+        for (const auto& sep : separators) {
+          std::string error;
+          ORT_ENFORCE(separator_set->Add(sep, &error) >= 0, "Can not digest separators: ", sep, " ", error);
+        }
+        ORT_ENFORCE(separator_set->Compile(), "Can not compile the separators");
+        separator_set_.swap(separator_set);
       }
     } else {
       // Use tokenexp
@@ -116,346 +166,198 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   }
 }
 
-Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
-                               const std::vector<int64_t>& input_dims) const {
-  // With char tokenzation we get as many tokens as the number of
-  // utf8 characters in the string. So for every string we calculate its character(utf8) length
-  // add padding and add start/end test separators if necessary
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t tokens = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       tokens)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-    max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
-  }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to apparently empty strings input.
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
+Status Tokenizer::CharTokenize(const std::string& s, std::vector<re2::StringPiece>& tokens) const {
+  // With char tokenzation we get as many tokens as the number of utf8 characters in the string
+  size_t utf8_chars = 0;
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
   }
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      (void)result;
-      assert(token_idx + tlen <= str_len);
-      *(output_data + output_index) = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (mark_ * 2) <= max_tokens);
-    const size_t pads = max_tokens - (mark_ * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
-    }
-    ++curr_input;
+  const size_t str_len = s.size();
+  for (size_t token_idx = 0; token_idx < str_len;) {
+    size_t tlen = 0;
+    bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+    assert(result);
+    (void)result;
+    assert(token_idx + tlen <= str_len);
+    tokens.emplace_back(s.data() + token_idx, tlen);
+    token_idx += tlen;
   }
   return Status::OK();
 }
 
-Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
-                                               size_t N, size_t C,
-                                               const std::vector<int64_t>& input_dims) const {
+Status Tokenizer::SeparatorTokenize(const std::string& s, TokenizedRows& rows) const {
   using namespace re2;
-  std::vector<std::vector<StringPiece>> rows;
-  rows.reserve(N * C);
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  // Scan all strings and attempt to find separators in them
-  // collect all the output tokens here
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t utf8_chars = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-
-    std::vector<StringPiece> row{s};
-
-    for (const auto& sep : separators_) {
-      std::vector<StringPiece> tokens;
-      for (const auto& text : row) {
-        const auto end_pos = text.length();
-        size_t start_pos = 0;
-        StringPiece submatch;
-
-        bool match = true;
-        do {
-          match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-          if (match) {
-            // Record  pos/len
-            assert(submatch.data() != nullptr);
-            size_t match_pos = submatch.data() - text.data();
-            assert(match_pos >= start_pos);
-            auto token_len = match_pos - start_pos;
-            utf8_chars = 0;
-            bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                                  token_len, utf8_chars);
-            if (!valid) {
-              return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                            "Match contains invalid utf8 chars: " + submatch.as_string());
-            }
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, token_len);
-            }
-            // Update starting position
-            // Guard against empty string match
-            auto match_len = submatch.length();
-            if (match_len > 0) {
-              start_pos = match_pos + match_len;
-            } else {
-              size_t bytes = 0;
-              utf8_bytes(*submatch.data(), bytes);
-              start_pos = match_pos + bytes;
-            }
-          } else {
-            // record trailing token
-            auto trailing_len = end_pos - start_pos;
-            utf8_chars = 0;
-            utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                     trailing_len, utf8_chars);
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, trailing_len);
-            }
-          }
-        } while (match);
-      }  // row
-      // Replace the row with the results of this tokenezation
-      row.swap(tokens);
-    }  // separators_
-    max_tokens = std::max(max_tokens, row.size());
-    rows.push_back(std::move(row));
-    ++curr_input;
-  }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
+  size_t utf8_chars = 0;  // length in utf8 chars
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                     utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
   }
 
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
+  // Find the separators that occur anywhere in the string in a single scan, so that the others are not searched
+  // for in every piece of it.
+  auto& active = rows.active_separators;
+  active.assign(separators_.size(), 1);
+  if (separator_set_ != nullptr) {
+    auto& matched = rows.matched_separators;
+    matched.clear();
+    separator_set_->Match(s, &matched);
+    active.assign(separator_has_assertion_.begin(), separator_has_assertion_.end());
+    for (int index : matched) {
+      active[index] = 1;
+    }
   }
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
+  auto& row = rows.pieces;
+  auto& tokens = rows.split_pieces;
+  row.assign(1, StringPiece(s));
 
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  size_t output_index = 0;
-  curr_input = input_data;
-  for (auto& row : rows) {
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.size());
-      ++output_index;
+  // The separators are applied in order, each one splitting the pieces left by the previous ones
+  for (size_t sep_idx = 0; sep_idx < separators_.size(); ++sep_idx) {
+    if (!active[sep_idx]) {
+      continue;
     }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
+    const auto& sep = separators_[sep_idx];
+    tokens.clear();
+    for (const auto& text : row) {
+      const auto end_pos = text.length();
+      size_t start_pos = 0;
+      StringPiece submatch;
+
+      bool match = true;
+      do {
+        match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+        if (match) {
+          // Record  pos/len
+          assert(submatch.data() != nullptr);
+          size_t match_pos = submatch.data() - text.data();
+          assert(match_pos >= start_pos);
+          auto token_len = match_pos - start_pos;
+          utf8_chars = 0;
+          bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                                token_len, utf8_chars);
+          if (!valid) {
+            return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                          "Match contains invalid utf8 chars: " + submatch.as_string());
+          }
+          if (utf8_chars >= size_t(mincharnum_)) {
+            tokens.emplace_back(text.data() + start_pos, token_len);
+          }
+          // Update starting position
+          // Guard against empty string match
+          auto match_len = submatch.length();
+          if (match_len > 0) {
+            start_pos = match_pos + match_len;
+          } else if (match_pos < end_pos) {
+            size_t bytes = 0;
+            utf8_bytes(*submatch.data(), bytes);
+            start_pos = match_pos + bytes;
+          } else {
+            // An empty match at the end of the piece leaves no trailing token
+            break;
+          }
+        } else {
+          // record trailing token
+          auto trailing_len = end_pos - start_pos;
+          utf8_chars = 0;
+          utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                   trailing_len, utf8_chars);
+          if (utf8_chars >= size_t(mincharnum_)) {
+            tokens.emplace_back(text.data() + start_pos, trailing_len);
+          }
+        }
+      } while (match);
+    }  // row
+    // Replace the row with the results of this tokenezation
+    row.swap(tokens);
+  }  // separators_
+
+  // A string that is not split by any separator is a single token, subject to the minimum length like any other
+  if (row.size() == 1 && row[0].data() == s.data() && row[0].length() == s.length()) {
+    utf8_chars = 0;
+    utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.length(), utf8_chars);
+    if (utf8_chars < size_t(mincharnum_)) {
+      row.clear();
     }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
   }
+
+  rows.tokens.insert(rows.tokens.end(), row.begin(), row.end());
   return Status::OK();
 }
 
-Status Tokenizer::TokenExpression(OpKernelContext* ctx,
-                                  size_t N, size_t C,
-                                  const std::vector<int64_t>& input_dims) const {
+Status Tokenizer::ExpressionTokenize(const std::string& s, std::vector<re2::StringPiece>& tokens) const {
   using namespace re2;
-  // Represents a token that will be output after
-  // first is the index, second is the size;
-  std::vector<std::vector<StringPiece>> tokens;
-  tokens.reserve(N * C);
-
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
 
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-
-    size_t utf8_chars = 0;
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-
-    tokens.emplace_back();
-    auto& row = tokens.back();
-
-    StringPiece text(s);
-    const auto end_pos = s.length();
-    size_t start_pos = 0;
-    StringPiece submatch;
-
-    bool match = true;
-    do {
-      match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-      if (match) {
-        // Record  pos/len
-        assert(submatch.data() != nullptr);
-        size_t match_pos = submatch.data() - s.data();
-        assert(match_pos >= start_pos);
-        // Guard against empty match and make
-        // sure we make progress either way
-        auto token_len = submatch.length();
-        utf8_chars = 0;
-        if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Match contains invalid utf8 chars: " + submatch.as_string());
-        }
-        if (utf8_chars >= size_t(mincharnum_)) {
-          row.push_back(submatch);
-          start_pos = match_pos + token_len;
-        } else {
-          size_t bytes = 0;
-          utf8_bytes(*submatch.data(), bytes);
-          start_pos = match_pos + bytes;
-        }
-      }
-    } while (match);
-    max_tokens = std::max(max_tokens, row.size());
-    ++curr_input;
-  }
-
-  // Check for empty output
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
-  }
-
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
+  size_t utf8_chars = 0;
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                     utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
   }
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  curr_input = input_data;
-  size_t output_index = 0;
-  for (const auto& row : tokens) {
-    assert(curr_input != last);
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.length());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
+  StringPiece text(s);
+  const auto end_pos = s.length();
+  size_t start_pos = 0;
+  StringPiece submatch;
+
+  bool match = true;
+  do {
+    match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+    if (match) {
+      // Record  pos/len
+      assert(submatch.data() != nullptr);
+      size_t match_pos = submatch.data() - s.data();
+      assert(match_pos >= start_pos);
+      // Guard against empty match and make
+      // sure we make progress either way
+      auto token_len = submatch.length();
+      utf8_chars = 0;
+      if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
+        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                      "Match contains invalid utf8 chars: " + submatch.as_string());
+      }
+      if (utf8_chars >= size_t(mincharnum_)) {
+        tokens.push_back(submatch);
+        start_pos = match_pos + token_len;
+      } else {
+        size_t bytes = 0;
+        utf8_bytes(*submatch.data(), bytes);
+        start_pos = match_pos + bytes;
+      }
     }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
+  } while (match && start_pos <= end_pos);
+  return Status::OK();
+}
+
+Status Tokenizer::TokenizeRows(const std::string* input, size_t first, size_t last, TokenizedRows& rows) const {
+  rows.counts.reserve(last - first);
+  for (size_t i = first; i < last; ++i) {
+    const size_t tokens_before = rows.tokens.size();
+    Status status;
+    if (char_tokenezation_) {
+      status = CharTokenize(input[i], rows.tokens);
+    } else if (!separators_.empty()) {
+      status = SeparatorTokenize(input[i], rows);
+    } else {
+      assert(regex_ != nullptr);
+      status = ExpressionTokenize(input[i], rows.tokens);
     }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
+    ORT_RETURN_IF_ERROR(status);
+    const size_t count = rows.tokens.size() - tokens_before;
+    rows.counts.push_back(count);
+    rows.max_tokens = std::max(rows.max_tokens, count);
   }
-
   return Status::OK();
 }
 
@@ -497,17 +399,84 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
     return s;
   }
 
-  if (char_tokenezation_) {
-    s = CharTokenize(ctx, N, C, input_dims);
-  } else {
-    if (!separators_.empty()) {
-      s = SeparatorExpressionTokenizer(ctx, N, C, input_dims);
-    } else {
-      assert(regex_ != nullptr);
-      s = TokenExpression(ctx, N, C, input_dims);
+  auto const input_data = X->template Data<std::string>();
+  const size_t num_rows = N * C;
+
+  // Tokenize blocks of rows in parallel. Each block records its tokens as spans into the input strings, so no
+  // string is allocated until the output is written.
+  auto* tp = GetOperatorThreadPool(ctx);
+  int64_t total_bytes = 0;
+  if (tp != nullptr) {
+    for (size_t i = 0; i < num_rows; ++i) {
+      total_bytes += static_cast<int64_t>(input_data[i].size());
     }
   }
-  return s;
+  const int64_t num_blocks = concurrency::ThreadPool::NumBlocks(tp, static_cast<int64_t>(num_rows), total_bytes,
+                                                                concurrency::ThreadPool::kMinStringBytesPerBlock);
+
+  std::vector<TokenizedRows> blocks(num_blocks);
+  std::vector<Status> block_status(num_blocks);
+  auto run_blocks = [&](auto fn) {
+    concurrency::ThreadPool::ParallelForBlocks(tp, static_cast<int64_t>(num_rows), num_blocks,
+                                               [&](int64_t block, int64_t first, int64_t last) {
+                                                 fn(block, static_cast<size_t>(first), static_cast<size_t>(last));
+                                               });
+  };
+
+  run_blocks([&](int64_t block, size_t first, size_t last) {
+    block_status[block] = TokenizeRows(input_data, first, last, blocks[block]);
+  });
+
+  size_t max_tokens = 0;
+  for (int64_t block = 0; block < num_blocks; ++block) {
+    ORT_RETURN_IF_ERROR(block_status[block]);
+    max_tokens = std::max(max_tokens, blocks[block].max_tokens);
+  }
+
+  std::vector<int64_t> output_dims(input_dims);
+  // Check if we have no output due to either empty input
+  // everything is a separator
+  if (max_tokens == 0) {
+    output_dims.push_back(0);
+    TensorShape output_shape(output_dims);
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  if (mark_) {
+    max_tokens += 2;  // Start/end markers as separate tokens
+  }
+
+  output_dims.push_back(max_tokens);
+  TensorShape output_shape(output_dims);
+
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+
+  run_blocks([&](int64_t block, size_t first, size_t last) {
+    const TokenizedRows& rows = blocks[block];
+    const re2::StringPiece* token = rows.tokens.data();
+    for (size_t i = first; i < last; ++i) {
+      std::string* output_row = output_data + i * max_tokens;
+      const size_t count = rows.counts[i - first];
+      if (mark_) {
+        (output_row++)->assign(&start_text, 1);
+      }
+      // Output tokens for this row
+      for (size_t t = 0; t < count; ++t, ++token) {
+        (output_row++)->assign(token->data(), token->size());
+      }
+      if (mark_) {
+        (output_row++)->assign(&end_text, 1);
+      }
+      const size_t pads = max_tokens - (mark_ * 2) - count;
+      for (size_t p = 0; p < pads; ++p) {
+        *(output_row++) = pad_value_;
+      }
+    }
+  });
+
+  return Status::OK();
 }
 }  // namespace contrib
 }  // namespace onnxruntime
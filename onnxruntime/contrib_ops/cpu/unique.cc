@@ -1,14 +1,16 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-// there's no way to use a raw pointer as the copy destination with std::copy_n
-// (which gsl::copy uses with span::data() which returns a raw pointer) with the 14.11 toolset
-// without generating a 4996 warning. going through an iterator is way too much overhead so turn off the warning.
-#ifdef _MSC_VER
-#pragma warning(disable : 4996)
-#endif
 #include "unique.h"
-#include "core/providers/cpu/tensor/utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+
+#include "core/common/murmur_hash3.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -17,74 +19,392 @@ ONNX_OPERATOR_KERNEL_EX(Unique,
                         kMSDomain,
                         1,
                         kCpuExecutionProvider,
-                        KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
-                        Unique<float>);
+                        KernelDefBuilder().TypeConstraint("T", std::vector<MLDataType>{
+                                                                   DataTypeImpl::GetTensorType<float>(),
+                                                                   DataTypeImpl::GetTensorType<int32_t>(),
+                                                                   DataTypeImpl::GetTensorType<int64_t>(),
+                                                                   DataTypeImpl::GetTensorType<std::string>()}),
+                        Unique);
+
+using concurrency::ThreadPool;
+
+namespace {
+
+// The input is split into partitions by the top bits of the hash of each element, so that equal elements always
+// land in the same partition and every partition is deduplicated on its own with data that stays in cache.
+constexpr size_t kPartitionSize = 16384;
+constexpr int kMaxPartitionBits = 12;
+
+// Partitions of numeric elements at least this large are deduplicated by a radix sort of their keys, which
+// streams through memory, instead of by hashing, which probes at random.
+constexpr size_t kRadixSortMinSize = 4096;
+
+// MurmurHash3 64 bit finalizer
+inline uint64_t Mix(uint64_t k) {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+// RadixSortable: whether partitions can be radix sorted on Key, an unsigned integer that is equal for two elements
+// exactly when the elements compare equal.
+// IsNaN: elements that compare unequal to everything, themselves included, each become their own unique value.
+template <typename T>
+struct UniqueTraits;
 
 template <>
-Status Unique<float>::Compute(OpKernelContext* ctx) const {
-  const Tensor* input = ctx->Input<Tensor>(0);
+struct UniqueTraits<int32_t> {
+  using Key = uint32_t;
+  using RadixSortable = std::true_type;
+  static Key ToKey(int32_t value) { return static_cast<Key>(value); }
+  static bool IsNaN(int32_t) { return false; }
+  static uint64_t Hash(int32_t value) { return Mix(ToKey(value)); }
+  static bool Equal(int32_t a, int32_t b) { return a == b; }
+};
 
-  // validate input
-  if (input->Shape().NumDimensions() != 1)
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input tensor to Unique op should be 1D");
+template <>
+struct UniqueTraits<int64_t> {
+  using Key = uint64_t;
+  using RadixSortable = std::true_type;
+  static Key ToKey(int64_t value) { return static_cast<Key>(value); }
+  static bool IsNaN(int64_t) { return false; }
+  static uint64_t Hash(int64_t value) { return Mix(ToKey(value)); }
+  static bool Equal(int64_t a, int64_t b) { return a == b; }
+};
 
-  // obtain raw input data
-  const float* input_data = input->Data<float>();
-  size_t num_elements = static_cast<size_t>(input->Shape().Size());
+template <>
+struct UniqueTraits<float> {
+  using Key = uint32_t;
+  using RadixSortable = std::true_type;
+  static Key ToKey(float value) {
+    // -0.0 and 0.0 compare equal
+    Key key = 0;
+    if (value != 0.0f) {
+      memcpy(&key, &value, sizeof(key));
+    }
+    return key;
+  }
+  static bool IsNaN(float value) { return value != value; }
+  static uint64_t Hash(float value) { return Mix(ToKey(value)); }
+  static bool Equal(float a, float b) { return a == b; }
+};
 
-  // 'idx' output has same output shape as input
-  Tensor* output_idx = ctx->Output(1, input->Shape());
-  int64_t* output_idx_data = output_idx->template MutableData<int64_t>();
+template <>
+struct UniqueTraits<std::string> {
+  using RadixSortable = std::false_type;
+  static bool IsNaN(const std::string&) { return false; }
+  static uint64_t Hash(const std::string& value) {
+    return Mix(MurmurHash3_x86_32(value.data(), static_cast<int>(value.size()), 0));
+  }
+  static bool Equal(const std::string& a, const std::string& b) { return a == b; }
+};
 
-  // container to hold the unique elements (in the order it was first seen)
-  std::vector<float> unique_elements;
-  // number of unique elements is atmost number of elements in the raw data
-  unique_elements.reserve(num_elements);
+// Groups of equal elements found in one partition: the position of the first element of each group and the
+// number of elements in it.
+struct Groups {
+  std::vector<int64_t> first;
+  std::vector<int64_t> count;
 
-  // containers to store other metadata needed for other output tensors
-  std::unordered_map<float, size_t> mapped_indices;
-  std::unordered_map<float, size_t> element_counts;
+  int64_t Add(int64_t position) {
+    first.push_back(position);
+    count.push_back(1);
+    return static_cast<int64_t>(first.size()) - 1;
+  }
+};
 
-  // processing
-  for (size_t i = 0; i < num_elements; ++i) {
-    float temp = input_data[i];
-
-    const auto iter = mapped_indices.find(temp);
-    if (iter == mapped_indices.end()) {
-      // element is being seen for the first time
-      element_counts[temp] = 1;
-      output_idx_data[i] = mapped_indices[temp] = unique_elements.size();
-      unique_elements.push_back(temp);
+// Groups the elements at 'positions', which are in ascending order, with an open addressing hash table, and
+// writes the group of each of them to 'group_of'.
+template <typename T>
+void HashGroups(const T* input, const uint64_t* hashes, const int64_t* positions, size_t size,
+                int64_t* group_of, Groups& groups) {
+  using Traits = UniqueTraits<T>;
+
+  struct Slot {
+    uint64_t hash;
+    int64_t group;
+  };
+
+  size_t capacity = 16;
+  while (capacity < 2 * size) {
+    capacity *= 2;
+  }
+  const size_t mask = capacity - 1;
+  std::vector<Slot> table(capacity, Slot{0, -1});
+
+  for (size_t i = 0; i < size; ++i) {
+    const int64_t position = positions[i];
+    const T& value = input[position];
+    if (Traits::IsNaN(value)) {
+      group_of[position] = groups.Add(position);
+      continue;
+    }
+
+    const uint64_t hash = hashes[position];
+    size_t slot = hash & mask;
+    for (;;) {
+      Slot& s = table[slot];
+      if (s.group < 0) {
+        s.hash = hash;
+        s.group = groups.Add(position);
+        group_of[position] = s.group;
+        break;
+      }
+      if (s.hash == hash && Traits::Equal(input[groups.first[s.group]], value)) {
+        ++groups.count[s.group];
+        group_of[position] = s.group;
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+}
+
+// Groups the elements at 'positions', which are in ascending order, by sorting their keys with a stable least
+// significant digit radix sort. Equal keys end up next to each other with their positions still in ascending
+// order, so the first position of a run is the first occurrence of its value.
+template <typename T>
+void RadixSortGroups(const T* input, const int64_t* positions, size_t size, int64_t* group_of, Groups& groups) {
+  using Traits = UniqueTraits<T>;
+  using Key = typename Traits::Key;
+
+  std::vector<std::pair<Key, int64_t>> entries;
+  entries.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    const int64_t position = positions[i];
+    if (Traits::IsNaN(input[position])) {
+      group_of[position] = groups.Add(position);
     } else {
-      // element has been seen before
-      output_idx_data[i] = iter->second;
-      ++element_counts[temp];
+      entries.emplace_back(Traits::ToKey(input[position]), position);
+    }
+  }
+
+  std::vector<std::pair<Key, int64_t>> sorted(entries.size());
+  for (size_t shift = 0; shift < 8 * sizeof(Key); shift += 8) {
+    size_t histogram[256] = {};
+    for (const auto& entry : entries) {
+      ++histogram[(entry.first >> shift) & 0xff];
+    }
+
+    // all the keys share this digit, so the pass would not change the order
+    if (histogram[(entries.empty() ? 0 : entries.front().first >> shift) & 0xff] == entries.size()) {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (auto& bucket : histogram) {
+      const size_t bucket_size = bucket;
+      bucket = offset;
+      offset += bucket_size;
+    }
+    for (const auto& entry : entries) {
+      sorted[histogram[(entry.first >> shift) & 0xff]++] = entry;
+    }
+    entries.swap(sorted);
+  }
+
+  for (size_t i = 0; i < entries.size();) {
+    const int64_t group = groups.Add(entries[i].second);
+    group_of[entries[i].second] = group;
+    size_t j = i + 1;
+    for (; j < entries.size() && entries[j].first == entries[i].first; ++j) {
+      group_of[entries[j].second] = group;
+    }
+    groups.count[group] = static_cast<int64_t>(j - i);
+    i = j;
+  }
+}
+
+template <typename T>
+void GroupPartition(const T* input, const uint64_t* hashes, const int64_t* positions, size_t size,
+                    int64_t* group_of, Groups& groups, std::true_type /* radix sortable */) {
+  if (size >= kRadixSortMinSize) {
+    RadixSortGroups(input, positions, size, group_of, groups);
+  } else {
+    HashGroups(input, hashes, positions, size, group_of, groups);
+  }
+}
+
+template <typename T>
+void GroupPartition(const T* input, const uint64_t* hashes, const int64_t* positions, size_t size,
+                    int64_t* group_of, Groups& groups, std::false_type /* radix sortable */) {
+  HashGroups(input, hashes, positions, size, group_of, groups);
+}
+
+template <typename T>
+Status ComputeUnique(const Tensor& input, OpKernelContext* ctx, concurrency::ThreadPool* tp) {
+  const T* input_data = input.template Data<T>();
+  const size_t num_elements = static_cast<size_t>(input.Shape().Size());
+  const int64_t total = input.Shape().Size();
+
+  // 'idx' output has same output shape as input. It first receives the group of every element and is then
+  // rewritten with the index of the unique value of the group.
+  Tensor* output_idx = ctx->Output(1, input.Shape());
+  int64_t* group_of = output_idx->template MutableData<int64_t>();
+
+  // Partition the input. Positions are scattered block by block, so each partition lists its elements in
+  // ascending order.
+  int partition_bits = 0;
+  while (partition_bits < kMaxPartitionBits && (kPartitionSize << partition_bits) < num_elements) {
+    ++partition_bits;
+  }
+  const size_t num_partitions = size_t{1} << partition_bits;
+  auto partition_of = [partition_bits](uint64_t hash) {
+    return partition_bits == 0 ? size_t{0} : static_cast<size_t>(hash >> (64 - partition_bits));
+  };
+
+  std::vector<uint64_t> hashes(num_elements);
+  std::vector<int64_t> positions(num_elements);
+  std::vector<size_t> partition_start(num_partitions + 1, 0);
+
+  if (num_partitions == 1) {
+    ThreadPool::TryParallelForBlocks(tp, total, total, ThreadPool::kMinElementsPerBlock,
+                                     [&](int64_t first, int64_t last) {
+                                       for (int64_t i = first; i < last; ++i) {
+                                         hashes[i] = UniqueTraits<T>::Hash(input_data[i]);
+                                       }
+                                     });
+    std::iota(positions.begin(), positions.end(), int64_t{0});
+    partition_start[1] = num_elements;
+  } else {
+    // every block counts and then scatters its elements into its own range of each partition
+    const int64_t num_blocks = ThreadPool::NumBlocks(tp, total, total, ThreadPool::kMinElementsPerBlock);
+    std::vector<size_t> offsets(num_blocks * num_partitions, 0);
+
+    auto run_blocks = [&](auto fn) {
+      ThreadPool::ParallelForBlocks(tp, total, num_blocks, [&](int64_t block, int64_t first, int64_t last) {
+        fn(static_cast<size_t>(first), static_cast<size_t>(last), offsets.data() + block * num_partitions);
+      });
+    };
+
+    run_blocks([&](size_t first, size_t last, size_t* histogram) {
+      for (size_t i = first; i < last; ++i) {
+        hashes[i] = UniqueTraits<T>::Hash(input_data[i]);
+        ++histogram[partition_of(hashes[i])];
+      }
+    });
+
+    size_t offset = 0;
+    for (size_t p = 0; p < num_partitions; ++p) {
+      partition_start[p] = offset;
+      for (int64_t block = 0; block < num_blocks; ++block) {
+        const size_t count = offsets[block * num_partitions + p];
+        offsets[block * num_partitions + p] = offset;
+        offset += count;
+      }
     }
+    partition_start[num_partitions] = offset;
+
+    run_blocks([&](size_t first, size_t last, size_t* next) {
+      for (size_t i = first; i < last; ++i) {
+        positions[next[partition_of(hashes[i])]++] = static_cast<int64_t>(i);
+      }
+    });
   }
 
-  // 'uniques' output
-  TensorShape output_shape({static_cast<int64_t>(unique_elements.size())});
-  Tensor* output_uniques = ctx->Output(0, output_shape);
-  float* output_uniques_data = output_uniques->template MutableData<float>();
+  // Partitions are processed in contiguous blocks, sized by the elements they hold in total.
+  auto for_each_partition = [&](auto fn) {
+    ThreadPool::TryParallelForBlocks(tp, static_cast<int64_t>(num_partitions), total,
+                                     ThreadPool::kMinElementsPerBlock, [&](int64_t first, int64_t last) {
+                                       for (int64_t p = first; p < last; ++p) {
+                                         fn(static_cast<size_t>(p));
+                                       }
+                                     });
+  };
 
-  // 'counts' output
-  Tensor* output_counts = ctx->Output(2, output_shape);
-  int64_t* output_counts_data = output_counts->template MutableData<int64_t>();
+  // Group the elements of every partition.
+  std::vector<Groups> groups(num_partitions);
+  auto group_partition = [&](size_t p) {
+    GroupPartition(input_data, hashes.data(), positions.data() + partition_start[p],
+                   partition_start[p + 1] - partition_start[p], group_of, groups[p],
+                   typename UniqueTraits<T>::RadixSortable());
+  };
 
-  size_t iter = 0;
-  for (const float& e : unique_elements) {
-    // 'uniques' data
-    output_uniques_data[iter] = e;
+  for_each_partition(group_partition);
+
+  // Merge the partitions: number the groups globally, then order them by their first occurrence, which is the
+  // order of the unique values in the output.
+  std::vector<int64_t> group_start(num_partitions + 1, 0);
+  for (size_t p = 0; p < num_partitions; ++p) {
+    group_start[p + 1] = group_start[p] + static_cast<int64_t>(groups[p].first.size());
+  }
+  const auto num_groups = static_cast<size_t>(group_start[num_partitions]);
+
+  std::vector<uint8_t> is_first(num_elements, 0);
+  auto globalize_partition = [&](size_t p) {
+    for (size_t i = partition_start[p]; i < partition_start[p + 1]; ++i) {
+      group_of[positions[i]] += group_start[p];
+    }
+    for (int64_t first : groups[p].first) {
+      is_first[first] = 1;
+    }
+  };
 
-    // 'counts' data
-    const auto iter_map = element_counts.find(e);
-    output_counts_data[iter] = static_cast<int64_t>(iter_map->second);
+  for_each_partition(globalize_partition);
 
-    ++iter;
+  std::vector<int64_t> unique_index(num_groups);
+  int64_t next_unique = 0;
+  for (size_t i = 0; i < num_elements; ++i) {
+    if (is_first[i]) {
+      unique_index[group_of[i]] = next_unique++;
+    }
   }
 
+  ThreadPool::TryParallelForBlocks(tp, total, total, ThreadPool::kMinElementsPerBlock,
+                                   [&](int64_t first, int64_t last) {
+                                     for (int64_t i = first; i < last; ++i) {
+                                       group_of[i] = unique_index[group_of[i]];
+                                     }
+                                   });
+
+  // 'uniques' and 'counts' outputs
+  TensorShape output_shape({static_cast<int64_t>(num_groups)});
+  T* output_uniques_data = ctx->Output(0, output_shape)->template MutableData<T>();
+  int64_t* output_counts_data = ctx->Output(2, output_shape)->template MutableData<int64_t>();
+
+  auto write_partition = [&](size_t p) {
+    const Groups& partition_groups = groups[p];
+    for (size_t g = 0; g < partition_groups.first.size(); ++g) {
+      const int64_t index = unique_index[group_start[p] + g];
+      output_uniques_data[index] = input_data[partition_groups.first[g]];
+      output_counts_data[index] = partition_groups.count[g];
+    }
+  };
+
+  for_each_partition(write_partition);
+
   return Status::OK();
 }
 
+}  // namespace
+
+Status Unique::Compute(OpKernelContext* ctx) const {
+  const Tensor* input = ctx->Input<Tensor>(0);
+
+  // validate input
+  if (input->Shape().NumDimensions() != 1)
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input tensor to Unique op should be 1D");
+
+  auto* tp = GetOperatorThreadPool(ctx);
+
+  const auto input_type = input->DataType();
+  if (input_type == DataTypeImpl::GetType<float>()) {
+    return ComputeUnique<float>(*input, ctx, tp);
+  }
+  if (input_type == DataTypeImpl::GetType<int32_t>()) {
+    return ComputeUnique<int32_t>(*input, ctx, tp);
+  }
+  if (input_type == DataTypeImpl::GetType<int64_t>()) {
+    return ComputeUnique<int64_t>(*input, ctx, tp);
+  }
+  if (input_type == DataTypeImpl::GetType<std::string>()) {
+    return ComputeUnique<std::string>(*input, ctx, tp);
+  }
+
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Unsupported input type for Unique");
+}
+
 }  // namespace contrib
-};  // namespace onnxruntime
+}  // namespace onnxruntime
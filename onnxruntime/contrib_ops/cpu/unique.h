@@ -1,14 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#pragma once
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
-#include "core/providers/cpu/tensor/pad.h"
 
 namespace onnxruntime {
 namespace contrib {
 
-template <class T>
 class Unique final : public OpKernel {
  public:
   explicit Unique(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info) {}
@@ -17,4 +17,4 @@ class Unique final : public OpKernel {
 };
 
 }  // namespace contrib
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -3,117 +3,103 @@
 
 #include "word_conv_embedding.h"
 
-#include "core/util/math.h"
-#include "core/util/math_cpuonly.h"
+#include <algorithm>
+#include <unordered_map>
+
+#include "core/common/murmur_hash3.h"
+#include "core/framework/op_kernel_context_internal.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace contrib {
 
-void WordConvEmbedding::CharEmbeddingLookup(
-    const int* seq_ptr,
-    const float* char_embedding_weight_p,
-    size_t seq_len,
-    size_t word_len,
-    size_t char_embedding_size,
-    size_t filter_width,
-    const int* words_len_ptr,
-    float* dst) const {
-  for (size_t word_inx = 0; word_inx < seq_len; word_inx++) {
-    if (words_len_ptr[word_inx] > 0) {
-      const int* cur_seq_ptr = seq_ptr + word_inx * word_len;
-      float* cur_dst_ptr = dst + word_inx * word_len * char_embedding_size;
-      size_t char_length_to_lookup = std::max<size_t>(words_len_ptr[word_inx], filter_width);
-      for (size_t char_inx = 0; char_inx < char_length_to_lookup; char_inx++) {
-        memcpy(cur_dst_ptr, char_embedding_weight_p + (*cur_seq_ptr) * char_embedding_size, sizeof(float) * char_embedding_size);
-        cur_dst_ptr += char_embedding_size;
-        cur_seq_ptr++;
-      }
-    }
+namespace {
+
+// A word is identified by its length, which sets the number of conv windows, and by the chars that the windows
+// read. Words with the same key have the same embedding.
+struct WordKey {
+  const int* chars;
+  int length;
+  int num_chars;
+};
+
+struct WordKeyHash {
+  size_t operator()(const WordKey& key) const {
+    return MurmurHash3_x86_32(key.chars, key.num_chars * static_cast<int>(sizeof(int)),
+                              static_cast<uint32_t>(key.length));
   }
-}
+};
 
-//input : [sequence_length, word_length, char_embedding_size]
-void WordConvEmbedding::ComputeConvMaxPoolWithActivation(
-    AllocatorPtr allocator,
-    const float* input,
-    const float* weights,
-    const float* bias,
-    const int* words_len_ptr,
-    int64_t seq_len,
-    int64_t word_len,
-    int64_t char_embedding_size,
-    int64_t filter_width,
-    int64_t num_filters,
-    float* output) const {
-  int64_t input_word_size = word_len * char_embedding_size;
-  int64_t unfolded_width = word_len - filter_width + 1;
-  int64_t unfolded_kernal_size = filter_width * char_embedding_size;
-  int64_t unfolded_segment_size = unfolded_width * unfolded_kernal_size;
-  int64_t conv_res_segment_size = unfolded_width * num_filters;
-  int64_t memcpy_size = unfolded_kernal_size * sizeof(float);
-
-  auto unfolded_buffer_p = IAllocator::MakeUniquePtr<float>(allocator, seq_len * unfolded_segment_size);
-  auto conv_result_p = IAllocator::MakeUniquePtr<float>(allocator, seq_len * conv_res_segment_size);
-  auto conv_activation_result_p = IAllocator::MakeUniquePtr<float>(allocator, seq_len * conv_res_segment_size);
-
-  int64_t word_inx = 0;
-  while (word_inx < seq_len) {
-    if (words_len_ptr[word_inx] <= 0) {
-      word_inx++;
-      continue;
-    }
+struct WordKeyEqual {
+  bool operator()(const WordKey& a, const WordKey& b) const {
+    return a.length == b.length && a.num_chars == b.num_chars &&
+           memcmp(a.chars, b.chars, a.num_chars * sizeof(int)) == 0;
+  }
+};
 
-    float* words_unfolded_buffer_p = unfolded_buffer_p.get();
-    int64_t words_unfolded_width = 0;
-    int64_t tmp_word_inx = word_inx;
-    float* conv_buf_p = conv_result_p.get();
-    float* pactivationbuf = conv_activation_result_p.get();
-
-    // unfolding buffer
-    while (tmp_word_inx < seq_len && words_len_ptr[tmp_word_inx] > 0) {
-      const float* current_word_input = input + tmp_word_inx * input_word_size;
-      int64_t word_unfolded_width = std::max<int64_t>(words_len_ptr[tmp_word_inx], filter_width) - filter_width + 1;
-      words_unfolded_width += word_unfolded_width;
-      for (int64_t unfolded_inx = 0; unfolded_inx < word_unfolded_width; unfolded_inx++) {
-        memcpy(words_unfolded_buffer_p, current_word_input, memcpy_size);
-        current_word_input += char_embedding_size;
-        words_unfolded_buffer_p += unfolded_kernal_size;
-      }
-      tmp_word_inx++;
-    }
+// the largest conv table, in floats, that is precomputed for constant weights
+constexpr int64_t kMaxConvTableSize = int64_t{1} << 22;
 
-    math::GemmEx<float, CPUMathUtil>(
-        CblasNoTrans, CblasTrans,
-        static_cast<int>(words_unfolded_width), static_cast<int>(num_filters), static_cast<int>(unfolded_kernal_size), 1.0f,
-        unfolded_buffer_p.get(), static_cast<int>(unfolded_kernal_size),
-        weights, static_cast<int>(unfolded_kernal_size), 0.0f,
-        conv_buf_p, static_cast<int>(num_filters), &CPUMathUtil::Instance());
+int64_t NumberOfWindows(int word_length, int64_t filter_width) {
+  return std::max<int64_t>(word_length, filter_width) - filter_width + 1;
+}
 
-    for (int64_t unfolded_inx = 0; unfolded_inx < words_unfolded_width; unfolded_inx++)
-      for (int64_t filter_inx = 0; filter_inx < num_filters; filter_inx++) {
-        conv_buf_p[unfolded_inx * num_filters + filter_inx] += bias[filter_inx];
-      }
-    MlasComputeTanh(conv_buf_p, pactivationbuf, words_unfolded_width * num_filters);
+// Writes the convolution of the window of 'filter_width' chars starting at 'chars' by summing one row of the conv
+// table per char.
+void SumConvTableRows(const float* conv_table, const int* chars, int64_t filter_width, int64_t num_filters,
+                      float* dst) {
+  const float* row = conv_table + static_cast<int64_t>(chars[0]) * filter_width * num_filters;
+  memcpy(dst, row, num_filters * sizeof(float));
+  for (int64_t t = 1; t < filter_width; t++) {
+    row = conv_table + (static_cast<int64_t>(chars[t]) * filter_width + t) * num_filters;
+    for (int64_t f = 0; f < num_filters; f++) {
+      dst[f] += row[f];
+    }
+  }
+}
 
-    float* activationbuf_cur_ptr = pactivationbuf;
-    for (int64_t pool_word_inx = word_inx; pool_word_inx < tmp_word_inx; pool_word_inx++) {
-      float* result_ptr = output + pool_word_inx * num_filters;
-      for (int64_t filter_inx = 0; filter_inx < num_filters; filter_inx++) {
-        result_ptr[filter_inx] = -1.0f * 1e12f;
-      }
+void MaxInPlace(float* dst, const float* src, int64_t count) {
+  for (int64_t i = 0; i < count; i++) {
+    dst[i] = std::max(dst[i], src[i]);
+  }
+}
 
-      int64_t word_unfolded_width = std::max<int64_t>(words_len_ptr[pool_word_inx], filter_width) - filter_width + 1;
-      for (int64_t unfolded_inx = 0; unfolded_inx < word_unfolded_width; unfolded_inx++) {
-        for (int64_t filter_inx = 0; filter_inx < num_filters; filter_inx++) {
-          result_ptr[filter_inx] = std::max(activationbuf_cur_ptr[filter_inx], result_ptr[filter_inx]);
-        }
-        activationbuf_cur_ptr += num_filters;
+}  // namespace
+
+WordConvEmbedding::WordConvEmbedding(const OpKernelInfo& info) : OpKernel(info) {
+  const Tensor* w_conv;
+  const Tensor* w_char_embedding;
+  if (info.TryGetConstantInput(1, &w_conv) && info.TryGetConstantInput(3, &w_char_embedding) &&
+      w_conv->Shape().NumDimensions() == 4 && w_char_embedding->Shape().NumDimensions() == 2 &&
+      w_conv->Shape()[3] == w_char_embedding->Shape()[1]) {
+    const int64_t num_chars = w_char_embedding->Shape()[0];
+    const int64_t char_embedding_size = w_char_embedding->Shape()[1];
+    const int64_t num_filters = w_conv->Shape()[0];
+    const int64_t filter_width = w_conv->Shape()[2];
+    const int64_t table_size = num_chars * filter_width * num_filters;
+
+    if (table_size > 0 && table_size <= kMaxConvTableSize) {
+      AllocatorPtr allocator = info.GetAllocator(0, OrtMemTypeDefault);
+      conv_table_ = BufferUniquePtr(allocator->AllocArray(static_cast<size_t>(table_size), sizeof(float)),
+                                    BufferDeleter(allocator));
+      ORT_ENFORCE(conv_table_ != nullptr, "Failed to allocate the conv table");
+
+      // one GEMM per row of the filters: [num_chars, char_embedding_size] x [char_embedding_size, num_filters]
+      auto* conv_table = static_cast<float*>(conv_table_.get());
+      const size_t kernel_size = static_cast<size_t>(filter_width * char_embedding_size);
+      for (int64_t t = 0; t < filter_width; t++) {
+        MlasSgemm(CblasNoTrans, CblasTrans,
+                  static_cast<size_t>(num_chars), static_cast<size_t>(num_filters),
+                  static_cast<size_t>(char_embedding_size), 1.0f,
+                  w_char_embedding->Data<float>(), static_cast<size_t>(char_embedding_size),
+                  w_conv->Data<float>() + t * char_embedding_size, kernel_size, 0.0f,
+                  conv_table + t * num_filters, static_cast<size_t>(filter_width * num_filters), nullptr);
       }
     }
-    word_inx = tmp_word_inx;
   }
 }
+
 void WordConvEmbedding::CalculateLengthOfEachWordInSequence(
     const int* seq_ptr,
     int* words_len_ptr,
@@ -178,45 +164,150 @@ Status WordConvEmbedding::Compute(OpKernelContext* ctx) const {
   int64_t filter_size = w_conv_shape[0];
   int64_t filter_width = w_conv_shape[2];
 
+  if (word_len < filter_width) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Word length ", word_len,
+                           " is smaller than the conv window size ", filter_width);
+  }
+
   TensorShape Y_dims{seq_len, filter_size};
   Tensor* Y = ctx->Output(/*index*/ 0, Y_dims);
+  float* output = Y->MutableData<float>();
+  if (seq_len == 0 || filter_size == 0) {
+    return Status::OK();
+  }
 
   const int* seq_ptr = sequence.Data<int>();
+  const float* weights = w_conv.Data<float>();
+  const float* bias = b_conv.Data<float>();
+  const float* char_embeddings = w_char_embedding.Data<float>();
 
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
 
-  // allocate memory for char look up
-  // seq_len * word_len * char_embedding_size
-  size_t chars_embeddings_size = seq_len * word_len * char_embedding_size;
-  auto chars_embeddings_ptr = IAllocator::MakeUniquePtr<float>(alloc, chars_embeddings_size);
   auto words_length_ptr = IAllocator::MakeUniquePtr<int>(alloc, seq_len);
-  std::memset(chars_embeddings_ptr.get(), 0, chars_embeddings_size * sizeof(float));
-  std::memset(words_length_ptr.get(), 0, seq_len * sizeof(int));
-
+  const int* words_len = words_length_ptr.get();
   CalculateLengthOfEachWordInSequence(seq_ptr, words_length_ptr.get(), seq_len, word_len);
 
-  CharEmbeddingLookup(seq_ptr,
-                      w_char_embedding.Data<float>(),
-                      seq_len,
-                      word_len,
-                      char_embedding_size,
-                      filter_width,
-                      words_length_ptr.get(),
-                      chars_embeddings_ptr.get());
-
-  ComputeConvMaxPoolWithActivation(
-      alloc,
-      chars_embeddings_ptr.get(),
-      w_conv.Data<float>(),
-      b_conv.Data<float>(),
-      words_length_ptr.get(),
-      seq_len,
-      word_len,
-      char_embedding_size,
-      filter_width,
-      filter_size,
-      Y->MutableData<float>());
+  // Words repeat within a batch, so each distinct word is embedded once. unique_words holds the first occurrence of
+  // each distinct word and word_to_unique the distinct word of each word, or -1 for empty words.
+  std::vector<int64_t> unique_words;
+  std::vector<int64_t> word_to_unique(seq_len, -1);
+  std::unordered_map<WordKey, int64_t, WordKeyHash, WordKeyEqual> unique_index;
+  unique_index.reserve(seq_len);
+  for (int64_t word_inx = 0; word_inx < seq_len; word_inx++) {
+    if (words_len[word_inx] <= 0) {
+      continue;
+    }
+    WordKey key{seq_ptr + word_inx * word_len, words_len[word_inx],
+                static_cast<int>(std::max<int64_t>(words_len[word_inx], filter_width))};
+    auto inserted = unique_index.emplace(key, static_cast<int64_t>(unique_words.size()));
+    if (inserted.second) {
+      unique_words.push_back(word_inx);
+    }
+    word_to_unique[word_inx] = inserted.first->second;
+  }
+
+  const int64_t num_unique = static_cast<int64_t>(unique_words.size());
+  const int64_t kernel_size = filter_width * char_embedding_size;
+  const float* conv_table = static_cast<const float*>(conv_table_.get());
+
+  // first conv window of each distinct word
+  std::vector<int64_t> window_offsets(num_unique + 1, 0);
+  for (int64_t u = 0; u < num_unique; u++) {
+    window_offsets[u + 1] = window_offsets[u] + NumberOfWindows(words_len[unique_words[u]], filter_width);
+  }
+  const int64_t num_windows = window_offsets[num_unique];
+
+  // max pooled embedding of each distinct word
+  auto pooled_ptr = IAllocator::MakeUniquePtr<float>(alloc, std::max<int64_t>(num_unique, 1) * filter_size);
+  float* pooled = pooled_ptr.get();
+
+  // Without a conv table the windows of all words are unfolded (im2col) and convolved by one GEMM per block of words.
+  BufferUniquePtr unfolded_buffer;
+  BufferUniquePtr conv_buffer;
+  if (conv_table == nullptr && num_windows > 0) {
+    unfolded_buffer = BufferUniquePtr(alloc->AllocArray(static_cast<size_t>(num_windows * kernel_size), sizeof(float)),
+                                      BufferDeleter(alloc));
+    conv_buffer = BufferUniquePtr(alloc->AllocArray(static_cast<size_t>(num_windows * filter_size), sizeof(float)),
+                                  BufferDeleter(alloc));
+  }
+
+  auto embed_words = [&](int64_t first, int64_t last) {
+    if (conv_table != nullptr) {
+      std::vector<float> window(filter_size);
+      for (int64_t u = first; u < last; u++) {
+        const int* chars = seq_ptr + unique_words[u] * word_len;
+        float* max_row = pooled + u * filter_size;
+        SumConvTableRows(conv_table, chars, filter_width, filter_size, max_row);
+        const int64_t word_windows = window_offsets[u + 1] - window_offsets[u];
+        for (int64_t unfolded_inx = 1; unfolded_inx < word_windows; unfolded_inx++) {
+          SumConvTableRows(conv_table, chars + unfolded_inx, filter_width, filter_size, window.data());
+          MaxInPlace(max_row, window.data(), filter_size);
+        }
+      }
+    } else {
+      float* unfolded = static_cast<float*>(unfolded_buffer.get()) + window_offsets[first] * kernel_size;
+      float* conv = static_cast<float*>(conv_buffer.get()) + window_offsets[first] * filter_size;
+
+      // unfold the windows straight from the char embeddings
+      float* unfolded_row = unfolded;
+      for (int64_t u = first; u < last; u++) {
+        const int* chars = seq_ptr + unique_words[u] * word_len;
+        const int64_t word_windows = window_offsets[u + 1] - window_offsets[u];
+        for (int64_t unfolded_inx = 0; unfolded_inx < word_windows; unfolded_inx++) {
+          for (int64_t t = 0; t < filter_width; t++) {
+            memcpy(unfolded_row + t * char_embedding_size,
+                   char_embeddings + static_cast<int64_t>(chars[unfolded_inx + t]) * char_embedding_size,
+                   char_embedding_size * sizeof(float));
+          }
+          unfolded_row += kernel_size;
+        }
+      }
+
+      MlasSgemm(CblasNoTrans, CblasTrans,
+                static_cast<size_t>(window_offsets[last] - window_offsets[first]), static_cast<size_t>(filter_size),
+                static_cast<size_t>(kernel_size), 1.0f,
+                unfolded, static_cast<size_t>(kernel_size),
+                weights, static_cast<size_t>(kernel_size), 0.0f,
+                conv, static_cast<size_t>(filter_size), nullptr);
+
+      const float* conv_row = conv;
+      for (int64_t u = first; u < last; u++) {
+        float* max_row = pooled + u * filter_size;
+        memcpy(max_row, conv_row, filter_size * sizeof(float));
+        conv_row += filter_size;
+        const int64_t word_windows = window_offsets[u + 1] - window_offsets[u];
+        for (int64_t unfolded_inx = 1; unfolded_inx < word_windows; unfolded_inx++) {
+          MaxInPlace(max_row, conv_row, filter_size);
+          conv_row += filter_size;
+        }
+      }
+    }
+
+    // tanh is increasing, so the bias and the activation are applied once to the max of the windows
+    for (int64_t u = first; u < last; u++) {
+      float* max_row = pooled + u * filter_size;
+      for (int64_t filter_inx = 0; filter_inx < filter_size; filter_inx++) {
+        max_row[filter_inx] += bias[filter_inx];
+      }
+    }
+    MlasComputeTanh(pooled + first * filter_size, pooled + first * filter_size, (last - first) * filter_size);
+  };
+
+  // each distinct word is embedded once, weighted by the convolution windows of all the words
+  auto* tp = GetOperatorThreadPool(ctx);
+  const int64_t window_work = filter_size * (conv_table != nullptr ? filter_width : kernel_size);
+  concurrency::ThreadPool::TryParallelForBlocks(tp, num_unique, num_windows * window_work,
+                                                concurrency::ThreadPool::kMinElementsPerBlock, embed_words);
+
+  for (int64_t word_inx = 0; word_inx < seq_len; word_inx++) {
+    float* result_ptr = output + word_inx * filter_size;
+    if (word_to_unique[word_inx] < 0) {
+      std::memset(result_ptr, 0, filter_size * sizeof(float));
+    } else {
+      memcpy(result_ptr, pooled + word_to_unique[word_inx] * filter_size, filter_size * sizeof(float));
+    }
+  }
 
   return Status::OK();
 }
@@ -12,33 +12,11 @@ namespace contrib {
 
 class WordConvEmbedding final : public OpKernel {
  public:
-  explicit WordConvEmbedding(const OpKernelInfo& info) : OpKernel(info) {
-  }
+  explicit WordConvEmbedding(const OpKernelInfo& info);
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  void CharEmbeddingLookup(
-      const int* seq_ptr,
-      const float* char_embedding_weight_p,
-      size_t seq_len,
-      size_t word_len,
-      size_t char_embedding_size,
-      size_t filter_width,
-      const int* words_len_ptr,
-      float* dst) const;
-  void ComputeConvMaxPoolWithActivation(
-      AllocatorPtr allocator,
-      const float* input,
-      const float* weights,
-      const float* bias,
-      const int* words_len_ptr,
-      int64_t seq_len,
-      int64_t word_len,
-      int64_t char_embedding_size,
-      int64_t filter_width,
-      int64_t num_filters,
-      float* output) const;
   void CalculateLengthOfEachWordInSequence(
       const int* seq_ptr,
       int* words_len_ptr,
@@ -53,6 +31,11 @@ class WordConvEmbedding final : public OpKernel {
   int64_t embedding_size_{Info().GetAttrOrDefault<int64_t>("embedding_size", -1)};
   int64_t conv_window_size_{Info().GetAttrOrDefault<int64_t>("conv_window_size", -1)};
   int64_t char_embedding_size_{Info().GetAttrOrDefault<int64_t>("char_embedding_size", -1)};
+
+  // When the conv weights and the char embeddings are constant, every char embedding is convolved with every row of
+  // the filters once: conv_table_[c][t][f] is the dot product of the embedding of char c with row t of filter f. The
+  // convolution of a window of chars is then the sum of conv_window_size rows of the table.
+  BufferUniquePtr conv_table_;
 };
 
 }  // namespace contrib
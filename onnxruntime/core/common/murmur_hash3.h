@@ -0,0 +1,17 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace onnxruntime {
+
+/**
+ * 32 bit MurmurHash3 of 'len' bytes starting at 'key', as computed by the x86 variant of the reference
+ * implementation and by scikit-learn's murmurhash3_32. Shared by the MurmurHash3 contrib operator and the hash
+ * tables of the string mapping kernels.
+ */
+uint32_t MurmurHash3_x86_32(const void* key, int len, uint32_t seed);
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 
+#include <algorithm>
 #include <cassert>
 
 #ifdef USE_EIGEN_THREADPOOL
@@ -206,5 +207,44 @@ int ThreadPool::CurrentThreadId() const { return impl_->CurrentThreadId(); }
 
 ThreadPool::~ThreadPool() {}
 
+constexpr int64_t ThreadPool::kMinElementsPerBlock;
+constexpr int64_t ThreadPool::kMinSortElementsPerBlock;
+constexpr int64_t ThreadPool::kMinStringBytesPerBlock;
+constexpr int64_t ThreadPool::kMinBoxesPerBlock;
+constexpr int64_t ThreadPool::kMinLookupsPerBlock;
+
+int64_t ThreadPool::NumBlocks(const ThreadPool* tp, int64_t total, int64_t total_work, int64_t min_block_work) {
+  if (tp == nullptr || total <= 1) {
+    return 1;
+  }
+
+  int64_t num_blocks = std::min<int64_t>(total, tp->NumThreads() + 1);
+  num_blocks = std::max<int64_t>(1, std::min(num_blocks, total_work / std::max<int64_t>(min_block_work, 1)));
+
+  // drop the blocks that rounding the block size up leaves empty
+  const int64_t block_size = (total + num_blocks - 1) / num_blocks;
+  return (total + block_size - 1) / block_size;
+}
+
+void ThreadPool::ParallelForBlocks(ThreadPool* tp, int64_t total, int64_t num_blocks,
+                                   const std::function<void(int64_t, int64_t, int64_t)>& fn) {
+  if (tp == nullptr || num_blocks <= 1) {
+    fn(0, 0, total);
+    return;
+  }
+
+  const int64_t block_size = (total + num_blocks - 1) / num_blocks;
+  tp->ParallelFor(static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    const int64_t first = block * block_size;
+    fn(block, first, std::min(first + block_size, total));
+  });
+}
+
+void ThreadPool::TryParallelForBlocks(ThreadPool* tp, int64_t total, int64_t total_work, int64_t min_block_work,
+                                      const std::function<void(int64_t, int64_t)>& fn) {
+  ParallelForBlocks(tp, total, NumBlocks(tp, total, total_work, min_block_work),
+                    [&fn](int64_t, int64_t first, int64_t last) { fn(first, last); });
+}
+
 }  // namespace concurrency
 }  // namespace onnxruntime
@@ -22,7 +22,7 @@ IExecutionFrame::IExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, cons
                                  const std::unordered_map<int, OrtValue>& initializers,
                                  const std::vector<int>& fetch_mlvalue_idxs, const std::vector<OrtValue>& fetches,
                                  const OrtValueNameIdxMap& ort_value_idx_map, const NodeIndexInfo& node_index_info)
-    : node_index_info_{node_index_info}, fetch_mlvalue_idxs_{fetch_mlvalue_idxs} {
+    : node_index_info_{node_index_info}, feed_mlvalue_idxs_{feed_mlvalue_idxs}, fetch_mlvalue_idxs_{fetch_mlvalue_idxs} {
   ORT_ENFORCE(feeds.size() == feed_mlvalue_idxs.size());
   ORT_ENFORCE(fetches.empty() || fetches.size() == fetch_mlvalue_idxs.size());
 
@@ -160,6 +160,17 @@ Status IExecutionFrame::GetOutputs(std::vector<OrtValue>& fetches) {
   return Status::OK();
 }
 
+void IExecutionFrame::ResetValues(const std::vector<OrtValue>& feeds,
+                                  const std::unordered_map<int, OrtValue>& initializers,
+                                  const std::vector<OrtValue>& fetches, const OrtValueNameIdxMap& ort_value_idx_map) {
+  ORT_ENFORCE(feeds.size() == feed_mlvalue_idxs_.size());
+  ORT_ENFORCE(fetches.empty() || fetches.size() == fetch_mlvalue_idxs_.size());
+
+  std::fill(all_values_.begin(), all_values_.end(), OrtValue());
+
+  Init(feed_mlvalue_idxs_, feeds, initializers, fetch_mlvalue_idxs_, fetches, ort_value_idx_map);
+}
+
 bool IExecutionFrame::IsOutput(int ort_value_idx) const {
   return std::find(fetch_mlvalue_idxs_.begin(), fetch_mlvalue_idxs_.end(), ort_value_idx) != fetch_mlvalue_idxs_.end();
 }
@@ -173,8 +184,22 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
       session_state_{session_state},
       mem_patterns_{nullptr},
       planner_{nullptr} {
+  SetCustomAllocators(fetch_allocators);
+
+  // If the session enable memory pattern optimization
+  // and we have execution plan generated, try to setup
+  // memory pattern optimization.
+  if (session_state.GetEnableMemoryPattern() && session_state.GetExecutionPlan()) {
+    InitMemoryPatterns(feeds);
+  }
+}
+
+void ExecutionFrame::SetCustomAllocators(
+    const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
   // map the custom allocators to ort_value_idx entries
+  custom_allocators_.clear();
   if (!fetch_allocators.empty()) {
+    const auto& fetch_mlvalue_idxs = FetchMLValueIdxs();
     for (size_t idx = 0, end = fetch_mlvalue_idxs.size(); idx < end; ++idx) {
       int ort_value_idx = fetch_mlvalue_idxs[idx];
 
@@ -184,43 +209,67 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
       }
     }
   }
+}
 
-  // If the session enable memory pattern optimization
-  // and we have execution plan generated, try to setup
-  // memory pattern optimization.
-  if (session_state.GetEnableMemoryPattern() && session_state.GetExecutionPlan()) {
-    std::vector<TensorShape> input_shapes;
-    bool all_tensors = true;
-    // Reserve mem to avoid re-allocation.
-    input_shapes.reserve(feeds.size());
-    for (const auto& feed : feeds) {
-      if (!(feed.IsTensor())) {
-        all_tensors = false;
-        break;
-      }
-      auto& tensor = feed.Get<Tensor>();
-      input_shapes.push_back(tensor.Shape());
+void ExecutionFrame::InitMemoryPatterns(const std::vector<OrtValue>& feeds) {
+  std::vector<TensorShape> input_shapes;
+  bool all_tensors = true;
+  // Reserve mem to avoid re-allocation.
+  input_shapes.reserve(feeds.size());
+  for (const auto& feed : feeds) {
+    if (!(feed.IsTensor())) {
+      all_tensors = false;
+      break;
     }
+    auto& tensor = feed.Get<Tensor>();
+    input_shapes.push_back(tensor.Shape());
+  }
 
-    //if there are some traditional ml value type in inputs disable the memory pattern optimization.
-    if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
-      // if no existing patterns, generate one in this executionframe
-      if (!mem_patterns_) {
-        planner_ = std::make_unique<OrtValuePatternPlanner>(*session_state.GetExecutionPlan());
-      } else {
-        // pre-allocate the big chunk requested in memory pattern.
-        // all the internal kernel's input/output tensors will be allocated on these buffer.
-        for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
-          ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
-          AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
-          void* buffer = mem_patterns_->patterns[i].PeakSize() > 0
-                             ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize())
-                             : nullptr;
-          buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
-        }
+  //if there are some traditional ml value type in inputs disable the memory pattern optimization.
+  if (all_tensors) {
+    mem_patterns_ = session_state_.GetMemoryPatternGroup(input_shapes);
+    // if no existing patterns, generate one in this executionframe
+    if (!mem_patterns_) {
+      planner_ = std::make_unique<OrtValuePatternPlanner>(*session_state_.GetExecutionPlan());
+    } else {
+      // pre-allocate the big chunk requested in memory pattern.
+      // all the internal kernel's input/output tensors will be allocated on these buffer.
+      for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
+        ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
+        AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
+        void* buffer = mem_patterns_->patterns[i].PeakSize() > 0
+                           ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize())
+                           : nullptr;
+        buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
       }
     }
+
+    mem_patterns_input_shapes_ = std::move(input_shapes);
+  }
+}
+
+void ExecutionFrame::Reset(const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches,
+                           const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  ResetValues(feeds, session_state_.GetInitializedTensors(), fetches, session_state_.GetOrtValueNameIdxMap());
+
+  SetCustomAllocators(fetch_allocators);
+
+  if (session_state_.GetEnableMemoryPattern() && session_state_.GetExecutionPlan()) {
+    // the memory pattern only needs to be looked up again if the feed shapes changed, or if the previous
+    // execution traced the allocations to generate a pattern that is now available from the session state.
+    bool same_shapes = mem_patterns_ != nullptr && feeds.size() == mem_patterns_input_shapes_.size();
+    for (size_t i = 0; same_shapes && i < feeds.size(); ++i) {
+      same_shapes = feeds[i].IsTensor() && feeds[i].Get<Tensor>().Shape() == mem_patterns_input_shapes_[i];
+    }
+
+    if (!same_shapes) {
+      mem_patterns_ = nullptr;
+      planner_.reset();
+      buffers_.clear();
+      mem_patterns_input_shapes_.clear();
+
+      InitMemoryPatterns(feeds);
+    }
   }
 }
 
@@ -69,6 +69,13 @@ class IExecutionFrame {
   // returns true if the ort_value_idx is an output from the graph
   bool IsOutput(int ort_value_idx) const;
 
+  const std::vector<int>& FetchMLValueIdxs() const { return fetch_mlvalue_idxs_; }
+
+  // release all values from the previous execution and setup the feeds, initializers and fetches for the next one.
+  // the feed and fetch indexes must be the same as the frame was created with.
+  void ResetValues(const std::vector<OrtValue>& feeds, const std::unordered_map<int, OrtValue>& initializers,
+                   const std::vector<OrtValue>& fetches, const OrtValueNameIdxMap& ort_value_idx_map);
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IExecutionFrame);
 
@@ -91,6 +98,7 @@ class IExecutionFrame {
   // Input and Output values are passed in by executors
   std::vector<OrtValue> all_values_;
 
+  const std::vector<int> feed_mlvalue_idxs_;
   const std::vector<int> fetch_mlvalue_idxs_;
 };
 
@@ -104,6 +112,12 @@ class ExecutionFrame final : public IExecutionFrame {
 
   ~ExecutionFrame() override;
 
+  // Prepare the frame for another execution of the same graph with the same feed and fetch indexes.
+  // This avoids re-creating the frame for each iteration of a control flow subgraph. The memory pattern buffers
+  // are kept if the feeds have the same shapes as the previous execution.
+  void Reset(const std::vector<OrtValue>& feeds, const std::vector<OrtValue>& fetches,
+             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
   // TODO: These two AllocateMLValue... methods are in the API purely for unit test usage.
   // Fix the unit tests so they set an execution plan that results in these methods being called by
   // GetOrCreateNodeOutputMLValue instead
@@ -129,6 +143,11 @@ class ExecutionFrame final : public IExecutionFrame {
   Status ReleaseMLValueImpl(int ort_value_idx) override;
   Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape, size_t nnz) override;
 
+  void SetCustomAllocators(const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // lookup the memory pattern for the feed shapes and allocate its buffers, or setup the planner to create one
+  void InitMemoryPatterns(const std::vector<OrtValue>& feeds);
+
   common::Status AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_value_index, const TensorShape* shape,
                                              size_t nnz);
 
@@ -160,5 +179,8 @@ class ExecutionFrame final : public IExecutionFrame {
 
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtAllocatorInfo, BufferUniquePtr> buffers_;
+
+  // feed shapes that mem_patterns_ was looked up with
+  std::vector<TensorShape> mem_patterns_input_shapes_;
 };
 }  // namespace onnxruntime
@@ -59,6 +59,12 @@ OrtStatus* OrtTypeInfo::FromDataTypeImpl(const onnxruntime::DataTypeImpl* input,
     *out = new OrtTypeInfo(ONNX_TYPE_SEQUENCE, nullptr);
     return nullptr;
   }
+  // other registered maps, such as the views of the elements of a sequence of maps returned by OrtGetValue
+  const ONNX_NAMESPACE::TypeProto* type_proto = input->GetTypeProto();
+  if (type_proto != nullptr && type_proto->value_case() == ONNX_NAMESPACE::TypeProto::kMapType) {
+    *out = new OrtTypeInfo(ONNX_TYPE_MAP, nullptr);
+    return nullptr;
+  }
   return OrtCreateStatus(ORT_NOT_IMPLEMENTED, "not implemented");
 }
 
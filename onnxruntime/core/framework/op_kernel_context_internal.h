@@ -65,4 +65,13 @@ class OpKernelContextInternal : public OpKernelContext {
   const bool& terminate_flag_;
 };
 
+/**
+ * Returns the thread pool that a kernel should run its parallel work on, or nullptr to run it on the calling thread.
+ * Kernels are always computed with an OpKernelContextInternal.
+ */
+inline concurrency::ThreadPool* GetOperatorThreadPool(OpKernelContext* context) {
+  return const_cast<concurrency::ThreadPool*>(
+      static_cast<OpKernelContextInternal*>(context)->GetOperatorThreadPool());
+}
+
 }  // namespace onnxruntime
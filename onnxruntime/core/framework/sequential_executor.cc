@@ -27,6 +27,16 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                    std::vector<OrtValue>& fetches,
                                    const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                    const logging::Logger& logger) {
+  std::unique_ptr<ExecutionFrame> frame;
+  return Execute(session_state, feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, logger,
+                 frame);
+}
+
+Status SequentialExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
+                                   const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                                   std::vector<OrtValue>& fetches,
+                                   const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
+                                   const logging::Logger& logger, std::unique_ptr<ExecutionFrame>& frame) {
   bool f_profiler_enabled = session_state.Profiler().FEnabled();
   TimePoint tp;
   TimePoint sync_time_begin;
@@ -36,7 +46,12 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     tp = session_state.Profiler().StartTime();
   }
 
-  ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
+  if (frame) {
+    frame->Reset(feeds, fetches, fetch_allocators);
+  } else {
+    frame = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators,
+                                             session_state);
+  }
 
   LOGS(logger, INFO) << "Begin execution";
   const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
@@ -62,7 +77,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 
     // construct OpKernelContext
     // TODO: log kernel inputs?
-    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger,
+    OpKernelContextInternal op_kernel_context(session_state, *frame, *p_op_kernel, logger,
                                               p_op_kernel->Node().ImplicitInputDefs(), terminate_flag_);
     // TODO: log kernel outputs?
     if (f_profiler_enabled) {
@@ -172,15 +187,15 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 
     // free ml-values corresponding to this node
     VLOGS(logger, 1) << "Releasing node ML values after computing kernel: " << p_op_kernel->Node().Name();
-    ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
+    ORT_RETURN_IF_ERROR(ReleaseNodeMLValues(*frame, seq_exec_plan, node_exec_plan, logger));
   }
 
   VLOGS(logger, 1) << "Fetching output.";
   // ExecutionFrame::Finalize will update 'fetches' with the final output
-  ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
+  ORT_RETURN_IF_ERROR(frame->GetOutputs(fetches));
   VLOGS(logger, 1) << "Done with execution.";
 
-  if (frame.HasMemoryPatternPlanner()) {
+  if (frame->HasMemoryPatternPlanner()) {
     std::vector<TensorShape> input_shapes;
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -194,7 +209,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
 
     if (all_tensors) {
       auto mem_patterns = std::make_unique<MemoryPatternGroup>();
-      ORT_RETURN_IF_ERROR(frame.GeneratePatterns(mem_patterns.get()));
+      ORT_RETURN_IF_ERROR(frame->GeneratePatterns(mem_patterns.get()));
       ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
     }
   }
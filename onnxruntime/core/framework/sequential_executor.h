@@ -15,6 +15,8 @@
 #include "core/graph/graph_viewer.h"
 
 namespace onnxruntime {
+class ExecutionFrame;
+
 class SequentialExecutor : public IExecutor {
  public:
   SequentialExecutor(const bool& terminate_flag = false) : terminate_flag_{terminate_flag} {}
@@ -25,6 +27,14 @@ class SequentialExecutor : public IExecutor {
                          const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                          const logging::Logger& logger) override;
 
+  // Execute using 'frame' if it holds the frame from a previous execution with the same feed and fetch indexes,
+  // otherwise create a new frame and return it in 'frame' so it can be re-used by the next execution.
+  common::Status Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
+                         const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                         std::vector<OrtValue>& fetches,
+                         const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
+                         const logging::Logger& logger, std::unique_ptr<ExecutionFrame>& frame);
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SequentialExecutor);
   const bool& terminate_flag_;
@@ -33,7 +33,7 @@ static common::Status SaveMLValueNameIndexMapping(const GraphViewer& graph_viewe
 // T should have signature of '(int idx, const OrtValue& value, const OrtCallback& d) -> Status'
 template <typename T>
 static common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
-                                             const onnxruntime::Graph& graph, const ExecutionProviders& exec_providers,
+                                             onnxruntime::Graph& graph, const ExecutionProviders& exec_providers,
                                              const OrtValueNameIdxMap& ort_value_name_idx_map,
                                              ITensorAllocator* planner, const T& save_tensor_func,
                                              const logging::Logger& logger);
@@ -49,8 +49,7 @@ static common::Status SaveInputOutputNamesToNodeMapping(
     SessionState& session_state,
     const ConstPointerContainer<std::vector<NodeArg*>>* implicit_inputs);
 
-SessionStateInitializer::SessionStateInitializer(bool enable_mem_pattern,
-                                                 const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
+SessionStateInitializer::SessionStateInitializer(const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                                  onnxruntime::Graph& graph, SessionState& session_state,
                                                  const ExecutionProviders& providers,
                                                  KernelRegistryManager& kernel_registry_manager)
@@ -59,8 +58,7 @@ SessionStateInitializer::SessionStateInitializer(bool enable_mem_pattern,
       session_state_{session_state},
       execution_providers_{providers},
       kernel_registry_manager_{kernel_registry_manager},
-      logger_{session_state.Logger()},
-      enable_mem_pattern_(enable_mem_pattern) {}
+      logger_{session_state.Logger()} {}
 
 common::Status SessionStateInitializer::CreatePlan(
     const Node* parent_node,
@@ -102,7 +100,7 @@ common::Status SessionStateInitializer::InitializeAndSave(
 
   const auto& ort_value_name_idx_map{session_state_.GetOrtValueNameIdxMap()};
   std::unique_ptr<ITensorAllocator> tensor_allocator_(ITensorAllocator::Create(
-      enable_mem_pattern_, *exec_plan_ptr, execution_providers_, session_state_.GetMutableWeightsBuffers()));
+      *exec_plan_ptr, execution_providers_, session_state_.GetMutableWeightsBuffers()));
 
   // lambda to save initialized tensors into SessionState directly
   const Env& env = Env::Default();
@@ -113,9 +111,7 @@ common::Status SessionStateInitializer::InitializeAndSave(
       },
       logger_));
 
-  // remove weights from the graph now to save memory but in many cases it won't save memory, if the tensor was
-  // preallocated with the some other tensors in a single 'allocate' call, which is very common.
-  // TODO: make it better
+  // the data of the weights was released as they were saved, now remove the weights from the graph
   graph_.CleanAllInitializedTensors();
 
   ORT_RETURN_IF_ERROR(SaveKernels(execution_providers_, session_state_, kernel_registry_manager_, logger_));
@@ -237,13 +233,13 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 
 template <typename T>
 common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
-                                      const Graph& graph, const ExecutionProviders& exec_providers,
+                                      Graph& graph, const ExecutionProviders& exec_providers,
                                       const OrtValueNameIdxMap& ort_value_name_idx_map, ITensorAllocator* planner,
                                       const T& save_tensor_func, const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > 0, "OrtValue indexes should have been populated.");
 
-  //1. first plan the memory
+  //1. first record the initializers
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   std::unordered_map<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   for (const auto& entry : initialized_tensor_set) {
@@ -255,10 +251,9 @@ common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PA
     ORT_RETURN_IF_ERROR(planner->Trace(entry.first, entry.second));
   }
 
-  //2. allocate weight buffer on different locations
-  ORT_RETURN_IF_ERROR(planner->FinalizePlan());
   OrtCallback deleter;
-  //3. create weight tensors based on weights buffer
+  //2. allocate each weight buffer right before its tensor is created from the initializer data, so that the weights
+  //   grow as the graph releases the initializers instead of being allocated in full while the graph holds them all
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const char* name = entry.second->has_name() ? entry.second->name().c_str() : "";
@@ -283,6 +278,11 @@ common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PA
     ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant));
 
     VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << ort_value_index;
+
+    // the weight has its own copy of the data now. release the one in the graph right away instead of after all the
+    // weights are saved, so that the data of the whole model is never held twice in memory.
+    // 'name' points into the tensor proto and must not be used after this.
+    graph.ReleaseInitializedTensorData(name);
   }
 
   LOGS(logger, INFO) << "Done saving initialized tensors";
@@ -31,7 +31,7 @@ class SessionStateInitializer {
    *
    * \param graph_loc The file path of where the graph was loaded. e.g. /tmp/test_squeezenet/model.onnx
    */
-  SessionStateInitializer(bool enable_mem_pattern, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
+  SessionStateInitializer(const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                           onnxruntime::Graph& graph, SessionState& session_state, const ExecutionProviders& providers,
                           KernelRegistryManager& kernel_registry_manager);
 
@@ -52,6 +52,5 @@ class SessionStateInitializer {
   const ExecutionProviders& execution_providers_;
   KernelRegistryManager& kernel_registry_manager_;
   const logging::Logger& logger_;
-  const bool enable_mem_pattern_;
 };
 }  // namespace onnxruntime
@@ -27,7 +27,6 @@ class SimpleTensorAllocator : public ITensorAllocator {
       : ITensorAllocator(exec_providers),
         weights_buffers_(weights_buffers),
         seq_plan_(execution_plan) {}
-  common::Status FinalizePlan() override { return Status::OK(); }
   common::Status GetPreallocatedBuffer(int ort_value_index, const char* name, std::unique_ptr<MemBuffer>& out) override;
   common::Status Trace(int id, const ONNX_NAMESPACE::TensorProto* value) override;
 };
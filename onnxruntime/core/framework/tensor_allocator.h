@@ -22,8 +22,9 @@ class ITensorAllocator {
  public:
   AllocatorPtr GetAllocator(const OrtAllocatorInfo& allocator_info);
 
-  virtual common::Status FinalizePlan() = 0;
   /**
+   * Allocates the buffer of the initializer traced with 'ort_value_index', so that each initializer is only
+   * allocated right before its data is copied in.
    *
    * \param ort_value_index The index in planner
    * \param name Tensor name. Only for logging purpose
@@ -41,7 +42,7 @@ class ITensorAllocator {
   explicit ITensorAllocator(const ExecutionProviders& exec_providers) : exec_providers_(exec_providers) {}
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ITensorAllocator);
 
-  static std::unique_ptr<ITensorAllocator> Create(bool enable_mem_pattern, const ExecutionPlanBase& execution_plan,
+  static std::unique_ptr<ITensorAllocator> Create(const ExecutionPlanBase& execution_plan,
                                                   const ExecutionProviders& exec_providers,
                                                   std::vector<BufferUniquePtr>& weights_buffers);
 };
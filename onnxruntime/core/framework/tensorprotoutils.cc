@@ -372,6 +372,7 @@ Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_proto_path,
   const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
   AutoDelete deleter_for_file_data;
   void* tensor_data;
+  bool read_into_preallocated = false;
   {
     if (tensor_proto.data_location() == TensorProto_DataLocation_EXTERNAL) {
       if (ele_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING)
@@ -387,8 +388,22 @@ Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_proto_path,
         full_path = external_data_info->GetRelPath();
       }
       raw_data_len = external_data_info->GetLength();
-      // load the file
-      {
+      if (IsLittleEndianOrder() && m.GetBuffer() != nullptr && raw_data_len > 0) {
+        // copy the data straight from the file to the preallocated buffer, so that it is never held twice in memory
+        size_t tensor_byte_size;
+        ORT_RETURN_IF_ERROR(GetSizeInBytesFromTensorProto<0>(tensor_proto, &tensor_byte_size));
+        if (raw_data_len != tensor_byte_size)
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The external data of the tensor has ", raw_data_len,
+                                 " bytes, expected ", tensor_byte_size);
+        if (m.GetLen() < raw_data_len)
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                 "The buffer planner is not consistent with tensor buffer size, expected ",
+                                 raw_data_len, ", got ", m.GetLen());
+        ORT_RETURN_IF_ERROR(env.ReadFileIntoBuffer(full_path.c_str(), external_data_info->GetOffset(), raw_data_len,
+                                                   m.GetBuffer()));
+        read_into_preallocated = true;
+      } else {
+        // load the file
         void* file_data;
         ORT_RETURN_IF_ERROR(env.ReadFileAsString(full_path.c_str(), external_data_info->GetOffset(),
                                                  file_data, raw_data_len, deleter_for_file_data.d));
@@ -400,7 +415,9 @@ Status TensorProtoToMLValue(const Env& env, const ORTCHAR_T* tensor_proto_path,
       raw_data = tensor_proto.raw_data().data();
       raw_data_len = tensor_proto.raw_data().size();
     }
-    if (IsLittleEndianOrder() && raw_data != nullptr && deleter_for_file_data.d.f != nullptr) {
+    if (read_into_preallocated) {
+      tensor_data = m.GetBuffer();
+    } else if (IsLittleEndianOrder() && raw_data != nullptr && deleter_for_file_data.d.f != nullptr) {
       tensor_data = const_cast<void*>(raw_data);
       MoveOrtCallback(deleter_for_file_data.d, deleter);
     } else {
@@ -431,10 +431,12 @@ common::Status ExecuteGraphWithCachedInfo(
     const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
     const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
     const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators, bool sequential_execution,
-    const bool& terminate_flag, const logging::Logger& logger) {
+    const bool& terminate_flag, const logging::Logger& logger, std::unique_ptr<ExecutionFrame>* frame) {
   const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
   auto device_copy_checks = feeds_fetches_manager.GetDeviceCopyChecks();
 
+  ORT_ENFORCE(frame == nullptr || sequential_execution, "Re-using the execution frame requires sequential execution.");
+
   std::unique_ptr<IExecutor> p_exec;
   if (sequential_execution) {
     p_exec = std::unique_ptr<IExecutor>(new SequentialExecutor(terminate_flag));
@@ -442,11 +444,22 @@ common::Status ExecuteGraphWithCachedInfo(
     p_exec = std::unique_ptr<IExecutor>(new ParallelExecutor(session_state, terminate_flag));
   }
 
+  auto execute = [&](const std::vector<OrtValue>& exec_feeds, std::vector<OrtValue>& exec_fetches) {
+    if (frame) {
+      return static_cast<SequentialExecutor&>(*p_exec).Execute(session_state,
+                                                               feeds_fetches_info.feeds_mlvalue_idxs, exec_feeds,
+                                                               feeds_fetches_info.fetches_mlvalue_idxs, exec_fetches,
+                                                               fetch_allocators, logger, *frame);
+    }
+
+    return p_exec->Execute(session_state,
+                           feeds_fetches_info.feeds_mlvalue_idxs, exec_feeds,
+                           feeds_fetches_info.fetches_mlvalue_idxs, exec_fetches, fetch_allocators, logger);
+  };
+
   if (device_copy_checks.status == DeviceCopyCheck::NoCopy) {
     // no device copies are needed so simple execute
-    ORT_RETURN_IF_ERROR(p_exec->Execute(session_state,
-                                        feeds_fetches_info.feeds_mlvalue_idxs, feeds,
-                                        feeds_fetches_info.fetches_mlvalue_idxs, fetches, fetch_allocators, logger));
+    ORT_RETURN_IF_ERROR(execute(feeds, fetches));
   } else {
     const std::vector<OrtValue>* p_feeds = &feeds;
     std::vector<OrtValue>* p_fetches = &fetches;
@@ -473,10 +486,7 @@ common::Status ExecuteGraphWithCachedInfo(
       p_fetches = &device_fetches;
     }
 
-    ORT_RETURN_IF_ERROR(p_exec->Execute(session_state,
-                                        feeds_fetches_info.feeds_mlvalue_idxs, *p_feeds,
-                                        feeds_fetches_info.fetches_mlvalue_idxs, *p_fetches, fetch_allocators,
-                                        logger));
+    ORT_RETURN_IF_ERROR(execute(*p_feeds, *p_fetches));
 
     if (device_copy_checks.output_copy_needed == DeviceCopyCheck::Copy) {
       ORT_RETURN_IF_ERROR(CachedCopyOutputsAcrossDevices(*p_fetches, fetches,
@@ -11,6 +11,7 @@
 #include "core/framework/session_state.h"
 
 namespace onnxruntime {
+class ExecutionFrame;
 class ExecutionProviders;
 class FeedsFetchesManager;
 class Graph;
@@ -45,11 +46,15 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
                             bool cache_copy_info = true);
 
 // ExecuteGraph used the cached information in feeds_fetches_manager.
+// If 'frame' is provided execution must be sequential. It holds the ExecutionFrame from a previous call that
+// will be reset and re-used, or receives the new frame, so that a subgraph executed once per iteration of a
+// control flow node doesn't re-create the frame and its memory pattern buffers on every iteration.
 common::Status ExecuteGraphWithCachedInfo(
     const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
     const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
     const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators, bool sequential_execution,
-    const bool& terminate_flag, const logging::Logger& logger);
+    const bool& terminate_flag, const logging::Logger& logger,
+    std::unique_ptr<ExecutionFrame>* frame = nullptr);
 
 #if defined(DEBUG_NODE_INPUTS_OUTPUTS)
 // to create a build with these enabled run the build script with
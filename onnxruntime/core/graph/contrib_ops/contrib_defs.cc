@@ -829,6 +829,72 @@ activation and leaky_relu_alpha.)DOC")
         }
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulWithHalfWeights)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Computes Y = alpha * A * B + C, where the constant weights B are stored as float16 or bfloat16
+values and are converted to float while being packed for the matrix multiply, so the product is
+computed in float without keeping a float copy of B. The operator is created by the graph optimizer
+from a Cast of a float16/bfloat16 initializer to float followed by MatMul or Gemm.)DOC")
+      .Input(
+          0,
+          "A",
+          "Input tensor A with shape (..., K).",
+          "T")
+      .Input(
+          1,
+          "B",
+          "2-D weights tensor B. "
+          "The shape of B should be (K, N) if transB is 0, "
+          "or (N, K) if transB is non-zero.",
+          "T1")
+      .Input(
+          2,
+          "C",
+          "Optional bias tensor with N elements.",
+          "T",
+          OpSchema::Optional)
+      .Output(0, "Y", "Output tensor with shape (..., N).", "T")
+      .TypeConstraint(
+          "T",
+          {"tensor(float)"},
+          "Constrain input A, bias and output types to float tensors.")
+      .TypeConstraint(
+          "T1",
+          {"tensor(float16)", "tensor(bfloat16)"},
+          "Constrain the weights type to 16-bit floating point tensors.")
+      .Attr(
+          "transB",
+          "Whether B should be transposed",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Attr(
+          "alpha",
+          "Scalar multiplier for the product of input tensors A * B.",
+          AttributeProto::FLOAT,
+          1.0f)
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (hasNInputShapes(ctx, 2)) {
+          auto transBAttr = ctx.getAttribute("transB");
+          bool transB =
+              transBAttr ? static_cast<int>(transBAttr->i()) != 0 : false;
+          auto& first_input_shape = getInputShape(ctx, 0);
+          auto& second_input_shape = getInputShape(ctx, 1);
+          if (first_input_shape.dim_size() < 1)
+            fail_shape_inference("First input does not have at least rank 1");
+          if (second_input_shape.dim_size() != 2)
+            fail_shape_inference("Second input does not have rank 2");
+          ONNX_NAMESPACE::TensorShapeProto output_shape;
+          for (int i = 0; i < first_input_shape.dim_size() - 1; i++) {
+            *output_shape.add_dim() = first_input_shape.dim(i);
+          }
+          *output_shape.add_dim() = second_input_shape.dim(transB ? 0 : 1);
+          updateOutputShape(ctx, 0, output_shape);
+        }
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(ExpandDims)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1946,6 +1946,22 @@ void Graph::CleanAllInitializedTensors() noexcept {
   }
 }
 
+void Graph::ReleaseInitializedTensorData(const std::string& tensor_name) {
+  auto iter = name_to_initial_tensor_.find(tensor_name);
+  if (name_to_initial_tensor_.end() == iter) {
+    return;
+  }
+
+  // The initializers are owned by graph_proto_. Clearing the data fields would retain their memory for reuse, so
+  // swap the initializer with a copy of its metadata and let the original be destroyed with the data.
+  TensorProto* tensor = const_cast<TensorProto*>(iter->second);
+  TensorProto metadata;
+  metadata.set_name(tensor->name());
+  metadata.set_data_type(tensor->data_type());
+  *metadata.mutable_dims() = tensor->dims();
+  tensor->Swap(&metadata);
+}
+
 const InitializedTensorSet& Graph::GetAllInitializedTensors() const noexcept {
   return name_to_initial_tensor_;
 }
@@ -110,6 +110,169 @@ MlasSgemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Single precision matrix/matrix multiply routines where matrix B is stored
+// as half precision or bfloat16 values. Matrix B is converted to single
+// precision while being packed, so the multiply is computed in single
+// precision.
+//
+
+struct MLAS_FP16 {
+    uint16_t Value;
+};
+
+struct MLAS_BFLOAT16 {
+    uint16_t Value;
+};
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_BFLOAT16* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Quantized integer matrix/matrix multiply routines.
+//
+// These routines compute C = (A - offa) * (B - offb) where matrix A is an
+// unsigned 8-bit matrix, matrix B is a signed or unsigned 8-bit matrix, and
+// matrix C is a 32-bit integer matrix. All matrices are row major.
+//
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Routines to pack a constant matrix B once for reuse across multiple
+// quantized integer GEMM operations. The zero point of matrix B is folded into
+// the packed buffer.
+//
+
+size_t
+MLASCALL
+MlasQgemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasQgemmPacked(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const void* PackedB,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Routine to requantize the 32-bit output of a QGEMM operation to unsigned
+// 8-bit values using a fixed point multiplier and rounding right shift.
+//
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    uint8_t* Output,
+    const int32_t* Bias,
+    size_t M,
+    size_t N,
+    int32_t Multiplier,
+    int32_t Shift,
+    uint8_t ZeroPoint
+    );
+
 //
 // Convolution routines.
 //
@@ -235,6 +398,83 @@ MlasComputeErf(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeLog(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+//
+// Recurrent network cell routines.
+//
+
+void
+MLASCALL
+MlasComputeLstmCell(
+    const float* Gates,
+    const float* Bias,
+    float* CellState,
+    float* Output,
+    size_t N
+    );
+
+//
+// Normalization routines.
+//
+
+void
+MLASCALL
+MlasComputeMeanVariance(
+    const float* Input,
+    size_t N,
+    float* Mean,
+    float* Variance
+    );
+
+void
+MLASCALL
+MlasComputeScaleShift(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    float Shift
+    );
+
+//
+// Elementwise transcendental routines partitioned across a thread pool.
+//
+
+enum MLAS_TRANSCENDENTAL_KIND {
+    MlasExpFunction,
+    MlasLogFunction,
+    MlasLogisticFunction,
+    MlasTanhFunction,
+    MlasErfFunction,
+    MlasSqrtFunction,
+    MlasTranscendentalKindCount,
+};
+
+void
+MLASCALL
+MlasComputeTranscendental(
+    MLAS_TRANSCENDENTAL_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -0,0 +1,189 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    exp.cpp
+
+Abstract:
+
+    This module implements routines to compute the exponential function.
+
+    This implementation uses the same range reduction and polynomial
+    coefficients as the exponential step of the error function kernel. Our
+    usage requires building platform specific versions of the algorithm to
+    target different instruction sets. The implementation below targets the
+    base instruction set (typically SSE2) while intrinsic implementations
+    target newer instruction sets (such as FMA3 and AVX512F).
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+
+//
+// Bundles the floating point constants for use by kernels written in assembly
+// or built with instruction set specific intrinsics.
+//
+
+extern "C" const MLAS_EXP_CONSTANTS MlasExpConstants = {
+    -88.3762626647949f,
+    88.3762626647950f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.38319808e-3f,
+    8.37550033e-3f,
+    4.16689515e-2f,
+    1.66664466e-1f,
+    4.99999851e-1f,
+    1.00000000e+0f,
+    1.00000000e+0f,
+    1.25829120e+7f,
+    0.5f,
+};
+
+void
+MLASCALL
+MlasExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the exponential function.
+
+    The input is clamped to the range where the result is representable and
+    then split as x = r * ln(2) + f with |f| <= ln(2)/2. The result is then
+    exp(f) * 2^r, where the power of two is applied in two halves so that the
+    intermediate scale factors remain normalized at both ends of the range.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+
+        Value = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRange), Value);
+        Value = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.UpperRange), Value);
+
+        //
+        // Round the scaled input to the nearest integer using the rounding
+        // bias and reduce the input into the range [-ln(2)/2, ln(2)/2].
+        //
+
+        MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+        MLAS_FLOAT32X4 r = MlasMultiplyAddFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), Value, RoundingBias);
+        r = MlasSubtractFloat32x4(r, RoundingBias);
+
+        MLAS_FLOAT32X4 f = MlasMultiplyAddFloat32x4(r, MlasBroadcastFloat32x4(MlasExpConstants.log2_hi), Value);
+        f = MlasMultiplyAddFloat32x4(r, MlasBroadcastFloat32x4(MlasExpConstants.log2_lo), f);
+
+        MLAS_FLOAT32X4 y = MlasBroadcastFloat32x4(MlasExpConstants.P0);
+        y = MlasMultiplyAddFloat32x4(y, f, MlasBroadcastFloat32x4(MlasExpConstants.P1));
+        y = MlasMultiplyAddFloat32x4(y, f, MlasBroadcastFloat32x4(MlasExpConstants.P2));
+        y = MlasMultiplyAddFloat32x4(y, f, MlasBroadcastFloat32x4(MlasExpConstants.P3));
+        y = MlasMultiplyAddFloat32x4(y, f, MlasBroadcastFloat32x4(MlasExpConstants.P4));
+        y = MlasMultiplyAddFloat32x4(y, f, MlasBroadcastFloat32x4(MlasExpConstants.P5));
+        y = MlasMultiplyAddFloat32x4(y, f, MlasBroadcastFloat32x4(MlasExpConstants.P6));
+
+        //
+        // Scale by 2^r. The exponent can reach +/-128 at the ends of the input
+        // range, so split the scale into two factors that stay normalized.
+        //
+
+        MLAS_FLOAT32X4 r1 = MlasMultiplyAddFloat32x4(r, MlasBroadcastFloat32x4(MlasExpConstants.OneHalf), RoundingBias);
+        r1 = MlasSubtractFloat32x4(r1, RoundingBias);
+        MLAS_FLOAT32X4 r2 = MlasSubtractFloat32x4(r, r1);
+
+        MLAS_FLOAT32X4 Scale1 = MlasPowerOf2Float32x4(r1);
+        MLAS_FLOAT32X4 Scale2 = MlasPowerOf2Float32x4(r2);
+
+        y = MlasMultiplyFloat32x4(y, Scale1);
+        y = MlasMultiplyFloat32x4(y, Scale2);
+
+        MlasStoreFloat32x4(Output, y);
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        Value = (std::min)(MlasExpConstants.UpperRange, (std::max)(MlasExpConstants.LowerRange, Value));
+
+        float r = MlasExpConstants.Log2Reciprocal * Value + MlasExpConstants.RoundingBias;
+        r -= MlasExpConstants.RoundingBias;
+
+        float f = r * MlasExpConstants.log2_hi + Value;
+        f = r * MlasExpConstants.log2_lo + f;
+
+        float y = MlasExpConstants.P0;
+        y = y * f + MlasExpConstants.P1;
+        y = y * f + MlasExpConstants.P2;
+        y = y * f + MlasExpConstants.P3;
+        y = y * f + MlasExpConstants.P4;
+        y = y * f + MlasExpConstants.P5;
+        y = y * f + MlasExpConstants.P6;
+
+        *Output++ = ldexpf(y, int(r));
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ExpKernelRoutine(Input, Output, N);
+#else
+    MlasExpKernel(Input, Output, N);
+#endif
+}
@@ -0,0 +1,175 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfconvert.cpp
+
+Abstract:
+
+    This module implements the kernels to convert half precision and bfloat16
+    values to single precision values.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+float
+MlasBitsToFloat(
+    uint32_t Bits
+    )
+{
+    float Value;
+    memcpy(&Value, &Bits, sizeof(float));
+    return Value;
+}
+
+MLAS_FORCEINLINE
+uint32_t
+MlasFloatToBits(
+    float Value
+    )
+{
+    uint32_t Bits;
+    memcpy(&Bits, &Value, sizeof(float));
+    return Bits;
+}
+
+void
+MLASCALL
+MlasHalfToFloatKernel(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to convert a buffer of half
+    precision values to single precision values.
+
+Arguments:
+
+    Source - Supplies the input buffer.
+
+    Destination - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < N; n++) {
+
+        const uint32_t Half = Source[n].Value;
+        const uint32_t Sign = (Half & 0x8000) << 16;
+        const uint32_t ExponentMantissa = Half & 0x7FFF;
+
+        float Value;
+
+        if (ExponentMantissa >= 0x7C00) {
+
+            //
+            // Infinity or NaN: keep the mantissa bits for the NaN payload.
+            //
+
+            Value = MlasBitsToFloat(Sign | 0x7F800000 | ((ExponentMantissa & 0x3FF) << 13));
+
+        } else if (ExponentMantissa >= 0x0400) {
+
+            //
+            // Normal value: rebias the exponent from 15 to 127.
+            //
+
+            Value = MlasBitsToFloat(Sign | ((ExponentMantissa << 13) + 0x38000000));
+
+        } else {
+
+            //
+            // Zero or denormal value: the value is the mantissa scaled by
+            // 2^-24, which is exactly representable as a single precision
+            // value.
+            //
+
+            Value = float(ExponentMantissa) * MlasBitsToFloat(0x33800000);
+            Value = MlasBitsToFloat(Sign | MlasFloatToBits(Value));
+        }
+
+        Destination[n] = Value;
+    }
+}
+
+void
+MLASCALL
+MlasBFloat16ToFloatKernel(
+    const MLAS_BFLOAT16* Source,
+    float* Destination,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the kernel to convert a buffer of bfloat16 values
+    to single precision values.
+
+    A bfloat16 value is the upper half of a single precision value, so the
+    conversion only widens each value and clears the lower 16 bits.
+
+Arguments:
+
+    Source - Supplies the input buffer.
+
+    Destination - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i ZeroVector = _mm_setzero_si128();
+
+    while (N >= 8) {
+
+        __m128i Vector = _mm_loadu_si128((const __m128i*)Source);
+
+        _mm_storeu_si128((__m128i*)&Destination[0], _mm_unpacklo_epi16(ZeroVector, Vector));
+        _mm_storeu_si128((__m128i*)&Destination[4], _mm_unpackhi_epi16(ZeroVector, Vector));
+
+        Source += 8;
+        Destination += 8;
+        N -= 8;
+    }
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+    while (N >= 4) {
+
+        uint32x4_t Vector = vshll_n_u16(vld1_u16((const uint16_t*)Source), 16);
+
+        vst1q_f32(Destination, vreinterpretq_f32_u32(Vector));
+
+        Source += 4;
+        Destination += 4;
+        N -= 4;
+    }
+
+#endif
+
+    for (size_t n = 0; n < N; n++) {
+        Destination[n] = MlasBitsToFloat(uint32_t(Source[n].Value) << 16);
+    }
+}
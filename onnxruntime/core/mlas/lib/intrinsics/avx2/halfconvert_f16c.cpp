@@ -0,0 +1,87 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfconvert_f16c.cpp
+
+Abstract:
+
+    This module implements the kernel to convert half precision values to
+    single precision values using F16C intrinsics.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasHalfToFloatKernelF16C(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the F16C kernel to convert a buffer of half
+    precision values to single precision values.
+
+Arguments:
+
+    Source - Supplies the input buffer.
+
+    Destination - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 16) {
+
+        __m256 Vector0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&Source[0]));
+        __m256 Vector1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&Source[8]));
+
+        _mm256_storeu_ps(&Destination[0], Vector0);
+        _mm256_storeu_ps(&Destination[8], Vector1);
+
+        Source += 16;
+        Destination += 16;
+        N -= 16;
+    }
+
+    if (N >= 8) {
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)Source)));
+
+        Source += 8;
+        Destination += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+
+        _mm_storeu_ps(Destination, _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)Source)));
+
+        Source += 4;
+        Destination += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        _mm_store_ss(Destination, _mm_cvtph_ps(_mm_cvtsi32_si128(Source->Value)));
+
+        Source += 1;
+        Destination += 1;
+        N -= 1;
+    }
+}
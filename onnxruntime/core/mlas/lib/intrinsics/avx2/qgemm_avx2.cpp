@@ -0,0 +1,173 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel for the quantized integer matrix/matrix
+    multiply operation (QGEMM) using AVX2 intrinsics.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasQgemmKernelRowsAvx2(
+    const int32_t* A,
+    const int32_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    while (CountN > 0) {
+
+        __m256i Accumulators[RowCount][2];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][0] = _mm256_setzero_si256();
+            Accumulators[r][1] = _mm256_setzero_si256();
+        }
+
+        const int32_t* b = B;
+
+        for (size_t k = 0; k < PairCountK; k++) {
+
+            __m256i BElements0 = _mm256_loadu_si256((const __m256i*)&b[0]);
+            __m256i BElements1 = _mm256_loadu_si256((const __m256i*)&b[8]);
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                __m256i AElements = _mm256_set1_epi32(A[r * lda + k]);
+
+                Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0],
+                    _mm256_madd_epi16(AElements, BElements0));
+                Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1],
+                    _mm256_madd_epi16(AElements, BElements1));
+            }
+
+            b += MLAS_QGEMM_PACKED_PANEL_N;
+        }
+
+        if (CountN >= MLAS_QGEMM_PACKED_PANEL_N) {
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                int32_t* c = C + r * ldc;
+
+                if (!ZeroMode) {
+                    Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0],
+                        _mm256_loadu_si256((const __m256i*)&c[0]));
+                    Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1],
+                        _mm256_loadu_si256((const __m256i*)&c[8]));
+                }
+
+                _mm256_storeu_si256((__m256i*)&c[0], Accumulators[r][0]);
+                _mm256_storeu_si256((__m256i*)&c[8], Accumulators[r][1]);
+            }
+
+        } else {
+
+            //
+            // Store the partial panel through a local buffer.
+            //
+
+            MLAS_DECLSPEC_ALIGN(int32_t Output[MLAS_QGEMM_PACKED_PANEL_N], 32);
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                int32_t* c = C + r * ldc;
+
+                _mm256_store_si256((__m256i*)&Output[0], Accumulators[r][0]);
+                _mm256_store_si256((__m256i*)&Output[8], Accumulators[r][1]);
+
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] = ZeroMode ? Output[n] : c[n] + Output[n];
+                }
+            }
+
+            break;
+        }
+
+        B += ldb;
+        C += MLAS_QGEMM_PACKED_PANEL_N;
+        CountN -= MLAS_QGEMM_PACKED_PANEL_N;
+    }
+}
+
+size_t
+MLASCALL
+MlasQgemmKernelAvx2(
+    const int32_t* A,
+    const int32_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the AVX2 kernel for the QGEMM operation.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A.
+
+    B - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    PairCountK - Supplies the number of packed pairs along the K dimension.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    lda - Supplies the number of packed pairs per row of matrix A.
+
+    ldb - Supplies the number of packed elements between panels of matrix B.
+
+    ldc - Supplies the number of elements per row of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 4) {
+        MlasQgemmKernelRowsAvx2<4>(A, B, C, PairCountK, CountN, lda, ldb, ldc, ZeroMode);
+        return 4;
+    }
+
+    if (CountM >= 2) {
+        MlasQgemmKernelRowsAvx2<2>(A, B, C, PairCountK, CountN, lda, ldb, ldc, ZeroMode);
+        return 2;
+    }
+
+    MlasQgemmKernelRowsAvx2<1>(A, B, C, PairCountK, CountN, lda, ldb, ldc, ZeroMode);
+    return 1;
+}
@@ -0,0 +1,225 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transcendental_fma3.cpp
+
+Abstract:
+
+    This module implements kernels for the exponential and natural logarithm
+    functions using AVX2 and FMA3 intrinsics.
+
+    These kernels use the same algorithm and constants as the generic kernels
+    in exp.cpp and log.cpp.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Masks used to load and store the trailing elements of a buffer.
+//
+
+MLAS_DECLSPEC_ALIGN(static const int32_t MlasMaskMoveFma3[16], 32) = {
+    -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+MLAS_FORCEINLINE
+__m256i
+MlasLoadTrailingMaskFma3(
+    size_t N
+    )
+{
+    return _mm256_loadu_si256((const __m256i*)&MlasMaskMoveFma3[8 - N]);
+}
+
+MLAS_FORCEINLINE
+__m256
+MlasExpFma3(
+    __m256 Value
+    )
+{
+    Value = _mm256_max_ps(_mm256_set1_ps(MlasExpConstants.LowerRange), Value);
+    Value = _mm256_min_ps(_mm256_set1_ps(MlasExpConstants.UpperRange), Value);
+
+    const __m256 RoundingBias = _mm256_set1_ps(MlasExpConstants.RoundingBias);
+    __m256 r = _mm256_fmadd_ps(_mm256_set1_ps(MlasExpConstants.Log2Reciprocal), Value, RoundingBias);
+    r = _mm256_sub_ps(r, RoundingBias);
+
+    __m256 f = _mm256_fmadd_ps(r, _mm256_set1_ps(MlasExpConstants.log2_hi), Value);
+    f = _mm256_fmadd_ps(r, _mm256_set1_ps(MlasExpConstants.log2_lo), f);
+
+    __m256 y = _mm256_set1_ps(MlasExpConstants.P0);
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(MlasExpConstants.P1));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(MlasExpConstants.P2));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(MlasExpConstants.P3));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(MlasExpConstants.P4));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(MlasExpConstants.P5));
+    y = _mm256_fmadd_ps(y, f, _mm256_set1_ps(MlasExpConstants.P6));
+
+    //
+    // Scale by 2^r using two factors that stay normalized.
+    //
+
+    __m256 r1 = _mm256_fmadd_ps(r, _mm256_set1_ps(MlasExpConstants.OneHalf), RoundingBias);
+    r1 = _mm256_sub_ps(r1, RoundingBias);
+    __m256 r2 = _mm256_sub_ps(r, r1);
+
+    const __m256i ExponentBias = _mm256_set1_epi32(0x7F);
+    __m256 Scale1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(r1), ExponentBias), 23));
+    __m256 Scale2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(r2), ExponentBias), 23));
+
+    return _mm256_mul_ps(_mm256_mul_ps(y, Scale1), Scale2);
+}
+
+void
+MLASCALL
+MlasExpKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the AVX2/FMA3 kernel for the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 8) {
+
+        _mm256_storeu_ps(Output, MlasExpFma3(_mm256_loadu_ps(Input)));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N > 0) {
+
+        __m256i Mask = MlasLoadTrailingMaskFma3(N);
+
+        _mm256_maskstore_ps(Output, Mask, MlasExpFma3(_mm256_maskload_ps(Input, Mask)));
+    }
+}
+
+MLAS_FORCEINLINE
+__m256
+MlasLogFma3(
+    __m256 Input
+    )
+{
+    __m256 Value = _mm256_max_ps(Input, _mm256_set1_ps(MlasLogConstants.MinimumNormal));
+
+    //
+    // Extract the exponent and normalize the mantissa into [0.5, 1).
+    //
+
+    __m256i Bits = _mm256_castps_si256(Value);
+    __m256 e = _mm256_cvtepi32_ps(_mm256_srli_epi32(Bits, 23));
+    e = _mm256_sub_ps(e, _mm256_set1_ps(MlasLogConstants.ExponentBias));
+
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(
+        _mm256_and_si256(Bits, _mm256_set1_epi32(MlasLogConstants.MantissaMask)),
+        _mm256_set1_epi32(MlasLogConstants.HalfExponent)));
+
+    const __m256 One = _mm256_set1_ps(MlasLogConstants.One);
+    __m256 SmallMask = _mm256_cmp_ps(m, _mm256_set1_ps(MlasLogConstants.SqrtHalf), _CMP_LT_OQ);
+    e = _mm256_sub_ps(e, _mm256_and_ps(SmallMask, One));
+    m = _mm256_add_ps(_mm256_sub_ps(m, One), _mm256_and_ps(SmallMask, m));
+
+    __m256 z = _mm256_mul_ps(m, m);
+
+    __m256 y = _mm256_set1_ps(MlasLogConstants.P0);
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(MlasLogConstants.P1));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(MlasLogConstants.P2));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(MlasLogConstants.P3));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(MlasLogConstants.P4));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(MlasLogConstants.P5));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(MlasLogConstants.P6));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(MlasLogConstants.P7));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(MlasLogConstants.P8));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, m), z);
+
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(MlasLogConstants.q1), y);
+    y = _mm256_fnmadd_ps(z, _mm256_set1_ps(MlasLogConstants.OneHalf), y);
+    y = _mm256_add_ps(m, y);
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(MlasLogConstants.q2), y);
+
+    //
+    // Fix up the special input values.
+    //
+
+    const __m256 Zero = _mm256_setzero_ps();
+    __m256 ZeroMask = _mm256_cmp_ps(Input, Zero, _CMP_EQ_OQ);
+    __m256 InvalidMask = _mm256_cmp_ps(Input, Zero, _CMP_NGE_UQ);
+    __m256 InfinityMask = _mm256_cmp_ps(Input, _mm256_set1_ps(std::numeric_limits<float>::infinity()), _CMP_EQ_OQ);
+
+    y = _mm256_blendv_ps(y, _mm256_set1_ps(-std::numeric_limits<float>::infinity()), ZeroMask);
+    y = _mm256_or_ps(y, InvalidMask);
+    y = _mm256_blendv_ps(y, Input, InfinityMask);
+
+    return y;
+}
+
+void
+MLASCALL
+MlasLogKernelFma3(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the AVX2/FMA3 kernel for the natural logarithm
+    function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 8) {
+
+        _mm256_storeu_ps(Output, MlasLogFma3(_mm256_loadu_ps(Input)));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N > 0) {
+
+        __m256i Mask = MlasLoadTrailingMaskFma3(N);
+
+        _mm256_maskstore_ps(Output, Mask, MlasLogFma3(_mm256_maskload_ps(Input, Mask)));
+    }
+}
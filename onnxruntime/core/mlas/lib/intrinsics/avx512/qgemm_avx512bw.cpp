@@ -0,0 +1,189 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_avx512bw.cpp
+
+Abstract:
+
+    This module implements the kernel for the quantized integer matrix/matrix
+    multiply operation (QGEMM) using AVX512BW intrinsics.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasQgemmKernelPanelsAvx512BW(
+    const int32_t* A,
+    const int32_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    __m512i Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            Accumulators[r][p] = _mm512_setzero_si512();
+        }
+    }
+
+    for (size_t k = 0; k < PairCountK; k++) {
+
+        __m512i BElements[PanelCount];
+
+        for (size_t p = 0; p < PanelCount; p++) {
+            BElements[p] = _mm512_loadu_si512(&B[p * ldb + k * MLAS_QGEMM_PACKED_PANEL_N]);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            __m512i AElements = _mm512_set1_epi32(A[r * lda + k]);
+
+            for (size_t p = 0; p < PanelCount; p++) {
+                Accumulators[r][p] = _mm512_add_epi32(Accumulators[r][p],
+                    _mm512_madd_epi16(AElements, BElements[p]));
+            }
+        }
+    }
+
+    for (size_t p = 0; p < PanelCount; p++) {
+
+        size_t CountNPanel = CountN - p * MLAS_QGEMM_PACKED_PANEL_N;
+        __mmask16 Mask = (CountNPanel >= MLAS_QGEMM_PACKED_PANEL_N) ?
+            __mmask16(0xFFFF) : __mmask16((1u << CountNPanel) - 1);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t* c = C + r * ldc + p * MLAS_QGEMM_PACKED_PANEL_N;
+
+            if (!ZeroMode) {
+                Accumulators[r][p] = _mm512_add_epi32(Accumulators[r][p],
+                    _mm512_maskz_loadu_epi32(Mask, c));
+            }
+
+            _mm512_mask_storeu_epi32(c, Mask, Accumulators[r][p]);
+        }
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasQgemmKernelRowsAvx512BW(
+    const int32_t* A,
+    const int32_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    //
+    // Process two panels at a time to amortize the broadcasts of matrix A.
+    //
+
+    while (CountN > MLAS_QGEMM_PACKED_PANEL_N) {
+
+        MlasQgemmKernelPanelsAvx512BW<RowCount, 2>(A, B, C, PairCountK, CountN,
+            lda, ldb, ldc, ZeroMode);
+
+        if (CountN <= 2 * MLAS_QGEMM_PACKED_PANEL_N) {
+            return;
+        }
+
+        B += 2 * ldb;
+        C += 2 * MLAS_QGEMM_PACKED_PANEL_N;
+        CountN -= 2 * MLAS_QGEMM_PACKED_PANEL_N;
+    }
+
+    if (CountN > 0) {
+        MlasQgemmKernelPanelsAvx512BW<RowCount, 1>(A, B, C, PairCountK, CountN,
+            lda, ldb, ldc, ZeroMode);
+    }
+}
+
+size_t
+MLASCALL
+MlasQgemmKernelAvx512BW(
+    const int32_t* A,
+    const int32_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the AVX512BW kernel for the QGEMM operation.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A.
+
+    B - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    PairCountK - Supplies the number of packed pairs along the K dimension.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    lda - Supplies the number of packed pairs per row of matrix A.
+
+    ldb - Supplies the number of packed elements between panels of matrix B.
+
+    ldc - Supplies the number of elements per row of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 6) {
+        MlasQgemmKernelRowsAvx512BW<6>(A, B, C, PairCountK, CountN, lda, ldb, ldc, ZeroMode);
+        return 6;
+    }
+
+    if (CountM >= 4) {
+        MlasQgemmKernelRowsAvx512BW<4>(A, B, C, PairCountK, CountN, lda, ldb, ldc, ZeroMode);
+        return 4;
+    }
+
+    if (CountM >= 2) {
+        MlasQgemmKernelRowsAvx512BW<2>(A, B, C, PairCountK, CountN, lda, ldb, ldc, ZeroMode);
+        return 2;
+    }
+
+    MlasQgemmKernelRowsAvx512BW<1>(A, B, C, PairCountK, CountN, lda, ldb, ldc, ZeroMode);
+    return 1;
+}
@@ -0,0 +1,223 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_avx512vnni.cpp
+
+Abstract:
+
+    This module implements the kernel for the quantized integer matrix/matrix
+    multiply operation (QGEMM) using AVX512VNNI intrinsics.
+
+    The kernel multiplies unsigned 8-bit elements of matrix A by signed 8-bit
+    elements of matrix B with VPDPBUSD, which accumulates groups of four
+    products directly to 32-bit values without intermediate saturation.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasQgemmU8S8KernelPanelsAvx512Vnni(
+    const uint8_t* A,
+    const int8_t* B,
+    int32_t* C,
+    size_t QuadCountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    )
+{
+    __m512i Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            Accumulators[r][p] = _mm512_setzero_si512();
+        }
+    }
+
+    const int32_t* a = (const int32_t*)A;
+
+    for (size_t k = 0; k < QuadCountK; k++) {
+
+        __m512i BElements[PanelCount];
+
+        for (size_t p = 0; p < PanelCount; p++) {
+            BElements[p] = _mm512_loadu_si512(&B[p * ldb + k * 4 * MLAS_QGEMM_PACKED_PANEL_N]);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            __m512i AElements = _mm512_set1_epi32(a[r * (lda / 4) + k]);
+
+            for (size_t p = 0; p < PanelCount; p++) {
+                Accumulators[r][p] = _mm512_dpbusd_epi32(Accumulators[r][p],
+                    AElements, BElements[p]);
+            }
+        }
+    }
+
+    //
+    // Apply the zero point adjustments and store the output.
+    //
+
+    for (size_t p = 0; p < PanelCount; p++) {
+
+        size_t CountNPanel = CountN - p * MLAS_QGEMM_PACKED_PANEL_N;
+        __mmask16 Mask = (CountNPanel >= MLAS_QGEMM_PACKED_PANEL_N) ?
+            __mmask16(0xFFFF) : __mmask16((1u << CountNPanel) - 1);
+
+        __m512i ColumnSums = _mm512_maskz_loadu_epi32(Mask,
+            &ColumnSumBuffer[p * MLAS_QGEMM_PACKED_PANEL_N]);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t* c = C + r * ldc + p * MLAS_QGEMM_PACKED_PANEL_N;
+
+            __m512i Sums = _mm512_add_epi32(ColumnSums, _mm512_set1_epi32(RowSumBuffer[r]));
+
+            Accumulators[r][p] = _mm512_add_epi32(Accumulators[r][p], Sums);
+
+            if (!ZeroMode) {
+                Accumulators[r][p] = _mm512_add_epi32(Accumulators[r][p],
+                    _mm512_maskz_loadu_epi32(Mask, c));
+            }
+
+            _mm512_mask_storeu_epi32(c, Mask, Accumulators[r][p]);
+        }
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasQgemmU8S8KernelRowsAvx512Vnni(
+    const uint8_t* A,
+    const int8_t* B,
+    int32_t* C,
+    size_t QuadCountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    )
+{
+    //
+    // Process two panels at a time to amortize the broadcasts of matrix A.
+    //
+
+    while (CountN > MLAS_QGEMM_PACKED_PANEL_N) {
+
+        MlasQgemmU8S8KernelPanelsAvx512Vnni<RowCount, 2>(A, B, C, QuadCountK,
+            CountN, lda, ldb, ldc, RowSumBuffer, ColumnSumBuffer, ZeroMode);
+
+        if (CountN <= 2 * MLAS_QGEMM_PACKED_PANEL_N) {
+            return;
+        }
+
+        B += 2 * ldb;
+        C += 2 * MLAS_QGEMM_PACKED_PANEL_N;
+        ColumnSumBuffer += 2 * MLAS_QGEMM_PACKED_PANEL_N;
+        CountN -= 2 * MLAS_QGEMM_PACKED_PANEL_N;
+    }
+
+    if (CountN > 0) {
+        MlasQgemmU8S8KernelPanelsAvx512Vnni<RowCount, 1>(A, B, C, QuadCountK,
+            CountN, lda, ldb, ldc, RowSumBuffer, ColumnSumBuffer, ZeroMode);
+    }
+}
+
+size_t
+MLASCALL
+MlasQgemmU8S8KernelAvx512Vnni(
+    const uint8_t* A,
+    const int8_t* B,
+    int32_t* C,
+    size_t QuadCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the AVX512VNNI kernel for the QGEMM operation with an
+    unsigned matrix A and a signed matrix B.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A.
+
+    B - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    QuadCountK - Supplies the number of packed groups of four elements along
+        the K dimension.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    lda - Supplies the number of packed elements per row of matrix A.
+
+    ldb - Supplies the number of packed elements between panels of matrix B.
+
+    ldc - Supplies the number of elements per row of matrix C.
+
+    RowSumBuffer - Supplies the per row adjustments to add to matrix C.
+
+    ColumnSumBuffer - Supplies the per column adjustments to add to matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 6) {
+        MlasQgemmU8S8KernelRowsAvx512Vnni<6>(A, B, C, QuadCountK, CountN, lda, ldb,
+            ldc, RowSumBuffer, ColumnSumBuffer, ZeroMode);
+        return 6;
+    }
+
+    if (CountM >= 4) {
+        MlasQgemmU8S8KernelRowsAvx512Vnni<4>(A, B, C, QuadCountK, CountN, lda, ldb,
+            ldc, RowSumBuffer, ColumnSumBuffer, ZeroMode);
+        return 4;
+    }
+
+    if (CountM >= 2) {
+        MlasQgemmU8S8KernelRowsAvx512Vnni<2>(A, B, C, QuadCountK, CountN, lda, ldb,
+            ldc, RowSumBuffer, ColumnSumBuffer, ZeroMode);
+        return 2;
+    }
+
+    MlasQgemmU8S8KernelRowsAvx512Vnni<1>(A, B, C, QuadCountK, CountN, lda, ldb,
+        ldc, RowSumBuffer, ColumnSumBuffer, ZeroMode);
+    return 1;
+}
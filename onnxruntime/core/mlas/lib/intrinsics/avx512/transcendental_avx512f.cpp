@@ -0,0 +1,206 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transcendental_avx512f.cpp
+
+Abstract:
+
+    This module implements kernels for the exponential and natural logarithm
+    functions using AVX512F intrinsics.
+
+    These kernels use the same polynomial coefficients as the generic kernels
+    in exp.cpp and log.cpp. The AVX512F scale and exponent extraction
+    instructions replace the integer bit manipulation of the other kernels.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// The GCC headers implement the unmasked forms of several AVX512F intrinsics
+// as merge masking into _mm512_undefined_ps(), which GCC 12 then reports as a
+// possibly uninitialized use. These kernels use the zero masking forms with
+// all lanes enabled instead, which generate the same instructions.
+//
+
+constexpr __mmask16 MlasAvx512FAllLanes = 0xFFFF;
+
+MLAS_FORCEINLINE
+__m512
+MlasExpAvx512F(
+    __m512 Value
+    )
+{
+    Value = _mm512_maskz_max_ps(MlasAvx512FAllLanes, _mm512_set1_ps(MlasExpConstants.LowerRange), Value);
+    Value = _mm512_maskz_min_ps(MlasAvx512FAllLanes, _mm512_set1_ps(MlasExpConstants.UpperRange), Value);
+
+    __m512 r = _mm512_maskz_roundscale_ps(MlasAvx512FAllLanes,
+        _mm512_mul_ps(_mm512_set1_ps(MlasExpConstants.Log2Reciprocal), Value),
+        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+    __m512 f = _mm512_fmadd_ps(r, _mm512_set1_ps(MlasExpConstants.log2_hi), Value);
+    f = _mm512_fmadd_ps(r, _mm512_set1_ps(MlasExpConstants.log2_lo), f);
+
+    __m512 y = _mm512_set1_ps(MlasExpConstants.P0);
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(MlasExpConstants.P1));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(MlasExpConstants.P2));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(MlasExpConstants.P3));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(MlasExpConstants.P4));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(MlasExpConstants.P5));
+    y = _mm512_fmadd_ps(y, f, _mm512_set1_ps(MlasExpConstants.P6));
+
+    //
+    // VSCALEFPS handles the full exponent range including denormal results.
+    //
+
+    return _mm512_maskz_scalef_ps(MlasAvx512FAllLanes, y, r);
+}
+
+void
+MLASCALL
+MlasExpKernelAvx512F(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the AVX512F kernel for the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 16) {
+
+        _mm512_storeu_ps(Output, MlasExpAvx512F(_mm512_loadu_ps(Input)));
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+    if (N > 0) {
+
+        __mmask16 Mask = __mmask16((1u << N) - 1);
+
+        _mm512_mask_storeu_ps(Output, Mask, MlasExpAvx512F(_mm512_maskz_loadu_ps(Mask, Input)));
+    }
+}
+
+MLAS_FORCEINLINE
+__m512
+MlasLogAvx512F(
+    __m512 Input
+    )
+{
+    __m512 Value = _mm512_maskz_max_ps(MlasAvx512FAllLanes, Input, _mm512_set1_ps(MlasLogConstants.MinimumNormal));
+
+    //
+    // Extract the exponent and normalize the mantissa into [0.5, 1). VGETEXPPS
+    // returns floor(log2(x)), which is one less than the frexp exponent.
+    //
+
+    const __m512 One = _mm512_set1_ps(MlasLogConstants.One);
+    __m512 e = _mm512_add_ps(_mm512_maskz_getexp_ps(MlasAvx512FAllLanes, Value), One);
+    __m512 m = _mm512_maskz_getmant_ps(MlasAvx512FAllLanes, Value, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_zero);
+
+    __mmask16 SmallMask = _mm512_cmp_ps_mask(m, _mm512_set1_ps(MlasLogConstants.SqrtHalf), _CMP_LT_OQ);
+    e = _mm512_mask_sub_ps(e, SmallMask, e, One);
+    m = _mm512_mask_add_ps(_mm512_sub_ps(m, One), SmallMask, _mm512_sub_ps(m, One), m);
+
+    __m512 z = _mm512_mul_ps(m, m);
+
+    __m512 y = _mm512_set1_ps(MlasLogConstants.P0);
+    y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(MlasLogConstants.P1));
+    y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(MlasLogConstants.P2));
+    y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(MlasLogConstants.P3));
+    y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(MlasLogConstants.P4));
+    y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(MlasLogConstants.P5));
+    y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(MlasLogConstants.P6));
+    y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(MlasLogConstants.P7));
+    y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(MlasLogConstants.P8));
+    y = _mm512_mul_ps(_mm512_mul_ps(y, m), z);
+
+    y = _mm512_fmadd_ps(e, _mm512_set1_ps(MlasLogConstants.q1), y);
+    y = _mm512_fnmadd_ps(z, _mm512_set1_ps(MlasLogConstants.OneHalf), y);
+    y = _mm512_add_ps(m, y);
+    y = _mm512_fmadd_ps(e, _mm512_set1_ps(MlasLogConstants.q2), y);
+
+    //
+    // Fix up the special input values.
+    //
+
+    const __m512 Zero = _mm512_setzero_ps();
+    __mmask16 ZeroMask = _mm512_cmp_ps_mask(Input, Zero, _CMP_EQ_OQ);
+    __mmask16 InvalidMask = _mm512_cmp_ps_mask(Input, Zero, _CMP_NGE_UQ);
+    __mmask16 InfinityMask = _mm512_cmp_ps_mask(Input, _mm512_set1_ps(std::numeric_limits<float>::infinity()), _CMP_EQ_OQ);
+
+    y = _mm512_mask_mov_ps(y, ZeroMask, _mm512_set1_ps(-std::numeric_limits<float>::infinity()));
+    y = _mm512_mask_mov_ps(y, InvalidMask, _mm512_set1_ps(std::numeric_limits<float>::quiet_NaN()));
+    y = _mm512_mask_mov_ps(y, InfinityMask, Input);
+
+    return y;
+}
+
+void
+MLASCALL
+MlasLogKernelAvx512F(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the AVX512F kernel for the natural logarithm
+    function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 16) {
+
+        _mm512_storeu_ps(Output, MlasLogAvx512F(_mm512_loadu_ps(Input)));
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+    if (N > 0) {
+
+        __mmask16 Mask = __mmask16((1u << N) - 1);
+
+        _mm512_mask_storeu_ps(Output, Mask, MlasLogAvx512F(_mm512_maskz_loadu_ps(Mask, Input)));
+    }
+}
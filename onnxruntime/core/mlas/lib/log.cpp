@@ -0,0 +1,196 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    log.cpp
+
+Abstract:
+
+    This module implements routines to compute the natural logarithm function.
+
+    This implementation uses the same polynomial coefficients and algorithm as
+    found in Cephes (and Eigen). Our usage requires building platform specific
+    versions of the algorithm to target different instruction sets. The
+    implementation below targets the base instruction set (typically SSE2)
+    while intrinsic implementations target newer instruction sets (such as
+    FMA3 and AVX512F).
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+
+//
+// Bundles the floating point constants for use by kernels written in assembly
+// or built with instruction set specific intrinsics.
+//
+
+extern "C" const MLAS_LOG_CONSTANTS MlasLogConstants = {
+    1.17549435e-38f,
+    0.707106781186547524f,
+    7.0376836292e-2f,
+    -1.1514610310e-1f,
+    1.1676998740e-1f,
+    -1.2420140846e-1f,
+    1.4249322787e-1f,
+    -1.6668057665e-1f,
+    2.0000714765e-1f,
+    -2.4999993993e-1f,
+    3.3333331174e-1f,
+    -2.12194440e-4f,
+    0.693359375f,
+    0.5f,
+    1.0f,
+    126.0f,
+    0x007FFFFF,
+    0x3F000000,
+};
+
+void
+MLASCALL
+MlasLogKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the natural logarithm
+    function.
+
+    The input is split as x = m * 2^e with m in [sqrt(0.5), sqrt(2)) and the
+    logarithm of the mantissa is approximated by a polynomial. Zero inputs
+    produce negative infinity, negative and NaN inputs produce NaN, and
+    positive infinity is passed through.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Input4 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 Zero = MlasZeroFloat32x4();
+
+        MLAS_FLOAT32X4 Value = MlasMaximumFloat32x4(Input4, MlasBroadcastFloat32x4(MlasLogConstants.MinimumNormal));
+
+        //
+        // Extract the exponent and normalize the mantissa into [0.5, 1).
+        //
+
+        MLAS_INT32X4 Bits = MlasReinterpretAsInt32x4(Value);
+        MLAS_FLOAT32X4 e = MlasCastToFloat32x4(MlasShiftRightLogicalInt32x4<23>(Bits));
+        e = MlasSubtractFloat32x4(e, MlasBroadcastFloat32x4(MlasLogConstants.ExponentBias));
+
+        MLAS_FLOAT32X4 m = MlasReinterpretAsFloat32x4(MlasOrInt32x4(
+            MlasAndInt32x4(Bits, MlasBroadcastInt32x4(MlasLogConstants.MantissaMask)),
+            MlasBroadcastInt32x4(MlasLogConstants.HalfExponent)));
+
+        //
+        // Shift the mantissa into [sqrt(0.5), sqrt(2)) and adjust the exponent:
+        //   if (m < SqrtHalf) { e -= 1; m = m + m - 1; } else { m = m - 1; }
+        //
+
+        MLAS_FLOAT32X4 One = MlasBroadcastFloat32x4(MlasLogConstants.One);
+        MLAS_FLOAT32X4 SmallMask = MlasGreaterThanFloat32x4(MlasBroadcastFloat32x4(MlasLogConstants.SqrtHalf), m);
+        e = MlasSubtractFloat32x4(e, MlasAndFloat32x4(SmallMask, One));
+        m = MlasAddFloat32x4(MlasSubtractFloat32x4(m, One), MlasAndFloat32x4(SmallMask, m));
+
+        MLAS_FLOAT32X4 z = MlasMultiplyFloat32x4(m, m);
+
+        MLAS_FLOAT32X4 y = MlasBroadcastFloat32x4(MlasLogConstants.P0);
+        y = MlasMultiplyAddFloat32x4(y, m, MlasBroadcastFloat32x4(MlasLogConstants.P1));
+        y = MlasMultiplyAddFloat32x4(y, m, MlasBroadcastFloat32x4(MlasLogConstants.P2));
+        y = MlasMultiplyAddFloat32x4(y, m, MlasBroadcastFloat32x4(MlasLogConstants.P3));
+        y = MlasMultiplyAddFloat32x4(y, m, MlasBroadcastFloat32x4(MlasLogConstants.P4));
+        y = MlasMultiplyAddFloat32x4(y, m, MlasBroadcastFloat32x4(MlasLogConstants.P5));
+        y = MlasMultiplyAddFloat32x4(y, m, MlasBroadcastFloat32x4(MlasLogConstants.P6));
+        y = MlasMultiplyAddFloat32x4(y, m, MlasBroadcastFloat32x4(MlasLogConstants.P7));
+        y = MlasMultiplyAddFloat32x4(y, m, MlasBroadcastFloat32x4(MlasLogConstants.P8));
+        y = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(y, m), z);
+
+        y = MlasMultiplyAddFloat32x4(e, MlasBroadcastFloat32x4(MlasLogConstants.q1), y);
+        y = MlasSubtractFloat32x4(y, MlasMultiplyFloat32x4(z, MlasBroadcastFloat32x4(MlasLogConstants.OneHalf)));
+        y = MlasAddFloat32x4(m, y);
+        y = MlasMultiplyAddFloat32x4(e, MlasBroadcastFloat32x4(MlasLogConstants.q2), y);
+
+        //
+        // Fix up the special input values.
+        //
+
+        MLAS_FLOAT32X4 ZeroMask = MlasAndNotFloat32x4(MlasGreaterThanFloat32x4(Input4, Zero),
+            MlasGreaterThanOrEqualFloat32x4(Input4, Zero));
+        MLAS_FLOAT32X4 InvalidMask = MlasXorFloat32x4(MlasGreaterThanOrEqualFloat32x4(Input4, Zero),
+            MlasReinterpretAsFloat32x4(MlasBroadcastInt32x4(-1)));
+        MLAS_FLOAT32X4 InfinityMask = MlasGreaterThanFloat32x4(Input4,
+            MlasBroadcastFloat32x4(std::numeric_limits<float>::max()));
+
+        y = MlasBlendFloat32x4(y, MlasBroadcastFloat32x4(-std::numeric_limits<float>::infinity()), ZeroMask);
+        y = MlasOrFloat32x4(y, InvalidMask);
+        y = MlasBlendFloat32x4(y, Input4, InfinityMask);
+
+        MlasStoreFloat32x4(Output, y);
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = logf(*Input++);
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeLog(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the natural logarithm function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.LogKernelRoutine(Input, Output, N);
+#else
+    MlasLogKernel(Input, Output, N);
+#endif
+}
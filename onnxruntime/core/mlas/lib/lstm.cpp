@@ -0,0 +1,141 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    lstm.cpp
+
+Abstract:
+
+    This module implements the elementwise portion of a long short term
+    memory (LSTM) cell for one batch row and one timestep.
+
+    The gate pre-activations produced by the input and recurrent matrix
+    multiplies are biased, activated and merged into the cell state in small
+    blocks that stay resident in the L1 cache, instead of making a separate
+    pass over the gate buffer for every step of the cell update.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of hidden units processed per block. The four gate blocks and the
+// temporary cell values fit in 4KB of stack.
+//
+
+#define MLAS_LSTM_CELL_BLOCK_SIZE 256
+
+void
+MLASCALL
+MlasComputeLstmCell(
+    const float* Gates,
+    const float* Bias,
+    float* CellState,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes one step of an LSTM cell using the default sigmoid
+    and tanh activation functions:
+
+        i = sigmoid(Gi + Bi)
+        o = sigmoid(Go + Bo)
+        f = sigmoid(Gf + Bf)
+        c = tanh(Gc + Bc)
+        CellState = f * CellState + i * c
+        Output = o * tanh(CellState)
+
+Arguments:
+
+    Gates - Supplies the gate pre-activations, stored as four consecutive
+        vectors of N elements in input, output, forget and cell order.
+
+    Bias - Supplies the optional bias with the same layout as Gates, else
+        nullptr.
+
+    CellState - Supplies the previous cell state on input and receives the
+        updated cell state on output.
+
+    Output - Supplies the output buffer for the hidden state.
+
+    N - Supplies the number of hidden units.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    PMLAS_LOGISTIC_KERNEL_ROUTINE LogisticKernelRoutine = MlasPlatform.LogisticKernelRoutine;
+    PMLAS_TANH_KERNEL_ROUTINE TanhKernelRoutine = MlasPlatform.TanhKernelRoutine;
+#else
+    PMLAS_LOGISTIC_KERNEL_ROUTINE LogisticKernelRoutine = MlasLogisticKernel;
+    PMLAS_TANH_KERNEL_ROUTINE TanhKernelRoutine = MlasTanhKernel;
+#endif
+
+    MLAS_DECLSPEC_ALIGN(float Buffer[4 * MLAS_LSTM_CELL_BLOCK_SIZE], 64);
+
+    for (size_t n = 0; n < N; n += MLAS_LSTM_CELL_BLOCK_SIZE) {
+
+        const size_t CountN = (std::min)(N - n, size_t(MLAS_LSTM_CELL_BLOCK_SIZE));
+
+        //
+        // Gather the biased input, output and forget gates into one block so
+        // that a single call to the logistic kernel activates all three.
+        //
+
+        float* GateI = Buffer;
+        float* GateO = GateI + CountN;
+        float* GateF = GateO + CountN;
+        float* GateC = GateF + CountN;
+
+        for (size_t gate = 0; gate < 4; gate++) {
+
+            const float* Source = Gates + gate * N + n;
+            float* Destination = Buffer + gate * CountN;
+
+            if (Bias != nullptr) {
+
+                const float* GateBias = Bias + gate * N + n;
+
+                for (size_t i = 0; i < CountN; i++) {
+                    Destination[i] = Source[i] + GateBias[i];
+                }
+
+            } else {
+
+                std::copy_n(Source, CountN, Destination);
+            }
+        }
+
+        LogisticKernelRoutine(GateI, GateI, 3 * CountN);
+        TanhKernelRoutine(GateC, GateC, CountN);
+
+        //
+        // Update the cell state and reuse the cell gate block for the
+        // activated cell state.
+        //
+
+        float* Cell = CellState + n;
+
+        for (size_t i = 0; i < CountN; i++) {
+            Cell[i] = GateF[i] * Cell[i] + GateI[i] * GateC[i];
+        }
+
+        TanhKernelRoutine(Cell, GateC, CountN);
+
+        float* Hidden = Output + n;
+
+        for (size_t i = 0; i < CountN; i++) {
+            Hidden[i] = GateO[i] * GateC[i];
+        }
+    }
+}
@@ -21,6 +21,7 @@ Abstract:
 #include <mlas.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
 #if defined(_WIN32)
@@ -120,6 +121,32 @@ Abstract:
 
 #define MLAS_SGEMM_STRIDEN_THREAD_ALIGN             16
 
+//
+// Define the target number of elements per thread for the elementwise
+// transcendental routines and the alignment used to segment the buffers.
+//
+
+#define MLAS_TRANSCENDENTAL_THREAD_ELEMENTS         (16 * 1024)
+#define MLAS_TRANSCENDENTAL_THREAD_ALIGN            16
+
+//
+// Define the default strides to step through slices of the input matrices for
+// the quantized integer GEMM operation. The K stride is in units of elements
+// and must be a multiple of four.
+//
+
+#define MLAS_QGEMM_STRIDEM                          64
+#define MLAS_QGEMM_STRIDEN                          128
+#define MLAS_QGEMM_STRIDEK                          256
+
+//
+// Define the number of columns in a packed panel of matrix B for the
+// quantized integer GEMM operation. This is also the alignment used to
+// segment the operation across multiple threads.
+//
+
+#define MLAS_QGEMM_PACKED_PANEL_N                   16
+
 //
 // Define the prototypes of the platform optimized routines.
 //
@@ -283,6 +310,131 @@ void
 
 typedef MLAS_ERF_KERNEL_ROUTINE* PMLAS_ERF_KERNEL_ROUTINE;
 
+typedef
+void
+(MLASCALL MLAS_EXP_KERNEL_ROUTINE)(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+typedef MLAS_EXP_KERNEL_ROUTINE* PMLAS_EXP_KERNEL_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_LOG_KERNEL_ROUTINE)(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+typedef MLAS_LOG_KERNEL_ROUTINE* PMLAS_LOG_KERNEL_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_SQRT_KERNEL_ROUTINE)(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+typedef
+size_t
+(MLASCALL MLAS_QGEMM_KERNEL_ROUTINE)(
+    const int32_t* A,
+    const int32_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    bool ZeroMode
+    );
+
+typedef MLAS_QGEMM_KERNEL_ROUTINE* PMLAS_QGEMM_KERNEL_ROUTINE;
+
+typedef
+size_t
+(MLASCALL MLAS_QGEMM_U8S8_KERNEL_ROUTINE)(
+    const uint8_t* A,
+    const int8_t* B,
+    int32_t* C,
+    size_t QuadCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    bool ZeroMode
+    );
+
+typedef MLAS_QGEMM_U8S8_KERNEL_ROUTINE* PMLAS_QGEMM_U8S8_KERNEL_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_HALF_TO_FLOAT_KERNEL_ROUTINE)(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t N
+    );
+
+typedef MLAS_HALF_TO_FLOAT_KERNEL_ROUTINE* PMLAS_HALF_TO_FLOAT_KERNEL_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_BFLOAT16_TO_FLOAT_KERNEL_ROUTINE)(
+    const MLAS_BFLOAT16* Source,
+    float* Destination,
+    size_t N
+    );
+
+//
+// Define the constants shared by the exponential and logarithm kernels built
+// for the various instruction sets.
+//
+
+struct MLAS_EXP_CONSTANTS {
+    float LowerRange;
+    float UpperRange;
+    float Log2Reciprocal;
+    float log2_hi;
+    float log2_lo;
+    float P0;
+    float P1;
+    float P2;
+    float P3;
+    float P4;
+    float P5;
+    float P6;
+    float RoundingBias;
+    float OneHalf;
+};
+
+struct MLAS_LOG_CONSTANTS {
+    float MinimumNormal;
+    float SqrtHalf;
+    float P0;
+    float P1;
+    float P2;
+    float P3;
+    float P4;
+    float P5;
+    float P6;
+    float P7;
+    float P8;
+    float q1;
+    float q2;
+    float OneHalf;
+    float One;
+    float ExponentBias;
+    int32_t MantissaMask;
+    int32_t HalfExponent;
+};
+
 extern "C" {
 
 #if defined(MLAS_TARGET_AMD64_IX86)
@@ -350,10 +502,26 @@ extern "C" {
     MLAS_TANH_KERNEL_ROUTINE MlasLogisticKernel;
     MLAS_TANH_KERNEL_ROUTINE MlasTanhKernel;
     MLAS_ERF_KERNEL_ROUTINE MlasErfKernel;
+    MLAS_EXP_KERNEL_ROUTINE MlasExpKernel;
+    MLAS_LOG_KERNEL_ROUTINE MlasLogKernel;
+    MLAS_SQRT_KERNEL_ROUTINE MlasSqrtKernel;
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernel;
+    MLAS_HALF_TO_FLOAT_KERNEL_ROUTINE MlasHalfToFloatKernel;
+    MLAS_BFLOAT16_TO_FLOAT_KERNEL_ROUTINE MlasBFloat16ToFloatKernel;
+    extern const MLAS_EXP_CONSTANTS MlasExpConstants;
+    extern const MLAS_LOG_CONSTANTS MlasLogConstants;
 #if defined(MLAS_TARGET_AMD64)
     MLAS_TANH_KERNEL_ROUTINE MlasLogisticKernelFma3;
     MLAS_TANH_KERNEL_ROUTINE MlasTanhKernelFma3;
     MLAS_ERF_KERNEL_ROUTINE MlasErfKernelFma3;
+    MLAS_EXP_KERNEL_ROUTINE MlasExpKernelFma3;
+    MLAS_LOG_KERNEL_ROUTINE MlasLogKernelFma3;
+    MLAS_EXP_KERNEL_ROUTINE MlasExpKernelAvx512F;
+    MLAS_LOG_KERNEL_ROUTINE MlasLogKernelAvx512F;
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx2;
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx512BW;
+    MLAS_QGEMM_U8S8_KERNEL_ROUTINE MlasQgemmU8S8KernelAvx512Vnni;
+    MLAS_HALF_TO_FLOAT_KERNEL_ROUTINE MlasHalfToFloatKernelF16C;
 #endif
 
 }
@@ -378,9 +546,17 @@ extern "C" {
 #endif
 
 //
-// Single-threaded single precision matrix/matrix multiply operation.
+// The quantized integer GEMM operation uses the same per-thread target.
+//
+
+#define MLAS_QGEMM_THREAD_COMPLEXITY                MLAS_SGEMM_THREAD_COMPLEXITY
+
+//
+// Single-threaded single precision matrix/matrix multiply operation. Matrix B
+// is stored as float, MLAS_FP16, or MLAS_BFLOAT16 values.
 //
 
+template<typename BType>
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -391,7 +567,7 @@ MlasSgemmOperation(
     float alpha,
     const float* A,
     size_t lda,
-    const float* B,
+    const BType* B,
     size_t ldb,
     float beta,
     float* C,
@@ -423,6 +599,11 @@ struct MLAS_PLATFORM {
     PMLAS_LOGISTIC_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_TANH_KERNEL_ROUTINE TanhKernelRoutine;
     PMLAS_ERF_KERNEL_ROUTINE ErfKernelRoutine;
+    PMLAS_EXP_KERNEL_ROUTINE ExpKernelRoutine;
+    PMLAS_LOG_KERNEL_ROUTINE LogKernelRoutine;
+    PMLAS_QGEMM_KERNEL_ROUTINE QgemmKernelRoutine;
+    PMLAS_QGEMM_U8S8_KERNEL_ROUTINE QgemmU8S8KernelRoutine;
+    PMLAS_HALF_TO_FLOAT_KERNEL_ROUTINE HalfToFloatKernelRoutine;
     uint32_t NchwcBlockSize;
 #endif
 
@@ -520,9 +701,89 @@ MlasGetMaximumThreadCount(
 
 #if defined(MLAS_NEON_INTRINSICS)
 typedef float32x4_t MLAS_FLOAT32X4;
+typedef int32x4_t MLAS_INT32X4;
 #elif defined(MLAS_SSE2_INTRINSICS)
 typedef __m128 MLAS_FLOAT32X4;
+typedef __m128i MLAS_INT32X4;
+#endif
+
+inline
+MLAS_INT32X4
+MlasReinterpretAsInt32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_f32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(Vector);
 #endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasReinterpretAsFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castsi128_ps(Vector);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasBroadcastInt32x4(int32_t Value)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vdupq_n_s32(Value);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_set1_epi32(Value);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasAndInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vandq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_and_si128(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasOrInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vorrq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_or_si128(Vector1, Vector2);
+#endif
+}
+
+template<unsigned ShiftCount>
+inline
+MLAS_INT32X4
+MlasShiftRightLogicalInt32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(Vector), ShiftCount));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_srli_epi32(Vector, ShiftCount);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasCastToFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vcvtq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cvtepi32_ps(Vector);
+#endif
+}
 
 inline
 MLAS_FLOAT32X4
@@ -710,6 +971,23 @@ MlasDivideFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+inline
+MLAS_FLOAT32X4
+MlasSqrtFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vsqrtq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 0)), Vector, 0);
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 1)), Vector, 1);
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 2)), Vector, 2);
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 3)), Vector, 3);
+    return Vector;
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_sqrt_ps(Vector);
+#endif
+}
+
 inline
 MLAS_FLOAT32X4
 MlasMaximumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
@@ -743,6 +1021,28 @@ MlasGreaterThanFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+inline
+MLAS_FLOAT32X4
+MlasGreaterThanOrEqualFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vcgeq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cmpge_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasBlendFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FLOAT32X4 Selection)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vbslq_f32(vreinterpretq_u32_f32(Selection), Vector2, Vector1);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_or_ps(_mm_andnot_ps(Selection, Vector1), _mm_and_ps(Selection, Vector2));
+#endif
+}
+
 inline
 MLAS_FLOAT32X4
 MlasAndFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
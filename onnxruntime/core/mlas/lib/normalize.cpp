@@ -0,0 +1,197 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    normalize.cpp
+
+Abstract:
+
+    This module implements routines to compute the mean and variance of a
+    buffer and to apply a per buffer scale and shift, which are the building
+    blocks of the batch, instance and mean variance normalization operators.
+
+    The statistics are gathered in a single pass over memory: the buffer is
+    processed in blocks that stay resident in the L1 cache, the sum and the
+    sum of squared deviations of each block are computed with vector
+    instructions, and the block results are merged using the parallel form of
+    Welford's algorithm. This avoids both the separate mean and variance
+    passes over the whole buffer and the cancellation of the naive sum of
+    squares formula.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements in a statistics block. A block of 4KB stays in the L1
+// cache between the mean and the deviation passes.
+//
+
+#define MLAS_NORMALIZE_BLOCK_SIZE 1024
+
+inline
+float
+MlasReduceAddFloat32x4(
+    MLAS_FLOAT32X4 Vector
+    )
+{
+    MLAS_DECLSPEC_ALIGN(float Lanes[4], 16);
+
+    MlasStoreAlignedFloat32x4(Lanes, Vector);
+
+    return (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+}
+
+void
+MLASCALL
+MlasComputeMeanVariance(
+    const float* Input,
+    size_t N,
+    float* Mean,
+    float* Variance
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the mean and the population variance of a buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements in the input buffer.
+
+    Mean - Returns the mean of the elements.
+
+    Variance - Returns the variance of the elements, normalized by N.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    double RunningMean = 0.0;
+    double RunningM2 = 0.0;
+    size_t RunningCount = 0;
+
+    for (size_t n = 0; n < N; n += MLAS_NORMALIZE_BLOCK_SIZE) {
+
+        const size_t CountN = (std::min)(N - n, size_t(MLAS_NORMALIZE_BLOCK_SIZE));
+        const float* Block = Input + n;
+
+        //
+        // Compute the mean of the block.
+        //
+
+        MLAS_FLOAT32X4 SumVector = MlasZeroFloat32x4();
+        size_t i = 0;
+
+        for (; i + 4 <= CountN; i += 4) {
+            SumVector = MlasAddFloat32x4(SumVector, MlasLoadFloat32x4(Block + i));
+        }
+
+        float BlockSum = MlasReduceAddFloat32x4(SumVector);
+
+        for (; i < CountN; i++) {
+            BlockSum += Block[i];
+        }
+
+        const float BlockMean = BlockSum / float(CountN);
+
+        //
+        // Compute the sum of the squared deviations from the block mean while
+        // the block is still in the cache.
+        //
+
+        MLAS_FLOAT32X4 BlockMeanVector = MlasBroadcastFloat32x4(BlockMean);
+        MLAS_FLOAT32X4 M2Vector = MlasZeroFloat32x4();
+        i = 0;
+
+        for (; i + 4 <= CountN; i += 4) {
+            MLAS_FLOAT32X4 Deviation = MlasSubtractFloat32x4(MlasLoadFloat32x4(Block + i), BlockMeanVector);
+            M2Vector = MlasMultiplyAddFloat32x4(Deviation, Deviation, M2Vector);
+        }
+
+        float BlockM2 = MlasReduceAddFloat32x4(M2Vector);
+
+        for (; i < CountN; i++) {
+            const float Deviation = Block[i] - BlockMean;
+            BlockM2 += Deviation * Deviation;
+        }
+
+        //
+        // Merge the block statistics into the running statistics.
+        //
+
+        const size_t TotalCount = RunningCount + CountN;
+        const double Delta = double(BlockMean) - RunningMean;
+
+        RunningMean += Delta * double(CountN) / double(TotalCount);
+        RunningM2 += double(BlockM2) + Delta * Delta * double(RunningCount) * double(CountN) / double(TotalCount);
+        RunningCount = TotalCount;
+    }
+
+    *Mean = float(RunningMean);
+    *Variance = (RunningCount > 0) ? float(RunningM2 / double(RunningCount)) : 0.0f;
+}
+
+void
+MLASCALL
+MlasComputeScaleShift(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    float Shift
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output = Input * Scale + Shift.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. The output buffer may alias the
+        input buffer.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the multiplier.
+
+    Shift - Supplies the addend.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input);
+
+        MlasStoreFloat32x4(Output, MlasMultiplyAddFloat32x4(Vector, ScaleVector, ShiftVector));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = *Input++ * Scale + Shift;
+        N -= 1;
+    }
+}
@@ -98,6 +98,11 @@ Return Value:
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
     this->ErfKernelRoutine = MlasErfKernel;
+    this->ExpKernelRoutine = MlasExpKernel;
+    this->LogKernelRoutine = MlasLogKernel;
+    this->QgemmKernelRoutine = MlasQgemmKernel;
+    this->QgemmU8S8KernelRoutine = nullptr;
+    this->HalfToFloatKernelRoutine = MlasHalfToFloatKernel;
     this->NchwcBlockSize = 8;
 #endif
 
@@ -167,6 +172,8 @@ Return Value:
                     this->PoolFloatKernel[MlasMaximumPooling] = MlasPoolMaximumFloatKernelAvx512F;
                     this->PoolFloatKernel[MlasAveragePoolingExcludePad] = MlasPoolAverageExcludePadFloatKernelAvx512F;
                     this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx512F;
+                    this->ExpKernelRoutine = MlasExpKernelAvx512F;
+                    this->LogKernelRoutine = MlasLogKernelAvx512F;
                     this->NchwcBlockSize = 16;
 
                 } else {
@@ -177,11 +184,38 @@ Return Value:
                     this->ConvNchwcFloatKernel = MlasConvNchwcFloatKernelFma3;
                     this->ConvDepthwiseFloatKernel = MlasConvDepthwiseFloatKernelFma3;
                     this->ConvPointwiseFloatKernel = MlasConvPointwiseFloatKernelFma3;
+                    this->ExpKernelRoutine = MlasExpKernelFma3;
+                    this->LogKernelRoutine = MlasLogKernelFma3;
                 }
 
                 this->LogisticKernelRoutine = MlasLogisticKernelFma3;
                 this->TanhKernelRoutine = MlasTanhKernelFma3;
                 this->ErfKernelRoutine = MlasErfKernelFma3;
+
+                //
+                // Check if the processor supports F16C for the half precision
+                // conversion kernel.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->HalfToFloatKernelRoutine = MlasHalfToFloatKernelF16C;
+                }
+
+                //
+                // Check if the processor supports AVX512BW and AVX512VNNI
+                // for the quantized integer GEMM kernels.
+                //
+
+                this->QgemmKernelRoutine = MlasQgemmKernelAvx2;
+
+                if (((Cpuid7[1] & 0x40010000) == 0x40010000) && ((xcr0 & 0xE0) == 0xE0)) {
+
+                    this->QgemmKernelRoutine = MlasQgemmKernelAvx512BW;
+
+                    if ((Cpuid7[2] & 0x800) != 0) {
+                        this->QgemmU8S8KernelRoutine = MlasQgemmU8S8KernelAvx512Vnni;
+                    }
+                }
             }
 
 #endif
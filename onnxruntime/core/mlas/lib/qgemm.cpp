@@ -0,0 +1,1440 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm.cpp
+
+Abstract:
+
+    This module implements the quantized integer matrix/matrix multiply
+    operation (QGEMM).
+
+    Two packed formats are supported depending on the platform:
+
+    The 16-bit format widens the 8-bit inputs with the zero points subtracted
+    and pairs adjacent elements along the K dimension into a 32-bit element.
+    The kernels multiply and horizontally add each pair with PMADDWD. Because
+    the widened values fit in 9 bits, the pair products cannot saturate and no
+    zero point adjustments are required after the multiply.
+
+    The U8S8 format keeps matrix A as unsigned 8-bit values and biases matrix
+    B to signed 8-bit values, grouping four elements along the K dimension for
+    VPDPBUSD. The zero points and bias are applied as row and column sum
+    adjustments when the output is stored.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of a QGEMM operation on worker
+// threads.
+//
+
+struct MLAS_QGEMM_WORK_BLOCK {
+    size_t N;
+    size_t K;
+    size_t lda;
+    size_t ldb;
+    size_t ldc;
+    int16_t offa;
+    int16_t offb;
+    bool BIsSigned;
+    bool BIsPacked;
+    struct SEGMENT {
+        size_t M;
+        size_t N;
+        size_t StartN;
+        const uint8_t* A;
+        const void* B;
+        int32_t* C;
+    } Segments[MLAS_MAXIMUM_THREAD_COUNT];
+};
+
+//
+// Define the header of a matrix B packed in the U8S8 format. The header is
+// followed by the column sums of the packed matrix and then the packed data.
+//
+
+struct MLAS_QGEMM_U8S8_PACKED_HEADER {
+    int32_t RowSumMultiplier;
+    int32_t Reserved[15];
+};
+
+inline
+bool
+MlasQgemmUseU8S8(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns whether the current platform uses the U8S8 format.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns true if the U8S8 kernel is available, else false.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    return MlasPlatform.QgemmU8S8KernelRoutine != nullptr;
+#else
+    return false;
+#endif
+}
+
+MLAS_FORCEINLINE
+int32_t
+MlasQgemmMakePair(
+    int32_t Low,
+    int32_t High
+    )
+/*++
+
+Routine Description:
+
+    This routine combines two 16-bit values into the 32-bit element consumed
+    by the kernels.
+
+Arguments:
+
+    Low - Supplies the value for the even K index.
+
+    High - Supplies the value for the odd K index.
+
+Return Value:
+
+    Returns the packed pair.
+
+--*/
+{
+    return int32_t(uint32_t(uint16_t(Low)) | (uint32_t(uint16_t(High)) << 16));
+}
+
+void
+MlasQgemmCopyPackA(
+    int32_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int16_t offa
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix A to the destination
+    packed buffer, subtracting the zero point and pairing adjacent elements
+    along the K dimension.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    CountM - Supplies the number of rows of the source matrix to copy.
+
+    CountK - Supplies the number of columns of the source matrix to copy.
+
+    offa - Supplies the zero point of the source matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountM-- > 0) {
+
+        const uint8_t* a = A;
+        size_t k = CountK;
+
+        while (k >= 2) {
+
+            *D++ = MlasQgemmMakePair(int32_t(a[0]) - offa, int32_t(a[1]) - offa);
+
+            a += 2;
+            k -= 2;
+        }
+
+        if (k > 0) {
+            *D++ = MlasQgemmMakePair(int32_t(a[0]) - offa, 0);
+        }
+
+        A += lda;
+    }
+}
+
+template<typename BType>
+void
+MlasQgemmCopyPackB(
+    int32_t* D,
+    const BType* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int16_t offb
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix B to the destination
+    packed buffer, subtracting the zero point and pairing adjacent elements
+    along the K dimension.
+
+    Columns of the source matrix are copied in panels of 16 columns. Each
+    panel stores the pairs for a K index contiguously. The trailing panel is
+    padded with zeroes.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of the source matrix to copy.
+
+    CountK - Supplies the number of rows of the source matrix to copy.
+
+    offb - Supplies the zero point of the source matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountN > 0) {
+
+        const size_t CountNPanel = (std::min)(CountN, size_t(MLAS_QGEMM_PACKED_PANEL_N));
+        const BType* b = B;
+        size_t k = CountK;
+
+        while (k > 0) {
+
+            const BType* b1 = (k >= 2) ? b + ldb : nullptr;
+
+            for (size_t n = 0; n < MLAS_QGEMM_PACKED_PANEL_N; n++) {
+
+                int32_t Low = 0;
+                int32_t High = 0;
+
+                if (n < CountNPanel) {
+                    Low = int32_t(b[n]) - offb;
+                    if (b1 != nullptr) {
+                        High = int32_t(b1[n]) - offb;
+                    }
+                }
+
+                D[n] = MlasQgemmMakePair(Low, High);
+            }
+
+            D += MLAS_QGEMM_PACKED_PANEL_N;
+
+            if (k < 2) {
+                break;
+            }
+
+            b += ldb * 2;
+            k -= 2;
+        }
+
+        B += MLAS_QGEMM_PACKED_PANEL_N;
+        CountN -= CountNPanel;
+    }
+}
+
+void
+MlasQgemmU8S8CopyPackA(
+    uint8_t* D,
+    int32_t* RowSumBuffer,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix A to the destination
+    packed buffer in the U8S8 format and computes the sum of each row.
+
+    Each row of the destination buffer is padded with zeroes to a multiple of
+    four elements.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    RowSumBuffer - Supplies the address of the buffer to receive the sums of
+        the elements of each row.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    CountM - Supplies the number of rows of the source matrix to copy.
+
+    CountK - Supplies the number of columns of the source matrix to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedCountK = (CountK + 3) & ~size_t(3);
+
+    while (CountM-- > 0) {
+
+        int32_t RowSum = 0;
+
+        for (size_t k = 0; k < CountK; k++) {
+            D[k] = A[k];
+            RowSum += A[k];
+        }
+
+        for (size_t k = CountK; k < AlignedCountK; k++) {
+            D[k] = 0;
+        }
+
+        *RowSumBuffer++ = RowSum;
+
+        A += lda;
+        D += AlignedCountK;
+    }
+}
+
+template<typename BType>
+void
+MlasQgemmU8S8CopyPackB(
+    int8_t* D,
+    int32_t* ColumnSumBuffer,
+    const BType* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t BiasB
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix B to the destination
+    packed buffer in the U8S8 format and computes the sum of each column.
+
+    Columns of the source matrix are copied in panels of 16 columns. Each
+    panel stores groups of four elements along the K dimension for a column
+    contiguously. The trailing panel is padded with zeroes.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    ColumnSumBuffer - Supplies the address of the buffer to receive the sums
+        of the biased elements of each column. The buffer is padded to a
+        multiple of 16 columns.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of the source matrix to copy.
+
+    CountK - Supplies the number of rows of the source matrix to copy.
+
+    BiasB - Supplies the bias to subtract from each element so that the
+        result is a signed 8-bit value.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedCountK = (CountK + 3) & ~size_t(3);
+
+    while (CountN > 0) {
+
+        const size_t CountNPanel = (std::min)(CountN, size_t(MLAS_QGEMM_PACKED_PANEL_N));
+
+        for (size_t n = 0; n < MLAS_QGEMM_PACKED_PANEL_N; n++) {
+            ColumnSumBuffer[n] = 0;
+        }
+
+        for (size_t k = 0; k < AlignedCountK; k += 4) {
+
+            for (size_t n = 0; n < MLAS_QGEMM_PACKED_PANEL_N; n++) {
+
+                for (size_t i = 0; i < 4; i++) {
+
+                    int32_t Value = 0;
+
+                    if (n < CountNPanel && (k + i) < CountK) {
+                        Value = int32_t(B[(k + i) * ldb + n]) - BiasB;
+                    }
+
+                    D[n * 4 + i] = int8_t(Value);
+                    ColumnSumBuffer[n] += Value;
+                }
+            }
+
+            D += 4 * MLAS_QGEMM_PACKED_PANEL_N;
+        }
+
+        B += MLAS_QGEMM_PACKED_PANEL_N;
+        ColumnSumBuffer += MLAS_QGEMM_PACKED_PANEL_N;
+        CountN -= CountNPanel;
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasQgemmKernelRows(
+    const int32_t* A,
+    const int32_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of rows of the output matrix using the
+    base instruction set.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A.
+
+    B - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    PairCountK - Supplies the number of packed pairs along the K dimension.
+
+    CountN - Supplies the number of columns of matrix C.
+
+    lda - Supplies the number of packed pairs per row of matrix A.
+
+    ldb - Supplies the number of packed elements between panels of matrix B.
+
+    ldc - Supplies the number of elements per row of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountN > 0) {
+
+        int32_t Output[RowCount][MLAS_QGEMM_PACKED_PANEL_N];
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+        __m128i Accumulators[RowCount][4];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            for (size_t i = 0; i < 4; i++) {
+                Accumulators[r][i] = _mm_setzero_si128();
+            }
+        }
+
+        const int32_t* b = B;
+
+        for (size_t k = 0; k < PairCountK; k++) {
+
+            __m128i BElements[4];
+
+            for (size_t i = 0; i < 4; i++) {
+                BElements[i] = _mm_loadu_si128((const __m128i*)&b[i * 4]);
+            }
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                __m128i AElements = _mm_set1_epi32(A[r * lda + k]);
+
+                for (size_t i = 0; i < 4; i++) {
+                    Accumulators[r][i] = _mm_add_epi32(Accumulators[r][i],
+                        _mm_madd_epi16(AElements, BElements[i]));
+                }
+            }
+
+            b += MLAS_QGEMM_PACKED_PANEL_N;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            for (size_t i = 0; i < 4; i++) {
+                _mm_storeu_si128((__m128i*)&Output[r][i * 4], Accumulators[r][i]);
+            }
+        }
+
+#else
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            for (size_t n = 0; n < MLAS_QGEMM_PACKED_PANEL_N; n++) {
+                Output[r][n] = 0;
+            }
+
+            const int32_t* b = B;
+
+            for (size_t k = 0; k < PairCountK; k++) {
+
+                int32_t APair = A[r * lda + k];
+                int32_t ALow = int16_t(APair & 0xFFFF);
+                int32_t AHigh = int16_t(uint32_t(APair) >> 16);
+
+                for (size_t n = 0; n < MLAS_QGEMM_PACKED_PANEL_N; n++) {
+                    int32_t BPair = b[n];
+                    Output[r][n] += ALow * int16_t(BPair & 0xFFFF) +
+                        AHigh * int16_t(uint32_t(BPair) >> 16);
+                }
+
+                b += MLAS_QGEMM_PACKED_PANEL_N;
+            }
+        }
+
+#endif
+
+        const size_t CountNPanel = (std::min)(CountN, size_t(MLAS_QGEMM_PACKED_PANEL_N));
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t* c = C + r * ldc;
+
+            for (size_t n = 0; n < CountNPanel; n++) {
+                c[n] = ZeroMode ? Output[r][n] : c[n] + Output[r][n];
+            }
+        }
+
+        B += ldb;
+        C += CountNPanel;
+        CountN -= CountNPanel;
+    }
+}
+
+size_t
+MLASCALL
+MlasQgemmKernel(
+    const int32_t* A,
+    const int32_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the generic kernel for the QGEMM operation.
+
+Arguments:
+
+    A - Supplies the address of the packed matrix A.
+
+    B - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    PairCountK - Supplies the number of packed pairs along the K dimension.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    lda - Supplies the number of packed pairs per row of matrix A.
+
+    ldb - Supplies the number of packed elements between panels of matrix B.
+
+    ldc - Supplies the number of elements per row of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 2) {
+        MlasQgemmKernelRows<2>(A, B, C, PairCountK, CountN, lda, ldb, ldc, ZeroMode);
+        return 2;
+    }
+
+    MlasQgemmKernelRows<1>(A, B, C, PairCountK, CountN, lda, ldb, ldc, ZeroMode);
+    return 1;
+}
+
+void
+MlasQgemmS16Operation(
+    const MLAS_QGEMM_WORK_BLOCK* WorkBlock,
+    const MLAS_QGEMM_WORK_BLOCK::SEGMENT* Segment
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a single threaded segment of the QGEMM operation
+    using the 16-bit packed format.
+
+Arguments:
+
+    WorkBlock - Supplies the common parameters of the operation.
+
+    Segment - Supplies the parameters of the segment to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(int32_t PanelA[MLAS_QGEMM_STRIDEM * MLAS_QGEMM_STRIDEK / 2], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t PanelB[MLAS_QGEMM_STRIDEN * MLAS_QGEMM_STRIDEK / 2], 64);
+
+    const size_t M = Segment->M;
+    const size_t N = Segment->N;
+    const size_t K = WorkBlock->K;
+    const size_t lda = WorkBlock->lda;
+    const size_t ldb = WorkBlock->ldb;
+    const size_t ldc = WorkBlock->ldc;
+
+    const size_t TotalPairCountK = (K + 1) / 2;
+
+    for (size_t CountN, n = 0; n < N; n += CountN) {
+
+        CountN = (std::min)(N - n, size_t(MLAS_QGEMM_STRIDEN));
+
+        for (size_t CountK, k = 0; k < K; k += CountK) {
+
+            CountK = (std::min)(K - k, size_t(MLAS_QGEMM_STRIDEK));
+
+            const size_t PairCountK = (CountK + 1) / 2;
+
+            //
+            // Use the prepacked matrix B if available, else copy and pack
+            // this slice of matrix B.
+            //
+
+            const int32_t* b;
+            size_t PanelStrideB;
+
+            if (WorkBlock->BIsPacked) {
+
+                b = (const int32_t*)Segment->B + (Segment->StartN + n) * TotalPairCountK +
+                    (k / 2) * MLAS_QGEMM_PACKED_PANEL_N;
+                PanelStrideB = TotalPairCountK * MLAS_QGEMM_PACKED_PANEL_N;
+
+            } else {
+
+                if (WorkBlock->BIsSigned) {
+                    MlasQgemmCopyPackB<int8_t>(PanelB, (const int8_t*)Segment->B + k * ldb + n,
+                        ldb, CountN, CountK, WorkBlock->offb);
+                } else {
+                    MlasQgemmCopyPackB<uint8_t>(PanelB, (const uint8_t*)Segment->B + k * ldb + n,
+                        ldb, CountN, CountK, WorkBlock->offb);
+                }
+
+                b = PanelB;
+                PanelStrideB = PairCountK * MLAS_QGEMM_PACKED_PANEL_N;
+            }
+
+            for (size_t CountM, m = 0; m < M; m += CountM) {
+
+                CountM = (std::min)(M - m, size_t(MLAS_QGEMM_STRIDEM));
+
+                MlasQgemmCopyPackA(PanelA, Segment->A + m * lda + k, lda, CountM,
+                    CountK, WorkBlock->offa);
+
+                const int32_t* a = PanelA;
+                int32_t* c = Segment->C + m * ldc + n;
+                size_t RowsRemaining = CountM;
+
+                while (RowsRemaining > 0) {
+
+#if defined(MLAS_TARGET_AMD64)
+                    size_t RowsHandled = MlasPlatform.QgemmKernelRoutine(a, b, c,
+                        PairCountK, RowsRemaining, CountN, PairCountK, PanelStrideB,
+                        ldc, k == 0);
+#else
+                    size_t RowsHandled = MlasQgemmKernel(a, b, c, PairCountK,
+                        RowsRemaining, CountN, PairCountK, PanelStrideB, ldc, k == 0);
+#endif
+
+                    a += RowsHandled * PairCountK;
+                    c += RowsHandled * ldc;
+                    RowsRemaining -= RowsHandled;
+                }
+            }
+        }
+    }
+}
+
+#if defined(MLAS_TARGET_AMD64)
+
+void
+MlasQgemmU8S8Operation(
+    const MLAS_QGEMM_WORK_BLOCK* WorkBlock,
+    const MLAS_QGEMM_WORK_BLOCK::SEGMENT* Segment
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a single threaded segment of the QGEMM operation
+    using the U8S8 packed format.
+
+    For each slice of the K dimension, the output is adjusted by:
+
+        RowSumMultiplier * (RowSumA - offa * CountK) - offa * ColumnSumB
+
+    where RowSumMultiplier is the bias applied to matrix B minus the zero
+    point of matrix B.
+
+Arguments:
+
+    WorkBlock - Supplies the common parameters of the operation.
+
+    Segment - Supplies the parameters of the segment to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(uint8_t PanelA[MLAS_QGEMM_STRIDEM * MLAS_QGEMM_STRIDEK], 64);
+    MLAS_DECLSPEC_ALIGN(int8_t PanelB[MLAS_QGEMM_STRIDEN * MLAS_QGEMM_STRIDEK], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t RowSumBuffer[MLAS_QGEMM_STRIDEM], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t ColumnSumBuffer[MLAS_QGEMM_STRIDEN], 64);
+
+    const size_t M = Segment->M;
+    const size_t N = Segment->N;
+    const size_t K = WorkBlock->K;
+    const size_t lda = WorkBlock->lda;
+    const size_t ldb = WorkBlock->ldb;
+    const size_t ldc = WorkBlock->ldc;
+    const int32_t offa = WorkBlock->offa;
+
+    const size_t AlignedK = (K + 3) & ~size_t(3);
+
+    int32_t RowSumMultiplier;
+    const int32_t* PackedColumnSums = nullptr;
+    const int8_t* PackedData = nullptr;
+
+    if (WorkBlock->BIsPacked) {
+
+        const MLAS_QGEMM_U8S8_PACKED_HEADER* Header =
+            (const MLAS_QGEMM_U8S8_PACKED_HEADER*)Segment->B;
+        const size_t AlignedN = (WorkBlock->N + MLAS_QGEMM_PACKED_PANEL_N - 1) &
+            ~(size_t(MLAS_QGEMM_PACKED_PANEL_N) - 1);
+
+        RowSumMultiplier = Header->RowSumMultiplier;
+        PackedColumnSums = (const int32_t*)(Header + 1);
+        PackedData = (const int8_t*)(PackedColumnSums + AlignedN);
+
+    } else {
+
+        RowSumMultiplier = (WorkBlock->BIsSigned ? 0 : 128) - WorkBlock->offb;
+    }
+
+    for (size_t CountN, n = 0; n < N; n += CountN) {
+
+        CountN = (std::min)(N - n, size_t(MLAS_QGEMM_STRIDEN));
+
+        for (size_t CountK, k = 0; k < K; k += CountK) {
+
+            CountK = (std::min)(K - k, size_t(MLAS_QGEMM_STRIDEK));
+
+            const size_t AlignedCountK = (CountK + 3) & ~size_t(3);
+
+            //
+            // Use the prepacked matrix B if available, else copy and pack
+            // this slice of matrix B. The column sums of a prepacked matrix
+            // cover the entire K dimension, so are only applied once.
+            //
+
+            const int8_t* b;
+            size_t PanelStrideB;
+
+            if (WorkBlock->BIsPacked) {
+
+                b = PackedData + (Segment->StartN + n) * AlignedK + k * MLAS_QGEMM_PACKED_PANEL_N;
+                PanelStrideB = AlignedK * MLAS_QGEMM_PACKED_PANEL_N;
+
+                for (size_t i = 0; i < CountN; i++) {
+                    ColumnSumBuffer[i] = (k == 0) ? -offa * PackedColumnSums[Segment->StartN + n + i] : 0;
+                }
+
+            } else {
+
+                if (WorkBlock->BIsSigned) {
+                    MlasQgemmU8S8CopyPackB<int8_t>(PanelB, ColumnSumBuffer,
+                        (const int8_t*)Segment->B + k * ldb + n, ldb, CountN, CountK, 0);
+                } else {
+                    MlasQgemmU8S8CopyPackB<uint8_t>(PanelB, ColumnSumBuffer,
+                        (const uint8_t*)Segment->B + k * ldb + n, ldb, CountN, CountK, 128);
+                }
+
+                for (size_t i = 0; i < CountN; i++) {
+                    ColumnSumBuffer[i] *= -offa;
+                }
+
+                b = PanelB;
+                PanelStrideB = AlignedCountK * MLAS_QGEMM_PACKED_PANEL_N;
+            }
+
+            for (size_t CountM, m = 0; m < M; m += CountM) {
+
+                CountM = (std::min)(M - m, size_t(MLAS_QGEMM_STRIDEM));
+
+                MlasQgemmU8S8CopyPackA(PanelA, RowSumBuffer, Segment->A + m * lda + k,
+                    lda, CountM, CountK);
+
+                for (size_t i = 0; i < CountM; i++) {
+                    RowSumBuffer[i] = RowSumMultiplier * (RowSumBuffer[i] - offa * int32_t(CountK));
+                }
+
+                const uint8_t* a = PanelA;
+                int32_t* c = Segment->C + m * ldc + n;
+                const int32_t* RowSums = RowSumBuffer;
+                size_t RowsRemaining = CountM;
+
+                while (RowsRemaining > 0) {
+
+                    size_t RowsHandled = MlasPlatform.QgemmU8S8KernelRoutine(a, b, c,
+                        AlignedCountK / 4, RowsRemaining, CountN, AlignedCountK,
+                        PanelStrideB, ldc, RowSums, ColumnSumBuffer, k == 0);
+
+                    a += RowsHandled * AlignedCountK;
+                    c += RowsHandled * ldc;
+                    RowSums += RowsHandled;
+                    RowsRemaining -= RowsHandled;
+                }
+            }
+        }
+    }
+}
+
+#endif
+
+void
+MlasQgemmOperation(
+    const MLAS_QGEMM_WORK_BLOCK* WorkBlock,
+    const MLAS_QGEMM_WORK_BLOCK::SEGMENT* Segment
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a single threaded segment of the QGEMM operation.
+
+Arguments:
+
+    WorkBlock - Supplies the common parameters of the operation.
+
+    Segment - Supplies the parameters of the segment to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // An empty inner dimension produces a zero matrix.
+    //
+
+    if (WorkBlock->K == 0) {
+
+        for (size_t m = 0; m < Segment->M; m++) {
+            std::fill_n(Segment->C + m * WorkBlock->ldc, Segment->N, 0);
+        }
+
+        return;
+    }
+
+#if defined(MLAS_TARGET_AMD64)
+    if (MlasQgemmUseU8S8()) {
+        MlasQgemmU8S8Operation(WorkBlock, Segment);
+        return;
+    }
+#endif
+
+    MlasQgemmS16Operation(WorkBlock, Segment);
+}
+
+void
+MlasQgemmOperationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    QGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_QGEMM_WORK_BLOCK* WorkBlock = (MLAS_QGEMM_WORK_BLOCK*)Context;
+
+    MlasQgemmOperation(WorkBlock, &WorkBlock->Segments[Index]);
+}
+
+void
+MlasQgemmSchedule(
+    MLAS_QGEMM_WORK_BLOCK* WorkBlock,
+    size_t M,
+    size_t N,
+    const uint8_t* A,
+    const void* B,
+    int32_t* C,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine segments a QGEMM operation across multiple threads and
+    executes the segments.
+
+Arguments:
+
+    WorkBlock - Supplies the common parameters of the operation. The segments
+        of the work block are initialized by this routine.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B or the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Compute the number of target threads given the complexity of the QGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(WorkBlock->K);
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads. Segments of matrix B
+    // start on a packed panel boundary so that a prepacked matrix B can be
+    // indexed directly.
+    //
+
+    int32_t Index = 0;
+
+    if (N > M) {
+
+        size_t StrideN = (N + TargetThreadCount - 1) / TargetThreadCount;
+
+        StrideN = (StrideN + MLAS_QGEMM_PACKED_PANEL_N - 1) & ~(size_t(MLAS_QGEMM_PACKED_PANEL_N) - 1);
+
+        for (size_t CountN, n = 0; n < N; n += CountN) {
+
+            CountN = (std::min)(N - n, StrideN);
+
+            WorkBlock->Segments[Index].M = M;
+            WorkBlock->Segments[Index].N = CountN;
+            WorkBlock->Segments[Index].StartN = n;
+            WorkBlock->Segments[Index].A = A;
+            WorkBlock->Segments[Index].C = C + n;
+
+            if (WorkBlock->BIsPacked) {
+                WorkBlock->Segments[Index].B = B;
+            } else if (WorkBlock->BIsSigned) {
+                WorkBlock->Segments[Index].B = (const int8_t*)B + n;
+            } else {
+                WorkBlock->Segments[Index].B = (const uint8_t*)B + n;
+            }
+
+            Index++;
+        }
+
+    } else {
+
+        size_t StrideM = (M + TargetThreadCount - 1) / TargetThreadCount;
+
+        for (size_t CountM, m = 0; m < M; m += CountM) {
+
+            CountM = (std::min)(M - m, StrideM);
+
+            WorkBlock->Segments[Index].M = CountM;
+            WorkBlock->Segments[Index].N = N;
+            WorkBlock->Segments[Index].StartN = 0;
+            WorkBlock->Segments[Index].A = A + m * WorkBlock->lda;
+            WorkBlock->Segments[Index].B = B;
+            WorkBlock->Segments[Index].C = C + m * WorkBlock->ldc;
+
+            Index++;
+        }
+    }
+
+    if (Index <= 1) {
+        MlasQgemmOperation(WorkBlock, &WorkBlock->Segments[0]);
+        return;
+    }
+
+    MlasExecuteThreaded(MlasQgemmOperationThreaded, WorkBlock, Index, ThreadPool);
+}
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) for an unsigned matrix B.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = ldb;
+    WorkBlock.ldc = ldc;
+    WorkBlock.offa = offa;
+    WorkBlock.offb = offb;
+    WorkBlock.BIsSigned = false;
+    WorkBlock.BIsPacked = false;
+
+    MlasQgemmSchedule(&WorkBlock, M, N, A, B, C, ThreadPool);
+}
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) for a signed matrix B.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = ldb;
+    WorkBlock.ldc = ldc;
+    WorkBlock.offa = offa;
+    WorkBlock.offb = offb;
+    WorkBlock.BIsSigned = true;
+    WorkBlock.BIsPacked = false;
+
+    MlasQgemmSchedule(&WorkBlock, M, N, A, B, C, ThreadPool);
+}
+
+size_t
+MLASCALL
+MlasQgemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack matrix B.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size of the packed buffer in bytes.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_QGEMM_PACKED_PANEL_N - 1) & ~(size_t(MLAS_QGEMM_PACKED_PANEL_N) - 1);
+
+    if (MlasQgemmUseU8S8()) {
+        const size_t AlignedK = (K + 3) & ~size_t(3);
+        return sizeof(MLAS_QGEMM_U8S8_PACKED_HEADER) + AlignedN * sizeof(int32_t) +
+            AlignedN * AlignedK;
+    }
+
+    return AlignedN * ((K + 1) / 2) * sizeof(int32_t);
+}
+
+template<typename BType>
+void
+MlasQgemmPackBInternal(
+    size_t N,
+    size_t K,
+    const BType* B,
+    size_t ldb,
+    BType offb,
+    int32_t BiasB,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs matrix B using the packed format of the platform.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B.
+
+    BiasB - Supplies the bias to convert the elements of matrix B to signed
+        8-bit values for the U8S8 format.
+
+    PackedB - Supplies the address of the packed buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (MlasQgemmUseU8S8()) {
+
+        const size_t AlignedN =
+            (N + MLAS_QGEMM_PACKED_PANEL_N - 1) & ~(size_t(MLAS_QGEMM_PACKED_PANEL_N) - 1);
+
+        MLAS_QGEMM_U8S8_PACKED_HEADER* Header = (MLAS_QGEMM_U8S8_PACKED_HEADER*)PackedB;
+        int32_t* ColumnSums = (int32_t*)(Header + 1);
+
+        memset(Header, 0, sizeof(MLAS_QGEMM_U8S8_PACKED_HEADER));
+        Header->RowSumMultiplier = BiasB - offb;
+
+        MlasQgemmU8S8CopyPackB<BType>((int8_t*)(ColumnSums + AlignedN), ColumnSums,
+            B, ldb, N, K, BiasB);
+
+        return;
+    }
+
+    MlasQgemmCopyPackB<BType>((int32_t*)PackedB, B, ldb, N, K, offb);
+}
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs an unsigned matrix B for use by MlasQgemmPacked.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B.
+
+    PackedB - Supplies the address of the packed buffer. The buffer must be
+        at least MlasQgemmPackBSize bytes.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQgemmPackBInternal<uint8_t>(N, K, B, ldb, offb, 128, PackedB);
+}
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs a signed matrix B for use by MlasQgemmPacked.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B.
+
+    PackedB - Supplies the address of the packed buffer. The buffer must be
+        at least MlasQgemmPackBSize bytes.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQgemmPackBInternal<int8_t>(N, K, B, ldb, offb, 0, PackedB);
+}
+
+void
+MLASCALL
+MlasQgemmPacked(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const void* PackedB,
+    int32_t* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) for a matrix B packed by MlasQgemmPackB.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    PackedB - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = 0;
+    WorkBlock.ldc = ldc;
+    WorkBlock.offa = offa;
+    WorkBlock.offb = 0;
+    WorkBlock.BIsSigned = false;
+    WorkBlock.BIsPacked = true;
+
+    MlasQgemmSchedule(&WorkBlock, M, N, A, PackedB, C, ThreadPool);
+}
@@ -0,0 +1,166 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    quantize.cpp
+
+Abstract:
+
+    This module implements routines to requantize the 32-bit output of a
+    quantized integer matrix/matrix multiply operation.
+
+    The arithmetic matches the fixed point output stage used by gemmlowp so
+    that results are bit exact with the previous implementation of the
+    quantized operators.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+int32_t
+MlasSaturatingRoundingDoublingHighMultiply(
+    int32_t a,
+    int32_t b
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the high 32 bits of the doubled product of the two
+    operands, rounded to nearest.
+
+Arguments:
+
+    a - Supplies the first operand.
+
+    b - Supplies the second operand.
+
+Return Value:
+
+    Returns the rounded high product.
+
+--*/
+{
+    if (a == b && a == (std::numeric_limits<int32_t>::min)()) {
+        return (std::numeric_limits<int32_t>::max)();
+    }
+
+    int64_t ab = int64_t(a) * int64_t(b);
+    int64_t nudge = (ab >= 0) ? (int64_t(1) << 30) : (1 - (int64_t(1) << 30));
+
+    return int32_t((ab + nudge) / (int64_t(1) << 31));
+}
+
+MLAS_FORCEINLINE
+int32_t
+MlasRoundingDivideByPowerOf2(
+    int32_t x,
+    int32_t Exponent
+    )
+/*++
+
+Routine Description:
+
+    This routine divides the operand by a power of two, rounding to nearest
+    with ties away from zero.
+
+Arguments:
+
+    x - Supplies the operand.
+
+    Exponent - Supplies the power of two.
+
+Return Value:
+
+    Returns the rounded quotient.
+
+--*/
+{
+    const int32_t Mask = int32_t((int64_t(1) << Exponent) - 1);
+    const int32_t Remainder = x & Mask;
+    const int32_t Threshold = (Mask >> 1) + ((x < 0) ? 1 : 0);
+
+    return (x >> Exponent) + ((Remainder > Threshold) ? 1 : 0);
+}
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    uint8_t* Output,
+    const int32_t* Bias,
+    size_t M,
+    size_t N,
+    int32_t Multiplier,
+    int32_t Shift,
+    uint8_t ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine requantizes the 32-bit output of a QGEMM operation to
+    unsigned 8-bit values.
+
+    Each element is optionally offset by the bias of its row, multiplied by
+    the fixed point multiplier, divided by 2^Shift with rounding, offset by
+    the zero point, and then saturated to the range of an unsigned 8-bit
+    value.
+
+Arguments:
+
+    Input - Supplies the input matrix with M rows and N columns.
+
+    Output - Supplies the output matrix with M rows and N columns.
+
+    Bias - Supplies the optional per row bias vector, else nullptr.
+
+    M - Supplies the number of rows.
+
+    N - Supplies the number of columns.
+
+    Multiplier - Supplies the fixed point multiplier in Q31 format.
+
+    Shift - Supplies the number of bits to right shift the product. A
+        negative value left shifts the input before the multiply.
+
+    ZeroPoint - Supplies the zero point of the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const int32_t LeftShift = (Shift < 0) ? -Shift : 0;
+    const int32_t RightShift = (Shift > 0) ? Shift : 0;
+
+    for (size_t m = 0; m < M; m++) {
+
+        const int32_t RowBias = (Bias != nullptr) ? Bias[m] : 0;
+
+        for (size_t n = 0; n < N; n++) {
+
+            //
+            // Add the bias and shift in unsigned arithmetic so that wrap around
+            // is defined, matching the 32-bit accumulator of the GEMM.
+            //
+
+            int32_t Value = int32_t((uint32_t(Input[n]) + uint32_t(RowBias)) << LeftShift);
+
+            Value = MlasSaturatingRoundingDoublingHighMultiply(Value, Multiplier);
+            Value = MlasRoundingDivideByPowerOf2(Value, RightShift) + ZeroPoint;
+            Value = (std::min)((std::max)(Value, 0), 255);
+
+            Output[n] = uint8_t(Value);
+        }
+
+        Input += N;
+        Output += N;
+    }
+}
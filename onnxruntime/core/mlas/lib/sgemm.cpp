@@ -31,6 +31,7 @@ Abstract:
 // threads.
 //
 
+template<typename BType>
 struct MLAS_SGEMM_WORK_BLOCK {
     CBLAS_TRANSPOSE TransA;
     CBLAS_TRANSPOSE TransB;
@@ -44,7 +45,7 @@ struct MLAS_SGEMM_WORK_BLOCK {
         size_t M;
         size_t N;
         const float* A;
-        const float* B;
+        const BType* B;
         float* C;
     } Segments[MLAS_MAXIMUM_THREAD_COUNT];
 };
@@ -772,6 +773,236 @@ Return Value:
     }
 }
 
+MLAS_FORCEINLINE
+void
+MlasSgemmConvertToFloat(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t N
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.HalfToFloatKernelRoutine(Source, Destination, N);
+#else
+    MlasHalfToFloatKernel(Source, Destination, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasSgemmConvertToFloat(
+    const MLAS_BFLOAT16* Source,
+    float* Destination,
+    size_t N
+    )
+{
+    MlasBFloat16ToFloatKernel(Source, Destination, N);
+}
+
+inline
+void
+MlasSgemmPackB(
+    float* D,
+    CBLAS_TRANSPOSE TransB,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies or transposes a panel of the source matrix to the
+    destination packed buffer.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    TransB - Supplies the transpose operation for the source matrix.
+
+    B - Supplies the address of the source panel.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of the panel.
+
+    CountK - Supplies the number of rows of the panel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (TransB == CblasNoTrans) {
+        MlasSgemmCopyPackB(D, B, ldb, CountN, CountK);
+    } else {
+        MlasSgemmTransposePackB(D, B, ldb, CountN, CountK);
+    }
+}
+
+template<typename BType>
+void
+MlasSgemmPackB(
+    float* D,
+    CBLAS_TRANSPOSE TransB,
+    const BType* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a panel of the half precision or bfloat16 source
+    matrix to single precision values and then copies or transposes the
+    panel to the destination packed buffer.
+
+    Only the panel is converted, so the source matrix stays in its compact
+    format and no single precision copy of the full matrix is kept.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    TransB - Supplies the transpose operation for the source matrix.
+
+    B - Supplies the address of the source panel.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of the panel.
+
+    CountK - Supplies the number of rows of the panel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float PanelConvert[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK];
+
+    if (TransB == CblasNoTrans) {
+
+        for (size_t k = 0; k < CountK; k++) {
+            MlasSgemmConvertToFloat(B + k * ldb, PanelConvert + k * CountN, CountN);
+        }
+
+        MlasSgemmCopyPackB(D, PanelConvert, CountN, CountN, CountK);
+
+    } else {
+
+        for (size_t n = 0; n < CountN; n++) {
+            MlasSgemmConvertToFloat(B + n * ldb, PanelConvert + n * CountK, CountK);
+        }
+
+        MlasSgemmTransposePackB(D, PanelConvert, CountK, CountN, CountK);
+    }
+}
+
+inline
+bool
+MlasSgemmTryKernelM1(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* A,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C
+    )
+/*++
+
+Routine Description:
+
+    This routine attempts to compute a single row of the output matrix
+    directly from the source matrix B without packing.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+Return Value:
+
+    Returns true if the operation was completed, else false if the operation
+    should use the packed path.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    PMLAS_SGEMM_KERNEL_M1_ROUTINE SgemmKernelM1Routine;
+
+    if (TransB == CblasNoTrans) {
+        SgemmKernelM1Routine = MlasPlatform.KernelM1Routine;
+    } else {
+        SgemmKernelM1Routine = MlasPlatform.KernelM1TransposeBRoutine;
+    }
+
+    if (SgemmKernelM1Routine != nullptr) {
+        SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+        return true;
+    }
+
+#else
+
+    MLAS_UNREFERENCED_PARAMETER(TransB);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(A);
+    MLAS_UNREFERENCED_PARAMETER(B);
+    MLAS_UNREFERENCED_PARAMETER(ldb);
+    MLAS_UNREFERENCED_PARAMETER(beta);
+    MLAS_UNREFERENCED_PARAMETER(C);
+
+#endif
+
+    return false;
+}
+
+template<typename BType>
+inline
+bool
+MlasSgemmTryKernelM1(
+    CBLAS_TRANSPOSE,
+    size_t,
+    size_t,
+    const float*,
+    const BType*,
+    size_t,
+    float,
+    float*
+    )
+{
+    //
+    // The M1 kernels read matrix B directly, so the half precision and
+    // bfloat16 formats always use the packed path.
+    //
+
+    return false;
+}
+
+template<typename BType>
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -782,7 +1013,7 @@ MlasSgemmOperation(
     float alpha,
     const float* A,
     size_t lda,
-    const float* B,
+    const BType* B,
     size_t ldb,
     float beta,
     float* C,
@@ -841,23 +1072,9 @@ Return Value:
 
     if (M == 1 && TransA == CblasNoTrans && alpha == 1.0f && (beta == 0.0f || beta == 1.0f)) {
 
-#if defined(MLAS_TARGET_AMD64)
-
-        PMLAS_SGEMM_KERNEL_M1_ROUTINE SgemmKernelM1Routine;
-
-        if (TransB == CblasNoTrans) {
-            SgemmKernelM1Routine = MlasPlatform.KernelM1Routine;
-        } else {
-            SgemmKernelM1Routine = MlasPlatform.KernelM1TransposeBRoutine;
-        }
-
-        if (SgemmKernelM1Routine != nullptr) {
-            SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+        if (MlasSgemmTryKernelM1(TransB, N, K, A, B, ldb, beta, C)) {
             return;
         }
-
-#endif
-
     }
 
     //
@@ -925,11 +1142,9 @@ Return Value:
             // Copy or transpose a panel of matrix B to a local packed buffer.
             //
 
-            if (TransB == CblasNoTrans) {
-                MlasSgemmCopyPackB(PanelB, B + n + k * ldb, ldb, CountN, CountK);
-            } else {
-                MlasSgemmTransposePackB(PanelB, B + k + n * ldb, ldb, CountN, CountK);
-            }
+            const BType* b = (TransB == CblasNoTrans) ? B + n + k * ldb : B + k + n * ldb;
+
+            MlasSgemmPackB(PanelB, TransB, b, ldb, CountN, CountK);
 
             //
             // Select the kernel routine to use for this panel.
@@ -1031,6 +1246,25 @@ Return Value:
     }
 }
 
+template
+void
+MlasSgemmOperation<float>(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
+template<typename BType>
 void
 MlasSgemmOperationThreaded(
     void* Context,
@@ -1055,9 +1289,9 @@ Return Value:
 
 --*/
 {
-    MLAS_SGEMM_WORK_BLOCK* WorkBlock = (MLAS_SGEMM_WORK_BLOCK*)Context;
+    MLAS_SGEMM_WORK_BLOCK<BType>* WorkBlock = (MLAS_SGEMM_WORK_BLOCK<BType>*)Context;
 
-    MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
+    typename MLAS_SGEMM_WORK_BLOCK<BType>::SEGMENT* Segment = &WorkBlock->Segments[Index];
 
     MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
         Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
@@ -1065,6 +1299,7 @@ Return Value:
         WorkBlock->ldc);
 }
 
+template<typename BType>
 inline
 bool
 MlasSgemmTryMultithread(
@@ -1076,7 +1311,7 @@ MlasSgemmTryMultithread(
     float alpha,
     const float* A,
     size_t lda,
-    const float* B,
+    const BType* B,
     size_t ldb,
     float beta,
     float* C,
@@ -1129,7 +1364,7 @@ Return Value:
 
 --*/
 {
-    MLAS_SGEMM_WORK_BLOCK WorkBlock;
+    MLAS_SGEMM_WORK_BLOCK<BType> WorkBlock;
     int32_t TargetThreadCount;
 
     //
@@ -1232,7 +1467,7 @@ Return Value:
         }
     }
 
-    MlasExecuteThreaded(MlasSgemmOperationThreaded, &WorkBlock, Index, ThreadPool);
+    MlasExecuteThreaded(MlasSgemmOperationThreaded<BType>, &WorkBlock, Index, ThreadPool);
 
     return true;
 }
@@ -1309,3 +1544,89 @@ Return Value:
         MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
     }
 }
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) where matrix B is stored as half precision values.
+
+    Matrix B is converted to single precision values one panel at a time
+    while the panel is packed for the SGEMM kernels.
+
+Arguments:
+
+    See the single precision version of this routine.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, ThreadPool)) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+}
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_BFLOAT16* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) where matrix B is stored as bfloat16 values.
+
+    Matrix B is converted to single precision values one panel at a time
+    while the panel is packed for the SGEMM kernels.
+
+Arguments:
+
+    See the single precision version of this routine.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, ThreadPool)) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+}
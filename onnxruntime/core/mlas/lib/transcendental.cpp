@@ -0,0 +1,249 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transcendental.cpp
+
+Abstract:
+
+    This module implements routines to compute elementwise transcendental
+    functions with the work partitioned across a thread pool.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of an elementwise transcendental
+// operation on worker threads.
+//
+
+struct MLAS_TRANSCENDENTAL_WORK_BLOCK {
+    PMLAS_EXP_KERNEL_ROUTINE KernelRoutine;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t ThreadStrideN;
+};
+
+void
+MlasTranscendentalThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of an
+    elementwise transcendental operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_TRANSCENDENTAL_WORK_BLOCK* WorkBlock = (MLAS_TRANSCENDENTAL_WORK_BLOCK*)Context;
+
+    const size_t Offset = size_t(Index) * WorkBlock->ThreadStrideN;
+
+    if (Offset < WorkBlock->N) {
+
+        const size_t CountN = (std::min)(WorkBlock->N - Offset, WorkBlock->ThreadStrideN);
+
+        WorkBlock->KernelRoutine(WorkBlock->Input + Offset, WorkBlock->Output + Offset, CountN);
+    }
+}
+
+void
+MLASCALL
+MlasSqrtKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the square root function.
+    The square root is a single instruction on all targets, so there are no
+    platform specific kernels.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasSqrtFloat32x4(MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = std::sqrt(*Input++);
+        N -= 1;
+    }
+}
+
+PMLAS_EXP_KERNEL_ROUTINE
+MlasGetTranscendentalKernelRoutine(
+    MLAS_TRANSCENDENTAL_KIND Kind
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the kernel that implements the specified function for
+    the current platform.
+
+Arguments:
+
+    Kind - Supplies the kind of transcendental function.
+
+Return Value:
+
+    Returns the kernel routine.
+
+--*/
+{
+    switch (Kind) {
+
+        case MlasExpFunction:
+#if defined(MLAS_TARGET_AMD64)
+            return MlasPlatform.ExpKernelRoutine;
+#else
+            return MlasExpKernel;
+#endif
+
+        case MlasLogFunction:
+#if defined(MLAS_TARGET_AMD64)
+            return MlasPlatform.LogKernelRoutine;
+#else
+            return MlasLogKernel;
+#endif
+
+        case MlasLogisticFunction:
+#if defined(MLAS_TARGET_AMD64)
+            return MlasPlatform.LogisticKernelRoutine;
+#else
+            return MlasLogisticKernel;
+#endif
+
+        case MlasTanhFunction:
+#if defined(MLAS_TARGET_AMD64)
+            return MlasPlatform.TanhKernelRoutine;
+#else
+            return MlasTanhKernel;
+#endif
+
+        case MlasSqrtFunction:
+            return MlasSqrtKernel;
+
+        case MlasErfFunction:
+        default:
+#if defined(MLAS_TARGET_AMD64)
+            return MlasPlatform.ErfKernelRoutine;
+#else
+            return MlasErfKernel;
+#endif
+    }
+}
+
+void
+MLASCALL
+MlasComputeTranscendental(
+    MLAS_TRANSCENDENTAL_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the specified elementwise transcendental function,
+    using the thread pool to process segments of the buffers in parallel.
+
+Arguments:
+
+    Kind - Supplies the kind of transcendental function.
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. The output buffer may alias the
+        input buffer.
+
+    N - Supplies the number of elements to process.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_TRANSCENDENTAL_WORK_BLOCK WorkBlock;
+
+    WorkBlock.KernelRoutine = MlasGetTranscendentalKernelRoutine(Kind);
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+
+    //
+    // Compute the number of target threads given the number of elements and
+    // the per thread target, then segment the buffers on aligned boundaries.
+    //
+
+    size_t TargetThreadCount = (N + MLAS_TRANSCENDENTAL_THREAD_ELEMENTS - 1) /
+        MLAS_TRANSCENDENTAL_THREAD_ELEMENTS;
+    size_t MaximumThreadCount = size_t(MlasGetMaximumThreadCount(ThreadPool));
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount <= 1) {
+        WorkBlock.KernelRoutine(Input, Output, N);
+        return;
+    }
+
+    size_t ThreadStrideN = (N + TargetThreadCount - 1) / TargetThreadCount;
+
+    ThreadStrideN = (ThreadStrideN + MLAS_TRANSCENDENTAL_THREAD_ALIGN - 1) &
+        ~(size_t(MLAS_TRANSCENDENTAL_THREAD_ALIGN) - 1);
+
+    WorkBlock.ThreadStrideN = ThreadStrideN;
+
+    int32_t Iterations = int32_t((N + ThreadStrideN - 1) / ThreadStrideN);
+
+    MlasExecuteThreaded(MlasTranscendentalThreaded, &WorkBlock, Iterations, ThreadPool);
+}
@@ -6,6 +6,7 @@
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/optimizer/matmul_half_weights_fusion.h"
 
 using namespace onnxruntime::common;
 
@@ -36,6 +37,13 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level)
       continue;
     }
 
+#ifndef DISABLE_CONTRIB_OPS
+    // keep the float16/bfloat16 weights for MatMulHalfWeightsFusion, which runs after partitioning
+    if (node->OpType() == "Cast" && MatMulHalfWeightsFusion::IsFusableWeightsCast(graph, *node)) {
+      continue;
+    }
+#endif
+
     // Create execution frame for executing constant nodes.
     // NOTE: As we call AllNodeInputsAreConstant we can use the full list of initializers from
     // graph.GetAllInitializedTensors() without filtering out overridable (i.e. non-constant) initializers
@@ -14,6 +14,8 @@
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/shape_to_initializer.h"
+#include "core/optimizer/qdq_fusion.h"
+#include "core/optimizer/matmul_half_weights_fusion.h"
 
 namespace onnxruntime {
 
@@ -98,7 +100,10 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(TransformerL
       rule_transformer = GenerateRuleBasedGraphTransformer(level, transformers_and_rules_to_enable, l2_execution_providers);
 
       // create standalone transformers
+      transformers.emplace_back(std::make_unique<QDQFusion>(l2_execution_providers));
 #ifndef DISABLE_CONTRIB_OPS
+      // constant folding leaves the Cast of the float16/bfloat16 weights in place for this fusion
+      transformers.emplace_back(std::make_unique<MatMulHalfWeightsFusion>(l2_execution_providers));
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(l2_execution_providers));
       transformers.emplace_back(std::make_unique<MatMulAddFusion>(l2_execution_providers));
       transformers.emplace_back(std::make_unique<ConvActivationFusion>(l2_execution_providers));
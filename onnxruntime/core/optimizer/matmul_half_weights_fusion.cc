@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <deque>
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/matmul_half_weights_fusion.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the Cast node that converts a 2-D float16/bfloat16 initializer to the weights input of 'node', or nullptr.
+const Node* GetWeightsCastNode(const Graph& graph, const Node& node) {
+  const Node* cast_node = nullptr;
+  for (auto it = node.InputEdgesBegin(); it != node.InputEdgesEnd(); ++it) {
+    if (it->GetDstArgIndex() == 1) {
+      cast_node = &it->GetNode();
+    }
+  }
+
+  if (cast_node == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*cast_node, "Cast", {6, 9}) ||
+      cast_node->GetOutputEdgesCount() != 1 ||
+      graph.IsNodeOutputsInGraphOutputs(*cast_node)) {
+    return nullptr;
+  }
+
+  const auto* to_attr = graph_utils::GetNodeAttribute(*cast_node, "to");
+  if (to_attr == nullptr || to_attr->i() != TensorProto::FLOAT) {
+    return nullptr;
+  }
+
+  const TensorProto* initializer = nullptr;
+  if (!graph.GetInitializedTensor(cast_node->InputDefs()[0]->Name(), initializer) ||
+      initializer == nullptr ||
+      initializer->dims_size() != 2 ||
+      (initializer->data_type() != TensorProto::FLOAT16 && initializer->data_type() != TensorProto::BFLOAT16)) {
+    return nullptr;
+  }
+
+  return cast_node;
+}
+
+// A Gemm can be rewritten if A is not transposed and C is absent or a vector of N elements added with beta 1.
+bool IsSupportedGemm(const Node& node, int64_t N) {
+  const auto* trans_a_attr = graph_utils::GetNodeAttribute(node, "transA");
+  if (trans_a_attr != nullptr && trans_a_attr->i() != 0) {
+    return false;
+  }
+
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() < 3 || !input_defs[2]->Exists()) {
+    return true;
+  }
+
+  const auto* beta_attr = graph_utils::GetNodeAttribute(node, "beta");
+  if (beta_attr != nullptr && beta_attr->f() != 1.0f) {
+    return false;
+  }
+
+  const auto* c_shape = input_defs[2]->Shape();
+  if (c_shape == nullptr) {
+    return false;
+  }
+  int64_t c_size = 1;
+  for (const auto& dim : c_shape->dim()) {
+    if (!dim.has_dim_value()) {
+      return false;
+    }
+    c_size *= dim.dim_value();
+  }
+  return c_size == N && (c_shape->dim_size() == 1 || (c_shape->dim_size() == 2 && c_shape->dim(0).dim_value() == 1));
+}
+
+// Returns the Cast of the weights if 'node' is a float MatMul or a supported Gemm with half weights, or nullptr.
+// trans_b and alpha are set from the Gemm attributes.
+const Node* GetFusableWeightsCastNode(const Graph& graph, const Node& node, int64_t& trans_b, float& alpha) {
+  const bool is_gemm = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", {7, 9});
+  if ((!is_gemm && !graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9})) ||
+      *node.InputDefs()[0]->Type() != "tensor(float)") {
+    return nullptr;
+  }
+
+  const Node* cast_node = GetWeightsCastNode(graph, node);
+  if (cast_node == nullptr || cast_node->GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return nullptr;
+  }
+
+  trans_b = 0;
+  alpha = 1.0f;
+  if (is_gemm) {
+    const auto* trans_b_attr = graph_utils::GetNodeAttribute(node, "transB");
+    const auto* alpha_attr = graph_utils::GetNodeAttribute(node, "alpha");
+    trans_b = trans_b_attr != nullptr ? trans_b_attr->i() : 0;
+    alpha = alpha_attr != nullptr ? alpha_attr->f() : 1.0f;
+
+    const TensorProto* weights = nullptr;
+    graph.GetInitializedTensor(cast_node->InputDefs()[0]->Name(), weights);
+    if (!IsSupportedGemm(node, weights->dims(trans_b != 0 ? 0 : 1))) {
+      return nullptr;
+    }
+  }
+
+  return cast_node;
+}
+
+}  // namespace
+
+Status MatMulHalfWeightsFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto* node = graph.GetNode(index);
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level));
+
+    if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    int64_t trans_b;
+    float alpha;
+    const Node* cast_node = GetFusableWeightsCastNode(graph, *node, trans_b, alpha);
+    if (cast_node == nullptr) {
+      continue;
+    }
+
+    auto& input_defs = node->MutableInputDefs();
+    std::vector<NodeArg*> fused_inputs{input_defs[0], const_cast<Node*>(cast_node)->MutableInputDefs()[0]};
+    if (node->OpType() == "Gemm" && input_defs.size() > 2 && input_defs[2]->Exists()) {
+      fused_inputs.push_back(input_defs[2]);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("MatMulWithHalfWeights"),
+                                     "MatMulWithHalfWeights",
+                                     "fused " + node->OpType() + " with the Cast of its weights",
+                                     fused_inputs,
+                                     node->MutableOutputDefs(),
+                                     nullptr,
+                                     "com.microsoft");
+    fused_node.AddAttribute("transB", trans_b);
+    fused_node.AddAttribute("alpha", alpha);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(node->GetExecutionProviderType());
+
+    removed_nodes.push_front(cast_node->Index());
+    removed_nodes.push_front(node->Index());
+  }
+
+  for (auto node : removed_nodes) {
+    graph.RemoveNode(node);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+bool MatMulHalfWeightsFusion::IsFusableWeightsCast(const Graph& graph, const Node& cast_node) {
+  if (cast_node.GetOutputEdgesCount() != 1) {
+    return false;
+  }
+
+  const Node& node = *cast_node.OutputNodesBegin();
+  const auto& provider = node.GetExecutionProviderType();
+  if (!provider.empty() && provider != kCpuExecutionProvider) {
+    return false;
+  }
+
+  int64_t trans_b;
+  float alpha;
+  return GetFusableWeightsCastNode(graph, node, trans_b, alpha) == &cast_node;
+}
+}  // namespace onnxruntime
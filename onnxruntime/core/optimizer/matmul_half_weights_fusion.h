@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MatMulHalfWeightsFusion
+
+Rewrite MatMul/Gemm nodes whose weights are a float16 or bfloat16 initializer cast to float into
+MatMulWithHalfWeights, so the weights stay resident in their 16-bit format and are converted while they are
+packed for the GEMM. MatMulWithHalfWeights is only implemented by the CPU execution provider, so this runs at
+Level2 after partitioning. Constant folding leaves the Casts it can fuse in place (see IsFusableWeightsCast), as it
+would otherwise replace them with a float copy of the initializer before this transformer sees them.
+*/
+class MatMulHalfWeightsFusion : public GraphTransformer {
+ public:
+  MatMulHalfWeightsFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MatMulHalfWeightsFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level) const override;
+
+  // Returns true if cast_node converts the weights of a MatMul/Gemm that is, or may still be, assigned to the
+  // CPU execution provider and that this transformer can rewrite.
+  static bool IsFusableWeightsCast(const Graph& graph, const Node& cast_node);
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <deque>
+#include "core/graph/graph_utils.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/optimizer/qdq_fusion.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the node that produces the input of 'node' at 'input_index', or nullptr if the input is a graph input or
+// an initializer.
+const Node* GetInputNode(const Node& node, int input_index) {
+  for (auto it = node.InputEdgesBegin(); it != node.InputEdgesEnd(); ++it) {
+    if (it->GetDstArgIndex() == input_index) {
+      return &it->GetNode();
+    }
+  }
+  return nullptr;
+}
+
+bool HasSingleConsumer(const Graph& graph, const Node& node) {
+  return node.GetOutputEdgesCount() == 1 && !graph.IsNodeOutputsInGraphOutputs(node);
+}
+
+template <typename T>
+bool GetConstantScalar(const Graph& graph, const NodeArg& node_arg, T& value) {
+  const TensorProto* tensor_proto = nullptr;
+  if (!graph_utils::IsConstantInitializer(graph, node_arg.Name(), true) ||
+      !graph.GetInitializedTensor(node_arg.Name(), tensor_proto) ||
+      tensor_proto == nullptr) {
+    return false;
+  }
+
+  int64_t size = 1;
+  for (int i = 0; i < tensor_proto->dims_size(); i++) {
+    size *= tensor_proto->dims(i);
+  }
+  if (size != 1) {
+    return false;
+  }
+
+  const void* raw_data = tensor_proto->has_raw_data() ? tensor_proto->raw_data().data() : nullptr;
+  const size_t raw_data_len = tensor_proto->has_raw_data() ? tensor_proto->raw_data().size() : 0;
+  return utils::UnpackTensor<T>(*tensor_proto, raw_data, raw_data_len, &value, 1).IsOK();
+}
+
+// Checks that 'node' is a DequantizeLinear with an explicit zero point whose quantized input has the given type.
+bool IsDequantizeLinear(const Node& node, const std::string& input_type,
+                        const std::unordered_set<std::string>& compatible_providers) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "DequantizeLinear", {10}) &&
+         graph_utils::IsSupportedProvider(node, compatible_providers) &&
+         node.InputDefs().size() == 3 &&
+         node.InputDefs()[2]->Exists() &&
+         *node.InputDefs()[0]->Type() == input_type;
+}
+
+// A quantized bias must be int32 with a zero point of 0 and a scale equal to the product of the input and weight
+// scales, which is the form QLinearConv consumes directly.
+bool IsCompatibleBias(const Graph& graph, const Node& bias_dq, const Node& x_dq, const Node& w_dq) {
+  if (bias_dq.InputDefs().size() == 3 && bias_dq.InputDefs()[2]->Exists()) {
+    int32_t bias_zero_point;
+    if (!GetConstantScalar(graph, *bias_dq.InputDefs()[2], bias_zero_point) || bias_zero_point != 0) {
+      return false;
+    }
+  }
+
+  float bias_scale, x_scale, w_scale;
+  if (!GetConstantScalar(graph, *bias_dq.InputDefs()[1], bias_scale) ||
+      !GetConstantScalar(graph, *x_dq.InputDefs()[1], x_scale) ||
+      !GetConstantScalar(graph, *w_dq.InputDefs()[1], w_scale)) {
+    return false;
+  }
+
+  const float expected_scale = x_scale * w_scale;
+  return std::abs(bias_scale - expected_scale) <= 1e-5f * std::abs(expected_scale);
+}
+
+}  // namespace
+
+Status QDQFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+  const auto& compatible_providers = GetCompatibleExecutionProviders();
+
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto* node = graph.GetNode(index);
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(*node, "QuantizeLinear", {10}) ||
+        !graph_utils::IsSupportedProvider(*node, compatible_providers) ||
+        node->InputDefs().size() != 3 ||
+        !node->InputDefs()[2]->Exists() ||
+        *node->OutputDefs()[0]->Type() != "tensor(uint8)") {
+      continue;
+    }
+
+    Node& q_node = *node;
+    const Node* producer = GetInputNode(q_node, 0);
+    if (producer == nullptr || !HasSingleConsumer(graph, *producer)) {
+      continue;
+    }
+
+    // The saturation to uint8 clamps at the zero point, so a Relu is implied when the output zero point is 0.
+    const Node* relu_node = nullptr;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*producer, "Relu", {6})) {
+      uint8_t y_zero_point;
+      if (!GetConstantScalar(graph, *q_node.InputDefs()[2], y_zero_point) || y_zero_point != 0) {
+        continue;
+      }
+      relu_node = producer;
+      producer = GetInputNode(*relu_node, 0);
+      if (producer == nullptr || !HasSingleConsumer(graph, *producer)) {
+        continue;
+      }
+    }
+
+    bool is_conv = graph_utils::IsSupportedOptypeVersionAndDomain(*producer, "Conv", {1});
+    if ((!is_conv && !graph_utils::IsSupportedOptypeVersionAndDomain(*producer, "MatMul", {1, 9})) ||
+        producer->GetExecutionProviderType() != q_node.GetExecutionProviderType() ||
+        (relu_node != nullptr && relu_node->GetExecutionProviderType() != q_node.GetExecutionProviderType())) {
+      continue;
+    }
+
+    const Node* x_dq = GetInputNode(*producer, 0);
+    const Node* w_dq = GetInputNode(*producer, 1);
+    if (x_dq == nullptr || w_dq == nullptr ||
+        !IsDequantizeLinear(*x_dq, "tensor(uint8)", compatible_providers) ||
+        !IsDequantizeLinear(*w_dq, "tensor(uint8)", compatible_providers)) {
+      continue;
+    }
+
+    const Node* bias_dq = nullptr;
+    if (is_conv && producer->InputDefs().size() == 3 && producer->InputDefs()[2]->Exists()) {
+      bias_dq = GetInputNode(*producer, 2);
+      if (bias_dq == nullptr ||
+          !graph_utils::IsSupportedOptypeVersionAndDomain(*bias_dq, "DequantizeLinear", {10}) ||
+          !graph_utils::IsSupportedProvider(*bias_dq, compatible_providers) ||
+          *bias_dq->InputDefs()[0]->Type() != "tensor(int32)" ||
+          !IsCompatibleBias(graph, *bias_dq, *x_dq, *w_dq)) {
+        continue;
+      }
+    }
+
+    auto& x_dq_inputs = const_cast<Node*>(x_dq)->MutableInputDefs();
+    auto& w_dq_inputs = const_cast<Node*>(w_dq)->MutableInputDefs();
+    auto& q_inputs = q_node.MutableInputDefs();
+
+    std::vector<NodeArg*> input_defs{x_dq_inputs[0], x_dq_inputs[1], x_dq_inputs[2],
+                                     w_dq_inputs[0], w_dq_inputs[1], w_dq_inputs[2],
+                                     q_inputs[1], q_inputs[2]};
+    if (bias_dq != nullptr) {
+      input_defs.push_back(const_cast<Node*>(bias_dq)->MutableInputDefs()[0]);
+    }
+
+    const std::string op_type = is_conv ? "QLinearConv" : "QLinearMatMul";
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(op_type),
+                                     op_type,
+                                     "fused " + producer->Name() + " with its DequantizeLinear/QuantizeLinear nodes",
+                                     input_defs,
+                                     q_node.MutableOutputDefs(),
+                                     is_conv ? &producer->GetAttributes() : nullptr);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(producer->GetExecutionProviderType());
+
+    // The DequantizeLinear nodes are only removed if nothing else consumes the float values.
+    for (const Node* dq : {x_dq, w_dq, bias_dq}) {
+      if (dq != nullptr && HasSingleConsumer(graph, *dq)) {
+        removed_nodes.push_front(dq->Index());
+      }
+    }
+    removed_nodes.push_front(producer->Index());
+    if (relu_node != nullptr) {
+      removed_nodes.push_front(relu_node->Index());
+    }
+    removed_nodes.push_front(q_node.Index());
+  }
+
+  for (auto node : removed_nodes) {
+    graph.RemoveNode(node);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
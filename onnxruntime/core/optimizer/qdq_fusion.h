@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class QDQFusion
+
+Rewrite the "fake quantized" DequantizeLinear -> Conv/MatMul -> QuantizeLinear patterns produced by quantization
+aware training exporters to QLinearConv/QLinearMatMul, so that activations stay in the uint8 domain between layers.
+A Relu between the float operator and the QuantizeLinear node is absorbed when the output zero point is 0, because
+the saturation of the integer operator already clamps the output at the zero point.
+*/
+class QDQFusion : public GraphTransformer {
+ public:
+  QDQFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QDQFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
@@ -89,6 +89,20 @@ class Env {
                                           OrtCallback& deleter) const = 0;
 #endif
 
+#ifndef _WIN32
+  /**
+   * Reads a part of a file into a buffer of the caller, without any intermediate copy of the data.
+   * \param file_path file_path must point to a regular file, which can't be a pipe/socket/...
+   * \param[in] offset file offset
+   * \param[in] len length to read. The file must have at least 'offset + len' bytes.
+   * \param[out] buffer buffer of at least 'len' bytes
+   */
+  virtual common::Status ReadFileIntoBuffer(const char* file_path, off_t offset, size_t len, void* buffer) const = 0;
+#else
+  virtual common::Status ReadFileIntoBuffer(const wchar_t* file_path, int64_t offset, size_t len,
+                                            void* buffer) const = 0;
+#endif
+
 #ifdef _WIN32
   //Mainly for use with protobuf library
   virtual common::Status FileOpenRd(const std::wstring& path, /*out*/ int& fd) const = 0;
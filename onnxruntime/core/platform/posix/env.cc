@@ -175,6 +175,45 @@ class PosixEnv : public Env {
     return common::Status::OK();
   }
 
+  common::Status ReadFileIntoBuffer(const char* fname, off_t offset, size_t len, void* buffer) const override {
+    if (!fname) {
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "ReadFileIntoBuffer: 'fname' cannot be NULL");
+    }
+
+    if (offset < 0) {
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                            "ReadFileIntoBuffer: offset must be non-negative");
+    }
+
+    int fd = open(fname, O_RDONLY);
+    if (fd < 0) {
+      return ReportSystemError("open", fname);
+    }
+
+    char* wptr = reinterpret_cast<char*>(buffer);
+    auto length_remain = len;
+    while (length_remain > 0) {
+      ssize_t bytes_read;
+      TEMP_FAILURE_RETRY(bytes_read = pread(fd, wptr, length_remain, offset));
+      if (bytes_read < 0) {
+        auto st = ReportSystemError("read", fname);
+        (void)close(fd);
+        return st;
+      }
+      if (bytes_read == 0) {
+        (void)close(fd);
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "read file '", fname, "' fail: unexpected end");
+      }
+      assert(static_cast<size_t>(bytes_read) <= length_remain);
+      wptr += bytes_read;
+      offset += bytes_read;
+      length_remain -= bytes_read;
+    }
+
+    (void)close(fd);
+    return common::Status::OK();
+  }
+
   static common::Status ReportSystemError(const char* operation_name, const std::string& path) {
     auto e = errno;
     char buf[1024];
@@ -145,6 +145,50 @@ class WindowsEnv : public Env {
     return common::Status::OK();
   }
 
+  common::Status ReadFileIntoBuffer(const wchar_t* fname, int64_t offset, size_t len, void* buffer) const override {
+    if (!fname) {
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "ReadFileIntoBuffer: 'fname' cannot be NULL");
+    }
+    if (offset < 0) {
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                            "ReadFileIntoBuffer: offset must be non-negative");
+    }
+    HANDLE hFile = CreateFileW(fname, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+      int err = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "open file ", ToMBString(fname), " fail, errcode =", err);
+    }
+    std::unique_ptr<void, decltype(&CloseHandle)> handler_holder(hFile, CloseHandle);
+    if (offset > 0) {
+      LARGE_INTEGER liCurrentPosition;
+      liCurrentPosition.QuadPart = offset;
+      if (SetFilePointerEx(hFile, liCurrentPosition, &liCurrentPosition, FILE_BEGIN) != TRUE) {
+        int err = GetLastError();
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "SetFilePointerEx ", ToMBString(fname), " fail, errcode =", err);
+      }
+    }
+    char* wptr = reinterpret_cast<char*>(buffer);
+    size_t length_remain = len;
+    DWORD bytes_read = 0;
+    for (; length_remain > 0; wptr += bytes_read, length_remain -= bytes_read) {
+      //read at most 1GB each time
+      DWORD bytes_to_read;
+      if (length_remain > (1 << 30)) {
+        bytes_to_read = 1 << 30;
+      } else {
+        bytes_to_read = static_cast<DWORD>(length_remain);
+      }
+      if (ReadFile(hFile, wptr, bytes_to_read, &bytes_read, nullptr) != TRUE) {
+        int err = GetLastError();
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ReadFile ", ToMBString(fname), " fail, errcode =", err);
+      }
+      if (bytes_read != bytes_to_read) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ReadFile ", ToMBString(fname), " fail: unexpected end");
+      }
+    }
+    return common::Status::OK();
+  }
+
   common::Status FileOpenRd(const std::wstring& path, /*out*/ int& fd) const override {
     _wsopen_s(&fd, path.c_str(), _O_RDONLY | _O_SEQUENTIAL | _O_BINARY, _SH_DENYWR, _S_IREAD | _S_IWRITE);
     if (0 > fd) {
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/activation/activations.h"
+#include "core/framework/op_kernel_context_internal.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
@@ -28,12 +29,78 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(Softsign, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(Tanh, 6);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ThresholdedRelu, 10);
 
+template <>
+Status Elu<float>::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  const int64_t N = x_shape.Size();
+
+  // Y may alias X, so compute the exponential into a scratch buffer.
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  auto* exp_data = static_cast<float*>(alloc->Alloc(sizeof(float) * N));
+  BufferUniquePtr exp_buffer(exp_data, BufferDeleter(alloc));
+
+  MlasComputeTranscendental(MlasExpFunction, X->template Data<float>(), exp_data, N, GetOperatorThreadPool(context));
+
+  ConstEigenVectorArrayMap<float> xm(X->template Data<float>(), N);
+  ConstEigenVectorArrayMap<float> em(exp_data, N);
+  EigenVectorArrayMap<float>(Y->template MutableData<float>(), N) = (xm >= 0).select(xm, alpha_ * (em - 1.0f));
+  return Status::OK();
+}
+
+template <>
+Status ParametricSoftplus<float>::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  const int64_t N = x_shape.Size();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  auto* log_data = static_cast<float*>(alloc->Alloc(sizeof(float) * N));
+  BufferUniquePtr log_buffer(log_data, BufferDeleter(alloc));
+
+  // alpha * (max(beta * x, 0) + log(1 + exp(-|beta * x|)))
+  ConstEigenVectorArrayMap<float> xm(X->template Data<float>(), N);
+  EigenVectorArrayMap<float> lm(log_data, N);
+  lm = -(xm * beta_).abs();
+  MlasComputeTranscendental(MlasExpFunction, log_data, log_data, N, GetOperatorThreadPool(context));
+  lm += 1.0f;
+  MlasComputeTranscendental(MlasLogFunction, log_data, log_data, N, GetOperatorThreadPool(context));
+  EigenVectorArrayMap<float>(Y->template MutableData<float>(), N) = alpha_ * ((xm * beta_).cwiseMax(0.0f) + lm);
+  return Status::OK();
+}
+
+template <>
+Status Selu<float>::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  const int64_t N = x_shape.Size();
+
+  // Y may alias X, so compute the exponential into a scratch buffer.
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  auto* exp_data = static_cast<float*>(alloc->Alloc(sizeof(float) * N));
+  BufferUniquePtr exp_buffer(exp_data, BufferDeleter(alloc));
+
+  MlasComputeTranscendental(MlasExpFunction, X->template Data<float>(), exp_data, N, GetOperatorThreadPool(context));
+
+  ConstEigenVectorArrayMap<float> xm(X->template Data<float>(), N);
+  ConstEigenVectorArrayMap<float> em(exp_data, N);
+  EigenVectorArrayMap<float>(Y->template MutableData<float>(), N) = gamma_ * (xm.cwiseMax(0.0f) + (alpha_ * (em - 1.0f)).cwiseMin(0.0f));
+  return Status::OK();
+}
+
 template <>
 Status Sigmoid<float>::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const auto& x_shape = X->Shape();
   Tensor* Y = context->Output(0, x_shape);
-  MlasComputeLogistic(X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
+  MlasComputeTranscendental(MlasLogisticFunction, X->template Data<float>(), Y->template MutableData<float>(),
+                            x_shape.Size(), GetOperatorThreadPool(context));
   return Status::OK();
 }
 
@@ -42,7 +109,8 @@ Status Tanh<float>::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const auto& x_shape = X->Shape();
   Tensor* Y = context->Output(0, x_shape);
-  MlasComputeTanh(X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
+  MlasComputeTranscendental(MlasTanhFunction, X->template Data<float>(), Y->template MutableData<float>(),
+                            x_shape.Size(), GetOperatorThreadPool(context));
   return Status::OK();
 }
 
@@ -9,10 +9,14 @@
 #pragma warning(disable : 4996)
 #endif
 
+#include <array>
+#include <unordered_set>
+
 #include "core/providers/cpu/controlflow/loop.h"
 #include "core/providers/cpu/controlflow/utils.h"
 
 #include "core/framework/framework_common.h"
+#include "core/framework/execution_frame.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
 #include "core/framework/session_state.h"
@@ -87,6 +91,145 @@ ONNX_CPU_OPERATOR_KERNEL(Loop,
                              .TypeConstraint("V", DataTypeImpl::AllTensorTypes()),
                          Loop);
 
+namespace {
+// copy num_elements values of data_type. string elements are assigned as the buffers hold constructed strings.
+void CopyElements(MLDataType data_type, const void* source, void* target, int64_t num_elements) {
+  if (data_type == DataTypeImpl::GetType<std::string>()) {
+    const auto* src = static_cast<const std::string*>(source);
+    std::copy(src, src + num_elements, static_cast<std::string*>(target));
+  } else {
+    memcpy(target, source, num_elements * data_type->Size());
+  }
+}
+}  // namespace
+
+/*
+Class that collects the per-iteration values of a Loop scan output in a single buffer.
+Once the per-iteration shape is known the subgraph writes each iteration directly to its slice of the buffer
+using a custom fetch allocator. If the number of iterations is known upfront the buffer is the Loop output.
+Otherwise it is a temporary buffer that grows geometrically, and is copied to the Loop output once at the end.
+*/
+class LoopScanOutput {
+ public:
+  LoopScanOutput(OpKernelContextInternal& context, int output_index, int64_t trip_count, AllocatorPtr allocator)
+      : context_{context}, output_index_{output_index}, trip_count_{trip_count}, allocator_{allocator} {}
+
+  // custom fetch allocator that returns the slice of the buffer for the given iteration.
+  // only valid once SaveIteration has been called for the first iteration.
+  Status AllocateIteration(int64_t iteration, const TensorShape& shape, OrtValue& ort_value);
+
+  // save the subgraph output for the given iteration. no copy is done if the subgraph wrote to the slice directly.
+  Status SaveIteration(int64_t iteration, const OrtValue& ort_value);
+
+  // create the Loop output from the values of the first num_iterations iterations
+  Status Finalize(int64_t num_iterations);
+
+ private:
+  Status Reserve(int64_t iteration, const TensorShape& per_iteration_shape, MLDataType data_type);
+
+  TensorShape ShapeWithIterations(int64_t num_iterations) const;
+
+  void* IterationData(int64_t iteration) const {
+    return static_cast<char*>(buffer_->MutableDataRaw()) + iteration * bytes_per_iteration_;
+  }
+
+  OpKernelContextInternal& context_;
+  const int output_index_;
+  const int64_t trip_count_;  // -1 if unknown
+  AllocatorPtr allocator_;
+
+  MLDataType data_type_ = nullptr;
+  TensorShape per_iteration_shape_;
+  size_t bytes_per_iteration_ = 0;
+  int64_t capacity_ = 0;
+
+  // the Loop output if trip_count_ is known, otherwise temporary_buffer_
+  Tensor* buffer_ = nullptr;
+  std::unique_ptr<Tensor> temporary_buffer_;
+};
+
+TensorShape LoopScanOutput::ShapeWithIterations(int64_t num_iterations) const {
+  const auto& per_iteration_dims = per_iteration_shape_.GetDims();
+  std::vector<int64_t> dims{num_iterations};
+  std::copy(per_iteration_dims.cbegin(), per_iteration_dims.cend(), std::back_inserter(dims));
+  return TensorShape(dims);
+}
+
+Status LoopScanOutput::Reserve(int64_t iteration, const TensorShape& per_iteration_shape, MLDataType data_type) {
+  if (data_type_ == nullptr) {
+    data_type_ = data_type;
+    per_iteration_shape_ = per_iteration_shape;
+    bytes_per_iteration_ = per_iteration_shape_.Size() * data_type_->Size();
+  } else if (per_iteration_shape != per_iteration_shape_ || data_type != data_type_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output ", output_index_,
+                           " Expected:", per_iteration_shape_, " Got:", per_iteration_shape);
+  }
+
+  if (iteration < capacity_) {
+    return Status::OK();
+  }
+
+  if (trip_count_ >= 0) {
+    buffer_ = context_.Output(output_index_, ShapeWithIterations(trip_count_));
+    if (!buffer_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create output tensor for output #", output_index_);
+    }
+
+    capacity_ = trip_count_;
+  } else {
+    // iterations are added one at a time so doubling always makes room for the new one
+    int64_t capacity = std::max<int64_t>(capacity_ * 2, 16);
+    auto buffer = std::make_unique<Tensor>(data_type_, ShapeWithIterations(capacity), allocator_);
+    if (capacity_ > 0) {
+      CopyElements(data_type_, buffer_->DataRaw(), buffer->MutableDataRaw(), capacity_ * per_iteration_shape_.Size());
+    }
+
+    temporary_buffer_ = std::move(buffer);
+    buffer_ = temporary_buffer_.get();
+    capacity_ = capacity;
+  }
+
+  return Status::OK();
+}
+
+Status LoopScanOutput::AllocateIteration(int64_t iteration, const TensorShape& shape, OrtValue& ort_value) {
+  ORT_ENFORCE(data_type_, "The first iteration of the Loop output must be saved before using the custom allocator.");
+  ORT_RETURN_IF_ERROR(Reserve(iteration, shape, data_type_));
+
+  auto slice = std::make_unique<Tensor>(data_type_, shape, IterationData(iteration), buffer_->Location());
+  ort_value.Init(slice.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+
+  return Status::OK();
+}
+
+Status LoopScanOutput::SaveIteration(int64_t iteration, const OrtValue& ort_value) {
+  const auto& tensor = ort_value.Get<Tensor>();
+  ORT_RETURN_IF_ERROR(Reserve(iteration, tensor.Shape(), tensor.DataType()));
+
+  // the subgraph output is somewhere else if it was produced before the custom allocator was set up,
+  // or if the subgraph passed an input through to the output.
+  void* target = IterationData(iteration);
+  if (tensor.DataRaw() != target) {
+    CopyElements(data_type_, tensor.DataRaw(), target, per_iteration_shape_.Size());
+  }
+
+  return Status::OK();
+}
+
+Status LoopScanOutput::Finalize(int64_t num_iterations) {
+  if (buffer_ == temporary_buffer_.get()) {
+    Tensor* output = context_.Output(output_index_, ShapeWithIterations(num_iterations));
+    if (!output) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create output tensor for output #", output_index_);
+    }
+
+    CopyElements(data_type_, buffer_->DataRaw(), output->MutableDataRaw(),
+                 num_iterations * per_iteration_shape_.Size());
+  }
+
+  return Status::OK();
+}
+
 class LoopImpl {
  public:
   LoopImpl(OpKernelContextInternal& context,
@@ -103,10 +246,17 @@ class LoopImpl {
 
  private:
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
-  void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+  void UpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+
+  // setup custom allocators so the subgraph writes the loop carried variables and scan outputs to buffers we manage
+  void CreateFetchAllocators(const FeedsFetchesManager& ffm, const std::vector<OrtValue>& feeds,
+                             std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // custom fetch allocator for a loop carried variable
+  Status AllocateLoopCarriedOutput(int index, const TensorShape& shape, const std::vector<OrtValue>& feeds,
+                                   OrtValue& ort_value);
 
-  // create the single Loop output from a collection of per-iteration outputs
-  Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
+  int64_t CurrentIteration() const { return *iter_num_mlvalue_.Get<Tensor>().Data<int64_t>(); }
 
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
@@ -115,6 +265,10 @@ class LoopImpl {
   int64_t max_trip_count_;
   bool condition_;
 
+  // number of iterations if it is known before execution, else -1
+  int64_t trip_count_ = -1;
+  bool has_duplicate_outputs_ = false;
+
   int num_loop_carried_vars_;
   int num_subgraph_inputs_;
   int num_outputs_;
@@ -127,9 +281,13 @@ class LoopImpl {
   std::vector<std::string> subgraph_input_names_;
   std::vector<std::string> subgraph_output_names_;
 
-  // collection of OrtValue outputs from each loop iteration for the loop outputs.
-  // the order from the subgraph matches the order from the loop output
-  std::vector<std::vector<OrtValue>> loop_output_tensors_;
+  AllocatorPtr allocator_;
+
+  // two buffers per loop carried variable that the subgraph outputs alternate between
+  std::vector<std::array<OrtValue, 2>> loop_carried_buffers_;
+
+  // the Loop scan outputs. the order from the subgraph matches the order from the loop output
+  std::vector<LoopScanOutput> scan_outputs_;
 };
 
 Status Loop::Compute(OpKernelContext* ctx) const {
@@ -219,15 +377,20 @@ Status LoopImpl::Initialize() {
     }
   }
 
-  AllocatorPtr allocator;
-  status = context_.GetTempSpaceAllocator(&allocator);
+  status = context_.GetTempSpaceAllocator(&allocator_);
   ORT_RETURN_IF_ERROR(status);
 
   auto iter_num_rank = subgraph_inputs[0]->Shape()->dim_size();
   auto condition_rank = subgraph_inputs[1]->Shape()->dim_size();
 
-  iter_num_mlvalue_ = MakeScalarMLValue<int64_t>(allocator, 0, iter_num_rank);
-  condition_mlvalue_ = MakeScalarMLValue<bool>(allocator, condition_, condition_rank);
+  iter_num_mlvalue_ = MakeScalarMLValue<int64_t>(allocator_, 0, iter_num_rank);
+  condition_mlvalue_ = MakeScalarMLValue<bool>(allocator_, condition_, condition_rank);
+
+  // if the subgraph passes the condition straight through, the loop runs until the trip count is reached
+  // so the number of iterations is known upfront.
+  if (max_trip_count_ != INT64_MAX && subgraph_outputs[0]->Name() == subgraph_inputs[1]->Name()) {
+    trip_count_ = condition_ ? std::max<int64_t>(max_trip_count_, 0) : 0;
+  }
 
   subgraph_input_names_.reserve(num_subgraph_inputs_);
   for (int i = 0; i < num_subgraph_inputs_; ++i) {
@@ -235,13 +398,21 @@ Status LoopImpl::Initialize() {
   }
 
   subgraph_output_names_.reserve(num_subgraph_outputs);
-  loop_output_tensors_.resize(num_outputs_ - num_loop_carried_vars_);
 
   // save list of subgraph output names in their provided order to use when fetching the results
   // from each subgraph execution. the Loop outputs will match this order.
+  std::unordered_set<std::string> unique_output_names;
   for (size_t i = 0; i < num_subgraph_outputs; ++i) {
     auto& output = subgraph_outputs[i];
     subgraph_output_names_.push_back(output->Name());
+    has_duplicate_outputs_ |= !unique_output_names.insert(output->Name()).second;
+  }
+
+  loop_carried_buffers_.resize(num_loop_carried_vars_);
+
+  scan_outputs_.reserve(num_outputs_ - num_loop_carried_vars_);
+  for (int i = num_loop_carried_vars_; i < num_outputs_; ++i) {
+    scan_outputs_.emplace_back(context_, i, trip_count_, allocator_);
   }
 
   return status;
@@ -284,8 +455,7 @@ void LoopImpl::CreateInitialFeeds(std::vector<OrtValue>& feeds) {
   }
 }
 
-void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
-                                         std::vector<OrtValue>& next_inputs) {
+void LoopImpl::UpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs) {
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
@@ -293,48 +463,65 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
   for (int i = 1; i < num_subgraph_inputs_; ++i) {
     next_inputs[i] = last_outputs[i - 1];
   }
+}
 
-  // save loop outputs as we have to concatenate at the end
-  for (int j = num_loop_carried_vars_; j < num_outputs_; ++j) {
-    loop_output_tensors_[j - num_loop_carried_vars_].push_back(last_outputs[j + 1]);  // skip 'cond' in output
+void LoopImpl::CreateFetchAllocators(const FeedsFetchesManager& ffm, const std::vector<OrtValue>& feeds,
+                                     std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  // a custom allocator returns CPU memory so it can't be used if a subgraph output is produced on another device.
+  // if an output name is listed more than once, all of its fetches would share a single allocator.
+  if (ffm.GetDeviceCopyChecks().output_copy_needed != DeviceCopyCheck::NoCopy || has_duplicate_outputs_) {
+    return;
   }
-}
 
-Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
-  const auto& first_output = per_iteration_output.front().Get<Tensor>();
-  size_t bytes_per_iteration = first_output.Size();
-  const auto& per_iteration_shape = first_output.Shape();
-  const auto& per_iteration_dims = per_iteration_shape.GetDims();
+  // the subgraph output index is offset by 1 as the first output is the condition
+  for (int i = 0; i < num_loop_carried_vars_; ++i) {
+    fetch_allocators[i + 1] = [this, i, &feeds](const TensorShape& shape, OrtValue& ort_value) {
+      return AllocateLoopCarriedOutput(i, shape, feeds, ort_value);
+    };
+  }
 
-  // prepend number of iterations to the dimensions
-  auto num_iterations = gsl::narrow_cast<int64_t>(per_iteration_output.size());
-  std::vector<int64_t> dims{num_iterations};
-  std::copy(per_iteration_dims.cbegin(), per_iteration_dims.cend(), std::back_inserter(dims));
-  TensorShape output_shape{dims};
+  for (int i = num_loop_carried_vars_; i < num_outputs_; ++i) {
+    auto& scan_output = scan_outputs_[i - num_loop_carried_vars_];
+    fetch_allocators[i + 1] = [this, &scan_output](const TensorShape& shape, OrtValue& ort_value) {
+      return scan_output.AllocateIteration(CurrentIteration(), shape, ort_value);
+    };
+  }
+}
 
-  Tensor* output = context_.Output(output_index, output_shape);
+Status LoopImpl::AllocateLoopCarriedOutput(int index, const TensorShape& shape, const std::vector<OrtValue>& feeds,
+                                           OrtValue& ort_value) {
+  auto iteration = CurrentIteration();
 
-  // we can't easily use a C++ template for the tensor element type,
-  // so use a span for some protection but work in bytes
-  gsl::span<gsl::byte> output_span = gsl::make_span<gsl::byte>(static_cast<gsl::byte*>(output->MutableDataRaw()),
-                                                               output->Size());
+  // the last iteration can write directly to the Loop output if we know which iteration that is
+  if (iteration + 1 == trip_count_) {
+    if (!context_.Output(index, shape)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create output tensor for output #", index);
+    }
 
-  for (int64_t i = 0; i < num_iterations; ++i) {
-    auto& ort_value = per_iteration_output[i];
-    auto& iteration_data = ort_value.Get<Tensor>();
+    ort_value = *context_.GetOutputMLValue(index);
+    return Status::OK();
+  }
 
-    // sanity check
-    if (bytes_per_iteration != iteration_data.Size()) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output ", output_index,
-                             " Expected:", per_iteration_shape, " Got:", iteration_data.Shape());
+  // the output alternates between two buffers. the buffer written two iterations ago is free once the previous
+  // iteration has consumed it, unless the subgraph passed it through so it is also an input of this iteration.
+  auto is_feed = [this, &feeds](const OrtValue& value) {
+    const void* data = value.Get<Tensor>().DataRaw();
+    for (int i = 2; i < num_subgraph_inputs_; ++i) {
+      if (feeds[i].Get<Tensor>().DataRaw() == data) {
+        return true;
+      }
     }
+    return false;
+  };
 
-    auto num_bytes = iteration_data.Size();
-    auto src = gsl::make_span<const gsl::byte>(static_cast<const gsl::byte*>(iteration_data.DataRaw()), num_bytes);
-    auto dst = output_span.subspan(i * bytes_per_iteration, bytes_per_iteration);
-    gsl::copy(src, dst);
+  OrtValue& buffer = loop_carried_buffers_[index][iteration % 2];
+  if (!buffer.IsAllocated() || buffer.Get<Tensor>().Shape() != shape || is_feed(buffer)) {
+    auto* data_type = feeds[index + 2].Get<Tensor>().DataType();
+    auto tensor = std::make_unique<Tensor>(data_type, shape, allocator_);
+    buffer.Init(tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
   }
 
+  ort_value = buffer;
   return Status::OK();
 }
 
@@ -343,6 +530,11 @@ Status LoopImpl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* ca
 
   std::vector<OrtValue> feeds;
   std::vector<OrtValue> fetches;
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  bool fetch_allocators_created = false;
+
+  // the execution frame is re-used for all iterations after the first
+  std::unique_ptr<ExecutionFrame> frame;
 
   CreateInitialFeeds(feeds);
 
@@ -350,17 +542,21 @@ Status LoopImpl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* ca
 
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
-      SaveOutputsAndUpdateFeeds(fetches, feeds);
+      UpdateFeeds(fetches, feeds);
       fetches.clear();
     }
 
-    // loop carried variables can change shape across iterations, and we don't know how many iterations
-    // there will be to allocate loop outputs upfront. due to that we can't use a custom fetch allocator
-    // for any outputs
+    // the custom allocators depend on whether the subgraph outputs need copying across devices,
+    // which is known once the FeedsFetchesManager has cached the result of the first execution
+    if (!fetch_allocators_created && cached_ffm) {
+      CreateFetchAllocators(*cached_ffm, feeds, fetch_allocators);
+      fetch_allocators_created = true;
+    }
+
     if (cached_ffm) {
-      status = utils::ExecuteGraphWithCachedInfo(session_state_, *cached_ffm, feeds, fetches, {},
+      status = utils::ExecuteGraphWithCachedInfo(session_state_, *cached_ffm, feeds, fetches, fetch_allocators,
                                                  /*sequential_execution*/ true, context_.GetTerminateFlag(),
-                                                 context_.Logger());
+                                                 context_.Logger(), &frame);
     } else {
       status = utils::ExecuteGraph(session_state_, *ffm, feeds, fetches, {},
                                    /*sequential_execution*/ true, context_.GetTerminateFlag(), context_.Logger(),
@@ -374,14 +570,23 @@ Status LoopImpl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* ca
 
     condition_mlvalue_ = fetches[0];
 
+    for (int i = num_loop_carried_vars_; i < num_outputs_; ++i) {
+      status = scan_outputs_[i - num_loop_carried_vars_].SaveIteration(iter_num_value, fetches[i + 1]);  // skip cond
+      ORT_RETURN_IF_ERROR(status);
+    }
+
     ++iter_num_value;
   }
 
-  // As the loop carried variables may change shape across iterations there's no way to avoid a copy
-  // as we need the final shape.
+  // As the loop carried variables may change shape across iterations we need a copy to the Loop output unless
+  // the last iteration was able to write to it directly.
   auto copy_tensor_from_mlvalue_to_output = [this](const OrtValue& input, int output_idx) {
     auto& data = input.Get<Tensor>();
     Tensor* output = context_.Output(output_idx, data.Shape());
+    if (output->DataRaw() == data.DataRaw()) {
+      return;
+    }
+
     auto src = gsl::make_span<const gsl::byte>(static_cast<const gsl::byte*>(data.DataRaw()), data.Size());
     auto dst = gsl::make_span<gsl::byte>(static_cast<gsl::byte*>(output->MutableDataRaw()), output->Size());
     gsl::copy(src, dst);
@@ -395,11 +600,7 @@ Status LoopImpl::Execute(FeedsFetchesManager* ffm, const FeedsFetchesManager* ca
     }
 
     for (int i = num_loop_carried_vars_; i < num_outputs_; ++i) {
-      // add last output
-      auto& per_iteration_outputs = loop_output_tensors_[i - num_loop_carried_vars_];
-      per_iteration_outputs.push_back(fetches[i + 1]);  // skip cond
-
-      ORT_RETURN_IF_ERROR(ConcatenateLoopOutput(per_iteration_outputs, i));
+      ORT_RETURN_IF_ERROR(scan_outputs_[i - num_loop_carried_vars_].Finalize(iter_num_value));
     }
   } else {
     // no iterations.
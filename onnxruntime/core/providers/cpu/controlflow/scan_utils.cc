@@ -13,6 +13,7 @@
 
 #include "gsl/gsl_algorithm"
 
+#include "core/framework/execution_frame.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
@@ -147,6 +148,9 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
   std::vector<OrtValue> fetches;
   std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
+  // the execution frame is re-used for all iterations after the first
+  std::unique_ptr<ExecutionFrame> frame;
+
   feeds.resize(num_inputs);
   fetches.resize(num_variadic_outputs);
 
@@ -204,7 +208,7 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
     if (cached_ffm) {
       status = utils::ExecuteGraphWithCachedInfo(session_state, *cached_ffm, feeds, fetches, fetch_allocators,
                                                  /*sequential_execution*/ true, context.GetTerminateFlag(),
-                                                 context.Logger());
+                                                 context.Logger(), &frame);
     } else {
       status = utils::ExecuteGraph(session_state, *ffm, feeds, fetches, fetch_allocators,
                                    /*sequential_execution*/ true, context.GetTerminateFlag(), context.Logger(),
@@ -13,6 +13,9 @@ namespace onnxruntime {
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
 
+  // quantize the activations of MatMul/Gemm/LSTM/GRU per call and use integer GEMM with constant int8 weights
+  bool enable_dynamic_quantization{false};
+
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
 
@@ -26,7 +29,8 @@ using FuseRuleFn = std::function<void(const onnxruntime::GraphViewer&,
 class CPUExecutionProvider : public IExecutionProvider {
  public:
   explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info)
-      : IExecutionProvider{onnxruntime::kCpuExecutionProvider} {
+      : IExecutionProvider{onnxruntime::kCpuExecutionProvider},
+        enable_dynamic_quantization_{info.enable_dynamic_quantization} {
     DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
                                                 [](int) { return std::make_unique<CPUAllocator>(); },
                                                 std::numeric_limits<size_t>::max()};
@@ -52,8 +56,10 @@ class CPUExecutionProvider : public IExecutionProvider {
 
   std::shared_ptr<KernelRegistry> GetKernelRegistry() const override;
 
+  bool DynamicQuantizationEnabled() const { return enable_dynamic_quantization_; }
 
  private:
   std::vector<FuseRuleFn> fuse_rules_;
+  bool enable_dynamic_quantization_;
 };
 }  // namespace onnxruntime
@@ -9,28 +9,32 @@
 namespace onnxruntime {
 
 struct CpuProviderFactory : IExecutionProviderFactory {
-  CpuProviderFactory(bool create_arena) : create_arena_(create_arena) {}
+  CpuProviderFactory(bool create_arena, bool enable_dynamic_quantization)
+      : create_arena_(create_arena), enable_dynamic_quantization_(enable_dynamic_quantization) {}
   ~CpuProviderFactory() override = default;
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
 
  private:
   bool create_arena_;
+  bool enable_dynamic_quantization_;
 };
 
 std::unique_ptr<IExecutionProvider> CpuProviderFactory::CreateProvider() {
   CPUExecutionProviderInfo info;
   info.create_arena = create_arena_;
+  info.enable_dynamic_quantization = enable_dynamic_quantization_;
   return std::make_unique<CPUExecutionProvider>(info);
 }
 
-std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena) {
-  return std::make_shared<onnxruntime::CpuProviderFactory>(use_arena != 0);
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena, bool enable_dynamic_quantization) {
+  return std::make_shared<onnxruntime::CpuProviderFactory>(use_arena != 0, enable_dynamic_quantization);
 }
 
 }  // namespace onnxruntime
 
 ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_CPU, _In_ OrtSessionOptions* options, int use_arena) {
-  options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_CPU(use_arena));
+  options->provider_factories.push_back(
+      onnxruntime::CreateExecutionProviderFactory_CPU(use_arena, options->value.enable_dynamic_quantization));
   return nullptr;
 }
 
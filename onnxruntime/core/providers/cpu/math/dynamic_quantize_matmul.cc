@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/math/dynamic_quantize_matmul.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/mlas/inc/mlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace onnxruntime {
+namespace dynamic_quantization {
+
+bool IsEnabled(const OpKernelInfo& info) {
+  const auto* provider = info.GetExecutionProvider();
+  return provider != nullptr &&
+         provider->Type() == kCpuExecutionProvider &&
+         static_cast<const CPUExecutionProvider*>(provider)->DynamicQuantizationEnabled();
+}
+
+void QuantizeWeights(const float* B, size_t K, size_t N, size_t ldb, bool trans_b,
+                     const AllocatorPtr& allocator, DynamicQuantizedWeights& weights) {
+  auto element = [&](size_t k, size_t n) { return trans_b ? B[n * ldb + k] : B[k * ldb + n]; };
+
+  float max_abs = 0.0f;
+  for (size_t k = 0; k < K; k++) {
+    for (size_t n = 0; n < N; n++) {
+      max_abs = std::max(max_abs, std::abs(element(k, n)));
+    }
+  }
+
+  // symmetric quantization keeps the zero point of B at 0, so no column sums are needed at run time
+  const float scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+
+  std::vector<int8_t> quantized(K * N);
+  for (size_t k = 0; k < K; k++) {
+    for (size_t n = 0; n < N; n++) {
+      quantized[k * N + n] = static_cast<int8_t>(std::max(-127.0f, std::min(127.0f, std::round(element(k, n) / scale))));
+    }
+  }
+
+  weights.packed_b = BufferUniquePtr(allocator->Alloc(MlasQgemmPackBSize(N, K)), BufferDeleter(allocator));
+  MlasQgemmPackB(N, K, quantized.data(), N, static_cast<int8_t>(0), weights.packed_b.get());
+  weights.scale = scale;
+  weights.N = N;
+  weights.K = K;
+}
+
+void Gemm(size_t M, float alpha, const float* A, size_t lda, const DynamicQuantizedWeights& B,
+          float beta, float* C, size_t ldc, const AllocatorPtr& allocator,
+          concurrency::ThreadPool* thread_pool) {
+  const size_t N = B.N;
+  const size_t K = B.K;
+
+  if (M == 0 || N == 0) {
+    return;
+  }
+
+  // the range always includes zero so that zero padding is exactly representable
+  float min_value = 0.0f;
+  float max_value = 0.0f;
+  for (size_t m = 0; m < M; m++) {
+    const float* a = A + m * lda;
+    for (size_t k = 0; k < K; k++) {
+      min_value = std::min(min_value, a[k]);
+      max_value = std::max(max_value, a[k]);
+    }
+  }
+
+  const float a_scale = max_value > min_value ? (max_value - min_value) / 255.0f : 1.0f;
+  const auto a_zero_point = static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, std::round(-min_value / a_scale))));
+
+  BufferUniquePtr a_buffer(allocator->Alloc(sizeof(uint8_t) * M * K), BufferDeleter(allocator));
+  BufferUniquePtr c_buffer(allocator->Alloc(sizeof(int32_t) * M * N), BufferDeleter(allocator));
+  auto* quantized_a = static_cast<uint8_t*>(a_buffer.get());
+  auto* gemm_output = static_cast<int32_t*>(c_buffer.get());
+
+  for (size_t m = 0; m < M; m++) {
+    const float* a = A + m * lda;
+    uint8_t* qa = quantized_a + m * K;
+    for (size_t k = 0; k < K; k++) {
+      qa[k] = static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, std::round(a[k] / a_scale) + a_zero_point)));
+    }
+  }
+
+  MlasQgemmPacked(M, N, K, quantized_a, K, a_zero_point, B.packed_b.get(), gemm_output, N, thread_pool);
+
+  const float multiplier = alpha * a_scale * B.scale;
+  for (size_t m = 0; m < M; m++) {
+    const int32_t* acc = gemm_output + m * N;
+    float* c = C + m * ldc;
+    if (beta == 0.0f) {
+      for (size_t n = 0; n < N; n++) {
+        c[n] = multiplier * static_cast<float>(acc[n]);
+      }
+    } else {
+      for (size_t n = 0; n < N; n++) {
+        c[n] = multiplier * static_cast<float>(acc[n]) + beta * c[n];
+      }
+    }
+  }
+}
+
+}  // namespace dynamic_quantization
+}  // namespace onnxruntime
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Float weights quantized once to symmetric int8 and packed for the integer GEMM.
+struct DynamicQuantizedWeights {
+  BufferUniquePtr packed_b;
+  float scale = 0.0f;
+  size_t N = 0;
+  size_t K = 0;
+
+  bool IsQuantized() const { return packed_b != nullptr; }
+};
+
+namespace dynamic_quantization {
+
+// Returns true if the session enabled dynamic quantization for the execution provider of this kernel.
+bool IsEnabled(const OpKernelInfo& info);
+
+// Quantizes and packs B, which is K x N, or N x K if trans_b is set, with a row stride of ldb.
+void QuantizeWeights(const float* B, size_t K, size_t N, size_t ldb, bool trans_b,
+                     const AllocatorPtr& allocator, DynamicQuantizedWeights& weights);
+
+// Computes C = alpha * A * B + beta * C, where A (M x K) is quantized to uint8 over its own min/max range on every
+// call, multiplied with the pre-quantized B using the integer GEMM, and the int32 result is dequantized into C.
+void Gemm(size_t M, float alpha, const float* A, size_t lda, const DynamicQuantizedWeights& B,
+          float beta, float* C, size_t ldc, const AllocatorPtr& allocator,
+          concurrency::ThreadPool* thread_pool);
+
+}  // namespace dynamic_quantization
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include <unsupported/Eigen/SpecialFunctions>
+#include "core/framework/op_kernel_context_internal.h"
 #include "core/util/math.h"
 #include "core/mlas/inc/mlas.h"
 
@@ -389,7 +390,8 @@ Status Sqrt<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).cwiseSqrt();
+  MlasComputeTranscendental(MlasSqrtFunction, X.template Data<float>(), Y.template MutableData<float>(),
+                            X.Shape().Size(), GetOperatorThreadPool(ctx));
 
   return Status::OK();
 }
@@ -420,7 +422,8 @@ Status Exp<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().exp();
+  MlasComputeTranscendental(MlasExpFunction, X.template Data<float>(), Y.template MutableData<float>(),
+                            X.Shape().Size(), GetOperatorThreadPool(ctx));
 
   return Status::OK();
 }
@@ -430,7 +433,8 @@ Status Log<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().log();
+  MlasComputeTranscendental(MlasLogFunction, X.template Data<float>(), Y.template MutableData<float>(),
+                            X.Shape().Size(), GetOperatorThreadPool(ctx));
 
   return Status::OK();
 }
@@ -1021,7 +1025,8 @@ Status Erf<float>::Compute(OpKernelContext* context) const {
   auto& X = *X_ptr;
   auto& Y = *context->Output(0, X.Shape());
 
-  MlasComputeErf(X.template Data<float>(), Y.template MutableData<float>(), X.Shape().Size());
+  MlasComputeTranscendental(MlasErfFunction, X.template Data<float>(), Y.template MutableData<float>(),
+                            X.Shape().Size(), GetOperatorThreadPool(context));
 
   return Status::OK();
 }
@@ -5,6 +5,8 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/providers/cpu/math/dynamic_quantize_matmul.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
@@ -27,6 +29,20 @@ class Gemm : public OpKernel {
 
     ORT_ENFORCE(info.GetAttr<float>("alpha", &alpha_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
+
+    // quantize a constant W once if the session enabled dynamic quantization
+    const Tensor* W;
+    if (std::is_same<T_X, float>::value && std::is_same<T_W, float>::value && std::is_same<T_Y, float>::value &&
+        trans_A_ == CblasNoTrans &&
+        dynamic_quantization::IsEnabled(info) &&
+        info.TryGetConstantInput(1, &W) &&
+        W->Shape().NumDimensions() == 2) {
+      const auto K = static_cast<size_t>(W->Shape()[trans_B_ == CblasNoTrans ? 0 : 1]);
+      const auto N = static_cast<size_t>(W->Shape()[trans_B_ == CblasNoTrans ? 1 : 0]);
+      dynamic_quantization::QuantizeWeights(reinterpret_cast<const float*>(W->template Data<T_W>()),
+                                            K, N, static_cast<size_t>(W->Shape()[1]), trans_B_ != CblasNoTrans,
+                                            info.GetAllocator(0, OrtMemTypeDefault), quantized_w_);
+    }
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -94,6 +110,21 @@ class Gemm : public OpKernel {
       }
     }
 
+    if (quantized_w_.IsQuantized()) {
+      AllocatorPtr alloc;
+      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+      auto* thread_pool = GetOperatorThreadPool(context);
+
+      dynamic_quantization::Gemm(static_cast<size_t>(M), alpha_,
+                                 reinterpret_cast<const float*>(X->template Data<T_X>()), static_cast<size_t>(K),
+                                 quantized_w_, beta_, reinterpret_cast<float*>(y_data), static_cast<size_t>(N),
+                                 alloc, thread_pool);
+
+      FuseActivation<T_Y>(activation_, y_data, M * N, leaky_relu_alpha_);
+
+      return Status::OK();
+    }
+
     // W * x
     math::Gemm<T_X, CPUMathUtil>(
         trans_A_,
@@ -118,6 +149,7 @@ class Gemm : public OpKernel {
   CBLAS_TRANSPOSE trans_B_;
   float alpha_;
   float beta_;
+  DynamicQuantizedWeights quantized_w_;
 
 protected:
   // For fused gemm + activation
@@ -5,10 +5,55 @@
 
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/framework/op_kernel_context_internal.h"
 #include "matmul_helper.h"
 
 namespace onnxruntime {
 
+template <typename T>
+void MatMul<T>::QuantizeConstantB(const OpKernelInfo&) {
+}
+
+template <>
+void MatMul<float>::QuantizeConstantB(const OpKernelInfo& info) {
+  const Tensor* b;
+  if (!dynamic_quantization::IsEnabled(info) ||
+      !info.TryGetConstantInput(1, &b) ||
+      b->Shape().NumDimensions() != 2) {
+    return;
+  }
+
+  const auto K = static_cast<size_t>(b->Shape()[0]);
+  const auto N = static_cast<size_t>(b->Shape()[1]);
+  dynamic_quantization::QuantizeWeights(b->Data<float>(), K, N, N, false,
+                                        info.GetAllocator(0, OrtMemTypeDefault), quantized_b_);
+}
+
+template <typename T>
+Status MatMul<T>::ComputeDynamicQuantized(OpKernelContext*, const Tensor&, Tensor&,
+                                          const std::vector<size_t>&, const std::vector<size_t>&, size_t) const {
+  return Status(common::ONNXRUNTIME, common::NOT_IMPLEMENTED, "Dynamic quantization requires float MatMul");
+}
+
+template <>
+Status MatMul<float>::ComputeDynamicQuantized(OpKernelContext* ctx, const Tensor& A, Tensor& Y,
+                                              const std::vector<size_t>& left_offsets,
+                                              const std::vector<size_t>& output_offsets,
+                                              size_t M) const {
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  auto* thread_pool = GetOperatorThreadPool(ctx);
+
+  for (size_t i = 0; i < output_offsets.size(); i++) {
+    dynamic_quantization::Gemm(M, 1.0f, A.Data<float>() + left_offsets[i], quantized_b_.K, quantized_b_,
+                               0.0f, Y.MutableData<float>() + output_offsets[i], quantized_b_.N,
+                               alloc, thread_pool);
+  }
+
+  return Status::OK();
+}
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
     1, 9,
@@ -61,6 +106,11 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
 
   Tensor* Y = ctx->Output(0, helper.OutputShape());
 
+  if (quantized_b_.IsQuantized()) {
+    return ComputeDynamicQuantized(ctx, *left_X, *Y, helper.LeftOffsets(), helper.OutputOffsets(),
+                                   static_cast<size_t>(helper.M()));
+  }
+
   // TODO: replace it with GemmBatch for performance, it's OK for now as GemmBatch unrolls as well
   size_t max_len = helper.OutputOffsets().size();
   for (size_t i = 0; i < max_len; i++) {
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/dynamic_quantize_matmul.h"
 
 namespace onnxruntime {
 
@@ -13,9 +14,21 @@ class MatMul final : public OpKernel {
  public:
   MatMul(const OpKernelInfo& info)
       : OpKernel(info) {
+    QuantizeConstantB(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Quantizes a constant 2-D B once if the session enabled dynamic quantization.
+  void QuantizeConstantB(const OpKernelInfo& info);
+
+  Status ComputeDynamicQuantized(OpKernelContext* context, const Tensor& A, Tensor& Y,
+                                 const std::vector<size_t>& left_offsets,
+                                 const std::vector<size_t>& output_offsets,
+                                 size_t M) const;
+
+  DynamicQuantizedWeights quantized_b_;
 };
 
 }  // namespace onnxruntime
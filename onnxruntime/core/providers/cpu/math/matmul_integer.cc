@@ -1,22 +1,19 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#ifdef _MSC_VER
-#pragma warning(disable : 4244)
-#pragma warning(disable : 4267)
-#endif
-
 #include "core/providers/cpu/math/matmul_integer.h"
 #include "core/providers/cpu/math/matmul_helper.h"
-#include "core/util/gemmlowp_common_wrapper.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
 // only register this operator if low precision computation is enabled.
-ONNX_OPERATOR_KERNEL_EX(
+ONNX_OPERATOR_TYPED_KERNEL_EX(
     MatMulInteger,
     kOnnxDomain,
     10,
+    uint8_t,
     kCpuExecutionProvider,
     KernelDefBuilder()
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
@@ -24,63 +21,112 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     MatMulInteger<uint8_t, uint8_t, int32_t>);
 
-Status GemmlowpMultiply(const uint8_t* lhs_data, const uint8_t* rhs_data,
-                        int32_t* result_data, const int lhs_offset, const int rhs_offset,
-                        int m, int n, int k) {
-  const std::tuple<> empty_pipeline = {};
-  // TODO exp ColMajor order for rhs and result. That may be faster
-  const auto matOrder = gemmlowp::MapOrder::RowMajor;
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> lhs(lhs_data, m, k);
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> rhs(rhs_data, k, n);
-  gemmlowp::MatrixMap<std::int32_t, matOrder> result(result_data, m, n);
-
-  gemmlowp::GemmContext gemm_context;
-  gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::int32_t,
-                                   gemmlowp::DefaultL8R8BitDepthParams>(
-      &gemm_context, lhs, rhs, &result, -lhs_offset, -rhs_offset, empty_pipeline);
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MatMulInteger,
+    kOnnxDomain,
+    10,
+    int8_t,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
+    MatMulInteger<uint8_t, int8_t, int32_t>);
 
-  return Status::OK();
+namespace {
+template <typename T>
+T GetZeroPoint(const Tensor* zero_point) {
+  ORT_ENFORCE(zero_point->Shape().NumDimensions() == 0 ||
+                  (zero_point->Shape().NumDimensions() == 1 && zero_point->Shape().GetDims().size() == 1),
+              "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
+  return *zero_point->template Data<T>();
 }
+}  // namespace
+
+template <typename T1, typename T2, typename T3>
+void MatMulInteger<T1, T2, T3>::PackConstantB(const OpKernelInfo& info) {
+  const Tensor* b;
+  if (!info.TryGetConstantInput(1, &b) || b->Shape().NumDimensions() != 2) {
+    return;
+  }
 
-template<>
-Status MatMulInteger<uint8_t, uint8_t, int32_t>::Compute(OpKernelContext* ctx) const {
+  // the zero point of B is folded into the packed buffer
+  T2 b_offset = 0;
+  if (has_b_zero_point_) {
+    const Tensor* b_zero_point;
+    if (!info.TryGetConstantInput(3, &b_zero_point)) {
+      return;
+    }
+    b_offset = GetZeroPoint<T2>(b_zero_point);
+  }
+
+  const size_t K = static_cast<size_t>(b->Shape()[0]);
+  const size_t N = static_cast<size_t>(b->Shape()[1]);
+
+  auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  packed_b_ = BufferUniquePtr(alloc->Alloc(MlasQgemmPackBSize(N, K)), BufferDeleter(alloc));
+  MlasQgemmPackB(N, K, b->template Data<T2>(), N, b_offset, packed_b_.get());
+  packed_b_shape_ = b->Shape();
+}
+
+template <typename T1, typename T2, typename T3>
+Status MatMulInteger<T1, T2, T3>::Compute(OpKernelContext* ctx) const {
   auto a = ctx->Input<Tensor>(0);
   auto b = ctx->Input<Tensor>(1);
   ORT_ENFORCE(a != nullptr && b != nullptr);
 
+  // the packed buffer was built from the initializer's shape, so B must still match it
+  if (packed_b_ && b->Shape() != packed_b_shape_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "MatMulInteger: B shape ", b->Shape(),
+                           " does not match the prepacked shape ", packed_b_shape_);
+  }
+
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
   // validate zero points
-  int32_t a_offset = 0;
-  int32_t b_offset = 0;
+  T1 a_offset = 0;
+  T2 b_offset = 0;
   if (has_a_zero_point_) {
-    auto a_zero_point = ctx->Input<Tensor>(2);
-    ORT_ENFORCE(a_zero_point->Shape().NumDimensions() == 0 ||
-        (a_zero_point->Shape().NumDimensions() == 1 && a_zero_point->Shape().GetDims().size() == 1),
-        "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
-    a_offset = static_cast<int32_t>(*a_zero_point->template Data<uint8_t>());
+    a_offset = GetZeroPoint<T1>(ctx->Input<Tensor>(2));
   }
   if (has_b_zero_point_) {
-    auto b_zero_point = ctx->Input<Tensor>(3);
-    ORT_ENFORCE(b_zero_point->Shape().NumDimensions() == 0 ||
-        (b_zero_point->Shape().NumDimensions() == 1 && b_zero_point->Shape().GetDims().size() == 1),
-        "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
-    b_offset = static_cast<int32_t>(*b_zero_point->template Data<uint8_t>());
+    b_offset = GetZeroPoint<T2>(ctx->Input<Tensor>(3));
   }
 
+  auto* thread_pool = GetOperatorThreadPool(ctx);
+
   for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
-    GemmlowpMultiply(a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                     b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                     y->template MutableData<int32_t>() + helper.OutputOffsets()[i],
-                     a_offset,
-                     b_offset,
-                     static_cast<int>(helper.M()),
-                     static_cast<int>(helper.N()),
-                     static_cast<int>(helper.K()));
+    if (packed_b_) {
+      MlasQgemmPacked(static_cast<size_t>(helper.M()),
+                      static_cast<size_t>(helper.N()),
+                      static_cast<size_t>(helper.K()),
+                      a->template Data<T1>() + helper.LeftOffsets()[i],
+                      static_cast<size_t>(helper.K()),
+                      a_offset,
+                      packed_b_.get(),
+                      y->template MutableData<T3>() + helper.OutputOffsets()[i],
+                      static_cast<size_t>(helper.N()),
+                      thread_pool);
+    } else {
+      MlasQgemm(static_cast<size_t>(helper.M()),
+                static_cast<size_t>(helper.N()),
+                static_cast<size_t>(helper.K()),
+                a->template Data<T1>() + helper.LeftOffsets()[i],
+                static_cast<size_t>(helper.K()),
+                a_offset,
+                b->template Data<T2>() + helper.RightOffsets()[i],
+                static_cast<size_t>(helper.N()),
+                b_offset,
+                y->template MutableData<T3>() + helper.OutputOffsets()[i],
+                static_cast<size_t>(helper.N()),
+                thread_pool);
+    }
   }
 
   return Status::OK();
 }
+
 }  // namespace onnxruntime
@@ -21,12 +21,18 @@ class MatMulInteger final : public OpKernel {
     if (info.GetInputCount() > 3) {
       has_b_zero_point_ = true;
     }
+    PackConstantB(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  // Packs a constant 2-D B (and its zero point) once for reuse by every Compute.
+  void PackConstantB(const OpKernelInfo& info);
+
   bool has_a_zero_point_;
   bool has_b_zero_point_;
+  BufferUniquePtr packed_b_;
+  TensorShape packed_b_shape_;
 };
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -8,7 +8,8 @@
 
 #include "core/providers/cpu/math/quantize_linear_matmul.h"
 #include "core/providers/cpu/math/matmul_helper.h"
-#include "core/util/gemmlowp_common_wrapper.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -24,30 +25,6 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>()),
     QLinearMatMul<uint8_t, uint8_t, uint8_t>);
 
-Status GemmlowpMultiply(const uint8_t* lhs_data, const uint8_t* rhs_data, uint8_t* result_data,
-                        const int lhs_offset, const int rhs_offset, const int result_offset,
-                        int m, int n, int k, int32_t int_multiplier, int32_t right_shift) {
-  gemmlowp::OutputStageQuantizeDownInt32ByFixedPoint quantize_down_stage;
-  quantize_down_stage.result_offset_after_shift = result_offset;
-  quantize_down_stage.result_fixedpoint_multiplier = int_multiplier;
-  quantize_down_stage.result_shift = right_shift;
-  gemmlowp::OutputStageSaturatingCastToUint8 saturating_cast_stage;
-  const auto& output_pipeline = std::make_tuple(quantize_down_stage, saturating_cast_stage);
-
-  // TODO exp ColMajor order for rhs and result. That may be faster
-  const auto matOrder = gemmlowp::MapOrder::RowMajor;
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> lhs(lhs_data, m, k);
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> rhs(rhs_data, k, n);
-  gemmlowp::MatrixMap<std::uint8_t, matOrder> result(result_data, m, n);
-
-  gemmlowp::GemmContext gemm_context;
-  gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::uint8_t,
-                                   gemmlowp::DefaultL8R8BitDepthParams>(
-      &gemm_context, lhs, rhs, &result, -lhs_offset, -rhs_offset, output_pipeline);
-
-  return Status::OK();
-}
-
 void QuantizeMultiplier(float fp_multiplier, std::int32_t* integer_multiplier, int* right_shift) {
   auto* fp_as_bits = reinterpret_cast<uint32_t*>(&fp_multiplier);
   auto current_exponent = (*fp_as_bits >> 23);
@@ -102,18 +79,38 @@ Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) c
   int right_shift;
   QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
 
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  // the 32-bit GEMM output for one matrix is requantized into Y
+  auto gemm_output_data = alloc->Alloc(sizeof(int32_t) * static_cast<size_t>(helper.M() * helper.N()));
+  BufferUniquePtr gemm_output_buffer(gemm_output_data, BufferDeleter(alloc));
+  auto* gemm_output = static_cast<int32_t*>(gemm_output_buffer.get());
+
+  auto* thread_pool = GetOperatorThreadPool(ctx);
+
   for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
-    GemmlowpMultiply(a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                     b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                     y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
-                     *a_zero_point->template Data<uint8_t>(),
-                     *b_zero_point->template Data<uint8_t>(),
-                     *y_zero_point->template Data<uint8_t>(),
-                     static_cast<int>(helper.M()),
-                     static_cast<int>(helper.N()),
-                     static_cast<int>(helper.K()),
-                     integer_multiplier,
-                     right_shift);
+    MlasQgemm(static_cast<size_t>(helper.M()),
+              static_cast<size_t>(helper.N()),
+              static_cast<size_t>(helper.K()),
+              a->template Data<uint8_t>() + helper.LeftOffsets()[i],
+              static_cast<size_t>(helper.K()),
+              *a_zero_point->template Data<uint8_t>(),
+              b->template Data<uint8_t>() + helper.RightOffsets()[i],
+              static_cast<size_t>(helper.N()),
+              *b_zero_point->template Data<uint8_t>(),
+              gemm_output,
+              static_cast<size_t>(helper.N()),
+              thread_pool);
+
+    MlasRequantizeOutput(gemm_output,
+                         y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
+                         nullptr,
+                         static_cast<size_t>(helper.M()),
+                         static_cast<size_t>(helper.N()),
+                         integer_multiplier,
+                         right_shift,
+                         *y_zero_point->template Data<uint8_t>());
   }
 
   return Status::OK();
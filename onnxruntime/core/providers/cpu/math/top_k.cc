@@ -19,9 +19,10 @@
 #include "core/common/common.h"
 #include "core/common/exceptions.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/tensor.h"
-#include "core/util/math_cpuonly.h"
-#include <queue>
+#include "core/platform/threadpool.h"
+#include <algorithm>
 using namespace std;
 namespace onnxruntime {
 
@@ -44,17 +45,80 @@ static int64_t SizeFromDim(size_t k, const vector<int64_t>& dims) {
   return r;
 }
 
+// Orders (value, index) pairs by descending value, with ties going to the smaller index.
 template <typename T>
 struct ValueCmp {
   bool operator()(
       const pair<T, int64_t>& lhs,
-      const pair<T, int64_t>& rhs) {
+      const pair<T, int64_t>& rhs) const {
     return (
         lhs.first > rhs.first ||
         (lhs.first == rhs.first && lhs.second < rhs.second));
   }
 };
 
+// A bounded heap rejects most elements with a single comparison against its top when k is small relative to the
+// axis, a selection in linear time is cheaper for larger k, and when almost every element is kept a full sort
+// avoids the selection pass altogether.
+static constexpr int64_t kTopKHeapMaxRatio = 64;
+
+// Selects the k largest of the n strided elements of 'input' and writes them to 'values' and 'indices', which have
+// the same stride, in descending order.
+template <typename T>
+static void SelectTopK(const T* input, int64_t n, int64_t stride, int64_t k,
+                       T* values, int64_t* indices, vector<pair<T, int64_t>>& scratch) {
+  const ValueCmp<T> cmp;
+
+  if (k == 1) {
+    int64_t max_index = 0;
+    T max_value = input[0];
+    for (int64_t l = 1; l < n; ++l) {
+      const T value = input[l * stride];
+      if (value > max_value) {
+        max_value = value;
+        max_index = l;
+      }
+    }
+    values[0] = max_value;
+    indices[0] = max_index;
+    return;
+  }
+
+  scratch.clear();
+  if (k * kTopKHeapMaxRatio <= n) {
+    // Min-heap of the k largest values seen so far. Indices increase as the axis is scanned, so a later element only
+    // displaces the top if its value is strictly greater.
+    for (int64_t l = 0; l < k; ++l) {
+      scratch.emplace_back(input[l * stride], l);
+    }
+    std::make_heap(scratch.begin(), scratch.end(), cmp);
+    for (int64_t l = k; l < n; ++l) {
+      const T value = input[l * stride];
+      if (value > scratch.front().first) {
+        std::pop_heap(scratch.begin(), scratch.end(), cmp);
+        scratch.back() = {value, l};
+        std::push_heap(scratch.begin(), scratch.end(), cmp);
+      }
+    }
+    std::sort_heap(scratch.begin(), scratch.end(), cmp);
+  } else {
+    for (int64_t l = 0; l < n; ++l) {
+      scratch.emplace_back(input[l * stride], l);
+    }
+    if (k * 8 >= n * 7) {
+      std::sort(scratch.begin(), scratch.end(), cmp);
+    } else {
+      std::nth_element(scratch.begin(), scratch.begin() + (k - 1), scratch.end(), cmp);
+      std::sort(scratch.begin(), scratch.begin() + k, cmp);
+    }
+  }
+
+  for (int64_t l = 0; l < k; ++l) {
+    values[l * stride] = scratch[l].first;
+    indices[l * stride] = scratch[l].second;
+  }
+}
+
 // Core TopK implementation
 Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* X, const int axis, const unsigned k) {
 
@@ -76,13 +140,6 @@ Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* X, const int
     return Status::OK();
   }
 
-  const int64_t rows = SizeToDim(axis_parsed, in_dims);
-  const int64_t cols = X->Shape().Size() / rows;
-  auto input_map = ConstEigenMatrixMapRowMajor<float>(
-      static_cast<const float*>(X->template Data<float>()),
-      rows,
-      cols);
-
   // Resize output tensors to be the same shape as the input except
   // for the specified dimension ((i.e.) axis_parsed), which will be of size k. E.x. for an input tensor
   // of shape [3, 4, 5] and k=2 with axis_parsed=1, both of these will be shape [3, 2, 5]
@@ -91,46 +148,34 @@ Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* X, const int
   auto* Values = p_op_kernel_context->Output(0, output_linear_shape);
   auto* Indices = p_op_kernel_context->Output(1, output_linear_shape);
 
-  // Use Eigen maps to allow indexing into the 2d tensors like Values_map(i,j)
-  const int64_t reduced_cols = SizeFromDim(axis_parsed, output_linear_shape);
-  auto Values_map = EigenMatrixMapRowMajor<float>(
-      Values->template MutableData<float>(), rows, reduced_cols);
-  auto Indices_map = EigenMatrixMapRowMajor<int64_t>(
-      Indices->template MutableData<int64_t>(), rows, reduced_cols);
+  const int64_t rows = SizeToDim(axis_parsed, in_dims);
+  if (rows == 0 || Values->Shape().Size() == 0) {
+    return Status::OK();
+  }
 
+  const int64_t axis_dim = in_dims[axis_parsed];
   // This is basically the number of elements within each of the "k" rows
-  const int64_t block_slice = reduced_cols / k;
-  // Sort preserving Indices
-  for (int64_t i = 0; i < rows; ++i) {
-    for (int64_t j = 0; j < block_slice; ++j) {
-      // Build a min-heap, the heap element is pair of (value, idx)
-      // the top of the heap is the smallest value
-      priority_queue<
-          pair<float, int64_t>,
-          vector<pair<float, int64_t>>,
-          ValueCmp<float>>
-          min_heap;
-      // Maintain the size of heap to be less or equal to k_, so the
-      // heap will hold the k largest Values
-      for (int64_t l = 0; l < in_dims[axis_parsed]; ++l) {
-        const auto value = input_map(i, l * block_slice + j);
-        if (min_heap.size() < k || value > min_heap.top().first) {
-          min_heap.push({value, l});
-        }
-        if (min_heap.size() > k) {
-          min_heap.pop();
-        }
-      }
-      // Extract these k elements and place them in the results placeholder
-      for (int64_t l = 0; l < k; ++l) {
-        auto& pqElem = min_heap.top();
-        auto col_index = (k - l - 1) * block_slice + j;
-        Values_map(i, col_index) = pqElem.first;
-        Indices_map(i, col_index) = pqElem.second;
-        min_heap.pop();
-      }
+  const int64_t block_slice = SizeFromDim(axis_parsed + 1, in_dims);
+  const int64_t num_slices = rows * block_slice;
+
+  const float* input = X->template Data<float>();
+  float* values = Values->template MutableData<float>();
+  int64_t* indices = Indices->template MutableData<int64_t>();
+
+  // the selection of each (row, j) slice along the axis reuses one scratch buffer per block of slices
+  auto select_slices = [&](int64_t first, int64_t last) {
+    vector<pair<float, int64_t>> scratch;
+    for (int64_t slice = first; slice < last; ++slice) {
+      const int64_t i = slice / block_slice;
+      const int64_t j = slice % block_slice;
+      SelectTopK<float>(input + i * axis_dim * block_slice + j, axis_dim, block_slice, k,
+                        values + i * k * block_slice + j, indices + i * k * block_slice + j, scratch);
     }
-  }
+  };
+
+  auto* tp = GetOperatorThreadPool(p_op_kernel_context);
+  concurrency::ThreadPool::TryParallelForBlocks(tp, num_slices, num_slices * axis_dim,
+                                                concurrency::ThreadPool::kMinSortElementsPerBlock, select_slices);
 
   return Status::OK();
 }
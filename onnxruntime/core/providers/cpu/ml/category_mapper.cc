@@ -2,8 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/category_mapper.h"
-#include <algorithm>
-#include <gsl/span>
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -28,40 +28,31 @@ Status CategoryMapper::Compute(OpKernelContext* context) const {
   Tensor& Y = *context->Output(0, TensorShape(shape));
 
   auto input_type = X.DataType();
+  const int64_t count = shape.Size();
+  auto* tp = GetOperatorThreadPool(context);
 
   if (input_type == DataTypeImpl::GetType<std::string>()) {
     if (Y.DataType() != DataTypeImpl::GetType<int64_t>())
       return Status(ONNXRUNTIME, FAIL, "Input of string must have output of int64");
 
-    auto input = gsl::make_span(X.template Data<std::string>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<int64_t>(), shape.Size());
-    auto out = output.begin();
+    const auto* input = X.template Data<std::string>();
+    auto* output = Y.template MutableData<int64_t>();
 
-    // map isn't going to change so get end() once instead of calling inside the for_each loop
-    const auto map_end = string_to_int_map_.end();
-
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const std::string& value) {
-                    auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
-                    ++out;
-                  });
+    concurrency::ThreadPool::TryParallelForBlocks(
+        tp, count, count, concurrency::ThreadPool::kMinLookupsPerBlock, [&](int64_t first, int64_t last) {
+          string_to_int_map_.Lookup(input + first, static_cast<size_t>(last - first), default_int_, output + first);
+        });
   } else {
     if (Y.DataType() != DataTypeImpl::GetType<std::string>())
       return Status(ONNXRUNTIME, FAIL, "Input of int64 must have output of string ");
 
-    auto input = gsl::make_span(X.template Data<int64_t>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<std::string>(), shape.Size());
-    auto out = output.begin();
-
-    const auto map_end = int_to_string_map_.end();
+    const auto* input = X.template Data<int64_t>();
+    auto* output = Y.template MutableData<std::string>();
 
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const int64_t& value) {
-                    auto map_to = int_to_string_map_.find(value);
-                    *out = map_to == map_end ? default_string_ : map_to->second;
-                    ++out;
-                  });
+    concurrency::ThreadPool::TryParallelForBlocks(
+        tp, count, count, concurrency::ThreadPool::kMinLookupsPerBlock, [&](int64_t first, int64_t last) {
+          int_to_string_map_.Lookup(input + first, static_cast<size_t>(last - first), default_string_, output + first);
+        });
   }
 
   return Status::OK();
@@ -2,16 +2,17 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/label_encoder.h"
-#include <algorithm>
-#include <gsl/span>
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
 namespace ml {
 
-ONNX_CPU_OPERATOR_ML_KERNEL(
+ONNX_CPU_OPERATOR_VERSIONED_ML_KERNEL(
     LabelEncoder,
     1,
+    1,
     KernelDefBuilder().TypeConstraint("T1",
                                       std::vector<MLDataType>{DataTypeImpl::GetTensorType<std::string>(),
                                                               DataTypeImpl::GetTensorType<int64_t>()})
@@ -28,44 +29,79 @@ Status LabelEncoder::Compute(OpKernelContext* context) const {
   Tensor& Y = *context->Output(0, TensorShape(shape));
 
   auto input_type = X.DataType();
+  const int64_t count = shape.Size();
+  auto* tp = GetOperatorThreadPool(context);
 
   if (input_type == DataTypeImpl::GetType<std::string>()) {
     if (Y.DataType() != DataTypeImpl::GetType<int64_t>())
       return Status(ONNXRUNTIME, FAIL, "Input of tensor(string) must have output of tensor(int64)");
 
-    auto input = gsl::make_span(X.template Data<std::string>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<int64_t>(), shape.Size());
-    auto out = output.begin();
-
-    // map isn't going to change so get end() once instead of calling inside the for_each loop
-    const auto map_end = string_to_int_map_.end();
+    const auto* input = X.template Data<std::string>();
+    auto* output = Y.template MutableData<int64_t>();
 
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const std::string& value) {
-                    auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
-                    ++out;
-                  });
+    concurrency::ThreadPool::TryParallelForBlocks(
+        tp, count, count, concurrency::ThreadPool::kMinLookupsPerBlock, [&](int64_t first, int64_t last) {
+          string_to_int_map_.Lookup(input + first, static_cast<size_t>(last - first), default_int_, output + first);
+        });
   } else {
     if (Y.DataType() != DataTypeImpl::GetType<std::string>())
       return Status(ONNXRUNTIME, FAIL, "Input of tensor(int64) must have output of tensor(string)");
 
-    auto input = gsl::make_span(X.template Data<int64_t>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<std::string>(), shape.Size());
-    auto out = output.begin();
-
-    const auto map_end = int_to_string_map_.end();
+    const auto* input = X.template Data<int64_t>();
+    auto* output = Y.template MutableData<std::string>();
+    const auto num_classes = static_cast<int64_t>(string_classes_.size());
 
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const int64_t& value) {
-                    auto map_to = int_to_string_map_.find(value);
-                    *out = map_to == map_end ? default_string_ : map_to->second;
-                    ++out;
-                  });
+    concurrency::ThreadPool::TryParallelForBlocks(
+        tp, count, count, concurrency::ThreadPool::kMinLookupsPerBlock, [&](int64_t first, int64_t last) {
+          for (int64_t i = first; i < last; ++i) {
+            const int64_t value = input[i];
+            output[i] = value >= 0 && value < num_classes ? string_classes_[value] : default_string_;
+          }
+        });
   }
 
   return Status::OK();
 }
 
+template <typename TKey, typename TValue>
+Status LabelEncoder_2<TKey, TValue>::Compute(OpKernelContext* context) const {
+  const auto* tensor_pointer = context->Input<Tensor>(0);
+  if (tensor_pointer == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
+  const Tensor& X = *tensor_pointer;
+  const TensorShape& shape = X.Shape();
+  Tensor& Y = *context->Output(0, TensorShape(shape));
+
+  const auto* input = X.template Data<TKey>();
+  auto* output = Y.template MutableData<TValue>();
+  const int64_t count = shape.Size();
+
+  concurrency::ThreadPool::TryParallelForBlocks(
+      GetOperatorThreadPool(context), count, count, concurrency::ThreadPool::kMinLookupsPerBlock,
+      [&](int64_t first, int64_t last) {
+        map_.Lookup(input + first, static_cast<size_t>(last - first), default_value_, output + first);
+      });
+
+  return Status::OK();
+}
+
+#define REG_LABEL_ENCODER_2(in_type, out_type)                                      \
+  ONNX_CPU_OPERATOR_TYPED_ML_KERNEL(                                                \
+      LabelEncoder,                                                                 \
+      2,                                                                            \
+      in_type##_##out_type,                                                         \
+      KernelDefBuilder()                                                            \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<in_type>())             \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<out_type>()),           \
+      LabelEncoder_2<in_type, out_type>)
+
+using string = std::string;
+
+REG_LABEL_ENCODER_2(int64_t, float);
+REG_LABEL_ENCODER_2(float, int64_t);
+REG_LABEL_ENCODER_2(int64_t, string);
+REG_LABEL_ENCODER_2(string, int64_t);
+REG_LABEL_ENCODER_2(float, string);
+REG_LABEL_ENCODER_2(string, float);
+
 }  // namespace ml
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/lookup_table.h"
 #include "core/providers/cpu/ml/ml_common.h"
 
 namespace onnxruntime {
@@ -13,35 +14,85 @@ namespace ml {
 class LabelEncoder final : public OpKernel {
  public:
   LabelEncoder(const OpKernelInfo& info) : OpKernel(info) {
-    std::vector<std::string> string_classes;
-
-    ORT_ENFORCE(info.GetAttrs<std::string>("classes_strings", string_classes).IsOK());
+    ORT_ENFORCE(info.GetAttrs<std::string>("classes_strings", string_classes_).IsOK());
 
     ORT_ENFORCE(info.GetAttr<std::string>("default_string", &default_string_).IsOK());
     ORT_ENFORCE(info.GetAttr<int64_t>("default_int64", &default_int_).IsOK());
 
-    auto num_entries = string_classes.size();
-
-    string_to_int_map_.reserve(num_entries);
-    int_to_string_map_.reserve(num_entries);
-
-    for (size_t i = 0; i < num_entries; ++i) {
-      const std::string& str = string_classes[i];
-
-      string_to_int_map_[str] = i;
-      int_to_string_map_[i] = str;
+    std::vector<int64_t> indices(string_classes_.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      indices[i] = static_cast<int64_t>(i);
     }
+
+    string_to_int_map_ = LookupTable<std::string, int64_t>(string_classes_, indices);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  // the int64 to string mapping is the identity on class indices, so it indexes string_classes_ directly
+  std::vector<std::string> string_classes_;
+  LookupTable<std::string, int64_t> string_to_int_map_;
 
   std::string default_string_;
   int64_t default_int_;
 };
 
+// Attribute names of the keys, values and default of each LabelEncoder-2 type.
+template <typename T>
+struct LabelEncoderAttributes;
+
+template <>
+struct LabelEncoderAttributes<std::string> {
+  static const char* Keys() { return "keys_strings"; }
+  static const char* Values() { return "values_strings"; }
+  static const char* Default() { return "default_string"; }
+  static std::string DefaultValue() { return "_Unused"; }
+};
+
+template <>
+struct LabelEncoderAttributes<int64_t> {
+  static const char* Keys() { return "keys_int64s"; }
+  static const char* Values() { return "values_int64s"; }
+  static const char* Default() { return "default_int64"; }
+  static int64_t DefaultValue() { return -1; }
+};
+
+template <>
+struct LabelEncoderAttributes<float> {
+  static const char* Keys() { return "keys_floats"; }
+  static const char* Values() { return "values_floats"; }
+  static const char* Default() { return "default_float"; }
+  static float DefaultValue() { return -0.0f; }
+};
+
+/**
+ * LabelEncoder from opset 2, which maps the keys given by the keys_* attribute to the values at the same position in
+ * the values_* attribute. Inputs that are not a key map to the default_* attribute.
+ */
+template <typename TKey, typename TValue>
+class LabelEncoder_2 final : public OpKernel {
+ public:
+  LabelEncoder_2(const OpKernelInfo& info) : OpKernel(info) {
+    std::vector<TKey> keys;
+    std::vector<TValue> values;
+
+    ORT_ENFORCE(info.GetAttrs<TKey>(LabelEncoderAttributes<TKey>::Keys(), keys).IsOK(),
+                "LabelEncoder is missing attribute ", LabelEncoderAttributes<TKey>::Keys());
+    ORT_ENFORCE(info.GetAttrs<TValue>(LabelEncoderAttributes<TValue>::Values(), values).IsOK(),
+                "LabelEncoder is missing attribute ", LabelEncoderAttributes<TValue>::Values());
+
+    map_ = LookupTable<TKey, TValue>(keys, values);
+    default_value_ = info.GetAttrOrDefault<TValue>(LabelEncoderAttributes<TValue>::Default(),
+                                                   LabelEncoderAttributes<TValue>::DefaultValue());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  LookupTable<TKey, TValue> map_;
+  TValue default_value_;
+};
+
 }  // namespace ml
 }  // namespace onnxruntime
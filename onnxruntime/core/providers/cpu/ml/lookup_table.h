@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/murmur_hash3.h"
+#include "core/util/prefetch.h"
+
+namespace onnxruntime {
+namespace ml {
+
+template <typename TKey>
+struct LookupTableHash;
+
+template <>
+struct LookupTableHash<std::string> {
+  static uint32_t Hash(const std::string& key) {
+    return MurmurHash3_x86_32(key.data(), static_cast<int>(key.size()), 0);
+  }
+};
+
+template <>
+struct LookupTableHash<int64_t> {
+  // MurmurHash3 64 bit finalizer, so that consecutive ids spread over the whole table
+  static uint32_t Hash(int64_t key) {
+    uint64_t k = static_cast<uint64_t>(key);
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return static_cast<uint32_t>(k);
+  }
+};
+
+template <>
+struct LookupTableHash<float> {
+  // hashes the bit pattern, with -0.0 folded onto 0.0 since they compare equal. NaN keys never match.
+  static uint32_t Hash(float key) {
+    if (key == 0.0f) {
+      key = 0.0f;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return LookupTableHash<int64_t>::Hash(bits);
+  }
+};
+
+/**
+ * Immutable key to value map for the mapping kernels, built once when the kernel is constructed.
+ *
+ * The keys are stored in an open addressing table with linear probing and a load factor of at most 1/2. Each slot
+ * is 8 bytes: the cached 32 bit hash of the key and the index of its entry, so a probe touches one cache line and
+ * only compares keys whose hashes match. Lookups are done in batches: the hashes of a batch of inputs are computed
+ * and their slots prefetched before any of them is probed, so that the cache misses of a large table overlap
+ * instead of being paid one after the other.
+ */
+template <typename TKey, typename TValue>
+class LookupTable final {
+ public:
+  LookupTable() = default;
+
+  /**
+   * Builds the table. When a key appears more than once the last value wins, as with repeated
+   * assignments to a std::unordered_map.
+   */
+  LookupTable(const std::vector<TKey>& keys, const std::vector<TValue>& values) {
+    ORT_ENFORCE(keys.size() == values.size(), "Number of keys ", keys.size(), " does not match number of values ",
+                values.size());
+    ORT_ENFORCE(keys.size() < static_cast<size_t>(kEmpty), "Too many keys: ", keys.size());
+
+    size_t capacity = 16;
+    while (capacity < 2 * keys.size()) {
+      capacity *= 2;
+    }
+
+    slots_.assign(capacity, Slot{0, kEmpty});
+    mask_ = capacity - 1;
+    keys_.reserve(keys.size());
+    values_.reserve(values.size());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+      const uint32_t hash = LookupTableHash<TKey>::Hash(keys[i]);
+      const uint32_t entry = Find(keys[i], hash);
+      if (entry != kEmpty) {
+        values_[entry] = values[i];
+        continue;
+      }
+
+      size_t slot = hash & mask_;
+      while (slots_[slot].entry != kEmpty) {
+        slot = (slot + 1) & mask_;
+      }
+
+      slots_[slot] = Slot{hash, static_cast<uint32_t>(keys_.size())};
+      keys_.push_back(keys[i]);
+      values_.push_back(values[i]);
+    }
+  }
+
+  size_t Size() const { return keys_.size(); }
+
+  /**
+   * Writes the value of each of the 'count' keys to 'output', or 'default_value' for keys that are not in the
+   * table.
+   */
+  void Lookup(const TKey* keys, size_t count, const TValue& default_value, TValue* output) const {
+    uint32_t hashes[kBatchSize];
+
+    for (size_t start = 0; start < count; start += kBatchSize) {
+      const size_t batch = std::min(count - start, kBatchSize);
+
+      for (size_t i = 0; i < batch; ++i) {
+        hashes[i] = LookupTableHash<TKey>::Hash(keys[start + i]);
+        PrefetchRead(&slots_[hashes[i] & mask_]);
+      }
+
+      for (size_t i = 0; i < batch; ++i) {
+        const uint32_t entry = Find(keys[start + i], hashes[i]);
+        output[start + i] = entry == kEmpty ? default_value : values_[entry];
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    uint32_t hash;
+    uint32_t entry;
+  };
+
+  static constexpr uint32_t kEmpty = 0xffffffff;
+  static constexpr size_t kBatchSize = 16;
+
+  uint32_t Find(const TKey& key, uint32_t hash) const {
+    size_t slot = hash & mask_;
+    for (;;) {
+      const Slot& s = slots_[slot];
+      if (s.entry == kEmpty) {
+        return kEmpty;
+      }
+      if (s.hash == hash && keys_[s.entry] == key) {
+        return s.entry;
+      }
+      slot = (slot + 1) & mask_;
+    }
+  }
+
+  std::vector<Slot> slots_{Slot{0, kEmpty}};
+  size_t mask_ = 0;
+  std::vector<TKey> keys_;
+  std::vector<TValue> values_;
+};
+
+template <typename TKey, typename TValue>
+constexpr uint32_t LookupTable<TKey, TValue>::kEmpty;
+
+template <typename TKey, typename TValue>
+constexpr size_t LookupTable<TKey, TValue>::kBatchSize;
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/zipmap.h"
+
+#include <algorithm>
+
 #include "core/util/math_cpuonly.h"
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
@@ -31,10 +34,49 @@ namespace ml {
 ONNX_CPU_OPERATOR_ML_KERNEL(
     ZipMap,
     1,
-    KernelDefBuilder().TypeConstraint("T", {DataTypeImpl::GetType<std::vector<std::map<std::string, float>>>(),
-                                            DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
+    KernelDefBuilder().TypeConstraint("T", {DataTypeImpl::GetType<VectorMapStringToFloat>(),
+                                            DataTypeImpl::GetType<VectorMapInt64ToFloat>()}),
     ZipMapOp);
 
+// Sorts the labels and drops the duplicates. The value of a repeated label comes from its last column, as it did when
+// each row was built by assigning the columns to a std::map in order.
+template <typename TKey>
+static void SortLabels(const std::vector<TKey>& labels, std::vector<TKey>& keys, std::vector<size_t>& columns) {
+  std::vector<size_t> order(labels.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&labels](size_t a, size_t b) { return labels[a] < labels[b]; });
+
+  keys.clear();
+  columns.clear();
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (!keys.empty() && keys.back() == labels[order[i]]) {
+      columns.back() = order[i];
+    } else {
+      keys.push_back(labels[order[i]]);
+      columns.push_back(order[i]);
+    }
+  }
+}
+
+// All rows have the same keys, so they are added to the output once and each row only writes its values.
+template <typename TKey>
+static void ZipRows(const float* x_data, int64_t batch_size, int64_t features_per_batch,
+                    const std::vector<TKey>& keys, const std::vector<size_t>& columns,
+                    MapSequence<TKey, float>& y) {
+  y.clear();
+  y.reserve(static_cast<size_t>(batch_size), static_cast<size_t>(batch_size) * keys.size());
+  const size_t keys_id = y.AddKeys(keys.data(), keys.size());
+  for (int64_t n = 0; n < batch_size; n++) {
+    const float* row = x_data + n * features_per_batch;
+    float* values = y.AppendMap(keys_id);
+    for (size_t k = 0; k < columns.size(); k++) {
+      values[k] = row[columns[k]];
+    }
+  }
+}
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +84,11 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  if (using_strings_) {
+    SortLabels(classlabels_strings_, keys_strings_, key_columns_);
+  } else {
+    SortLabels(classlabels_int64s_, keys_int64s_, key_columns_);
+  }
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -75,20 +122,9 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
                     "Input features_per_batch[" + std::to_string(features_per_batch) +
                         "] != number of classlabels[" + std::to_string(classlabels_strings_.size()) + "]");
     }
-    auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
+    auto* y_data = context->Output<VectorMapStringToFloat>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-
-    //auto* y_data = Y->template MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map1);
-    }
+    ZipRows(x_data, batch_size, features_per_batch, keys_strings_, key_columns_, *y_data);
   } else {
     if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
       return Status(ONNXRUNTIME,
@@ -96,19 +132,9 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
                     "Input features_per_batch[" + std::to_string(features_per_batch) +
                         "] != number of classlabels[" + std::to_string(classlabels_int64s_.size()) + "]");
     }
-    auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
+    auto* y_data = context->Output<VectorMapInt64ToFloat>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    //auto* y_data = Y->template MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+    ZipRows(x_data, batch_size, features_per_batch, keys_int64s_, key_columns_, *y_data);
   }
   return common::Status::OK();
 }
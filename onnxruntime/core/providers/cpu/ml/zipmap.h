@@ -16,6 +16,12 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+
+  // the distinct class labels in increasing order, the keys of every output map, and for each of them the input
+  // column it takes its value from
+  std::vector<int64_t> keys_int64s_;
+  std::vector<std::string> keys_strings_;
+  std::vector<size_t> key_columns_;
 };
 
 }  // namespace ml
@@ -17,6 +17,10 @@
 
 #include "core/providers/cpu/nn/batch_norm.h"
 #include "core/providers/cpu/nn/batch_norm_helper.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include <algorithm>
 
 namespace onnxruntime {
 // spec: https://github.com/onnx/onnx/blob/master/docs/Operators.md#BatchNormalization
@@ -67,11 +71,20 @@ Status BatchNorm<float>::Compute(OpKernelContext* p_op_kernel_context) const {
   //   (x * inv_var * scale) + (bias - est_mean * inv_var * scale)
   Eigen::Array<float, Eigen::Dynamic, 1> new_scale = inv_std * scale_arr;
   Eigen::Array<float, Eigen::Dynamic, 1> new_bias = bias_arr - mean_arr * new_scale;
-  EigenArrayMap<float> Y_arr(Y->template MutableData<float>(), sample_size, N * C);
-  ConstEigenArrayMap<float> X_arr(X->template Data<float>(), sample_size, N * C);
-  for (size_t nc = 0; nc < N * C; ++nc) {
-    Y_arr.col(nc) = X_arr.col(nc) * new_scale(nc % C) + new_bias(nc % C);
-  }
+  const float* Xdata = X->template Data<float>();
+  float* Ydata = Y->template MutableData<float>();
+  auto normalize_planes = [&](int64_t first, int64_t last) {
+    for (int64_t nc = first; nc < last; ++nc) {
+      MlasComputeScaleShift(Xdata + nc * sample_size, Ydata + nc * sample_size, sample_size,
+                            new_scale(nc % C), new_bias(nc % C));
+    }
+  };
+
+  // the statistics are folded into new_scale and new_bias up front, so a plane only needs the entries of its channel
+  const int64_t num_planes = static_cast<int64_t>(N * C);
+  auto* tp = GetOperatorThreadPool(p_op_kernel_context);
+  concurrency::ThreadPool::TryParallelForBlocks(tp, num_planes, num_planes * static_cast<int64_t>(sample_size),
+                                                concurrency::ThreadPool::kMinElementsPerBlock, normalize_planes);
 
   return Status::OK();
 }
@@ -9,7 +9,8 @@
 #include "core/providers/cpu/nn/conv_integer.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
-#include "core/util/gemmlowp_common_wrapper.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -82,6 +83,8 @@ Status ConvInteger::Compute(OpKernelContext* context) const {
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
+  auto* thread_pool = GetOperatorThreadPool(context);
+
   const auto* Xdata = X->template Data<uint8_t>();
   auto* Ydata = Y->template MutableData<int32_t>();
 
@@ -121,24 +124,18 @@ Status ConvInteger::Compute(OpKernelContext* context) const {
 		  false,
 		  input_offset);
 
-      const uint8_t* filter_data_as_uint8 = W->template Data<uint8_t>() + group_id * W_offset;
-      static const gemmlowp::MapOrder ResultOrder = gemmlowp::MapOrder::RowMajor;
-      static const gemmlowp::MapOrder LhsOrder = gemmlowp::MapOrder::RowMajor;
-      static const gemmlowp::MapOrder RhsOrder = gemmlowp::MapOrder::RowMajor;
-      gemmlowp::MatrixMap<const std::uint8_t, LhsOrder> lhs(
-          filter_data_as_uint8, static_cast<int>(M / group_), static_cast<int>(kernel_dim));
-      gemmlowp::MatrixMap<const std::uint8_t, RhsOrder> rhs(
-          col_buffer_data, static_cast<int>(kernel_dim), static_cast<int>(output_image_size));
-      gemmlowp::MatrixMap<std::int32_t, ResultOrder> result(
-          Ydata + group_id * Y_offset, static_cast<int>(M / group_), static_cast<int>(output_image_size));
-      const std::tuple<> empty_pipeline = {};
-
-      gemmlowp::GemmContext gemm_context;
-      // TODO: worker thread pool needs to be handled.
-      gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::int32_t,
-                                       gemmlowp::DefaultL8R8BitDepthParams>(
-          &gemm_context, lhs, rhs, &result, -filter_offset, -input_offset,
-          empty_pipeline);
+      MlasQgemm(static_cast<size_t>(M / group_),
+                static_cast<size_t>(output_image_size),
+                static_cast<size_t>(kernel_dim),
+                W->template Data<uint8_t>() + group_id * W_offset,
+                static_cast<size_t>(kernel_dim),
+                static_cast<uint8_t>(filter_offset),
+                col_buffer_data,
+                static_cast<size_t>(output_image_size),
+                static_cast<uint8_t>(input_offset),
+                Ydata + group_id * Y_offset,
+                static_cast<size_t>(output_image_size),
+                thread_pool);
     }
 
     Xdata += X_offset * group_;
@@ -3,7 +3,11 @@
 
 #include "core/providers/cpu/nn/instance_norm.h"
 #include "core/providers/cpu/nn/instance_norm_helper.h"
-#include "core/util/math_cpuonly.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include <algorithm>
+#include <cmath>
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -28,16 +32,30 @@ Status InstanceNorm<float>::Compute(OpKernelContext* p_op_kernel_context) const
   const TensorShape& x_shape = input->Shape();
   Tensor* Y = p_op_kernel_context->Output(0, x_shape);
 
-  for (auto i = 0; i < N * C; ++i) {
-    ConstEigenVectorArrayMap<float> Xi(input->template Data<float>() + W * i, W);
-    const float Xi_mean = Xi.mean();
-    const float squared_norm = (Xi - Xi_mean).matrix().squaredNorm();
-    const float inv_stdev = 1.0f / std::sqrt(squared_norm / W + epsilon_);
-    EigenVectorArrayMap<float> Yi(Y->template MutableData<float>() + W * i, W);
-    const float channel_scale = inv_stdev * scale->template Data<float>()[i % C];
-    const float channel_shift = B->template Data<float>()[i % C] - Xi_mean * channel_scale;
-    Yi = Xi * channel_scale + channel_shift;
-  }
+  const float* Xdata = input->template Data<float>();
+  float* Ydata = Y->template MutableData<float>();
+  const float* scale_data = scale->template Data<float>();
+  const float* bias_data = B->template Data<float>();
+
+  // The mean and variance of a plane are gathered in one pass and the normalization, scale and bias are applied
+  // as a single multiply-add in a second pass.
+  auto normalize_planes = [&](int64_t first, int64_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      float mean;
+      float variance;
+      MlasComputeMeanVariance(Xdata + W * i, static_cast<size_t>(W), &mean, &variance);
+      const float inv_stdev = 1.0f / std::sqrt(variance + epsilon_);
+      const float channel_scale = inv_stdev * scale_data[i % C];
+      const float channel_shift = bias_data[i % C] - mean * channel_scale;
+      MlasComputeScaleShift(Xdata + W * i, Ydata + W * i, static_cast<size_t>(W), channel_scale, channel_shift);
+    }
+  };
+
+  // each plane is normalized by its own mean and variance, so a block of planes needs nothing from the others
+  const int64_t num_planes = N * C;
+  auto* tp = GetOperatorThreadPool(p_op_kernel_context);
+  concurrency::ThreadPool::TryParallelForBlocks(tp, num_planes, num_planes * W,
+                                                concurrency::ThreadPool::kMinElementsPerBlock, normalize_planes);
 
   return Status::OK();
 }
@@ -18,6 +18,9 @@
 #include "core/providers/cpu/nn/lrn.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
+#include <algorithm>
 
 namespace onnxruntime {
 
@@ -47,45 +50,73 @@ Status LRN<float>::Compute(OpKernelContext* context) const {
   auto sdata = alloc->Alloc(sizeof(float) * Xsize);
   BufferUniquePtr scale_buffer(sdata, BufferDeleter(alloc));
   auto* scale_data = static_cast<float*>(scale_buffer.get());
-  math::Set<float, CPUMathUtil>(Xsize, bias_, scale_data, &CPUMathUtil::Instance());
 
-  const size_t padded_square_size = (C + size_ - 1) * H * W;
+  const int spatial_size = H * W;
+  const size_t padded_square_size = (C + size_ - 1) * spatial_size;
   auto psdata = alloc->Alloc(sizeof(float) * padded_square_size);
   BufferUniquePtr padded_square_buffer(psdata, BufferDeleter(alloc));
   auto* padded_square_data = static_cast<float*>(padded_square_buffer.get());
   math::Set<float, CPUMathUtil>(padded_square_size, 0.0f, padded_square_data, &CPUMathUtil::Instance());
 
   const float alpha_over_size = alpha_ / size_;
-  // go through the images
-  for (int n = 0; n < N; ++n) {
-    // compute the padded square
-    math::Sqr<float, CPUMathUtil>(image_size, Xdata + image_size * n,
-                                  padded_square_data + pre_pad * H * W,
-                                  &CPUMathUtil::Instance());
-    // Create the first channel scale
-    for (int c = 0; c < size_; ++c) {
-      math::Axpy<float, CPUMathUtil>(
-          H * W, alpha_over_size, padded_square_data + c * H * W,
-          scale_data + image_size * n, &CPUMathUtil::Instance());
-    }
 
-    for (int c = 1; c < C; ++c) {
-      float* this_scale_slice = scale_data + n * image_size + c * H * W;
-      // copy previous scale
-      memcpy(this_scale_slice, this_scale_slice - H * W, H * W * sizeof(float));
-      // add head
-      math::Axpy<float, CPUMathUtil>(
-          H * W, alpha_over_size, padded_square_data + (c + size_ - 1) * H * W,
-          this_scale_slice, &CPUMathUtil::Instance());
-      // subtract tail
-      math::Axpy<float, CPUMathUtil>(
-          H * W, -alpha_over_size, padded_square_data + (c - 1) * H * W,
-          this_scale_slice, &CPUMathUtil::Instance());
+  // The window slides along the channels independently at every spatial position, so the spatial positions are
+  // split into segments that each run through all the images and channels, and finish with the power and multiply
+  // while the segment is still in the cache. The segments write disjoint columns of the shared buffers.
+  auto normalize_segment = [&](int first, int last) {
+    const int len = last - first;
+    for (int n = 0; n < N; ++n) {
+      const float* x = Xdata + image_size * n + first;
+      float* scale = scale_data + image_size * n + first;
+      float* padded_square = padded_square_data + first;
+
+      // compute the padded square
+      for (int c = 0; c < C; ++c) {
+        math::Sqr<float, CPUMathUtil>(len, x + c * spatial_size, padded_square + (c + pre_pad) * spatial_size,
+                                      &CPUMathUtil::Instance());
+      }
+      // Create the first channel scale
+      math::Set<float, CPUMathUtil>(len, bias_, scale, &CPUMathUtil::Instance());
+      for (int c = 0; c < size_; ++c) {
+        math::Axpy<float, CPUMathUtil>(
+            len, alpha_over_size, padded_square + c * spatial_size,
+            scale, &CPUMathUtil::Instance());
+      }
+
+      for (int c = 1; c < C; ++c) {
+        float* this_scale_slice = scale + c * spatial_size;
+        // copy previous scale
+        memcpy(this_scale_slice, this_scale_slice - spatial_size, len * sizeof(float));
+        // add head
+        math::Axpy<float, CPUMathUtil>(
+            len, alpha_over_size, padded_square + (c + size_ - 1) * spatial_size,
+            this_scale_slice, &CPUMathUtil::Instance());
+        // subtract tail
+        math::Axpy<float, CPUMathUtil>(
+            len, -alpha_over_size, padded_square + (c - 1) * spatial_size,
+            this_scale_slice, &CPUMathUtil::Instance());
+      }
+
+      float* y = Ydata + image_size * n + first;
+      for (int c = 0; c < C; ++c) {
+        math::Powx<float, CPUMathUtil>(len, scale + c * spatial_size, -beta_, y + c * spatial_size,
+                                       &CPUMathUtil::Instance());
+        math::Mul<float, CPUMathUtil>(len, y + c * spatial_size, x + c * spatial_size, y + c * spatial_size,
+                                      &CPUMathUtil::Instance());
+      }
     }
-  }
+  };
+
+  auto* tp = GetOperatorThreadPool(context);
 
-  math::Powx<float, CPUMathUtil>(Xsize, scale_data, -beta_, Ydata, &CPUMathUtil::Instance());
-  math::Mul<float, CPUMathUtil>(Xsize, Ydata, Xdata, Ydata, &CPUMathUtil::Instance());
+  // the segments are made of whole groups of 16 columns, a multiple of the vector width
+  constexpr int64_t kColumnsPerGroup = 16;
+  const int64_t num_groups = (spatial_size + kColumnsPerGroup - 1) / kColumnsPerGroup;
+  concurrency::ThreadPool::TryParallelForBlocks(
+      tp, num_groups, Xsize, concurrency::ThreadPool::kMinElementsPerBlock, [&](int64_t first, int64_t last) {
+        normalize_segment(static_cast<int>(first * kColumnsPerGroup),
+                          static_cast<int>(std::min<int64_t>(last * kColumnsPerGroup, spatial_size)));
+      });
 
   return Status::OK();
 }
@@ -189,8 +189,7 @@ Status PoolBase::Compute(OpKernelContext* context, MLAS_POOLING_KIND kind) const
 
   // Get access to the internal threadpool
   // Temporarily derive concurrency parameters without access to session state
-  auto ctx_internal = static_cast<OpKernelContextInternal*>(context);
-  auto thread_pool = ctx_internal->GetOperatorThreadPool();
+  auto* thread_pool = GetOperatorThreadPool(context);
 
   MlasPool(kind,
            pooling_dims,
@@ -201,7 +200,7 @@ Status PoolBase::Compute(OpKernelContext* context, MLAS_POOLING_KIND kind) const
            output_dims.data(),
            X->template Data<float>(),
            Y->template MutableData<float>(),
-           const_cast<concurrency::ThreadPool*>(thread_pool));
+           thread_pool);
 
   return Status::OK();
 }
@@ -9,6 +9,8 @@
 #include "core/providers/cpu/nn/qlinearconv.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 ONNX_OPERATOR_KERNEL_EX(
@@ -98,12 +100,19 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   const int64_t W_offset = W->Shape().Size() / group_;  
   const int64_t kernel_dim = C / group_ * kernel_size;
   const int64_t col_buffer_size = kernel_dim * output_image_size;
-  const int bias_offset = static_cast<int>(M / group_);
+  const int64_t bias_offset = M / group_;
 
   auto col_data = alloc->Alloc(sizeof(uint8_t) * col_buffer_size);
   BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
   auto* col_buffer_data = static_cast<uint8_t*>(col_buffer.get());
 
+  // the 32-bit GEMM output for one group is requantized into Y
+  auto gemm_output_data = alloc->Alloc(sizeof(int32_t) * Y_offset);
+  BufferUniquePtr gemm_output_buffer(gemm_output_data, BufferDeleter(alloc));
+  auto* gemm_output = static_cast<int32_t*>(gemm_output_buffer.get());
+
+  auto* thread_pool = GetOperatorThreadPool(context);
+
   TensorShape image_shape = X->Shape().Slice(1);
   std::vector<int64_t> col_buffer_shape{kernel_dim};
   col_buffer_shape.insert(col_buffer_shape.end(), output_shape.GetDims().begin(),
@@ -127,32 +136,27 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
 		  false,
           input_offset_data);
 
-      const uint8_t* filter_data_as_uint8 = W->template Data<uint8_t>() + group_id * W_offset;
-      static const gemmlowp::MapOrder MatOrder = gemmlowp::MapOrder::RowMajor;
-      gemmlowp::MatrixMap<const std::uint8_t, MatOrder> lhs(
-          filter_data_as_uint8, static_cast<int>(M / group_), static_cast<int>(kernel_dim));
-      gemmlowp::MatrixMap<const std::uint8_t, MatOrder> rhs(
-          col_buffer_data, static_cast<int>(kernel_dim), static_cast<int>(output_image_size));
-      gemmlowp::MatrixMap<std::uint8_t, MatOrder> result(
-          Ydata + group_id * Y_offset, static_cast<int>(M / group_), static_cast<int>(output_image_size));
-
-      // TODO: worker thread pool needs to be handled.
-      gemmlowp::GemmContext gemm_context;
-      if (bias == nullptr) {
-        auto output_pipeline = MakeOutputPipelineWithOutBias(result_offset_data, 
-            integer_multiplier, right_shift);
-        gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::uint8_t,
-                                         gemmlowp::DefaultL8R8BitDepthParams>(
-            &gemm_context, lhs, rhs, &result, -filter_offset_data, -input_offset_data,
-            output_pipeline);        
-      } else {
-        auto output_pipeline = MakeOutputPipelineWithBias(bias->template Data<int32_t>() + group_id * bias_offset, 
-            static_cast<int>(M / group_), result_offset_data, integer_multiplier, right_shift);
-        gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::uint8_t,
-                                         gemmlowp::DefaultL8R8BitDepthParams>(
-            &gemm_context, lhs, rhs, &result, -filter_offset_data, -input_offset_data,
-            output_pipeline);
-      }      
+      MlasQgemm(static_cast<size_t>(M / group_),
+                static_cast<size_t>(output_image_size),
+                static_cast<size_t>(kernel_dim),
+                W->template Data<uint8_t>() + group_id * W_offset,
+                static_cast<size_t>(kernel_dim),
+                filter_offset_data,
+                col_buffer_data,
+                static_cast<size_t>(output_image_size),
+                input_offset_data,
+                gemm_output,
+                static_cast<size_t>(output_image_size),
+                thread_pool);
+
+      MlasRequantizeOutput(gemm_output,
+                           Ydata + group_id * Y_offset,
+                           bias != nullptr ? bias->template Data<int32_t>() + group_id * bias_offset : nullptr,
+                           static_cast<size_t>(M / group_),
+                           static_cast<size_t>(output_image_size),
+                           integer_multiplier,
+                           right_shift,
+                           result_offset_data);
     }
 
     Xdata += X_offset * group_;
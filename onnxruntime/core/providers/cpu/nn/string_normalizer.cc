@@ -4,15 +4,18 @@
 #include "string_normalizer.h"
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
+#include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #include <locale.h>
 #endif
 
+#include <algorithm>
 #include <codecvt>
+#include <cstring>
 #include <locale>
-#include <functional>
 #include <unordered_set>
 
 namespace onnxruntime {
@@ -101,52 +104,99 @@ const std::string default_locale("en_US.UTF-8");
 
 #endif
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
-                      std::wstring_convert<std::codecvt_utf8<wchar_t>>& converter,
-                      size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
-  std::vector<int64_t> output_dims;
-  if (N == 1) {
-    output_dims.push_back(1);
-  }
+using Converter = std::wstring_convert<std::codecvt_utf8<wchar_t>>;
 
-  // Empty output case
-  if (C == 0) {
-    output_dims.push_back(1);
-    TensorShape output_shape(output_dims);
-    // This will create one empty string
-    ctx->Output(0, output_shape);
-    return Status::OK();
+namespace {
+
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+inline uint64_t Broadcast(uint8_t byte) {
+  return 0x0101010101010101ULL * byte;
+}
+
+// Returns the bits 0x20 of the bytes of 'word' that are in ['first', 'last']. Every byte of 'word' must be ASCII,
+// so that adding 0x80 - 'first' to a byte sets its high bit exactly when the byte is at least 'first' and no
+// carry crosses into the next byte.
+inline uint64_t CaseBits(uint64_t word, uint8_t first, uint8_t last) {
+  const uint64_t at_least_first = word + Broadcast(static_cast<uint8_t>(0x80 - first));
+  const uint64_t above_last = word + Broadcast(static_cast<uint8_t>(0x80 - last - 1));
+  return ((at_least_first ^ above_last) & kHighBits) >> 2;
+}
+
+inline uint64_t ChangeCaseAscii(StringNormalizer::CaseAction caseaction, uint64_t word) {
+  return caseaction == StringNormalizer::LOWER ? word | CaseBits(word, 'A', 'Z')
+                                               : word & ~CaseBits(word, 'a', 'z');
+}
+
+// Changes the case of 's' into 'out' eight bytes at a time.
+// Returns false without a complete result if 's' contains a byte that is not ASCII.
+bool ChangeCaseAscii(StringNormalizer::CaseAction caseaction, const std::string& s, std::string& out) {
+  const size_t length = s.size();
+  out.resize(length);
+  const char* src = s.data();
+  char* dst = &out[0];
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, src + i, sizeof(word));
+    if ((word & kHighBits) != 0) {
+      return false;
+    }
+    word = ChangeCaseAscii(caseaction, word);
+    memcpy(dst + i, &word, sizeof(word));
   }
 
-  output_dims.push_back(C);
+  if (i < length) {
+    uint64_t word = 0;
+    memcpy(&word, src + i, length - i);
+    if ((word & kHighBits) != 0) {
+      return false;
+    }
+    word = ChangeCaseAscii(caseaction, word);
+    memcpy(dst + i, &word, length - i);
+  }
 
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
+  return true;
+}
 
-  size_t output_idx = 0;
-  while (first != end) {
-    auto& s = *first;
-    if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
-        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars at: " + static_cast<const std::string&>(s));
-      }
-      // In place transform
-      loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
-    } else {
-      assert(caseaction == StringNormalizer::NONE);
-      // Simple copy or move if the iterator points to a non-const string
-      *(output_data + output_idx) = std::move(s);
+bool HasAsciiCaseMapping(const Locale& loc) {
+  for (wchar_t ch = 0; ch < 0x80; ++ch) {
+    const wchar_t lower = (ch >= L'A' && ch <= L'Z') ? static_cast<wchar_t>(ch + 0x20) : ch;
+    const wchar_t upper = (ch >= L'a' && ch <= L'z') ? static_cast<wchar_t>(ch - 0x20) : ch;
+    std::wstring wstr(1, ch);
+    loc.ChangeCase(StringNormalizer::LOWER, wstr);
+    if (wstr != std::wstring(1, lower)) {
+      return false;
+    }
+    wstr.assign(1, ch);
+    loc.ChangeCase(StringNormalizer::UPPER, wstr);
+    if (wstr != std::wstring(1, upper)) {
+      return false;
     }
-    ++output_idx;
-    ++first;
   }
+  return true;
+}
+
+}  // namespace
+
+// Changes the case of the UTF-8 string 's' into 'out'. Strings made only of ASCII characters are converted in
+// place when the locale allows it; other strings are widened so that the locale handles every character.
+Status ChangeCase(const Locale& loc, bool ascii_case_mapping, StringNormalizer::CaseAction caseaction,
+                  const std::string& s, Converter& converter, std::string& out) {
+  assert(caseaction != StringNormalizer::NONE);
+  if (ascii_case_mapping && ChangeCaseAscii(caseaction, s, out)) {
+    return Status::OK();
+  }
+
+  std::wstring wstr = converter.from_bytes(s);
+  if (wstr == wconv_error) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input contains invalid utf8 chars at: " + s);
+  }
+  // In place transform
+  loc.ChangeCase(caseaction, wstr);
+  out = converter.to_bytes(wstr);
   return Status::OK();
 }
 }  // namespace string_normalizer
@@ -156,7 +206,8 @@ using namespace string_normalizer;
 StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
                                                                is_case_sensitive_(true),
                                                                case_change_action_(NONE),
-                                                               compare_caseaction_(NONE) {
+                                                               compare_caseaction_(NONE),
+                                                               ascii_case_mapping_(false) {
   int64_t iscasesensitive = 0;
   Status status = info.GetAttr("is_case_sensitive", &iscasesensitive);
   ORT_ENFORCE(status.IsOK(), "attribute is_case_sensitive is not set");
@@ -181,8 +232,9 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
   }
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
-  Locale locale(locale_name_);
-  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
+  locale_ = std::make_unique<Locale>(locale_name_);
+  ascii_case_mapping_ = HasAsciiCaseMapping(*locale_);
+  Converter converter(conv_error, wconv_error);
 
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
   for (const auto& sw : swords) {
@@ -191,15 +243,17 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
       auto p = stopwords_.insert(sw);
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     } else {
-      std::wstring wstr = converter.from_bytes(sw);
-      ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
-      locale.ChangeCase(compare_caseaction_, wstr);
-      auto p = wstopwords_.insert(wstr);
+      std::string cased;
+      status = ChangeCase(*locale_, ascii_case_mapping_, compare_caseaction_, sw, converter, cased);
+      ORT_ENFORCE(status.IsOK(), "Stopword contains invalid utf8 chars");
+      auto p = stopwords_.insert(std::move(cased));
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     }
   }
 }
 
+StringNormalizer::~StringNormalizer() = default;
+
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
 
@@ -227,70 +281,90 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
-  Status status;
-  Locale locale(locale_name_);
-  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
   auto const input_data = X->template Data<std::string>();
-  using StrRef = std::reference_wrapper<const std::string>;
-  if (is_case_sensitive_) {
-    if (!stopwords_.empty()) {
-      std::vector<StrRef> filtered_strings;
-      filtered_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        if (0 == stopwords_.count(s)) {
-          filtered_strings.push_back(std::cref(s));
-        }
-        ++first;
-      }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
-                              N, filtered_strings.size(), case_change_action_);
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
-    }
-  } else {
-    if (!wstopwords_.empty()) {
-      // Filter input. When no case action is required
-      // we simply store original string references.
-      // Otherwise, we store converted strings.
-      std::vector<StrRef> filtered_orignal_strings;
-      std::vector<std::string> filtered_cased_strings;
-      filtered_orignal_strings.reserve(C);
-      filtered_cased_strings.reserve(C);
-      auto first = input_data;
-      auto const last = input_data + C;
-      while (first != last) {
-        const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Input contains invalid utf8 chars at: " + s);
-        }
-        locale.ChangeCase(compare_caseaction_, wstr);
-        if (0 == wstopwords_.count(wstr)) {
-          if (case_change_action_ == NONE) {
-            filtered_orignal_strings.push_back(std::cref(s));
-          } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
+  const bool filter = !stopwords_.empty();
+  const bool change_case = case_change_action_ != NONE;
+
+  // Strings are filtered and case converted independently of each other, so the batch is processed in
+  // blocks. Stopwords are found before the case of the remaining strings is changed, so only strings that
+  // are kept are converted.
+  std::vector<uint8_t> keep(C, 1);
+  std::vector<std::string> cased(change_case ? C : 0);
+
+  auto process = [&](size_t first, size_t last) -> Status {
+    Converter converter(conv_error, wconv_error);
+    std::string key;
+    for (size_t i = first; i < last; ++i) {
+      const std::string& s = input_data[i];
+      if (filter) {
+        if (is_case_sensitive_) {
+          keep[i] = stopwords_.count(s) == 0;
+        } else {
+          ORT_RETURN_IF_ERROR(ChangeCase(*locale_, ascii_case_mapping_, compare_caseaction_, s, converter, key));
+          keep[i] = stopwords_.count(key) == 0;
+          if (keep[i] && change_case) {
+            // compare_caseaction_ is the requested case action whenever there is one
+            cased[i] = key;
+            continue;
           }
         }
-        ++first;
       }
-      if (case_change_action_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
-                                N, filtered_orignal_strings.size(), NONE);
+      if (keep[i] && change_case) {
+        ORT_RETURN_IF_ERROR(ChangeCase(*locale_, ascii_case_mapping_, case_change_action_, s, converter, cased[i]));
+      }
+    }
+    return Status::OK();
+  };
+
+  // without filtering or case changing there is no per string work to split
+  concurrency::ThreadPool* tp = filter || change_case ? GetOperatorThreadPool(ctx) : nullptr;
+  const auto num_strings = static_cast<int64_t>(C);
+  const int64_t num_blocks = concurrency::ThreadPool::NumBlocks(tp, num_strings, num_strings,
+                                                                concurrency::ThreadPool::kMinLookupsPerBlock);
+  std::vector<Status> block_status(num_blocks);
+  concurrency::ThreadPool::ParallelForBlocks(tp, num_strings, num_blocks,
+                                             [&](int64_t block, int64_t first, int64_t last) {
+                                               block_status[block] = process(static_cast<size_t>(first),
+                                                                             static_cast<size_t>(last));
+                                             });
+  for (const auto& status : block_status) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  const size_t output_count = filter ? static_cast<size_t>(std::count(keep.cbegin(), keep.cend(), uint8_t{1})) : C;
+
+  std::vector<int64_t> output_dims;
+  if (N == 1) {
+    output_dims.push_back(1);
+  }
+
+  // Empty output case
+  if (output_count == 0) {
+    output_dims.push_back(1);
+    TensorShape output_shape(output_dims);
+    // This will create one empty string
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  output_dims.push_back(output_count);
+
+  TensorShape output_shape(output_dims);
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+
+  size_t output_idx = 0;
+  for (size_t i = 0; i < C; ++i) {
+    if (keep[i]) {
+      if (change_case) {
+        output_data[output_idx] = std::move(cased[i]);
       } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
+        output_data[output_idx] = input_data[i];
       }
-    } else {
-      // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, case_change_action_);
+      ++output_idx;
     }
   }
-  return status;
+
+  return Status::OK();
 }
 }  // namespace onnxruntime
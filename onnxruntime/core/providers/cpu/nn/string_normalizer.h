@@ -5,12 +5,16 @@
 
 #include "core/framework/op_kernel.h"
 
-#include <locale>
+#include <memory>
 #include <string>
 #include <unordered_set>
 
 namespace onnxruntime {
 
+namespace string_normalizer {
+class Locale;
+}  // namespace string_normalizer
+
 class StringNormalizer : public OpKernel {
  public:
   enum CaseAction {
@@ -20,7 +24,7 @@ class StringNormalizer : public OpKernel {
   };
 
   explicit StringNormalizer(const OpKernelInfo& info);
-  ~StringNormalizer() override = default;
+  ~StringNormalizer() override;
 
   Status Compute(OpKernelContext* ctx) const override;
 
@@ -29,9 +33,12 @@ class StringNormalizer : public OpKernel {
   CaseAction case_change_action_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
   std::string locale_name_;
-  // Either if these are populated but not both
+  std::unique_ptr<string_normalizer::Locale> locale_;
+  // true when the locale maps the case of ASCII characters like the C locale, so that
+  // strings made only of ASCII characters can be converted without widening them
+  bool ascii_case_mapping_;
+  // UTF-8 stopwords, converted to compare_caseaction_ when the comparison is case-insensitive
   std::unordered_set<std::string> stopwords_;
-  std::unordered_set<std::wstring> wstopwords_;
 };
 
 }  // namespace onnxruntime
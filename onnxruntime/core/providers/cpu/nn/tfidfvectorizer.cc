@@ -4,12 +4,12 @@
 #include "tfidfvectorizer.h"
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
+#include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 
-#include <functional>
-#include <unordered_set>
-#include <ostream>
-#include <iterator>
+#include <algorithm>
+#include <unordered_map>
 
 namespace onnxruntime {
 
@@ -42,148 +42,106 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
 
 namespace ngram_details {
 
-class NgramEntryBase {
-  size_t id_;  // Id in the pool
- protected:
-  NgramEntryBase(size_t id) : id_(id) {}
-  ~NgramEntryBase() = default;
-
+// A prefix trie of the pool n-grams. The items of the pool are first mapped to dense vocabulary ids, so an input item
+// is hashed once no matter how many n-grams it takes part in, and the edges of the trie are kept in one open
+// addressing table keyed by (parent node, vocabulary id). Extending an (n-1)-gram to an n-gram is a single probe.
+class NgramTrie {
  public:
-  size_t Id() const { return id_; }
-};
+  static constexpr int32_t kRoot = 0;
+  static constexpr int32_t kNone = -1;
 
-template <class T>
-class NgramEntry;
-
-template <>
-class NgramEntry<int64_t> : public NgramEntryBase {
-  std::vector<int64_t> items_;
-  size_t hash_ = 0;
+  NgramTrie() : node_ngram_id_(1, kNone) {}
 
-  void RunningHash(int64_t v) {
-    std::hash<int64_t> hf{};
-    hash_ ^= hf(v) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
+  int32_t Child(int32_t node, int32_t item) const {
+    if (edge_keys_.empty()) {
+      return kNone;
+    }
+    const uint64_t key = EdgeKey(node, item);
+    for (size_t slot = Slot(key);; slot = (slot + 1) & edge_mask_) {
+      if (edge_keys_[slot] == key) {
+        return edge_children_[slot];
+      }
+      if (edge_keys_[slot] == kEmptyKey) {
+        return kNone;
+      }
+    }
   }
 
- public:
+  // Returns the id of the pool n-gram ending at a node, or kNone if the node is only the prefix of longer n-grams.
+  int64_t NgramId(int32_t node) const { return node_ngram_id_[node]; }
+
+  // Adds an n-gram given by the vocabulary ids of its items. Returns false if the n-gram is already present.
   template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
-    while (first != last) {
-      RunningHash(*first);
-      items_.push_back(*first);
-      ++first;
+  bool Insert(ForwardIter first, ForwardIter last, int64_t ngram_id) {
+    int32_t node = kRoot;
+    for (; first != last; ++first) {
+      int32_t child = Child(node, *first);
+      if (child == kNone) {
+        child = static_cast<int32_t>(node_ngram_id_.size());
+        node_ngram_id_.push_back(kNone);
+        AddEdge(node, *first, child);
+      }
+      node = child;
     }
-    assert(!items_.empty());
-  }
-  // For sampling
-  explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(int64_t v) {
-    items_.push_back(v);
-    RunningHash(v);
-  }
-  void DebugPrint() const {
-    std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<int64_t>(std::cout, ","));
-    std::cout << std::endl;
-  }
-  void Clear() {
-    items_.clear();
-    hash_ = 0;
-  }
-  bool operator==(const NgramEntry& o) const {
-    return items_ == o.items_;
-  }
-  size_t Hash() const {
-    return hash_;
+    if (node_ngram_id_[node] != kNone) {
+      return false;
+    }
+    node_ngram_id_[node] = ngram_id;
+    return true;
   }
-};
-
-template <>
-class NgramEntry<int32_t> : public NgramEntry<int64_t> {
- public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntry<int64_t>(id, first, last) {}
-  explicit NgramEntry() = default;
-};
 
-template <>
-class NgramEntry<std::string> : public NgramEntryBase {
  private:
-  std::vector<std::reference_wrapper<const std::string>> items_;
-  size_t hash_ = 0;
+  static constexpr uint64_t kEmptyKey = ~uint64_t(0);
 
-  void RunningHash(const std::string& s) {
-    std::hash<std::string> hf{};
-    hash_ ^= hf(s) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
+  static uint64_t EdgeKey(int32_t node, int32_t item) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(node)) << 32) | static_cast<uint32_t>(item);
   }
 
- public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
-    while (first != last) {
-      RunningHash(*first);
-      items_.push_back(std::cref(*first));
-      ++first;
-    }
-    assert(!items_.empty());
-  }
-  explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(const std::string& s) {
-    items_.push_back(std::cref(s));
-    RunningHash(s);
-  }
-  void DebugPrint() const {
-    std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<std::string>(std::cout, ","));
-    std::cout << std::endl;
-  }
-  void Clear() {
-    items_.clear();
-    hash_ = 0;
+  size_t Slot(uint64_t key) const {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & edge_mask_;
   }
 
-  bool operator==(const NgramEntry& o) const {
-    if (items_.size() == o.items_.size()) {
-      return std::equal(items_.cbegin(), items_.cend(),
-                        o.items_.cbegin(), o.items_.cend(),
-                        std::equal_to<std::string>());
+  void AddEdge(int32_t node, int32_t item, int32_t child) {
+    // Keep the table at most half full
+    if (2 * (edge_count_ + 1) > edge_keys_.size()) {
+      std::vector<uint64_t> keys(std::max<size_t>(16, 2 * edge_keys_.size()), kEmptyKey);
+      std::vector<int32_t> children(keys.size(), kNone);
+      keys.swap(edge_keys_);
+      children.swap(edge_children_);
+      edge_mask_ = edge_keys_.size() - 1;
+      for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] != kEmptyKey) {
+          Place(keys[i], children[i]);
+        }
+      }
     }
-    return false;
-  }
-  size_t Hash() const {
-    return hash_;
+    Place(EdgeKey(node, item), child);
+    ++edge_count_;
   }
-};
 
-using IntegerPoolSet = std::unordered_set<NgramEntry<int64_t>>;
-// Does not own strings, contains references to them. This helps
-// to search by string references that point to the current input.
-using StringPoolSet = std::unordered_set<NgramEntry<std::string>>;
-
-template <typename ForwardIter, typename Cont>
-inline void Emplace(ForwardIter first, size_t ngrams, size_t ngram_size, size_t& ngram_id, Cont& c) {
-  for (; ngrams > 0; --ngrams) {
-    c.emplace(ngram_id, first, first + ngram_size);
-    first += ngram_size;
-    ++ngram_id;
+  void Place(uint64_t key, int32_t child) {
+    size_t slot = Slot(key);
+    while (edge_keys_[slot] != kEmptyKey) {
+      slot = (slot + 1) & edge_mask_;
+    }
+    edge_keys_[slot] = key;
+    edge_children_[slot] = child;
   }
-}
 
-}  // namespace ngram_details
-}  // namespace onnxruntime
+  std::vector<int64_t> node_ngram_id_;
+  std::vector<uint64_t> edge_keys_;
+  std::vector<int32_t> edge_children_;
+  size_t edge_mask_ = 0;
+  size_t edge_count_ = 0;
+};
 
-using namespace onnxruntime::ngram_details;
+constexpr int32_t NgramTrie::kRoot;
+constexpr int32_t NgramTrie::kNone;
+constexpr uint64_t NgramTrie::kEmptyKey;
 
-namespace std {
-template <typename T>
-struct hash<NgramEntry<T>> {
-  typedef NgramEntry<T> argument_type;
-  typedef size_t result_type;
-  result_type operator()(const argument_type& a) const {
-    return a.Hash();
-  }
-};
-}  // namespace std
+}  // namespace ngram_details
 
-namespace onnxruntime {
+using namespace ngram_details;
 
 // The weighting criteria.
 // "TF"(term frequency),
@@ -219,12 +177,10 @@ struct TfIdfVectorizer::Impl {
   std::vector<int64_t> ngram_indexes_;
   std::vector<float> weights_;
 
-  std::vector<std::string> pool_strings_;
-  // This set contains references to pool_string_ entries
-  // of pool_strings attribute
-  StringPoolSet str_set_;
-  // This set contains pool_int64s entries
-  IntegerPoolSet int64_set_;
+  // Dense ids of the distinct items of pool_strings or pool_int64s
+  std::unordered_map<std::string, int32_t> str_vocabulary_;
+  std::unordered_map<int64_t, int32_t> int64_vocabulary_;
+  NgramTrie trie_;
   size_t output_size_ = 0;
 
   Impl() = default;
@@ -233,48 +189,41 @@ struct TfIdfVectorizer::Impl {
   Impl& operator=(const Impl&) = delete;
 
   template <typename T>
-  auto PoolEnd() const;
+  int32_t VocabularyId(const T& item) const {
+    auto hit = int64_vocabulary_.find(static_cast<int64_t>(item));
+    return hit == int64_vocabulary_.end() ? NgramTrie::kNone : hit->second;
+  }
 
   template <typename T>
-  auto PoolFind(const ngram_details::NgramEntry<T>&) const;
-
-  void IncrementCount(size_t ngram_id, size_t row_num,
-                      std::vector<uint32_t>& frequencies) const {
-    assert(ngram_id < ngram_indexes_.size());
-    auto output_idx = row_num * output_size_ + ngram_indexes_[ngram_id];
-    assert(static_cast<size_t>(output_idx) < frequencies.size());
-    ++frequencies[output_idx];
+  int32_t AddToVocabulary(const T& item) {
+    return int64_vocabulary_.emplace(static_cast<int64_t>(item), static_cast<int32_t>(int64_vocabulary_.size()))
+        .first->second;
   }
-};
 
-template <>
-inline auto TfIdfVectorizer::Impl::PoolEnd<int64_t>() const {
-  return int64_set_.cend();
-}
-
-template <>
-inline auto TfIdfVectorizer::Impl::PoolEnd<int32_t>() const {
-  return PoolEnd<int64_t>();
-}
+  void IncrementCount(int32_t node, float* output_row) const {
+    const int64_t ngram_id = trie_.NgramId(node);
+    if (ngram_id != NgramTrie::kNone) {
+      assert(static_cast<size_t>(ngram_id) < ngram_indexes_.size());
+      output_row[ngram_indexes_[ngram_id]] += 1.0f;
+    }
+  }
 
-template <>
-inline auto TfIdfVectorizer::Impl::PoolEnd<std::string>() const {
-  return str_set_.cend();
-}
+  // Counts the n-grams of one row into output_row, given the vocabulary ids of the row items
+  void CountRow(const int32_t* ids, size_t C, float* output_row) const;
 
-template <>
-inline auto TfIdfVectorizer::Impl::PoolFind<int64_t>(const NgramEntry<int64_t>& i) const {
-  return int64_set_.find(i);
-}
+  // Applies the weighing criteria to the counts of one row
+  void WeighRow(float* output_row) const;
+};
 
 template <>
-inline auto TfIdfVectorizer::Impl::PoolFind<int32_t>(const NgramEntry<int32_t>& i) const {
-  return int64_set_.find(i);
+int32_t TfIdfVectorizer::Impl::VocabularyId<std::string>(const std::string& item) const {
+  auto hit = str_vocabulary_.find(item);
+  return hit == str_vocabulary_.end() ? NgramTrie::kNone : hit->second;
 }
 
 template <>
-inline auto TfIdfVectorizer::Impl::PoolFind<std::string>(const NgramEntry<std::string>& i) const {
-  return str_set_.find(i);
+int32_t TfIdfVectorizer::Impl::AddToVocabulary<std::string>(const std::string& item) {
+  return str_vocabulary_.emplace(item, static_cast<int32_t>(str_vocabulary_.size())).first->second;
 }
 
 TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), impl_(new Impl) {
@@ -334,18 +283,25 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
   }
 
   std::vector<int64_t> pool_int64s;
-  status = info.GetAttrs("pool_strings", impl_->pool_strings_);
+  std::vector<std::string> pool_strings;
+  status = info.GetAttrs("pool_strings", pool_strings);
   if (status.IsOK()) {
-    ORT_ENFORCE(!impl_->pool_strings_.empty(), "pool_strings must not be empty if specified");
+    ORT_ENFORCE(!pool_strings.empty(), "pool_strings must not be empty if specified");
   } else {
     status = info.GetAttrs("pool_int64s", pool_int64s);
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
   }
 
+  // Map the pool items to vocabulary ids
+  const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
+  std::vector<int32_t> pool_ids(total_items);
+  for (size_t i = 0; i < total_items; ++i) {
+    pool_ids[i] = pool_strings.empty() ? impl_->AddToVocabulary(pool_int64s[i]) : impl_->AddToVocabulary(pool_strings[i]);
+  }
+
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
-  const auto total_items = (impl_->pool_strings_.empty()) ? pool_int64s.size() : impl_->pool_strings_.size();
   size_t ngram_id = 0;
-  // Load into dictionary only required gram sizes
+  // Load into the trie only required gram sizes
   const size_t min_gram_length = impl_->min_gram_length_;
   const size_t max_gram_length = impl_->max_gram_length_;
   size_t ngram_size = 1;
@@ -359,16 +315,15 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       ORT_ENFORCE((items % ngram_size == 0),
                   "Number of items must compose whole ", std::to_string(ngram_size), "-grams");
       auto ngrams = items / ngram_size;
-      // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
+      // Skip loading into the trie ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
-        if (impl_->pool_strings_.empty()) {
-          auto before_insert = impl_->int64_set_.size();
-          Emplace(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_set_);
-          ORT_ENFORCE((before_insert + ngrams) == impl_->int64_set_.size(), "pool_int64s duplicate ", std::to_string(ngram_size), "-grams detected");
-        } else {
-          auto before_insert = impl_->str_set_.size();
-          Emplace(impl_->pool_strings_.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_set_);
-          ORT_ENFORCE((before_insert + ngrams) == impl_->str_set_.size(), "poll_strings duplicate ", std::to_string(ngram_size), "-grams detected");
+        auto first = pool_ids.cbegin() + start_idx;
+        for (size_t n = 0; n < ngrams; ++n, first += ngram_size, ++ngram_id) {
+          ORT_ENFORCE(ngram_id < impl_->ngram_indexes_.size(),
+                      "ngram_indexes has fewer entries than the pool has n-grams");
+          ORT_ENFORCE(impl_->trie_.Insert(first, first + ngram_size, static_cast<int64_t>(ngram_id)),
+                      pool_strings.empty() ? "pool_int64s" : "poll_strings", " duplicate ",
+                      std::to_string(ngram_size), "-grams detected");
         }
       } else {
         ngram_id += ngrams;
@@ -380,50 +335,72 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
 
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
-void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::vector<uint32_t>& frequences) const {
-  const Impl& impl = *impl_;
-  std::vector<int64_t> output_dims;
-  if (B == 0) {
-    output_dims.push_back(impl.output_size_);
-  } else {
-    output_dims.push_back(B);
-    output_dims.push_back(impl.output_size_);
-  }
+void TfIdfVectorizer::Impl::CountRow(const int32_t* ids, size_t C, float* output_row) const {
+  const auto* const row_end = ids + C;
+  auto start_ngram_size = min_gram_length_;
 
-  TensorShape output_shape(output_dims);
-  assert(frequences.size() == static_cast<size_t>(output_shape.Size()));
+  // Treat 1-grams in a special way, they are counted once and not for every skip distance
+  if (start_ngram_size == 1) {
+    for (const auto* item = ids; item < row_end; ++item) {
+      if (*item != NgramTrie::kNone) {
+        const int32_t node = trie_.Child(NgramTrie::kRoot, *item);
+        if (node != NgramTrie::kNone) {
+          IncrementCount(node, output_row);
+        }
+      }
+    }
+    if (++start_ngram_size > max_gram_length_) {
+      return;
+    }
+  }
 
-  auto Y = ctx->Output(0, output_shape);
-  auto output_data = Y->MutableData<float>();
-  const auto& w = impl.weights_;
-  switch (impl.weighting_criteria_) {
-    case kTF: {
-      for (auto f : frequences) {
-        *output_data++ = static_cast<float>(f);
+  const auto max_skip_distance = max_skip_count_ + 1;  // Convert to distance
+  for (int64_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    for (const auto* ngram_start = ids; ngram_start < row_end; ++ngram_start) {
+      // At least items of start_ngram_size should fit before the end of the row
+      if (skip_distance * (start_ngram_size - 1) >= row_end - ngram_start) {
+        break;
       }
-    } break;
-    case kIDF: {
-      if (!w.empty()) {
-        assert(frequences.size() == w.size());
-        for (size_t i = 0; i < frequences.size(); ++i) {
-          *output_data++ = (frequences[i] > 0) ? w[i] : 0;
+      // Walk down the trie and stop as soon as the items read so far are not the prefix of any pool n-gram
+      int32_t node = NgramTrie::kRoot;
+      const auto* ngram_item = ngram_start;
+      for (int64_t ngram_size = 1; ngram_size <= max_gram_length_; ++ngram_size, ngram_item += skip_distance) {
+        if (*ngram_item == NgramTrie::kNone) {
+          break;
         }
-      } else {
-        for (auto f : frequences) {
-          *output_data++ = (f > 0) ? 1.0f : 0;
+        node = trie_.Child(node, *ngram_item);
+        if (node == NgramTrie::kNone) {
+          break;
+        }
+        // Do not count anything before start_ngram_size
+        if (ngram_size >= start_ngram_size) {
+          IncrementCount(node, output_row);
+        }
+        if (skip_distance >= row_end - ngram_item) {
+          break;
+        }
+      }
+    }
+  }
+}
+
+void TfIdfVectorizer::Impl::WeighRow(float* output_row) const {
+  // The i-th weight applies to the i-th output column
+  const auto& w = weights_;
+  const size_t weighted = std::min(w.size(), output_size_);
+  switch (weighting_criteria_) {
+    case kTF:
+      break;
+    case kIDF: {
+      for (size_t i = 0; i < output_size_; ++i) {
+        if (output_row[i] > 0) {
+          output_row[i] = i < weighted ? w[i] : 1.0f;
         }
       }
     } break;
     case kTFIDF: {
-      if (!w.empty()) {
-        assert(frequences.size() == w.size());
-        for (size_t i = 0; i < frequences.size(); ++i) {
-          *output_data++ = frequences[i] * w[i];
-        }
-      } else {
-        for (auto f : frequences) {
-          *output_data++ = static_cast<float>(f);
-        }
+      for (size_t i = 0; i < weighted; ++i) {
+        output_row[i] *= w[i];
       }
     } break;
     case kNone:  // fall-through
@@ -435,7 +412,6 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
 template <typename T>
 Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
   const auto& impl = *impl_;
-  auto const set_end = impl.PoolEnd<T>();
 
   auto X = ctx->Input<Tensor>(0);
   auto& input_shape = X->Shape();
@@ -465,99 +441,52 @@ Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
                   "Input shape must have either [C] or [B,C] dimensions with B > 0.");
   }
 
-  // Frequency holder allocate [B..output_size_]
-  // and init all to zero
-  std::vector<uint32_t> frequencies;
-  frequencies.resize(b_dim * impl.output_size_, 0);
-
-  if (input_shape.Size() == 0) {
-    // TfidfVectorizer may receive an empty input when it follows a Tokenizer
-    // (for example for a string containing only stopwords).
-    // TfidfVectorizer returns a zero tensor of shape
-    // {b_dim, output_size} when b_dim is the number of received observations
-    // and output_size the is the maximum value in ngram_indexes attribute plus 1.
-    OutputResult(ctx, B, frequencies);
+  std::vector<int64_t> output_dims;
+  if (B == 0) {
+    output_dims.push_back(impl.output_size_);
+  } else {
+    output_dims.push_back(B);
+    output_dims.push_back(impl.output_size_);
+  }
+
+  // The counts are accumulated directly in the zero initialized output.
+  // TfidfVectorizer may receive an empty input when it follows a Tokenizer
+  // (for example for a string containing only stopwords), in which case
+  // it returns a zero tensor of shape {b_dim, output_size}.
+  auto Y = ctx->Output(0, TensorShape(output_dims));
+  auto output_data = Y->MutableData<float>();
+  std::fill_n(output_data, b_dim * impl.output_size_, 0.0f);
+
+  if (total_items == 0) {
     return Status::OK();
   }
 
   assert((b_dim * C) == total_items);
-
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
   auto const input_data = X->template Data<T>();
-  auto const end_data = input_data + total_items;
-  NgramEntry<T> sample;
 
-  // Treat 1-grams in a special way
-  if (start_ngram_size == 1) {
-    size_t row_num = 0;
-    auto ngram_start = input_data;
-    while (ngram_start < end_data) {
-      auto const ngram_row_end = ngram_start + C;
-      while (ngram_start < ngram_row_end) {
-        sample.Clear();
-        sample.AddItem(*ngram_start);
-        auto hit = impl.PoolFind<T>(sample);
-        if (hit != set_end) {
-          // record frequency
-          auto ngram_id = hit->Id();
-          impl.IncrementCount(ngram_id, row_num, frequencies);
-        }
-        ++ngram_start;
+  auto process_rows = [&](size_t first, size_t last) {
+    // The vocabulary ids of the items of the current row
+    std::vector<int32_t> ids(C);
+    for (size_t row_num = first; row_num < last; ++row_num) {
+      const T* row = input_data + row_num * C;
+      for (size_t i = 0; i < C; ++i) {
+        ids[i] = impl.VocabularyId(row[i]);
       }
-      ++row_num;
-      ngram_start = ngram_row_end;
-    }
-    if (++start_ngram_size > max_gram_length) {
-      OutputResult(ctx, B, frequencies);
-      return Status::OK();
+      float* output_row = output_data + row_num * impl.output_size_;
+      impl.CountRow(ids.data(), C, output_row);
+      impl.WeighRow(output_row);
     }
-  }
+  };
+
+  auto* tp = GetOperatorThreadPool(ctx);
+  const int64_t work_per_row = static_cast<int64_t>(C) * impl.max_gram_length_ * (impl.max_skip_count_ + 1);
+  const auto num_rows = static_cast<int64_t>(b_dim);
+  concurrency::ThreadPool::TryParallelForBlocks(tp, num_rows, num_rows * work_per_row,
+                                                concurrency::ThreadPool::kMinElementsPerBlock,
+                                                [&](int64_t first, int64_t last) {
+                                                  process_rows(static_cast<size_t>(first), static_cast<size_t>(last));
+                                                });
 
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = input_data;
-    size_t row_num = 0;
-    while (ngram_start < end_data) {
-      assert((B == 0) || (row_num < B));
-      auto const ngram_row_end = ngram_start + C;
-      assert(ngram_row_end <= end_data);
-      while (ngram_start < ngram_row_end) {
-        // Check if any n-gram size in [start_ngram_size..max_gram_length] range
-        // fit before the end of the row so we do not waste time adding [1..start_ngram_size)
-        // At least items of start_ngram_size should fit
-        // last row should match end_data
-        auto at_least_this = ngram_start + skip_distance * (start_ngram_size - 1);
-        if (at_least_this >= ngram_row_end) {
-          break;
-        }
-        sample.Clear();
-        auto ngram_item = ngram_start;
-        for (auto ngram_size = 1;
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item += skip_distance) {
-          sample.AddItem(*ngram_item);
-
-          // Do not test anything before start_ngram_size
-          if (ngram_size >= start_ngram_size) {
-            auto hit = impl.PoolFind<T>(sample);
-            if (hit != set_end) {
-              // record frequency
-              auto ngram_id = hit->Id();
-              impl.IncrementCount(ngram_id, row_num, frequencies);
-            }
-          }
-        }
-        // Sliding window shift
-        ++ngram_start;
-      }
-      // Next row
-      ngram_start = ngram_row_end;
-      ++row_num;
-    }
-  }
-  OutputResult(ctx, B, frequencies);
   return Status::OK();
 }
 
@@ -13,7 +13,9 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
-#include <queue>
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
+#include <algorithm>
 
 namespace onnxruntime {
 
@@ -122,6 +124,36 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
+  const auto center_point_box = GetCenterPointBox();
+
+  // Convert the boxes of every batch once to corner coordinates and areas, stored as separate arrays so that the
+  // IoU of a candidate against all the selected boxes of a class is computed with contiguous loads.
+  const int64_t num_boxes = pc.num_boxes_;
+  const int64_t total_boxes = pc.num_batches_ * num_boxes;
+  std::vector<float> box_coordinates(5 * total_boxes);
+  float* const x_min = box_coordinates.data();
+  float* const y_min = x_min + total_boxes;
+  float* const x_max = y_min + total_boxes;
+  float* const y_max = x_max + total_boxes;
+  float* const area = y_max + total_boxes;
+  for (int64_t i = 0; i < total_boxes; ++i) {
+    const float* box = boxes_data + 4 * i;
+    // center_point_box_ only support 0 or 1
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2],
+      MaxMin(box[1], box[3], x_min[i], x_max[i]);
+      MaxMin(box[0], box[2], y_min[i], y_max[i]);
+    } else {
+      // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      x_min[i] = box[0] - width_half;
+      x_max[i] = box[0] + width_half;
+      y_min[i] = box[1] - height_half;
+      y_max[i] = box[1] + height_half;
+    }
+    area[i] = (x_max[i] - x_min[i]) * (y_max[i] - y_min[i]);
+  }
 
   struct ScoreIndexPair {
     float score_{};
@@ -130,61 +162,99 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
     ScoreIndexPair() = default;
     explicit ScoreIndexPair(float score, int64_t idx) : score_(score), index_(idx) {}
 
+    // Higher scores first, and the lower box index first among equal scores.
     bool operator<(const ScoreIndexPair& rhs) const {
-      return score_ < rhs.score_;
+      return score_ > rhs.score_ || (score_ == rhs.score_ && index_ < rhs.index_);
     }
   };
 
-  const auto center_point_box = GetCenterPointBox();
-
-  std::vector<SelectedIndex> selected_indices;
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      int64_t box_offset = batch_index * pc.num_classes_ * pc.num_boxes_ * 4;
-      // Filter by score_threshold_
-      std::priority_queue<ScoreIndexPair, std::deque<ScoreIndexPair>> sorted_scores_with_index;
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            sorted_scores_with_index.push(ScoreIndexPair(*class_scores, box_index));
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          sorted_scores_with_index.push(ScoreIndexPair(*class_scores, box_index));
+  // Candidates are checked against the selected boxes in blocks, which keeps the inner loop free of branches so it
+  // can be vectorized while still stopping soon after the first overlap.
+  constexpr int64_t kIouBlockSize = 16;
+
+  const int64_t num_pairs = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<SelectedIndex>> selected_per_pair(num_pairs);
+
+  auto suppress_pairs = [&](int64_t first, int64_t last) {
+    std::vector<ScoreIndexPair> candidates;
+    std::vector<float> selected_coordinates;
+    for (int64_t pair_index = first; pair_index < last; ++pair_index) {
+      const int64_t batch_index = pair_index / pc.num_classes_;
+      const int64_t class_index = pair_index % pc.num_classes_;
+      const int64_t box_base = batch_index * num_boxes;
+
+      // Filter by score_threshold_ and sort once
+      candidates.clear();
+      const auto* class_scores = scores_data + pair_index * num_boxes;
+      for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+        if (pc.score_threshold_ == nullptr || class_scores[box_index] > score_threshold) {
+          candidates.emplace_back(class_scores[box_index], box_index);
         }
       }
+      std::sort(candidates.begin(), candidates.end());
+
+      const int64_t max_selected = std::min<int64_t>(max_output_boxes_per_class,
+                                                     static_cast<int64_t>(candidates.size()));
+      selected_coordinates.resize(5 * max_selected);
+      float* const sel_x_min = selected_coordinates.data();
+      float* const sel_y_min = sel_x_min + max_selected;
+      float* const sel_x_max = sel_y_min + max_selected;
+      float* const sel_y_max = sel_x_max + max_selected;
+      float* const sel_area = sel_y_max + max_selected;
+
+      auto& selected = selected_per_pair[pair_index];
+      int64_t num_selected = 0;
+      for (const auto& candidate : candidates) {
+        if (num_selected >= max_selected) {
+          break;
+        }
 
-      ScoreIndexPair next_top_score;
-      std::vector<int64_t> selected_indicies_inside_class;
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_scores_with_index.empty()) {
-        next_top_score = sorted_scores_with_index.top();
-        sorted_scores_with_index.pop();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (int64_t selected_index : selected_indicies_inside_class) {
-          if (SuppressByIOU(boxes_data + box_offset, selected_index, next_top_score.index_,
-                            center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+        const int64_t i = box_base + candidate.index_;
+        const float cx_min = x_min[i];
+        const float cy_min = y_min[i];
+        const float cx_max = x_max[i];
+        const float cy_max = y_max[i];
+        const float carea = area[i];
+
+        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union)
+        // threshold. This is the same test as SuppressByIOU.
+        bool suppressed = false;
+        for (int64_t block = 0; block < num_selected && !suppressed; block += kIouBlockSize) {
+          const int64_t block_end = std::min(block + kIouBlockSize, num_selected);
+          int overlaps = 0;
+          for (int64_t j = block; j < block_end; ++j) {
+            const float intersection_area =
+                std::max(std::min(cx_max, sel_x_max[j]) - std::max(cx_min, sel_x_min[j]), .0f) *
+                std::max(std::min(cy_max, sel_y_max[j]) - std::max(cy_min, sel_y_min[j]), .0f);
+            const float union_area = carea + sel_area[j] - intersection_area;
+            overlaps += (intersection_area > .0f) & (carea > .0f) & (sel_area[j] > .0f) & (union_area > .0f) &
+                        (intersection_area / union_area > iou_threshold);
           }
+          suppressed = overlaps != 0;
         }
 
-        if (selected) {
-          if (max_output_boxes_per_class > 0 &&
-              static_cast<int64_t>(selected_indicies_inside_class.size()) >= max_output_boxes_per_class) {
-            break;
-          }
-          selected_indicies_inside_class.push_back(next_top_score.index_);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+        if (!suppressed) {
+          sel_x_min[num_selected] = cx_min;
+          sel_y_min[num_selected] = cy_min;
+          sel_x_max[num_selected] = cx_max;
+          sel_y_max[num_selected] = cy_max;
+          sel_area[num_selected] = carea;
+          ++num_selected;
+          selected.emplace_back(batch_index, class_index, candidate.index_);
         }
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+      }
+    }
+  };
+
+  // boxes are only suppressed within their (batch, class) pair, so the pairs are split by their box count
+  auto* tp = GetOperatorThreadPool(ctx);
+  concurrency::ThreadPool::TryParallelForBlocks(tp, num_pairs, num_pairs * num_boxes,
+                                                concurrency::ThreadPool::kMinBoxesPerBlock, suppress_pairs);
+
+  std::vector<SelectedIndex> selected_indices;
+  for (const auto& selected : selected_per_pair) {
+    selected_indices.insert(selected_indices.end(), selected.begin(), selected.end());
+  }
 
   const auto last_dim = 3;
   const auto num_selected = selected_indices.size();
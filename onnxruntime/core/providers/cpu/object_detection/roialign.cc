@@ -170,105 +170,109 @@ void RoiAlignForward(
     T* top_data,
     const std::string& mode,
     const int64_t* batch_indices_ptr,
-    const ThreadPool* ttp) {
+    ThreadPool* tp) {
   int64_t n_rois = nthreads / channels / pooled_width / pooled_height;
-
-  std::function<void(int32_t)> work_object = [&](int32_t n) {
-    int64_t index_n = n * channels * pooled_width * pooled_height;
-
-    const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
-    const auto roi_batch_ind = batch_indices_ptr[n];
-
-    // Do not using rounding; this implementation detail is critical
-    T roi_start_w = offset_bottom_rois[0] * spatial_scale;
-    T roi_start_h = offset_bottom_rois[1] * spatial_scale;
-    T roi_end_w = offset_bottom_rois[2] * spatial_scale;
-    T roi_end_h = offset_bottom_rois[3] * spatial_scale;
-
-    // Force malformed ROIs to be 1x1
-    T roi_width = std::max(roi_end_w - roi_start_w, (T)1.);
-    T roi_height = std::max(roi_end_h - roi_start_h, (T)1.);
-    T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
-    T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
-
-    // We use roi_bin_grid to sample the grid and mimic integral
-    int64_t roi_bin_grid_h = (sampling_ratio > 0)
-                                 ? sampling_ratio
-                                 : static_cast<int64_t>(std::ceil(roi_height / pooled_height));  // e.g., = 2
-    int64_t roi_bin_grid_w =
-        (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
-
-    // We do average (integral) pooling inside a bin
-    const int64_t count = roi_bin_grid_h * roi_bin_grid_w;  // e.g. = 4
-
-    // we want to precalculate indices and weights shared by all channels,
-    // this is the key point of optimization
-    std::vector<PreCalc<T>> pre_calc(
-        roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
-    pre_calc_for_bilinear_interpolate(
-        height,
-        width,
-        pooled_height,
-        pooled_width,
-        roi_bin_grid_h,
-        roi_bin_grid_w,
-        roi_start_h,
-        roi_start_w,
-        bin_size_h,
-        bin_size_w,
-        roi_bin_grid_h,
-        roi_bin_grid_w,
-        pre_calc);
-
-    for (int64_t c = 0; c < channels; c++) {
-      int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-      const T* offset_bottom_data =
-          bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-      int64_t pre_calc_index = 0;
-
-      for (int64_t ph = 0; ph < pooled_height; ph++) {
-        for (int64_t pw = 0; pw < pooled_width; pw++) {
-          int64_t index = index_n_c + ph * pooled_width + pw;
-
-          T output_val = 0.;
-          if (mode == "avg") {  // avg pooling
-            for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-              for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                PreCalc<T> pc = pre_calc[pre_calc_index];
+  const bool avg_mode = mode == "avg";
+
+  // The ROIs are split into one contiguous block per thread rather than one task per ROI, and every block reuses a
+  // single table of sample positions and weights.
+  auto work_object = [&](int64_t first_roi, int64_t last_roi) {
+    std::vector<PreCalc<T>> pre_calc;
+    for (int64_t n = first_roi; n < last_roi; n++) {
+      int64_t index_n = n * channels * pooled_width * pooled_height;
+
+      const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+      const auto roi_batch_ind = batch_indices_ptr[n];
+
+      // Do not using rounding; this implementation detail is critical
+      T roi_start_w = offset_bottom_rois[0] * spatial_scale;
+      T roi_start_h = offset_bottom_rois[1] * spatial_scale;
+      T roi_end_w = offset_bottom_rois[2] * spatial_scale;
+      T roi_end_h = offset_bottom_rois[3] * spatial_scale;
+
+      // Force malformed ROIs to be 1x1
+      T roi_width = std::max(roi_end_w - roi_start_w, (T)1.);
+      T roi_height = std::max(roi_end_h - roi_start_h, (T)1.);
+      T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
+      T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
+
+      // We use roi_bin_grid to sample the grid and mimic integral
+      int64_t roi_bin_grid_h = (sampling_ratio > 0)
+                                   ? sampling_ratio
+                                   : static_cast<int64_t>(std::ceil(roi_height / pooled_height));  // e.g., = 2
+      int64_t roi_bin_grid_w =
+          (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
+
+      // We do average (integral) pooling inside a bin
+      const int64_t count = roi_bin_grid_h * roi_bin_grid_w;  // e.g. = 4
+
+      // we want to precalculate indices and weights shared by all channels,
+      // this is the key point of optimization
+      pre_calc.resize(roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
+      pre_calc_for_bilinear_interpolate(
+          height,
+          width,
+          pooled_height,
+          pooled_width,
+          roi_bin_grid_h,
+          roi_bin_grid_w,
+          roi_start_h,
+          roi_start_w,
+          bin_size_h,
+          bin_size_w,
+          roi_bin_grid_h,
+          roi_bin_grid_w,
+          pre_calc);
+
+      for (int64_t c = 0; c < channels; c++) {
+        int64_t index_n_c = index_n + c * pooled_width * pooled_height;
+        const T* offset_bottom_data =
+            bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
+        int64_t pre_calc_index = 0;
+
+        for (int64_t ph = 0; ph < pooled_height; ph++) {
+          for (int64_t pw = 0; pw < pooled_width; pw++) {
+            int64_t index = index_n_c + ph * pooled_width + pw;
+
+            T output_val = 0.;
+            if (avg_mode) {  // avg pooling
+              const PreCalc<T>* bin_pre_calc = pre_calc.data() + pre_calc_index;
+              for (int64_t i = 0; i < count; i++) {
+                const PreCalc<T>& pc = bin_pre_calc[i];
                 output_val += pc.w1 * offset_bottom_data[pc.pos1] +
                               pc.w2 * offset_bottom_data[pc.pos2] +
                               pc.w3 * offset_bottom_data[pc.pos3] +
                               pc.w4 * offset_bottom_data[pc.pos4];
-
-                pre_calc_index += 1;
               }
-            }
-            output_val /= count;
-          } else {  // max pooling
-            bool max_flag = false;
-            for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-              for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                PreCalc<T> pc = pre_calc[pre_calc_index];
-                if (!max_flag) {
-                  output_val = pc.w1 * offset_bottom_data[pc.pos1];
-                  max_flag = true;
-                } else {
-                  output_val = std::max(std::max(std::max(output_val, pc.w2 * offset_bottom_data[pc.pos2]),
-                                                 pc.w3 * offset_bottom_data[pc.pos3]),
-                                        pc.w4 * offset_bottom_data[pc.pos4]);
+              pre_calc_index += count;
+              output_val /= count;
+            } else {  // max pooling
+              bool max_flag = false;
+              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
+                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
+                  const PreCalc<T>& pc = pre_calc[pre_calc_index];
+                  if (!max_flag) {
+                    output_val = pc.w1 * offset_bottom_data[pc.pos1];
+                    max_flag = true;
+                  } else {
+                    output_val = std::max(std::max(std::max(output_val, pc.w2 * offset_bottom_data[pc.pos2]),
+                                                   pc.w3 * offset_bottom_data[pc.pos3]),
+                                          pc.w4 * offset_bottom_data[pc.pos4]);
+                  }
+
+                  pre_calc_index += 1;
                 }
-
-                pre_calc_index += 1;
               }
             }
-          }
 
-          top_data[index] = output_val;
-        }  // for pw
-      }    // for ph
-    }      // for c
-  };       // for n
-  const_cast<ThreadPool*>(ttp)->ParallelFor(static_cast<int32_t>(n_rois), work_object);
+            top_data[index] = output_val;
+          }  // for pw
+        }    // for ph
+      }      // for c
+    }        // for n
+  };
+
+  ThreadPool::TryParallelForBlocks(tp, n_rois, nthreads, ThreadPool::kMinElementsPerBlock, work_object);
 }
 }  // namespace
 
@@ -349,7 +353,7 @@ Status RoiAlign<T>::Compute(OpKernelContext* context) const {
       Y.template MutableData<T>(),
       mode_,
       batch_indices_ptr->Data<int64_t>(),
-      static_cast<OpKernelContextInternal*>(context)->GetOperatorThreadPool());
+      GetOperatorThreadPool(context));
 
   return Status::OK();
 }
@@ -17,6 +17,7 @@
 
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/tensor.h"
 
 #include "core/platform/ort_mutex.h"
@@ -167,11 +168,15 @@ class UniDirectionalGru {
   UniDirectionalGru(AllocatorPtr allocator, int seq_length, int batch_size, int input_size, int hidden_size,
                     bool linear_before_reset, Direction direction, const gsl::span<const T>& bias,
                     const gsl::span<const T>& initial_hidden_state, const ActivationFuncs::Entry& activation_func_f,
-                    const ActivationFuncs::Entry& activation_func_g, float clip);
+                    const ActivationFuncs::Entry& activation_func_g, float clip,
+                    onnxruntime::concurrency::ThreadPool* thread_pool);
 
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
                const gsl::span<const T>& input_weights, const gsl::span<const T>& recurrent_weights,
-               gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
+               gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
+               const DynamicQuantizedWeights* quantized_input_weights = nullptr,
+               const DynamicQuantizedWeights* quantized_recurrent_weightsZR = nullptr,
+               const DynamicQuantizedWeights* quantized_recurrent_weightsH = nullptr);
 
   ~UniDirectionalGru() = default;
 
@@ -232,6 +237,9 @@ class UniDirectionalGru {
   deepcpu::ActivationFuncPtr update_gate_{};
   deepcpu::GruOutputGateFuncPtr output_gate_{};
 
+  // intra-op thread pool of the session used to partition the GEMMs. may be nullptr.
+  onnxruntime::concurrency::ThreadPool* thread_pool_;
+
   void AllocateBuffers();
 };
 }  // namespace detail
@@ -301,6 +309,9 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
+
+  auto* thread_pool = GetOperatorThreadPool(&context);
+
   gsl::span<const T> input_weights = W.DataAsSpan<T>();
   gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
@@ -318,8 +329,23 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   gsl::span<const int> sequence_lens_span = sequence_lens != nullptr ? sequence_lens->DataAsSpan<int>()
                                                                      : gsl::span<const int>();
 
+  // process the batch in order of decreasing sequence length so that each step only computes the rows that are
+  // still active. the outputs are moved back to the original batch order at the end.
+  std::vector<int> batch_order;
+  IAllocatorUniquePtr<T> sorted_input_ptr, sorted_initial_hidden_ptr;
+  IAllocatorUniquePtr<int> sorted_sequence_lens_ptr;
+  const bool reorder_batch = SortBatchBySequenceLength(sequence_lens_span, batch_order);
+  if (reorder_batch) {
+    input = GatherBatch(input, batch_size, input_size, batch_order, alloc, sorted_input_ptr);
+    sequence_lens_span = GatherBatch(sequence_lens_span, batch_size, 1, batch_order, alloc, sorted_sequence_lens_ptr);
+  }
+
   const size_t initial_hidden_size_per_direction = batch_size * hidden_size_;
   gsl::span<const T> initial_hidden = initial_h != nullptr ? initial_h->DataAsSpan<T>() : gsl::span<const T>();
+  if (reorder_batch) {
+    initial_hidden = GatherBatch(initial_hidden, batch_size, hidden_size_, batch_order, alloc,
+                                 sorted_initial_hidden_ptr);
+  }
   gsl::span<const T> initial_hidden_1 = initial_hidden.empty()
                                             ? initial_hidden
                                             : initial_hidden.subspan(0, initial_hidden_size_per_direction);
@@ -374,8 +400,11 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
         bias_1, initial_hidden_1,
         activation_funcs_.Entries()[0],
         activation_funcs_.Entries()[1],
-        clip_);
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+        clip_, thread_pool);
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1,
+                QuantizedWeightsForDirection(quantized_input_weights_, 0),
+                QuantizedWeightsForDirection(quantized_recurrent_weightsZR_, 0),
+                QuantizedWeightsForDirection(quantized_recurrent_weightsH_, 0));
 
     std::unique_ptr<detail::UniDirectionalGru<T>> bw = std::make_unique<detail::UniDirectionalGru<T>>(
         alloc,
@@ -388,8 +417,11 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
         bias_2, initial_hidden_2,
         activation_funcs_.Entries()[2],
         activation_funcs_.Entries()[3],
-        clip_);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2);
+        clip_, thread_pool);
+    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2,
+                QuantizedWeightsForDirection(quantized_input_weights_, 1),
+                QuantizedWeightsForDirection(quantized_recurrent_weightsZR_, 1),
+                QuantizedWeightsForDirection(quantized_recurrent_weightsH_, 1));
   } else {
     std::unique_ptr<detail::UniDirectionalGru<T>> gru_p = std::make_unique<detail::UniDirectionalGru<T>>(
         alloc,
@@ -402,9 +434,18 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
         bias_1, initial_hidden_1,
         activation_funcs_.Entries()[0],
         activation_funcs_.Entries()[1],
-        clip_);
+        clip_, thread_pool);
 
-    gru_p->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+    gru_p->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1,
+                   QuantizedWeightsForDirection(quantized_input_weights_, 0),
+                   QuantizedWeightsForDirection(quantized_recurrent_weightsZR_, 0),
+                   QuantizedWeightsForDirection(quantized_recurrent_weightsH_, 0));
+  }
+
+  if (reorder_batch) {
+    ScatterBatch(output, batch_size, hidden_size_, batch_order, alloc);
+    if (Y_h != nullptr)
+      ScatterBatch(hidden_output, batch_size, hidden_size_, batch_order, alloc);
   }
 
   if (!output.empty())
@@ -431,7 +472,8 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
                                         const gsl::span<const T>& initial_hidden_state,
                                         const ActivationFuncs::Entry& activation_func_f,
                                         const ActivationFuncs::Entry& activation_func_g,
-                                        const float clip)
+                                        const float clip,
+                                        onnxruntime::concurrency::ThreadPool* thread_pool)
     : allocator_(allocator),
       seq_length_(seq_length),
       batch_size_(batch_size),
@@ -440,7 +482,8 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
       linear_before_reset_(linear_before_reset),
       clip_(clip),
       direction_(direction),
-      use_bias_(!bias.empty()) {
+      use_bias_(!bias.empty()),
+      thread_pool_(thread_pool) {
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
   // setup activation function pointers and alpha/beta values to use with them
@@ -505,7 +548,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const gsl::span<const T>& input_weights,
                                    const gsl::span<const T>& recurrent_weights,
                                    gsl::span<T>& outputs,
-                                   gsl::span<T>& final_hidden_state) {
+                                   gsl::span<T>& final_hidden_state,
+                                   const DynamicQuantizedWeights* quantized_input_weights,
+                                   const DynamicQuantizedWeights* quantized_recurrent_weightsZR,
+                                   const DynamicQuantizedWeights* quantized_recurrent_weightsH) {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
   using span_T_iter = typename gsl::span<T>::iterator;
 
@@ -545,6 +591,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   int32_t min_sequence_length = std::min(seq_length_, *std::min_element(sequence_lengths.cbegin(),
                                                                         sequence_lengths.cend()));
 
+  // if the batch is ordered by decreasing sequence length the active rows of each step are a prefix of the batch,
+  // so the rows that have finished can be left out of the recurrent GEMMs and the reset gate computations.
+  const bool batch_sorted = std::is_sorted(sequence_lengths.rbegin(), sequence_lengths.rend());
+  int active_rows = batch_size_;
+
   const int hidden_size_x2 = 2 * hidden_size_;
   const int hidden_size_x3 = 3 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
@@ -559,7 +610,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
               input_weights.cbegin(), input_weights.cend(),
               input_size_, beta,
               outputZRH_.begin(), outputZRH_.end(),
-              hidden_size_x3);
+              hidden_size_x3, quantized_input_weights, allocator_, thread_pool_);
 
   DumpMatrix("inputs with weights applied", outputZRH_.data(), seq_length_ * batch_size_ * 3, hidden_size_);
 
@@ -614,17 +665,20 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
     DumpMatrix("Ht-1" + seqno_str, &*prev_Ht, batch_size_, hidden_size_);
 
+    if (batch_sorted)
+      active_rows = ActiveBatchRows(sequence_lengths, step, active_rows);
+
     out_added_offset = (step * batch_size_) * hidden_size_x3;
 
     // calculate Ht-1*R[zr], and add to the weighted inputs that are in outputZRH_
     // Ht-1 * R[zr] + Xt*(W[zr]^T)
-    ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
+    ComputeGemm(active_rows, hidden_size_x2, hidden_size_, alpha,
                 prev_Ht, prev_Ht_end,
                 hidden_size_,
                 recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
                 hidden_size_, beta,
                 outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                hidden_size_x3);
+                hidden_size_x3, quantized_recurrent_weightsZR, allocator_, thread_pool_);
 
     DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                outputZRH_.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -634,19 +688,19 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       gsl::copy(batched_bias_Rh_.subspan(batched_bias_Rh_local - batched_bias_Rh_.begin(), batched_bias_Rh_local_end - batched_bias_Rh_local), linear_output_);
 
       // compute Ht-1 * (Rh^T) + Rbh
-      ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+      ComputeGemm(active_rows, hidden_size_, hidden_size_, alpha,
                   prev_Ht, prev_Ht_end,  // Ht-1
                   hidden_size_,
                   recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
                   hidden_size_, beta,
                   linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
-                  hidden_size_);
+                  hidden_size_, quantized_recurrent_weightsH, allocator_, thread_pool_);
 
       DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
     }
 
     // 1st Set Of Activations
-    for (int r = 0; r < batch_size_; r++) {
+    for (int r = 0; r < active_rows; r++) {
       const T* p_bias_r = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRr_local + r * hidden_size_,
                                                              batched_bias_WRr_local_end, hidden_size_)
                                     : nullptr;
@@ -685,7 +739,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       // out_H currently contains Xt*(W[zrh]^T).
       auto out_H = outputZRH_.begin() + out_added_offset;
 
-      for (int r = 0; r < batch_size_; r++) {
+      for (int r = 0; r < active_rows; r++) {
         // skip over the inputs with Z and R weights
         out_H += hidden_size_x2;
         for (int h = 0; h < hidden_size_; ++h) {
@@ -701,13 +755,13 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
       auto out_H = outputZRH_.begin() + out_added_offset + hidden_size_x2;
 
       // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
-      ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+      ComputeGemm(active_rows, hidden_size_, hidden_size_, alpha,
                   cur_h_local, cur_h_local_end,  // rt (.) Ht-1
                   hidden_size_,
                   recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
                   hidden_size_, beta,
                   out_H, outputZRH_.end(),
-                  hidden_size_x3);
+                  hidden_size_x3, quantized_recurrent_weightsH, allocator_, thread_pool_);
     }
 
     DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, outputZRH_.data() + out_added_offset,
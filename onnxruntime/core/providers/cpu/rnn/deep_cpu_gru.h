@@ -50,6 +50,19 @@ class DeepCpuGruOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
+
+    // R is split as the Z and R gates are applied separately from the H gate
+    const Tensor* W;
+    const Tensor* R;
+    if (dynamic_quantization::IsEnabled(info) &&
+        info.TryGetConstantInput(1, &W) &&
+        info.TryGetConstantInput(2, &R)) {
+      auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+      rnn::detail::QuantizeWeights(*W, num_directions_, 0, 3 * hidden_size_, alloc, quantized_input_weights_);
+      rnn::detail::QuantizeWeights(*R, num_directions_, 0, 2 * hidden_size_, alloc, quantized_recurrent_weightsZR_);
+      rnn::detail::QuantizeWeights(*R, num_directions_, 2 * hidden_size_, hidden_size_, alloc,
+                                   quantized_recurrent_weightsH_);
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -66,6 +79,11 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // per direction weights when the session enabled dynamic quantization and W and R are constant
+  std::vector<DynamicQuantizedWeights> quantized_input_weights_;
+  std::vector<DynamicQuantizedWeights> quantized_recurrent_weightsZR_;
+  std::vector<DynamicQuantizedWeights> quantized_recurrent_weightsH_;
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 };
@@ -14,6 +14,8 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -193,11 +195,13 @@ class UniDirectionalLstm {
                      const gsl::span<const T>& initial_hidden_state, const gsl::span<const T>& initial_cell_state,
                      const ActivationFuncs::Entry& activation_func_f, const ActivationFuncs::Entry& activation_func_g,
                      const ActivationFuncs::Entry& activation_func_h, float clip,
-                     onnxruntime::concurrency::ThreadPool& ttp);
+                     onnxruntime::concurrency::ThreadPool* thread_pool);
 
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
                const gsl::span<const T>& input_weights, const gsl::span<const T>& recurrent_weights,
-               gsl::span<T>& outputs, gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state);
+               gsl::span<T>& outputs, gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state,
+               const DynamicQuantizedWeights* quantized_input_weights = nullptr,
+               const DynamicQuantizedWeights* quantized_recurrent_weights = nullptr);
 
   ~UniDirectionalLstm() = default;
 
@@ -238,6 +242,10 @@ class UniDirectionalLstm {
   bool use_bias_;
   bool use_peepholes_;
 
+  // the cell uses the default activations without clipping or peepholes, so MlasComputeLstmCell can do the
+  // bias, activations and cell update in a single pass
+  bool use_fused_cell_;
+
   int hidden_num_threads_ = -1;
 
   IAllocatorUniquePtr<T> output_iofc_ptr_;
@@ -252,10 +260,12 @@ class UniDirectionalLstm {
   gsl::span<T> internal_memory_cur_, batched_internal_memory_cur_;
   gsl::span<T> batched_internal_memory_clipped_;
 
-  IAllocatorUniquePtr<T> bias_WRi_ptr_, bias_WRf_ptr_, bias_WRo_ptr_, bias_WRc_ptr_;
+  IAllocatorUniquePtr<T> bias_WR_ptr_;
   IAllocatorUniquePtr<T> batched_bias_WRi_ptr_, batched_bias_WRf_ptr_, batched_bias_WRo_ptr_, batched_bias_WRc_ptr_;
   IAllocatorUniquePtr<T> peephole_i_ptr_, peephole_f_ptr_, peephole_o_ptr_;
   IAllocatorUniquePtr<T> inputs_reverse_ptr_, outputs_reverse_ptr_;
+  // bias_WR_ holds the fused Wb + Rb values in iofc order. the per-gate spans point into it.
+  gsl::span<T> bias_WR_;
   gsl::span<T> bias_WRi_, bias_WRf_, bias_WRo_, bias_WRc_;
   gsl::span<T> batched_bias_WRi_, batched_bias_WRf_, batched_bias_WRo_, *batched_bias_WRc_;
   gsl::span<T> inputs_reverse_, outputs_reverse_;
@@ -275,7 +285,8 @@ class UniDirectionalLstm {
   ActivationInfo<deepcpu::ActivationFuncPtr> activation_g_;
   ActivationInfo<deepcpu::LstmMergeGatesFuncPtr> activation_h_;
 
-  onnxruntime::concurrency::ThreadPool& ttp_;
+  // intra-op thread pool of the session. may be nullptr, in which case everything runs on the calling thread.
+  onnxruntime::concurrency::ThreadPool* thread_pool_;
 };
 
 }  // namespace detail
@@ -356,6 +367,8 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
 
+  auto* thread_pool = GetOperatorThreadPool(&context);
+
   gsl::span<const T> input_weights = W.DataAsSpan<T>();
   gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
@@ -378,14 +391,32 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   gsl::span<const int> sequence_lens_span = sequence_lens != nullptr ? sequence_lens->DataAsSpan<int>()
                                                                      : gsl::span<const int>();
 
+  // process the batch in order of decreasing sequence length so that each step only computes the rows that are
+  // still active. the outputs are moved back to the original batch order at the end.
+  std::vector<int> batch_order;
+  IAllocatorUniquePtr<T> sorted_input_ptr, sorted_initial_hidden_ptr, sorted_initial_cell_ptr;
+  IAllocatorUniquePtr<int> sorted_sequence_lens_ptr;
+  const bool reorder_batch = SortBatchBySequenceLength(sequence_lens_span, batch_order);
+  if (reorder_batch) {
+    input = GatherBatch(input, batch_size, input_size, batch_order, alloc, sorted_input_ptr);
+    sequence_lens_span = GatherBatch(sequence_lens_span, batch_size, 1, batch_order, alloc, sorted_sequence_lens_ptr);
+  }
+
   const size_t initial_hidden_size_per_direction = batch_size * hidden_size_;
   gsl::span<const T> initial_hidden = initial_h != nullptr ? initial_h->DataAsSpan<T>() : gsl::span<const T>();
+  if (reorder_batch) {
+    initial_hidden = GatherBatch(initial_hidden, batch_size, hidden_size_, batch_order, alloc,
+                                 sorted_initial_hidden_ptr);
+  }
   gsl::span<const T> initial_hidden_1 =
       initial_hidden.empty() ? initial_hidden
                              : initial_hidden.subspan(0, initial_hidden_size_per_direction);
 
   const size_t initial_cell_size_per_direction = batch_size * hidden_size_;
   gsl::span<const T> initial_cell = initial_c != nullptr ? initial_c->DataAsSpan<T>() : gsl::span<const T>();
+  if (reorder_batch) {
+    initial_cell = GatherBatch(initial_cell, batch_size, hidden_size_, batch_order, alloc, sorted_initial_cell_ptr);
+  }
   gsl::span<const T> initial_cell_1 =
       initial_cell.empty() ? initial_cell
                            : initial_cell.subspan(0, initial_cell_size_per_direction);
@@ -456,7 +487,7 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[0],
                                                          activation_funcs_.Entries()[1],
                                                          activation_funcs_.Entries()[2],
-                                                         clip_, ttp_);
+                                                         clip_, thread_pool);
 
     bw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
                                                          seq_length, batch_size, input_size,
@@ -465,10 +496,14 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[3],
                                                          activation_funcs_.Entries()[4],
                                                          activation_funcs_.Entries()[5],
-                                                         clip_, ttp_);
-
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+                                                         clip_, thread_pool);
+
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1,
+                QuantizedWeightsForDirection(quantized_input_weights_, 0),
+                QuantizedWeightsForDirection(quantized_recurrent_weights_, 0));
+    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2,
+                QuantizedWeightsForDirection(quantized_input_weights_, 1),
+                QuantizedWeightsForDirection(quantized_recurrent_weights_, 1));
   } else {
     fw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
                                                          seq_length, batch_size, input_size,
@@ -477,9 +512,19 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[0],
                                                          activation_funcs_.Entries()[1],
                                                          activation_funcs_.Entries()[2],
-                                                         clip_, ttp_);
+                                                         clip_, thread_pool);
+
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1,
+                QuantizedWeightsForDirection(quantized_input_weights_, 0),
+                QuantizedWeightsForDirection(quantized_recurrent_weights_, 0));
+  }
 
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+  if (reorder_batch) {
+    ScatterBatch(output, batch_size, hidden_size_, batch_order, alloc);
+    if (Y_h != nullptr)
+      ScatterBatch(hidden_output, batch_size, hidden_size_, batch_order, alloc);
+    if (Y_c != nullptr)
+      ScatterBatch(last_cell, batch_size, hidden_size_, batch_order, alloc);
   }
 
   if (!output.empty())
@@ -549,7 +594,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
                                           const ActivationFuncs::Entry& activation_func_g,
                                           const ActivationFuncs::Entry& activation_func_h,
                                           const float clip,
-                                          onnxruntime::concurrency::ThreadPool& ttp)
+                                          onnxruntime::concurrency::ThreadPool* thread_pool)
     : allocator_(allocator),
       logger_(logger),
       seq_length_(seq_length),
@@ -561,7 +606,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
       clip_(clip),
       use_bias_(!bias.empty()),
       use_peepholes_(!peephole_weights.empty()),
-      ttp_(ttp) {
+      thread_pool_(thread_pool) {
   activation_f_ = {deepcpu::ActivationFuncByName(activation_func_f.name),
                    activation_func_f.alpha,
                    activation_func_f.beta};
@@ -576,6 +621,13 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
 
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
+  use_fused_cell_ = std::is_same<T, float>::value &&
+                    !use_peepholes_ && !input_forget_ &&
+                    clip_ == std::numeric_limits<float>::max() &&
+                    activation_func_f.name == "sigmoid" &&
+                    activation_func_g.name == "tanh" &&
+                    activation_func_h.name == "tanh";
+
   SetNumThreads();
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
@@ -605,10 +657,11 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   output_iofc_ = Allocate(allocator_, hidden_size_ * 4 * batch_size_ * seq_length_, output_iofc_ptr_, fill);
 
   if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+    bias_WR_ = Allocate(allocator_, 4 * hidden_size_, bias_WR_ptr_);
+    bias_WRi_ = bias_WR_.subspan(0 * hidden_size_, hidden_size_);
+    bias_WRo_ = bias_WR_.subspan(1 * hidden_size_, hidden_size_);
+    bias_WRf_ = bias_WR_.subspan(2 * hidden_size_, hidden_size_);
+    bias_WRc_ = bias_WR_.subspan(3 * hidden_size_, hidden_size_);
   }
 
   if (direction_ == kReverse) {
@@ -717,7 +770,9 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                                     const gsl::span<const T>& recurrent_weights,
                                     gsl::span<T>& outputs,
                                     gsl::span<T>& final_hidden_state,
-                                    gsl::span<T>& final_cell_state) {
+                                    gsl::span<T>& final_cell_state,
+                                    const DynamicQuantizedWeights* quantized_input_weights,
+                                    const DynamicQuantizedWeights* quantized_recurrent_weights) {
   // copy spans (just T* and size, not data in span) as we may change them
   gsl::span<const T> inputs = inputs_arg;
   gsl::span<const int> sequence_lengths = sequence_lengths_arg;
@@ -763,6 +818,10 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   int32_t min_sequence_length = std::min(seq_length_, *std::min_element(sequence_lengths.cbegin(),
                                                                         sequence_lengths.cend()));
 
+  // if the batch is ordered by decreasing sequence length the active rows of each step are a prefix of the batch,
+  // so the rows that have finished can be left out of the recurrent GEMM and the gate computations.
+  const bool batch_sorted = std::is_sorted(sequence_lengths.rbegin(), sequence_lengths.rend());
+
   ///**************************LSTM Calculations****************************/
   float alpha = 1.0f;
   float beta = 0.0f;  // first call to ComputeGemm zeros out any existing data
@@ -777,7 +836,7 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
               input_weights.cbegin(), input_weights.cend(),  // W[iofc]
               input_size_, beta,
               output_iofc_.begin(), output_iofc_.end(),
-              hidden_size_x4);
+              hidden_size_x4, quantized_input_weights, allocator_, thread_pool_);
 
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
 
@@ -811,22 +870,29 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       // after the first step this will switch to the output from the previous step
       span_T_const_iter previous_state = batched_hidden_state_one_step.cbegin() + row * hidden_size_;
 
+      int active_rows = local_fused_hidden_rows;
+
       // run through steps sequentially
       for (int step = 0; step < max_sequence_length; step++) {
 #if defined(DUMP_MATRIXES)
         const std::string row_str = " [row=" + std::to_string(row) + ",seqno=" + std::to_string(step) + "]";
 #endif
 
+        if (batch_sorted)
+          active_rows = ActiveBatchRows(sequence_lengths.subspan(row, local_fused_hidden_rows), step, active_rows);
+
         span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_ + row) * hidden_size_x4;
 
         // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-        ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
-                    previous_state, previous_state_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                    hidden_size_, beta,
-                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                    hidden_size_x4);
+        if (active_rows > 0) {
+          ComputeGemm(active_rows, hidden_size_x4, hidden_size_, alpha,
+                      previous_state, previous_state_end,  // Ht-1
+                      hidden_size_,
+                      recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                      hidden_size_, beta,
+                      step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                      hidden_size_x4, quantized_recurrent_weights, allocator_);
+        }
 
         DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str,
                    &*step_out_IOFC, local_fused_hidden_rows, hidden_size_x4);
@@ -847,7 +913,7 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                          c_prev, C_prev_end,
                          c_prev_clipped, C_prev_clipped_end,
                          batched_output, batched_output_end,
-                         sequence_lengths, min_sequence_length, step, row, local_fused_hidden_rows, output_sequence);
+                         sequence_lengths, min_sequence_length, step, row, active_rows, output_sequence);
 
         // copy last row to final_cell_state
         for (int lrow = row; lrow < row + local_fused_hidden_rows; ++lrow) {
@@ -877,7 +943,8 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       }
     };
 
-    ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows, ttp_, logger_);
+    ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows,
+                            thread_pool_, logger_);
 
   } else {
     span_T_iter c_prev = batched_internal_state_prev_one_step.begin();
@@ -887,24 +954,29 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
     // after the first step this will switch to the output from the previous step
     span_T_const_iter previous_state = batched_hidden_state_one_step.cbegin();
 
+    int active_rows = batch_size_;
+
     //run through steps sequentially
     for (int step = 0; step < max_sequence_length; step++) {
 #if defined(DUMP_MATRIXES)
       const std::string seqno_str = " [seqno=" + std::to_string(step) + "]";
 #endif
 
+      if (batch_sorted)
+        active_rows = ActiveBatchRows(sequence_lengths, step, active_rows);
+
       DumpMatrix("previous_state" + seqno_str, &*previous_state, batch_size_, hidden_size_);
 
       span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_) * hidden_size_x4;
 
       // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-      ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
+      ComputeGemm(active_rows, hidden_size_x4, hidden_size_, alpha,
                   previous_state, previous_state_end,  // Ht-1
                   hidden_size_,
                   recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
                   hidden_size_, beta,
                   step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4);
+                  hidden_size_x4, quantized_recurrent_weights, allocator_, thread_pool_);
 
       span_T_iter batched_output;
       span_T_iter batched_output_end;
@@ -922,7 +994,7 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                        c_prev, C_prev_end,
                        c_prev_clipped, C_prev_clipped_end,
                        batched_output, batched_output_end,
-                       sequence_lengths, min_sequence_length, step, 0, batch_size_, output_sequence);
+                       sequence_lengths, min_sequence_length, step, 0, active_rows, output_sequence);
 
       // copy last row to final_cell_state
       for (int lrow = 0; lrow < batch_size_; lrow++) {
@@ -1026,6 +1098,13 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
 
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
+    if (use_fused_cell_) {
+      float* pH = SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_,
+                                    batched_output_end, hidden_size_);
+      MlasComputeLstmCell(pi, use_bias_ ? bias_WR_.data() : nullptr, pCprev_hidden_size, pH, hidden_size_);
+      continue;
+    }
+
     // Input Gate
     if (use_peepholes_) {
       deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_),
@@ -1114,14 +1193,15 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
 
 template <typename T>
 void UniDirectionalLstm<T>::SetNumThreads() {
-  int threads = std::thread::hardware_concurrency() - 1;
-
-  if (threads < 1)
-    threads = 1;
+  // the calling thread takes part in ExecuteLambdaInParallel, so it counts as one of the threads
+  int threads = thread_pool_ != nullptr ? thread_pool_->NumThreads() + 1 : 1;
 
   hidden_num_threads_ = threads;
   batch_parallel_ = false;
 
+  if (threads == 1)
+    return;
+
   // for readability of the below logic
   const auto num_rows = batch_size_;
   const auto num_columns = hidden_size_;
@@ -49,6 +49,16 @@ class DeepCpuLstmOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
+
+    const Tensor* W;
+    const Tensor* R;
+    if (dynamic_quantization::IsEnabled(info) &&
+        info.TryGetConstantInput(1, &W) &&
+        info.TryGetConstantInput(2, &R)) {
+      auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+      rnn::detail::QuantizeWeights(*W, num_directions_, 0, 4 * hidden_size_, alloc, quantized_input_weights_);
+      rnn::detail::QuantizeWeights(*R, num_directions_, 0, 4 * hidden_size_, alloc, quantized_recurrent_weights_);
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -78,12 +88,9 @@ class DeepCpuLstmOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
-  // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
-  // across them. mutable due to this.
-  // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
-  // cost on every call.
-  mutable onnxruntime::concurrency::ThreadPool ttp_{"DEEPCPU_LSTM",
-                                                    static_cast<int>(std::thread::hardware_concurrency())};
+  // per direction weights when the session enabled dynamic quantization and W and R are constant
+  std::vector<DynamicQuantizedWeights> quantized_input_weights_;
+  std::vector<DynamicQuantizedWeights> quantized_recurrent_weights_;
 };
 
 }  // namespace onnxruntime
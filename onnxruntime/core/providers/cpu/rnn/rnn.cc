@@ -147,6 +147,13 @@ Status RNN<float>::Compute(OpKernelContext* ctx) const {
 
   int64_t Y_frame_size = batch_size * hidden_size_;
 
+  // frames past the longest sequence are cleared by ClearMissingFrames, so the forward direction can stop there
+  int64_t max_sequence_length = seq_length;
+  if (sequence_lens != nullptr && batch_size > 0) {
+    const int* lengths = sequence_lens->template Data<int>();
+    max_sequence_length = std::min<int64_t>(seq_length, *std::max_element(lengths, lengths + batch_size));
+  }
+
   for (int direction = 0; direction < num_directions; direction++) {
     auto activation_func = GetFuncByName<float>(activations_[direction], "Tanh");
     bool isReverse = direction_ == "reverse" || direction == 1;
@@ -173,7 +180,8 @@ Status RNN<float>::Compute(OpKernelContext* ctx) const {
         x_matmul_w_buffer_data,
         &CPUMathUtil::Instance());
 
-    for (int64_t t = 0; t < seq_length; t++) {
+    const int64_t num_steps = isReverse ? seq_length : max_sequence_length;
+    for (int64_t t = 0; t < num_steps; t++) {
       int64_t time_step = isReverse ? (seq_length - t - 1) : t;
       int64_t Y_frame_offset = (time_step * num_directions + direction) * Y_frame_size;
       float* Y_buffer_data_current_frame = Y_buffer_data + Y_frame_offset;
@@ -7,6 +7,7 @@
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <stdlib.h>
 #include <string>
 #include <unordered_map>
@@ -101,6 +102,39 @@ Status ValidateCommonRnnInputs(const Tensor& X,
   return Status::OK();
 }  // namespace detail
 
+void QuantizeWeights(const Tensor& weights, int num_directions, int row_start, int row_count,
+                     const AllocatorPtr& allocator, std::vector<DynamicQuantizedWeights>& quantized_weights) {
+  const auto& shape = weights.Shape();
+  if (weights.DataType() != DataTypeImpl::GetType<float>() ||
+      shape.NumDimensions() != 3 || shape[0] != num_directions || row_start + row_count > shape[1]) {
+    // leave the weights unquantized and let the input validation report any error
+    return;
+  }
+
+  const auto rows = static_cast<size_t>(shape[1]);
+  const auto cols = static_cast<size_t>(shape[2]);
+
+  quantized_weights.resize(num_directions);
+  for (int direction = 0; direction < num_directions; direction++) {
+    const float* B = weights.Data<float>() + (direction * rows + row_start) * cols;
+    dynamic_quantization::QuantizeWeights(B, cols, static_cast<size_t>(row_count), cols, true,
+                                          allocator, quantized_weights[direction]);
+  }
+}
+
+bool SortBatchBySequenceLength(gsl::span<const int> sequence_lengths, std::vector<int>& batch_order) {
+  batch_order.clear();
+  if (std::is_sorted(sequence_lengths.rbegin(), sequence_lengths.rend())) {
+    return false;
+  }
+
+  batch_order.resize(sequence_lengths.size());
+  std::iota(batch_order.begin(), batch_order.end(), 0);
+  std::stable_sort(batch_order.begin(), batch_order.end(),
+                   [&sequence_lengths](int a, int b) { return sequence_lengths[a] > sequence_lengths[b]; });
+  return true;
+}
+
 // map of arg name and whether the alpha and/or beta arguments are required
 static std::unordered_map<std::string, std::pair<bool, bool>>
     NameToArgUsageMap{{"affine", {1, 1}},
@@ -19,6 +19,8 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/dynamic_quantize_matmul.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -143,6 +145,65 @@ void ReverseSequence(gsl::span<const T> inputs,
   }
 }
 
+// Computes the permutation that orders the batch by decreasing sequence length. With that order the rows that are
+// still active at any step form a prefix of the batch, so the recurrent GEMMs can shrink as sequences finish
+// instead of computing padding. Returns false and leaves batch_order empty if the batch is already in that order.
+bool SortBatchBySequenceLength(gsl::span<const int> sequence_lengths, std::vector<int>& batch_order);
+
+// Returns the number of rows that are still active at 'step' for a batch sorted by decreasing sequence length.
+// 'active_rows' is the value returned for the previous step, as the count can only decrease.
+inline int ActiveBatchRows(gsl::span<const int> sorted_sequence_lengths, int step, int active_rows) {
+  while (active_rows > 0 && sorted_sequence_lengths[active_rows - 1] <= step) {
+    --active_rows;
+  }
+  return active_rows;
+}
+
+// Gathers the rows of a [outer, batch_size, row_size] tensor into the order given by batch_order, so that
+// row i of the result is row batch_order[i] of the input. An empty input is returned as is.
+template <typename T>
+gsl::span<const T> GatherBatch(gsl::span<const T> input, int batch_size, int row_size,
+                               const std::vector<int>& batch_order,
+                               std::shared_ptr<IAllocator> allocator, IAllocatorUniquePtr<T>& buffer) {
+  if (input.empty()) {
+    return input;
+  }
+
+  gsl::span<T> output = Allocate(allocator, input.size(), buffer);
+  const size_t outer = input.size() / (static_cast<size_t>(batch_size) * row_size);
+
+  for (size_t o = 0; o < outer; o++) {
+    for (int i = 0; i < batch_size; i++) {
+      gsl::copy(input.subspan((o * batch_size + batch_order[i]) * row_size, row_size),
+                output.subspan((o * batch_size + i) * row_size, row_size));
+    }
+  }
+
+  return output;
+}
+
+// Reverses GatherBatch in place on a [outer, batch_size, row_size] tensor, so that row i is moved back to
+// row batch_order[i].
+template <typename T>
+void ScatterBatch(gsl::span<T> data, int batch_size, int row_size, const std::vector<int>& batch_order,
+                  std::shared_ptr<IAllocator> allocator) {
+  if (data.empty()) {
+    return;
+  }
+
+  IAllocatorUniquePtr<T> buffer;
+  gsl::span<T> block = Allocate(allocator, static_cast<size_t>(batch_size) * row_size, buffer);
+  const size_t outer = data.size() / block.size();
+
+  for (size_t o = 0; o < outer; o++) {
+    gsl::span<T> rows = data.subspan(o * block.size(), block.size());
+    gsl::copy(rows, block);
+    for (int i = 0; i < batch_size; i++) {
+      gsl::copy(block.subspan(i * row_size, row_size), rows.subspan(batch_order[i] * row_size, row_size));
+    }
+  }
+}
+
 // A has size M x K, B has size N x K (transposed), and C has size M x N
 // We check that A, B and C are large enough before calling the lower level GEMM implementation
 template <typename TSpanAIter, typename TSpanBIter, typename TSpanCIter>
@@ -175,6 +236,62 @@ void ComputeGemm(const int M,
       &*C, ldc, &CPUMathUtil::Instance());
 }
 
+// Same as above, but uses the dynamic quantization path if the session quantized B ahead of time.
+// The float B is still required so that callers do not need to special case the bounds checks.
+// If thread_pool is provided the GEMM is partitioned across it. This must not be used from a lambda that is already
+// running on the same pool, as the nested wait could block every worker.
+template <typename TSpanAIter, typename TSpanBIter, typename TSpanCIter>
+void ComputeGemm(const int M,
+                 const int N,
+                 const int K,
+                 const float alpha,
+                 TSpanAIter A,
+                 TSpanAIter A_end,
+                 const int lda,
+                 TSpanBIter B,
+                 TSpanBIter B_end,
+                 const int ldb,
+                 const float beta,
+                 TSpanCIter C,
+                 TSpanCIter C_end,
+                 const int ldc,
+                 const DynamicQuantizedWeights* quantized_B,
+                 const AllocatorPtr& allocator,
+                 onnxruntime::concurrency::ThreadPool* thread_pool = nullptr) {
+  if (quantized_B == nullptr || !quantized_B->IsQuantized()) {
+    if (thread_pool == nullptr) {
+      ComputeGemm(M, N, K, alpha, A, A_end, lda, B, B_end, ldb, beta, C, C_end, ldc);
+      return;
+    }
+
+    ORT_ENFORCE(lda >= K && ldb >= K && ldc >= N);
+    ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+    ORT_ENFORCE(B + (N * ldb - (ldb - K)) <= B_end);
+    ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+
+    MlasSgemm(CblasNoTrans, CblasTrans, M, N, K, alpha, &*A, lda, &*B, ldb, beta, &*C, ldc, thread_pool);
+    return;
+  }
+
+  ORT_ENFORCE(lda >= K && ldc >= N);
+  ORT_ENFORCE(static_cast<size_t>(N) == quantized_B->N && static_cast<size_t>(K) == quantized_B->K);
+  ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+  ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+
+  dynamic_quantization::Gemm(M, alpha, &*A, lda, *quantized_B, beta, &*C, ldc, allocator, thread_pool);
+}
+
+// Returns the quantized weights of a direction, or nullptr if the weights were not quantized.
+inline const DynamicQuantizedWeights* QuantizedWeightsForDirection(
+    const std::vector<DynamicQuantizedWeights>& quantized_weights, int direction) {
+  return static_cast<size_t>(direction) < quantized_weights.size() ? &quantized_weights[direction] : nullptr;
+}
+
+// Quantizes rows [row_start, row_start + row_count) of each direction of a [num_directions, rows, cols] weight tensor
+// for use as the transposed B of ComputeGemm. quantized_weights is left empty if the tensor cannot be quantized.
+void QuantizeWeights(const Tensor& weights, int num_directions, int row_start, int row_count,
+                     const AllocatorPtr& allocator, std::vector<DynamicQuantizedWeights>& quantized_weights);
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -211,37 +328,36 @@ T* SafeRawPointer(typename gsl::span<T> span, size_t offset, size_t size) {
   return span.data() + offset;
 }
 
+// Runs lambda(i) for i = 0, step, 2 * step, ... < max on the thread pool, or sequentially if there is no pool.
+// The calling thread runs the first task and then blocks until the others complete, so no thread spins while the
+// pool is busy with other kernels or sessions.
 template <typename TLambda>
 void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, int step,
-                             onnxruntime::concurrency::ThreadPool& ttp,
+                             onnxruntime::concurrency::ThreadPool* ttp,
                              const ::onnxruntime::logging::Logger& logger) {
   // #define NOTHREADS to execute the lambdas directly and in order if you need to do that to debug
 
-#ifdef NOTHREADS
-  ORT_UNUSED_PARAMETER(ttp);
+  ORT_UNUSED_PARAMETER(name);
   ORT_UNUSED_PARAMETER(logger);
 
-  for (int i = 0; i < max; i += step) {
-    (void)name;
-    std::bind(lambda, i)();
-  }
-#else
+  step = step > 0 ? step : 1;
+  const int total_tasks = max / step + (max % step > 0 ? 1 : 0);
 
-  ORT_UNUSED_PARAMETER(name);
-  ORT_UNUSED_PARAMETER(logger);
+#ifdef NOTHREADS
+  ORT_UNUSED_PARAMETER(ttp);
+  const bool run_sequentially = true;
+#else
+  const bool run_sequentially = ttp == nullptr || total_tasks <= 1;
+#endif
 
-  std::atomic<int> done(0);
-  for (int i = 0; i < max; i += step) {
-    ttp.Schedule([lambda, i, &done]() {
+  if (run_sequentially) {
+    for (int i = 0; i < max; i += step) {
       lambda(i);
-      ++done;
-    });
+    }
+    return;
   }
 
-  int totalTasks = max / (step > 0 ? step : 1) + (max % step > 0 ? 1 : 0);
-  while (done != totalTasks)
-    ;
-#endif
+  ttp->ParallelFor(total_tasks, [&lambda, step](int32_t task) { lambda(task * step); });
 }
 
 void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
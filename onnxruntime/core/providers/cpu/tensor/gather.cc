@@ -4,6 +4,11 @@
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
 #include "core/common/common.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
+#include "core/util/prefetch.h"
+
+#include <algorithm>
 
 namespace onnxruntime {
 
@@ -30,43 +35,93 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   return Status::OK();
 }
 
+namespace {
+
+// Rows are prefetched ahead of the copy when the gathered table is too large to stay in the cache, which is the case
+// for the embedding lookups of recommender models.
+constexpr int64_t kPrefetchTableBytes = 1 << 20;
+
+// Copies one gathered row. Rows of a single scalar use a fixed size copy that compiles to a plain load and store.
+inline void CopyRow(uint8_t* dst, const uint8_t* src, int64_t row_bytes) {
+  switch (row_bytes) {
+    case 1:
+      *dst = *src;
+      break;
+    case 2:
+      memcpy(dst, src, 2);
+      break;
+    case 4:
+      memcpy(dst, src, 4);
+      break;
+    case 8:
+      memcpy(dst, src, 8);
+      break;
+    default:
+      memcpy(dst, src, static_cast<size_t>(row_bytes));
+      break;
+  }
+}
+
+}  // namespace
+
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
                       const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
-                      const TensorShape& input_data_shape, const int64_t axis) {
+                      const TensorShape& input_data_shape, const int64_t axis, concurrency::ThreadPool* tp) {
   const Tin* indices_data = indices_tensor->template Data<Tin>();
-
-  // Check the indices first in case there's a out of bound index.
-  // We can't merge this code in the omp loop below as omp does not allow return in the loop
-  for (int64_t i = 0; i < N; ++i) {
-    Tin idx = indices_data[i];
-    if (idx < 0 || idx >= input_data_shape[axis]) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", idx,
-                             " data_dim=", input_data_shape[axis]);
+  const int64_t axis_dim = input_data_shape[axis];
+
+  // Check the indices once up front with a branch free min/max reduction, and only search for the offending
+  // index to report when the range check fails.
+  if (N > 0) {
+    Tin min_index = indices_data[0];
+    Tin max_index = indices_data[0];
+    for (int64_t i = 1; i < N; ++i) {
+      min_index = std::min(min_index, indices_data[i]);
+      max_index = std::max(max_index, indices_data[i]);
+    }
+    if (min_index < 0 || max_index >= axis_dim) {
+      for (int64_t i = 0; i < N; ++i) {
+        Tin idx = indices_data[i];
+        if (idx < 0 || idx >= axis_dim) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", idx,
+                                 " data_dim=", axis_dim);
+        }
+      }
     }
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t index = 0; index < M * N; ++index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
-
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
+  const int64_t block = block_size / static_cast<int64_t>(element_bytes);
+  const bool prefetch = !is_string_type && data_batch_bytes >= kPrefetchTableBytes;
+
+  auto copy_rows = [&](int64_t first, int64_t last) {
+    for (int64_t index = first; index < last; ++index) {
+      const int64_t batch = index / N;
+      const int64_t i = index % N;
+
+      const int64_t src_offset = batch * data_batch_bytes + indices_data[i] * block_size;
+      const int64_t dst_offset = batch * gathered_batch_bytes + i * block_size;
+
+      if (is_string_type) {
+        const auto* src = reinterpret_cast<const std::string*>(src_base + src_offset);
+        auto* dst = reinterpret_cast<std::string*>(dst_base + dst_offset);
+        std::copy(src, src + block, dst);
+        continue;
+      }
+
+      if (prefetch && index + kPrefetchDistance < last) {
+        const int64_t ahead = index + kPrefetchDistance;
+        PrefetchRow(src_base + (ahead / N) * data_batch_bytes + indices_data[ahead % N] * block_size, block_size);
+      }
+
+      CopyRow(dst_base + dst_offset, src_base + src_offset, block_size);
     }
-  }
+  };
+
+  const int64_t total = M * N;
+  concurrency::ThreadPool::TryParallelForBlocks(tp, total, total * std::max<int64_t>(block_size, 1),
+                                                concurrency::ThreadPool::kMinElementsPerBlock, copy_rows);
 
   return Status::OK();
 }
@@ -90,14 +145,18 @@ Status Gather::Compute(OpKernelContext* context) const {
   const auto* src_base = static_cast<const uint8_t*>(p.input_tensor->DataRaw());
   auto* dst_base = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
 
+  auto* tp = GetOperatorThreadPool(context);
+
   MLDataType Tind_type = p.indices_tensor->DataType();
   if (Tind_type == DataTypeImpl::GetType<int32_t>()) {
     return GatherCopyData<int32_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   tp);
   }
   if (Tind_type == DataTypeImpl::GetType<int64_t>()) {
     return GatherCopyData<int64_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   tp);
   }
 
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for Tind not supported yet in Gather.");
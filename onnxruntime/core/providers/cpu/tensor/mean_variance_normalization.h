@@ -5,7 +5,14 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
-#include "core/util/math_cpuonly.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
 
 #include "gsl/gsl_util"
 namespace onnxruntime {
@@ -40,55 +47,70 @@ class MeanVarianceNormalization_0 : public OpKernel {
     T* Ydata = Y->template MutableData<T>();
 
     const int64_t sample_size = H * W;
-    Eigen::Array<float, Eigen::Dynamic, 1> mean(C, 1);
-    Eigen::Array<float, Eigen::Dynamic, 1> var(C, 1);
-    mean.setZero();
-    var.setZero();
-
-    ConstEigenArrayMap<T> X_arr(Xdata, sample_size, N * C);
-    for (int nc = 0; nc < N * C; ++nc) {
-      mean(nc % C) += X_arr.col(nc).sum();
-    }
-    mean /= gsl::narrow_cast<T>(N * sample_size);
-    for (int64_t nc = 0; nc < N * C; ++nc) {
-      var(nc % C) += (X_arr.col(nc) - mean(nc % C)).matrix().squaredNorm();
-    }
-    var /= gsl::narrow_cast<T>(N * sample_size);
-
-    Eigen::Array<T, Eigen::Dynamic, 1> inv_std;
-    EigenArrayMap<T> Y_arr(Ydata, sample_size, N * C);
+    const int64_t num_planes = N * C;
+
+    // both passes below (the plane statistics and the normalization) split the planes into the same blocks
+    auto* tp = GetOperatorThreadPool(context);
+    auto for_each_plane_block = [&](const std::function<void(int64_t, int64_t)>& fn) {
+      concurrency::ThreadPool::TryParallelForBlocks(tp, num_planes, num_planes * sample_size,
+                                                    concurrency::ThreadPool::kMinElementsPerBlock, fn);
+    };
+
+    // Gather the mean and variance of every plane in a single pass over the input.
+    std::vector<float> plane_mean(num_planes);
+    std::vector<float> plane_var(num_planes);
+    for_each_plane_block([&](int64_t first, int64_t last) {
+      for (int64_t nc = first; nc < last; ++nc) {
+        MlasComputeMeanVariance(Xdata + nc * sample_size, static_cast<size_t>(sample_size),
+                                &plane_mean[nc], &plane_var[nc]);
+      }
+    });
 
+    // All planes have the same number of elements, so the statistics of a group of planes are the mean of the plane
+    // means and the mean of the plane variances plus the squared deviations of the plane means:
+    // var_c = [(var_1 + (m_1 - m_c)^2) + ...  + (var_n + (m_n - m_c)^2)] / n
+    std::vector<float> mean(C, 0.0f);
+    std::vector<float> var(C, 0.0f);
     if (across_channels_) {
-      // m_c = sum(m_i) / n
-      float global_mean = mean.mean();
-
-      // var_c = [(var_1 + (m_1 - m_c)^2) + ...  + (var_n + (m_n - m_c)^2)] / n
-      //       = [sum(var_i) + squared_norm(m_i - m_c)] / n
-      float global_var = ((mean - global_mean).matrix().squaredNorm() + var.sum()) / C;
-
-      // For across channels we can directly use eigen because global_mean and global_var
-      // are just scalars.
-      if (!normalize_variance_) {
-        Y_arr = X_arr - global_mean;
-      } else {
-        float inv_std_scalar = 1 / std::sqrt(global_var);
-        Y_arr = (X_arr - global_mean) * inv_std_scalar;
+      float global_mean = 0.0f;
+      for (int64_t nc = 0; nc < num_planes; ++nc) {
+        global_mean += plane_mean[nc];
+      }
+      global_mean /= gsl::narrow_cast<float>(num_planes);
+
+      float global_var = 0.0f;
+      for (int64_t nc = 0; nc < num_planes; ++nc) {
+        global_var += plane_var[nc] + (plane_mean[nc] - global_mean) * (plane_mean[nc] - global_mean);
       }
+      global_var /= gsl::narrow_cast<float>(num_planes);
+
+      std::fill(mean.begin(), mean.end(), global_mean);
+      std::fill(var.begin(), var.end(), global_var);
     } else {
-      if (!normalize_variance_) {
-        // inv_std = 1
-        for (int64_t nc = 0; nc < N * C; ++nc) {
-          // y = (x - mean)
-          Y_arr.col(nc) = (X_arr.col(nc) - mean(nc % C));
-        }
-      } else {
-        inv_std = var.sqrt().inverse();
-        for (int64_t nc = 0; nc < N * C; ++nc) {
-          // y = (x - mean) * (inv_std)
-          Y_arr.col(nc) = (X_arr.col(nc) - mean(nc % C)) * inv_std(nc % C);
-        }
+      for (int64_t nc = 0; nc < num_planes; ++nc) {
+        mean[nc % C] += plane_mean[nc];
+      }
+      for (int64_t c = 0; c < C; ++c) {
+        mean[c] /= gsl::narrow_cast<float>(N);
+      }
+      for (int64_t nc = 0; nc < num_planes; ++nc) {
+        const float deviation = plane_mean[nc] - mean[nc % C];
+        var[nc % C] += plane_var[nc] + deviation * deviation;
+      }
+      for (int64_t c = 0; c < C; ++c) {
+        var[c] /= gsl::narrow_cast<float>(N);
       }
     }
+
+    // y = (x - mean) * inv_std, computed as a single multiply-add per element.
+    for_each_plane_block([&](int64_t first, int64_t last) {
+      for (int64_t nc = first; nc < last; ++nc) {
+        const float inv_std = normalize_variance_ ? 1 / std::sqrt(var[nc % C]) : 1.0f;
+        MlasComputeScaleShift(Xdata + nc * sample_size, Ydata + nc * sample_size, static_cast<size_t>(sample_size),
+                              inv_std, -mean[nc % C] * inv_std);
+      }
+    });
+
     return Status::OK();
   }
 
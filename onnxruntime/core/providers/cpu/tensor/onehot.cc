@@ -15,10 +15,12 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #include "core/providers/cpu/tensor/onehot.h"
-#include "core/util/eigen_common_wrapper.h"
+#include "core/framework/op_kernel_context_internal.h"
 #include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 
-#define EIGEN_USE_THREADS
+#include <algorithm>
+#include <type_traits>
 
 using namespace ::onnxruntime::common;
 using namespace std;
@@ -67,39 +69,25 @@ Status ValidateInputs(const Tensor* depth,
   return Status::OK();
 }
 
-// Helper to define Tensor types given that the scalar is of type T.
-template <typename T, int NDIMS = 1, typename IndexType = Eigen::DenseIndex>
-struct EigenTensorTypes {
-  using EigenTensorMap = Eigen::TensorMap<Eigen::Tensor<T, NDIMS, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using ConstEigenTensorMap = Eigen::TensorMap<Eigen::Tensor<const T, NDIMS, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using Scalar = Eigen::TensorMap<Eigen::TensorFixedSize<T, Eigen::Sizes<>, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using ConstScalar = Eigen::TensorMap<Eigen::TensorFixedSize<const T, Eigen::Sizes<>, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using ConstMatrix = Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-};
-
-namespace generator {
-template <typename in_type, typename out_type>
-class OneGenerator {
- public:
-  EIGEN_DEVICE_FUNC EIGEN_ALWAYS_INLINE
-  OneGenerator(const typename EigenTensorTypes<in_type>::ConstMatrix& indices,
-               const typename EigenTensorTypes<out_type>::ConstScalar& on_value,
-               const typename EigenTensorTypes<out_type>::ConstScalar& off_value)
-      : indices_(indices), on_value_(on_value), off_value_(off_value) {}
-
-  EIGEN_DEVICE_FUNC EIGEN_ALWAYS_INLINE out_type
-  operator()(const Eigen::array<Eigen::DenseIndex, 3>& pre_depth_suff) const {
-    return (indices_(pre_depth_suff[0], pre_depth_suff[2]) == pre_depth_suff[1])
-               ? on_value_()
-               : off_value_();
-  }
+// Returns the depth position selected by an index, or -1 if the index selects none because it's out of range or, for
+// floating point indices, not integral.
+template <typename in_type>
+inline typename std::enable_if<std::is_integral<in_type>::value, int64_t>::type DepthPosition(in_type index,
+                                                                                              int64_t depth) {
+  const auto position = static_cast<int64_t>(index);
+  return (position >= 0 && position < depth) ? position : -1;
+}
 
- private:
-  const typename EigenTensorTypes<in_type>::ConstMatrix indices_;
-  const typename EigenTensorTypes<out_type>::ConstScalar on_value_;
-  const typename EigenTensorTypes<out_type>::ConstScalar off_value_;
-};
-}  // namespace generator
+template <typename in_type>
+inline typename std::enable_if<std::is_floating_point<in_type>::value, int64_t>::type DepthPosition(in_type index,
+                                                                                                    int64_t depth) {
+  // NaN and values outside [0, depth) are rejected before the conversion, which is undefined for them
+  if (!(index >= 0 && index < static_cast<in_type>(depth))) {
+    return -1;
+  }
+  const auto position = static_cast<int64_t>(index);
+  return (position < depth && static_cast<in_type>(position) == index) ? position : -1;
+}
 
 template <typename in_type, typename out_type, typename depth_type>
 Status OneHotOp<in_type, out_type, depth_type>::Compute(OpKernelContext* p_op_kernel_context) const {
@@ -145,29 +133,50 @@ Status OneHotOp<in_type, out_type, depth_type>::Compute(OpKernelContext* p_op_ke
   for (int64_t i = 0; i < true_axis; ++i) {
     prefix_dim_size *= indices_dims[i];
   }
-  const int64_t suffix_dim_size = indices_shape.Size() / prefix_dim_size;
+  const int64_t suffix_dim_size = prefix_dim_size == 0 ? 0 : indices_shape.Size() / prefix_dim_size;
 
-  // Split indices into matrix of size prefix_dim_size x suffix_dim_size
-  Eigen::array<Eigen::DenseIndex, 2> indices_dims_e = {
-    {static_cast<Eigen::DenseIndex>(prefix_dim_size), static_cast<Eigen::DenseIndex>(suffix_dim_size)}};
   const auto* indices_data = indices->Data<in_type>();
-  typename EigenTensorTypes<in_type, 2>::ConstEigenTensorMap indices_tensor_e(indices_data, indices_dims_e);
-
-  // Split output into 3-Tensor of size:
-  //   prefix_dim_size x depth x suffix_dim_size.
-  Eigen::array<Eigen::DenseIndex, 3> output_dims_e = {
-    {static_cast<Eigen::DenseIndex>(prefix_dim_size), static_cast<Eigen::DenseIndex>(depth_val), static_cast<Eigen::DenseIndex>(suffix_dim_size)}};
   auto* output_data = output->MutableData<out_type>();
-  typename EigenTensorTypes<out_type, 3>::EigenTensorMap output_tensor_e(output_data, output_dims_e);
-
-  typename EigenTensorTypes<out_type>::ConstScalar on_value_e(values_data + 1);
-  typename EigenTensorTypes<out_type>::ConstScalar off_value_e(values_data);
-
-  generator::OneGenerator<in_type, out_type> generator(indices_tensor_e, on_value_e, off_value_e);
-
-  // TODO potential optimization opportunity
-  // TODO figure out the eigen threadpool stuff for use here
-  output_tensor_e = output_tensor_e.generate(generator);
+  const out_type& off_value = values_data[0];
+  const out_type& on_value = values_data[1];
+
+  // The output is prefix_dim_size x depth x suffix_dim_size. Each task fills a range of the prefix and suffix
+  // dimensions with the off value and then sets the on value at the selected depth of each index, instead of
+  // evaluating a comparison per output element.
+  auto fill = [&](int64_t prefix_first, int64_t prefix_last, int64_t suffix_first, int64_t suffix_last) {
+    const int64_t count = suffix_last - suffix_first;
+    for (int64_t p = prefix_first; p < prefix_last; ++p) {
+      out_type* output_plane = output_data + p * depth_val * suffix_dim_size;
+      for (int64_t d = 0; d < depth_val; ++d) {
+        std::fill_n(output_plane + d * suffix_dim_size + suffix_first, count, off_value);
+      }
+      const in_type* plane_indices = indices_data + p * suffix_dim_size;
+      for (int64_t s = suffix_first; s < suffix_last; ++s) {
+        const int64_t d = DepthPosition(plane_indices[s], depth_val);
+        if (d >= 0) {
+          output_plane[d * suffix_dim_size + s] = on_value;
+        }
+      }
+    }
+  };
+
+  auto* tp = GetOperatorThreadPool(p_op_kernel_context);
+
+  // Split the outermost dimension that has more than one element, so an axis of 0 still spreads over the threads.
+  const bool split_prefix = prefix_dim_size > 1;
+  const int64_t items = split_prefix ? prefix_dim_size : suffix_dim_size;
+  const int64_t work_per_item = split_prefix ? depth_val * suffix_dim_size : depth_val;
+
+  auto fill_items = [&](int64_t first, int64_t last) {
+    if (split_prefix) {
+      fill(first, last, 0, suffix_dim_size);
+    } else {
+      fill(0, prefix_dim_size, first, last);
+    }
+  };
+
+  concurrency::ThreadPool::TryParallelForBlocks(tp, items, items * work_per_item,
+                                                concurrency::ThreadPool::kMinElementsPerBlock, fill_items);
 
   return Status::OK();
 }
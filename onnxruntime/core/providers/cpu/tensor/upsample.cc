@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/upsample.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
 #include <cmath>
+#include <functional>
 
 using namespace onnxruntime::common;
 using namespace std;
@@ -36,24 +39,30 @@ void UpsampleNearest2x(
     int64_t input_height,
     int64_t input_width,
     const T* input,
-    T* output) {
+    T* output,
+    concurrency::ThreadPool* tp) {
   const int64_t output_height = input_height * 2;
   const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const T v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
+  const int64_t num_planes = batch_size * num_channels;
+  concurrency::ThreadPool::TryParallelForBlocks(
+      tp, num_planes, num_planes * output_height * output_width, concurrency::ThreadPool::kMinElementsPerBlock,
+      [&](int64_t first, int64_t last) {
+        for (int64_t plane = first; plane < last; ++plane) {
+          const T* Xdata = input + plane * input_height * input_width;
+          T* Ydata = output + plane * output_height * output_width;
+          for (int64_t y = 0; y < input_height; ++y) {
+            // write each output row once and duplicate it for the next output row
+            for (int64_t x = 0; x < input_width; ++x) {
+              const T v = Xdata[x];
+              Ydata[x * 2 + 0] = v;
+              Ydata[x * 2 + 1] = v;
+            }
+            memcpy(Ydata + output_width, Ydata, output_width * sizeof(T));
+            Xdata += input_width;
+            Ydata += 2 * output_width;
+          }
         }
-      }
-      input += input_height * input_width;
-      output += output_height * output_width;
-    }
-  }
+      });
 }
 
 template <typename T>
@@ -61,35 +70,78 @@ Status UpsampleNearest(const T* input,
                        T* output,
                        const TensorShape& input_shape,
                        const TensorShape& output_shape,
-                       const vector<float>& scales) {
+                       const vector<float>& scales,
+                       concurrency::ThreadPool* tp) {
   if (!input || !output)
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value is nullptr");
   if (input_shape.NumDimensions() != output_shape.NumDimensions())
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value's dimension mismatch");
   auto n_dim = input_shape.NumDimensions();
   if (scales.size() == 4 && scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
-    UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output);
-  } else {
-    for (size_t i = 0, size = output_shape.Size(); i < size; i++) {
-      size_t old_idx = 0;
-      size_t cur_idx = i;
+    UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output, tp);
+    return Status::OK();
+  }
 
-      int64_t base = 1;
-      for (auto j = static_cast<int64_t>(n_dim - 1); j >= 0; j--) {
-        auto tmp = cur_idx % output_shape[j];
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
 
-        if (scales[j] < 1) {  //downsample
-          old_idx += (std::min(static_cast<int64_t>(std::ceil(tmp / scales[j])), input_shape[j] - 1)) * base;
-        } else {  //upsample
-          old_idx += (std::min(static_cast<int64_t>(tmp / scales[j]), input_shape[j] - 1)) * base;
-        }
-        base *= input_shape[j];
-        cur_idx /= output_shape[j];
-      }
+  // a scalar has no axis to build an offset table for
+  if (n_dim == 0) {
+    output[0] = input[0];
+    return Status::OK();
+  }
 
-      output[i] = input[old_idx];
+  // Precompute, per axis, the offset into the input that each output coordinate maps to, so that the element loop
+  // only sums table entries instead of dividing by the scales.
+  std::vector<std::vector<int64_t>> input_offsets(n_dim);
+  int64_t input_stride = 1;
+  for (auto j = static_cast<int64_t>(n_dim - 1); j >= 0; j--) {
+    auto& offsets = input_offsets[j];
+    offsets.resize(output_shape[j]);
+    for (int64_t i = 0; i < output_shape[j]; i++) {
+      int64_t in_idx;
+      if (scales[j] < 1) {  //downsample
+        in_idx = std::min(static_cast<int64_t>(std::ceil(i / scales[j])), input_shape[j] - 1);
+      } else {  //upsample
+        in_idx = std::min(static_cast<int64_t>(i / scales[j]), input_shape[j] - 1);
+      }
+      offsets[i] = in_idx * input_stride;
     }
+    input_stride *= input_shape[j];
   }
+
+  // Output rows along the innermost axis are independent. A row that maps to the same input row as the one before
+  // it is a copy of that output row.
+  const int64_t output_width = output_shape[n_dim - 1];
+  const int64_t num_rows = output_shape.Size() / output_width;
+  const int64_t* inner_offsets = input_offsets[n_dim - 1].data();
+
+  concurrency::ThreadPool::TryParallelForBlocks(
+      tp, num_rows, num_rows * output_width, concurrency::ThreadPool::kMinElementsPerBlock,
+      [&](int64_t first, int64_t last) {
+        int64_t previous_offset = -1;
+        for (int64_t row = first; row < last; row++) {
+          int64_t input_offset = 0;
+          int64_t cur_idx = row;
+          for (auto j = static_cast<int64_t>(n_dim - 2); j >= 0; j--) {
+            input_offset += input_offsets[j][cur_idx % output_shape[j]];
+            cur_idx /= output_shape[j];
+          }
+
+          T* Ydata = output + row * output_width;
+          if (input_offset == previous_offset) {
+            memcpy(Ydata, Ydata - output_width, output_width * sizeof(T));
+          } else {
+            const T* Xdata = input + input_offset;
+            for (int64_t x = 0; x < output_width; x++) {
+              Ydata[x] = Xdata[inner_offsets[x]];
+            }
+          }
+          previous_offset = input_offset;
+        }
+      });
+
   return Status::OK();
 }
 
@@ -151,6 +203,49 @@ Status upsampleLiner(const T* input,
   return Status::OK();
 }
 
+// Source indices and interpolation weights of the two neighbours of every output row and column. The tables only
+// depend on the input and output sizes and are shared by all the planes of the tensor.
+struct BilinearParams {
+  std::vector<int64_t> in_y1;
+  std::vector<int64_t> in_y2;
+  std::vector<int64_t> in_x1;
+  std::vector<int64_t> in_x2;
+  std::vector<float> dy1;
+  std::vector<float> dy2;
+  std::vector<float> dx1;
+  std::vector<float> dx2;
+};
+
+static void ComputeBilinearAxis(int64_t input_size, int64_t output_size, float scale,
+                                std::vector<int64_t>& in1, std::vector<int64_t>& in2,
+                                std::vector<float>& d1, std::vector<float>& d2) {
+  in1.resize(output_size);
+  in2.resize(output_size);
+  d1.resize(output_size);
+  d2.resize(output_size);
+  for (int64_t i = 0; i < output_size; ++i) {
+    float in = std::min(i / scale, static_cast<float>(input_size - 1));
+    in1[i] = std::min(static_cast<int64_t>(in), input_size - 1);
+    in2[i] = std::min(in1[i] + 1, input_size - 1);
+
+    d1[i] = std::fabs(in - in1[i]);
+    d2[i] = std::fabs(in - in2[i]);
+    if (in1[i] == in2[i]) {
+      d1[i] = 0.5f;
+      d2[i] = 0.5f;
+    }
+  }
+}
+
+static BilinearParams SetupUpsampleBilinear(int64_t input_height, int64_t input_width,
+                                            int64_t output_height, int64_t output_width,
+                                            float height_scale, float width_scale) {
+  BilinearParams p;
+  ComputeBilinearAxis(input_height, output_height, height_scale, p.in_y1, p.in_y2, p.dy1, p.dy2);
+  ComputeBilinearAxis(input_width, output_width, width_scale, p.in_x1, p.in_x2, p.dx1, p.dx2);
+  return p;
+}
+
 template <typename T>
 void upsampleBilinear(
     int64_t batch_size,
@@ -161,73 +256,88 @@ void upsampleBilinear(
     float width_scale,
     const T* Xdata,
     T* Ydata,
-    AllocatorPtr& alloc) {
+    concurrency::ThreadPool* tp) {
   auto output_width = static_cast<int64_t>(input_width * width_scale);
   auto output_height = static_cast<int64_t>(input_height * height_scale);
 
-  size_t inx_buffer_size = 2 * sizeof(int64_t) * (output_height + output_width);
-  size_t scale_buffer_size = 2 * sizeof(float_t) * (output_height + output_width);
-  auto inx_scale_data_buffer = alloc->Alloc(inx_buffer_size + scale_buffer_size);
-  BufferUniquePtr inx_scale_data_buffer_holder(inx_scale_data_buffer, BufferDeleter(alloc));
-  auto* inx_data = static_cast<int64_t*>(inx_scale_data_buffer_holder.get());
-  int64_t* input_width_mul_y1 = inx_data;
-  int64_t* input_width_mul_y2 = inx_data + output_height;
-  int64_t* in_x1 = inx_data + 2 * output_height;
-  int64_t* in_x2 = inx_data + 2 * output_height + output_width;
-
-  auto* scale_data = reinterpret_cast<float*>(in_x2 + output_width);
-  float* dy1 = scale_data;
-  float* dy2 = scale_data + output_height;
-  float* dx1 = scale_data + 2 * output_height;
-  float* dx2 = scale_data + 2 * output_height + output_width;
-
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = std::min(y / height_scale, static_cast<float>(input_height - 1));
-    const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-    const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    dy1[y] = std::fabs(in_y - in_y1);
-    dy2[y] = std::fabs(in_y - in_y2);
-    if (in_y1 == in_y2) {
-      dy1[y] = 0.5f;
-      dy2[y] = 0.5f;
-    }
+  const BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                                 height_scale, width_scale);
 
-    input_width_mul_y1[y] = input_width * in_y1;
-    input_width_mul_y2[y] = input_width * in_y2;
-  }
+  const int64_t num_planes = batch_size * num_channels;
+  concurrency::ThreadPool::TryParallelForBlocks(
+      tp, num_planes, num_planes * output_height * output_width, concurrency::ThreadPool::kMinElementsPerBlock,
+      [&](int64_t first, int64_t last) {
+        for (int64_t plane = first; plane < last; ++plane) {
+          const T* X = Xdata + plane * input_height * input_width;
+          T* Y = Ydata + plane * output_height * output_width;
+          for (int64_t y = 0; y < output_height; ++y) {
+            const T* X1 = X + p.in_y1[y] * input_width;
+            const T* X2 = X + p.in_y2[y] * input_width;
+            const float dy1 = p.dy1[y];
+            const float dy2 = p.dy2[y];
+            for (int64_t x = 0; x < output_width; ++x) {
+              T X11 = X1[p.in_x1[x]];
+              T X21 = X1[p.in_x2[x]];
+              T X12 = X2[p.in_x1[x]];
+              T X22 = X2[p.in_x2[x]];
 
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = std::min(x / width_scale, static_cast<float>(input_width - 1));
-    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
+              Y[x] = static_cast<T>(p.dx2[x] * dy2 * X11 +
+                                    p.dx1[x] * dy2 * X21 +
+                                    p.dx2[x] * dy1 * X12 +
+                                    p.dx1[x] * dy1 * X22);
+            }
+            Y += output_width;
+          }
+        }
+      });
+}
 
-    dx1[x] = std::abs(in_x - in_x1[x]);
-    dx2[x] = std::abs(in_x - in_x2[x]);
-    if (in_x1[x] == in_x2[x]) {
-      dx1[x] = 0.5f;
-      dx2[x] = 0.5f;
-    }
-  }
+// Bilinear upsampling of a NHWC tensor. The channels of a pixel are contiguous, so the innermost loop blends four
+// input pixels with the same weights and vectorizes over the channels.
+template <typename T>
+void upsampleBilinearNhwc(
+    int64_t batch_size,
+    int64_t num_channels,
+    int64_t input_height,
+    int64_t input_width,
+    float height_scale,
+    float width_scale,
+    const T* Xdata,
+    T* Ydata,
+    concurrency::ThreadPool* tp) {
+  auto output_width = static_cast<int64_t>(input_width * width_scale);
+  auto output_height = static_cast<int64_t>(input_height * height_scale);
+
+  const BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                                 height_scale, width_scale);
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        for (int64_t x = 0; x < output_width; ++x) {
-          T X11 = Xdata[input_width_mul_y1[y] + in_x1[x]];
-          T X21 = Xdata[input_width_mul_y1[y] + in_x2[x]];
-          T X12 = Xdata[input_width_mul_y2[y] + in_x1[x]];
-          T X22 = Xdata[input_width_mul_y2[y] + in_x2[x]];
-
-          Ydata[output_width * y + x] = static_cast<T>(dx2[x] * dy2[y] * X11 +
-                                                       dx1[x] * dy2[y] * X21 +
-                                                       dx2[x] * dy1[y] * X12 +
-                                                       dx1[x] * dy1[y] * X22);
+  const int64_t num_rows = batch_size * output_height;
+  concurrency::ThreadPool::TryParallelForBlocks(
+      tp, num_rows, num_rows * output_width * num_channels, concurrency::ThreadPool::kMinElementsPerBlock,
+      [&](int64_t first, int64_t last) {
+        for (int64_t row = first; row < last; ++row) {
+          const int64_t n = row / output_height;
+          const int64_t y = row % output_height;
+          const T* X = Xdata + n * input_height * input_width * num_channels;
+          const T* X1 = X + p.in_y1[y] * input_width * num_channels;
+          const T* X2 = X + p.in_y2[y] * input_width * num_channels;
+          T* Y = Ydata + row * output_width * num_channels;
+          for (int64_t x = 0; x < output_width; ++x) {
+            const T* X11 = X1 + p.in_x1[x] * num_channels;
+            const T* X21 = X1 + p.in_x2[x] * num_channels;
+            const T* X12 = X2 + p.in_x1[x] * num_channels;
+            const T* X22 = X2 + p.in_x2[x] * num_channels;
+            const float w11 = p.dx2[x] * p.dy2[y];
+            const float w21 = p.dx1[x] * p.dy2[y];
+            const float w12 = p.dx2[x] * p.dy1[y];
+            const float w22 = p.dx1[x] * p.dy1[y];
+            for (int64_t c = 0; c < num_channels; ++c) {
+              Y[c] = static_cast<T>(w11 * X11[c] + w21 * X21[c] + w12 * X12[c] + w22 * X22[c]);
+            }
+            Y += num_channels;
+          }
         }
-      }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
-    }
-  }
+      });
 }
 
 template <typename T>
@@ -246,24 +356,26 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context, const std::vector<floa
   }
   Tensor* Y = context->Output(0, Y_dims);
 
+  auto tp = GetOperatorThreadPool(context);
+
   switch (mode_) {
     case UpsampleMode::NN:
-      return UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales);
+      return UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales,
+                                tp);
     case UpsampleMode::LINEAR: {
       //What's the correct behavior of linear mode is not clear right now,
-      //Only support bilinear with 4D tensor to keep consistent with previous behavior
+      //Only support bilinear with 4D tensor to keep consistent with previous behavior.
+      //The layout is NCHW unless the channel dimension is scaled, in which case it must be NHWC.
       if (dims.size() != 4)
-        return Status(ONNXRUNTIME, FAIL, "Upsample: linear mode upsample only support 4-D tensor with NCHW layout");
+        return Status(ONNXRUNTIME, FAIL, "Upsample: linear mode upsample only support 4-D tensor with NCHW or NHWC layout");
 
-      const int64_t batch_size = dims[0];
-      const int64_t num_channels = dims[1];
-      const int64_t input_height = dims[2];
-      const int64_t input_width = dims[3];
-
-      AllocatorPtr alloc;
-      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-      upsampleBilinear(batch_size, num_channels, input_height, input_width,
-                       scales[2], scales[3], X->template Data<T>(), Y->template MutableData<T>(), alloc);
+      if (scales[1] == 1) {
+        upsampleBilinear(dims[0], dims[1], dims[2], dims[3], scales[2], scales[3],
+                         X->template Data<T>(), Y->template MutableData<T>(), tp);
+      } else {
+        upsampleBilinearNhwc(dims[0], dims[3], dims[1], dims[2], scales[1], scales[2],
+                             X->template Data<T>(), Y->template MutableData<T>(), tp);
+      }
       return Status::OK();
     }
     default:
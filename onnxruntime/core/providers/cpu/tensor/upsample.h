@@ -17,7 +17,10 @@ enum UpsampleMode {
 
 class UpsampleBase {
  protected:
-  UpsampleBase(OpKernelInfo info) : scales_cached_(false) {
+  // 'nhwc_linear_supported' is set by the providers whose linear mode also accepts a NHWC layout, which is told
+  // apart from NCHW by the channel scale.
+  UpsampleBase(OpKernelInfo info, bool nhwc_linear_supported = false)
+      : scales_cached_(false), nhwc_linear_supported_(nhwc_linear_supported) {
     int start;
     int end;
     info.GetKernelDef().SinceVersion(&start, &end);
@@ -48,6 +51,7 @@ class UpsampleBase {
   std::vector<float> scales_;
   bool scales_cached_;
   bool is_resize = false;
+  bool nhwc_linear_supported_;
 
   UpsampleMode StringToUpsampleMode(const std::string& mode) {
     if (strcmp(mode.c_str(), UpsampleModeNN) == 0) {
@@ -73,8 +77,14 @@ class UpsampleBase {
 
     if (UpsampleMode::LINEAR == mode) {
       ORT_ENFORCE(scales.size() == 4, "Upsample: linear mode upsample only support bilinear with 4 dimension.");
-      ORT_ENFORCE(((scales[0] == 1) && (scales[1] == 1)),
-                  "Upsample: linear mode upsample only support bilinear, the first 2 scales should be 1.");
+      if (nhwc_linear_supported_) {
+        ORT_ENFORCE(((scales[0] == 1) && (scales[1] == 1 || scales[3] == 1)),
+                    "Upsample: linear mode upsample only support bilinear, the batch and channel scales should be 1 "
+                    "for NCHW or NHWC layout.");
+      } else {
+        ORT_ENFORCE(((scales[0] == 1) && (scales[1] == 1)),
+                    "Upsample: linear mode upsample only support bilinear, the first 2 scales should be 1.");
+      }
     }
   }
 
@@ -93,7 +103,7 @@ class UpsampleBase {
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
-  Upsample(OpKernelInfo info) : UpsampleBase(info), OpKernel(info) {
+  Upsample(OpKernelInfo info) : UpsampleBase(info, true), OpKernel(info) {
   }
 
   Status Compute(OpKernelContext* context) const override;
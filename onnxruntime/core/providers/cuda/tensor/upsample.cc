@@ -76,6 +76,10 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context, const std::vector<floa
       } else {
         return Status(ONNXRUNTIME, FAIL, "Upsample: linear mode only supports 4-D tensor with NCHW layout");
       }
+    if (scales[1] != 1)
+      return Status(ONNXRUNTIME, NOT_IMPLEMENTED,
+                    is_resize ? "Resize: linear mode only supports NCHW layout"
+                              : "Upsample: linear mode only supports NCHW layout");
   }
 
   if (is_resize) {
@@ -82,6 +82,18 @@ ORT_API_STATUS_IMPL(OrtDisableCpuMemArena, _In_ OrtSessionOptions* options) {
   return nullptr;
 }
 
+// Quantize the activations of MatMul, Gemm, LSTM and GRU nodes with constant weights on every call
+// and use integer GEMM with the weights quantized once at load time.
+ORT_API_STATUS_IMPL(OrtEnableDynamicQuantization, _In_ OrtSessionOptions* options) {
+  options->value.enable_dynamic_quantization = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtDisableDynamicQuantization, _In_ OrtSessionOptions* options) {
+  options->value.enable_dynamic_quantization = false;
+  return nullptr;
+}
+
 ///< logger id to use for session output
 ORT_API_STATUS_IMPL(OrtSetSessionLogId, _In_ OrtSessionOptions* options, const char* logid) {
   options->value.session_logid = logid;
@@ -86,6 +86,11 @@ struct SessionOptions {
 
   // How many threads in the session thread pool.
   int session_thread_pool_size = 0;
+
+  // Quantize the activations of float MatMul, Gemm, LSTM and GRU nodes with constant weights to uint8 on every
+  // call and compute them with integer GEMM against weights quantized to int8 once at load time.
+  // This trades some accuracy for speed on models where static calibration is impractical.
+  bool enable_dynamic_quantization = false;
 };
 
 /**
@@ -504,7 +504,7 @@ ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
   }
   size_t f = 0;
   char* p = static_cast<char*>(s);
-  for (size_t i = 0; i != offsets_len; ++i, ++offsets) {
+  for (size_t i = 0; i != len; ++i, ++offsets) {
     memcpy(p, input[i].data(), input[i].size());
     p += input[i].size();
     *offsets = f;
@@ -514,6 +514,39 @@ ORT_API_STATUS_IMPL(OrtGetStringTensorContent, _In_ const OrtValue* value,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtFillStringTensorFromBuffer, _Inout_ OrtValue* value, _In_ const void* s, size_t s_len,
+                    _In_ const size_t* offsets, size_t offsets_len) {
+  TENSOR_READWRITE_API_BEGIN
+  auto* dst = tensor->MutableData<std::string>();
+  auto len = static_cast<size_t>(tensor->Shape().Size());
+  if (offsets_len < len) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "offsets array is too short");
+  }
+  const char* chars = static_cast<const char*>(s);
+  for (size_t i = 0; i != len; ++i) {
+    const size_t end = i + 1 < offsets_len ? offsets[i + 1] : s_len;
+    if (offsets[i] > end || end > s_len) {
+      return OrtCreateStatus(ORT_INVALID_ARGUMENT, "offsets are out of the range of the string buffer");
+    }
+    dst[i].assign(chars + offsets[i], end - offsets[i]);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtGetStringTensorElement, _In_ const OrtValue* value, size_t index, _Out_ const char** s,
+                    _Out_ size_t* len) {
+  TENSOR_READ_API_BEGIN
+  if (index >= static_cast<size_t>(tensor.Shape().Size())) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "index is out of range");
+  }
+  const std::string& element = tensor.Data<std::string>()[index];
+  *s = element.data();
+  *len = element.size();
+  return nullptr;
+  API_IMPL_END
+}
+
 #define ORT_C_API_RETURN_IF_ERROR(expr)                 \
   do {                                                  \
     auto _status = (expr);                              \
@@ -693,6 +726,29 @@ ORT_API_STATUS_IMPL(OrtSessionGetOutputName, _In_ const OrtSession* sess, size_t
 ///////////////////////////////////////////////////////////////////////////
 const int NUM_MAP_INDICES = 2;
 
+namespace onnxruntime {
+// One map of a sequence of maps, as returned by OrtGetValue. It keeps the sequence alive and reads the keys and the
+// values from its storage, so that fetching the maps of a ZipMap output does not copy each of them into a std::map.
+template <typename TSeq>
+struct MapSequenceElement {
+  using key_type = typename TSeq::key_type;
+  using mapped_type = typename TSeq::mapped_type;
+
+  typename TSeq::Map Get() const {
+    return sequence.Get<TSeq>()[index];
+  }
+
+  OrtValue sequence;
+  size_t index = 0;
+};
+
+using MapStringToFloatElement = MapSequenceElement<VectorMapStringToFloat>;
+using MapInt64ToFloatElement = MapSequenceElement<VectorMapInt64ToFloat>;
+
+ORT_REGISTER_MAP(MapStringToFloatElement);
+ORT_REGISTER_MAP(MapInt64ToFloatElement);
+}  // namespace onnxruntime
+
 ////////////////////
 // OrtGetValueCount
 template <typename T>
@@ -745,16 +801,17 @@ ORT_API_STATUS_IMPL(OrtGetValueCount, const OrtValue* value, size_t* out) {
 // OrtGetValue
 template <typename T>
 static OrtStatus* OrtGetValueImplSeqOfMap(const OrtValue* p_ml_value, int index, OrtValue** out) {
-  using TKey = typename T::value_type::key_type;
-  using TVal = typename T::value_type::mapped_type;
-  using MapType = std::map<TKey, TVal>;
+  using ElementType = MapSequenceElement<T>;
   auto& data_vec = p_ml_value->Get<T>();
-  auto& data_elem = data_vec.at(index);
-  auto copy_data_elem = std::make_unique<MapType>(data_elem);
+  ORT_ENFORCE(index >= 0 && static_cast<size_t>(index) < data_vec.size(), "Index ", index,
+              " is out of range for a sequence of ", data_vec.size(), " maps");
+  auto element = std::make_unique<ElementType>();
+  element->sequence = *p_ml_value;
+  element->index = static_cast<size_t>(index);
   auto value = std::make_unique<OrtValue>();
-  value->Init(copy_data_elem.release(),
-              DataTypeImpl::GetType<MapType>(),
-              DataTypeImpl::GetType<MapType>()->GetDeleteFunc());
+  value->Init(element.release(),
+              DataTypeImpl::GetType<ElementType>(),
+              DataTypeImpl::GetType<ElementType>()->GetDeleteFunc());
   *out = value.release();
   return nullptr;
 }
@@ -881,6 +938,32 @@ static OrtStatus* OrtGetValueImplMapHelper(const OrtValue* p_ml_value, int index
   }
 }
 
+// The keys and the values of a map of a sequence are already stored in arrays, in key order, and are copied
+// directly into the tensors.
+template <typename T>
+static OrtStatus* OrtGetValueImplMapElementHelper(const OrtValue* p_ml_value, int index, OrtAllocator* allocator,
+                                                  OrtValue** out) {
+  using TKey = typename T::key_type;
+  using TVal = typename T::mapped_type;
+  const auto map = p_ml_value->Get<T>().Get();
+  const size_t num_kv_pairs = map.size();
+  std::vector<int64_t> dims{static_cast<int64_t>(num_kv_pairs)};
+  switch (index) {
+    case 0: {  // user is requesting keys
+      OrtStatus* st = OrtCreateTensorAsOrtValue(allocator, dims.data(), dims.size(),
+                                                GetONNXTensorElementDataType<TKey>(), out);
+      return st ? st : PopulateTensorWithData<TKey>(*out, map.keys(), num_kv_pairs);
+    }
+    case 1: {  // user is requesting values
+      OrtStatus* st = OrtCreateTensorAsOrtValue(allocator, dims.data(), dims.size(),
+                                                GetONNXTensorElementDataType<TVal>(), out);
+      return st ? st : PopulateTensorWithData<TVal>(*out, map.values(), num_kv_pairs);
+    }
+    default:
+      return OrtCreateStatus(ORT_FAIL, "Invalid index requested for map type.");
+  }
+}
+
 static OrtStatus* OrtGetValueImplMap(const OrtValue* value, int index, OrtAllocator* allocator,
                                      OrtValue** out) {
   auto p_ml_value = reinterpret_cast<const OrtValue*>(value);
@@ -903,6 +986,10 @@ static OrtStatus* OrtGetValueImplMap(const OrtValue* value, int index, OrtAlloca
     return OrtGetValueImplMapHelper<MapInt64ToFloat>(p_ml_value, index, allocator, out);
   } else if (type == DataTypeImpl::GetType<MapInt64ToDouble>()) {
     return OrtGetValueImplMapHelper<MapInt64ToDouble>(p_ml_value, index, allocator, out);
+  } else if (type == DataTypeImpl::GetType<MapStringToFloatElement>()) {
+    return OrtGetValueImplMapElementHelper<MapStringToFloatElement>(p_ml_value, index, allocator, out);
+  } else if (type == DataTypeImpl::GetType<MapInt64ToFloatElement>()) {
+    return OrtGetValueImplMapElementHelper<MapInt64ToFloatElement>(p_ml_value, index, allocator, out);
   } else {
     return OrtCreateStatus(ORT_FAIL, "Input is not of one of the supported map types.");
   }
@@ -932,18 +1019,24 @@ ORT_API_STATUS_IMPL(OrtGetValue, const OrtValue* value, int index, OrtAllocator*
 
 ///////////////////
 // OrtCreateValue
-template <typename T>
+// The maps are either created by OrtCreateValue or returned by OrtGetValue for the elements of another sequence.
+template <typename TKey, typename TVal>
 static OrtStatus* OrtCreateValueImplSeqHelperMap(OrtValue** const in, size_t num_values, OrtValue** out) {
-  using SeqType = std::vector<T>;
-  auto vec_ptr = std::make_unique<SeqType>();
-  vec_ptr->reserve(num_values);
+  using SeqType = MapSequence<TKey, TVal>;
+  using MapType = std::map<TKey, TVal>;
+  using ElementType = MapSequenceElement<SeqType>;
+  auto seq_ptr = std::make_unique<SeqType>();
   for (size_t idx = 0; idx < num_values; ++idx) {
-    auto& m = reinterpret_cast<const OrtValue*>(in[idx])->Get<T>();
-    vec_ptr->push_back(m);
+    auto* v = reinterpret_cast<const OrtValue*>(in[idx]);
+    if (v->Type() == DataTypeImpl::GetType<ElementType>()) {
+      seq_ptr->push_back(v->Get<ElementType>().Get());
+    } else {
+      seq_ptr->push_back(v->Get<MapType>());
+    }
   }
-  // create OrtValue with this vector
+  // create OrtValue with this sequence
   auto value = std::make_unique<OrtValue>();
-  value->Init(vec_ptr.release(),
+  value->Init(seq_ptr.release(),
               DataTypeImpl::GetType<SeqType>(),
               DataTypeImpl::GetType<SeqType>()->GetDeleteFunc());
   *out = value.release();
@@ -1017,11 +1110,13 @@ static OrtStatus* OrtCreateValueImplSeq(OrtValue** in, size_t num_values, OrtVal
     }
   } else if (first_value_type == ONNX_TYPE_MAP) {
     auto map_type = first_mlvalue->Type();
-    if (map_type == DataTypeImpl::GetType<MapStringToFloat>()) {
-      return OrtCreateValueImplSeqHelperMap<MapStringToFloat>(in, num_values, out);
+    if (map_type == DataTypeImpl::GetType<MapStringToFloat>() ||
+        map_type == DataTypeImpl::GetType<MapStringToFloatElement>()) {
+      return OrtCreateValueImplSeqHelperMap<std::string, float>(in, num_values, out);
     }
-    if (map_type == DataTypeImpl::GetType<MapInt64ToFloat>()) {
-      return OrtCreateValueImplSeqHelperMap<MapInt64ToFloat>(in, num_values, out);
+    if (map_type == DataTypeImpl::GetType<MapInt64ToFloat>() ||
+        map_type == DataTypeImpl::GetType<MapInt64ToFloatElement>()) {
+      return OrtCreateValueImplSeqHelperMap<int64_t, float>(in, num_values, out);
     } else {
       return OrtCreateStatus(ORT_FAIL, "Input is not of one of the supported map types.");
     }
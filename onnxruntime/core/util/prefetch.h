@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+constexpr int64_t kPrefetchCacheLineBytes = 64;
+
+// Only the start of a long row is prefetched; the hardware prefetcher picks up the sequential rest.
+constexpr int64_t kPrefetchMaxRowBytes = 512;
+
+// How many rows ahead of the copy an indexed gather prefetches, far enough to cover the latency of a cache miss.
+constexpr int64_t kPrefetchDistance = 8;
+
+/**
+ * Hints the CPU to load the cache line holding 'address' for a read that will happen shortly.
+ */
+inline void PrefetchRead(const void* address) {
+#if defined(__GNUC__)
+  __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+  ORT_UNUSED_PARAMETER(address);
+#endif
+}
+
+/**
+ * Prefetches the first kPrefetchMaxRowBytes of the 'row_bytes' long row at 'row', one cache line at a time.
+ */
+inline void PrefetchRow(const uint8_t* row, int64_t row_bytes) {
+  const int64_t prefetch_bytes = std::min(row_bytes, kPrefetchMaxRowBytes);
+  for (int64_t offset = 0; offset < prefetch_bytes; offset += kPrefetchCacheLineBytes) {
+    PrefetchRead(row + offset);
+  }
+}
+
+}  // namespace onnxruntime
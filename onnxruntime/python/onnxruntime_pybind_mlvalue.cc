@@ -262,18 +262,18 @@ template <typename KeyType, typename ValueType, typename KeyGetterType, typename
 void CreateMapMLValue_VectorMap(Py_ssize_t& pos, PyObject*& key, const std::string& name_input, PyObject*& value,
                                 PyObject* iterator, PyObject* item, AllocatorPtr /*alloc*/, OrtValue* p_mlvalue,
                                 KeyGetterType keyGetter, ValueGetterType valueGetter) {
-  std::unique_ptr<std::vector<std::map<KeyType, ValueType>>> dstVector;
-  dstVector = std::make_unique<std::vector<std::map<KeyType, ValueType>>>();
-  int index = 0;
+  std::unique_ptr<MapSequence<KeyType, ValueType>> dstVector;
+  dstVector = std::make_unique<MapSequence<KeyType, ValueType>>();
+  std::map<KeyType, ValueType> dstMap;
   do {
-    dstVector->push_back(std::map<KeyType, ValueType>());
-    CreateMapMLValue_LoopIntoMap(pos, key, name_input, value, item, (*dstVector)[index], keyGetter, valueGetter);
+    dstMap.clear();
+    CreateMapMLValue_LoopIntoMap(pos, key, name_input, value, item, dstMap, keyGetter, valueGetter);
+    dstVector->push_back(dstMap);
     Py_DECREF(item);
-    ++index;
     item = iterator == NULL ? NULL : PyIter_Next(iterator);
   } while (item != NULL);
-  p_mlvalue->Init(dstVector.release(), DataTypeImpl::GetType<std::vector<std::map<KeyType, ValueType>>>(),
-                  DataTypeImpl::GetType<std::vector<std::map<KeyType, ValueType>>>()->GetDeleteFunc());
+  p_mlvalue->Init(dstVector.release(), DataTypeImpl::GetType<MapSequence<KeyType, ValueType>>(),
+                  DataTypeImpl::GetType<MapSequence<KeyType, ValueType>>()->GetDeleteFunc());
 }
 
 void CreateMapMLValue_AgnosticMap(Py_ssize_t& pos, PyObject*& key, const std::string& name_input, PyObject*& value,
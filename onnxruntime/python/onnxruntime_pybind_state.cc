@@ -85,7 +85,7 @@
 #endif
 
 namespace onnxruntime {
-std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena);
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena, bool enable_dynamic_quantization);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CUDA(int device_id);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Tensorrt();
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Mkldnn(int use_arena);
@@ -127,6 +127,22 @@ template <typename T>
 void AddNonTensor(OrtValue& val, vector<py::object>& pyobjs) {
   pyobjs.push_back(py::cast(val.Get<T>()));
 }
+
+// A sequence of maps is returned as a list of dicts, built directly from the keys and values of each map.
+template <typename TKey, typename TValue>
+void AddMapSequence(OrtValue& val, vector<py::object>& pyobjs) {
+  const auto& seq = val.Get<MapSequence<TKey, TValue>>();
+  py::list maps;
+  for (size_t i = 0; i < seq.size(); ++i) {
+    const auto map = seq[i];
+    py::dict dict;
+    for (size_t j = 0; j < map.size(); ++j) {
+      dict[py::cast(map.keys()[j])] = py::cast(map.values()[j]);
+    }
+    maps.append(dict);
+  }
+  pyobjs.push_back(maps);
+}
 void AddNonTensorAsPyObj(OrtValue& val, vector<py::object>& pyobjs) {
   // Should be in sync with core/framework/datatypes.h
   if (val.Type() == DataTypeImpl::GetType<MapStringToString>()) {
@@ -154,9 +170,9 @@ void AddNonTensorAsPyObj(OrtValue& val, vector<py::object>& pyobjs) {
   } else if (val.Type() == DataTypeImpl::GetType<VectorDouble>()) {
     AddNonTensor<VectorDouble>(val, pyobjs);
   } else if (val.Type() == DataTypeImpl::GetType<VectorMapStringToFloat>()) {
-    AddNonTensor<VectorMapStringToFloat>(val, pyobjs);
+    AddMapSequence<std::string, float>(val, pyobjs);
   } else if (val.Type() == DataTypeImpl::GetType<VectorMapInt64ToFloat>()) {
-    AddNonTensor<VectorMapInt64ToFloat>(val, pyobjs);
+    AddMapSequence<int64_t, float>(val, pyobjs);
   } else {
     throw std::runtime_error("Output is a non-tensor type which is not supported.");
   }
@@ -387,6 +403,9 @@ void addObjectMethods(py::module& m) {
       .def_readwrite("enable_cpu_mem_arena", &SessionOptions::enable_cpu_mem_arena,
                      R"pbdoc(Enables the memory arena on CPU. Arena may pre-allocate memory for future usage.
 Set this option to false if you don't want it. Default is True.)pbdoc")
+      .def_readwrite("enable_dynamic_quantization", &SessionOptions::enable_dynamic_quantization,
+                     R"pbdoc(Quantizes the activations of MatMul, Gemm, LSTM and GRU nodes with constant weights
+on every call and uses integer GEMM with weights quantized to int8 at load time. Default is false.)pbdoc")
       .def_readwrite("enable_profiling", &SessionOptions::enable_profiling,
                      R"pbdoc(Enable profiling for this session. Default is false.)pbdoc")
       .def_readwrite("enable_mem_pattern", &SessionOptions::enable_mem_pattern,
@@ -234,6 +234,16 @@ static std::vector<T> ConvertBatchSeqToSeqBatch(
 
 // This  convert seq in [*, 4*cell_hidden_size] from: I, J(C), F, O into: I O, F, C(J)
 // for weights from semantic TF to Onnx semantic.
+// Builds a batch out of the rows of 'src' listed in 'rows', each row being 'row_size' values.
+template <typename T>
+static std::vector<T> SelectRows(const std::vector<T>& src, const std::vector<int>& rows, int row_size) {
+  std::vector<T> dst;
+  for (int row : rows) {
+    dst.insert(dst.end(), src.begin() + row * row_size, src.begin() + (row + 1) * row_size);
+  }
+  return dst;
+}
+
 template <typename T>
 static std::vector<T> ConvertIcfoToIofc(const std::vector<T>& icfo, int cell_hidden_size) {
   std::vector<T> iofc(icfo.size());
@@ -585,5 +595,54 @@ TEST(AttnLSTMTest, BidirectionLstmWithBahdanauAM2BatchShortenSeqLen) {
       "bidirectional", -9999.f, true, false);
 }
 
+// The batch rows are independent, so a larger batch mixing the rows of the 2 batch case, with their different memory
+// lengths, must give each row the output it has in the 2 batch case.
+TEST(AttnLSTMTest, ForwardLstmWithBahdanauAMMixedMemoryLengths) {
+  const int inputMaxStep4 = 4;
+  const std::vector<int> rows{1, 0, 1, 1, 0};
+  const int batch5Size = static_cast<int>(rows.size());
+
+  static const std::vector<float> s_X_T_2batch{0.25f, -1.5f, 1.0f, 0.25f, -0.5f, -1.5f, 0.1f, 1.5f, 0.25f, 0.0f, 0.0f, 0.0f,
+                                               0.1f, -0.125f, 0.25f, -0.5f, 0.25f, 0.1f, 1.0f, 0.5f, -1.5f, 0.0f, 0.0f, 0.0f};
+  static const std::vector<int> s_seq_lengths_2batch{3, 2};
+
+  // forward half of the 2 batch bidirectional case
+  static const std::vector<float> s_Y_T_2batch{
+      0.0978363082f, 0.105625421f, 0.116753615f, 0.236107856f, 0.195716992f, -0.133973882f, -0.029754376f, 0.274325848f, -0.387993187f, 0.0f, 0.0f, 0.0f,
+      0.261070877f, 0.144692719f, -0.274273455f, -0.272313654f, 0.324584424f, -0.298215479f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+  std::vector<float> X_data = ConvertBatchSeqToSeqBatch(
+      SelectRows(s_X_T_2batch, rows, inputMaxStep4 * input_only_depth), batch5Size, inputMaxStep4, input_only_depth);
+  std::vector<float> M_data = SelectRows(s_M_2batch, rows, memory_max_step * memory_depth);
+  std::vector<int> mem_seq_lengths = SelectRows(s_mem_seq_lenghts_2batch, rows, 1);
+  std::vector<int> seq_lengths = SelectRows(s_seq_lengths_2batch, rows, 1);
+
+  std::vector<float> WR_T_data = ConvertIcfoToIofc(s_WR_T_data_ICFO, cell_hidden_size);
+
+  const size_t W_data_size = 5 * 12;
+  std::vector<float> W_T_data(&(WR_T_data[0]), &(WR_T_data[0]) + W_data_size);
+  std::vector<float> R_T_data(&(WR_T_data[0]) + W_data_size, &(WR_T_data[0]) + WR_T_data.size());
+
+  // transpose W and R for onnx sematic
+  std::vector<float> W_data = Transpose2D(W_T_data, input_size, 4 * cell_hidden_size);
+  std::vector<float> R_data = Transpose2D(R_T_data, cell_hidden_size, 4 * cell_hidden_size);
+
+  std::vector<float> B_data = ConvertIcfoToIofc(s_lstm_cell_bias_ICFO, cell_hidden_size);
+
+  std::vector<float> Y_data = ConvertBatchSeqToSeqBatch(
+      SelectRows(s_Y_T_2batch, rows, inputMaxStep4 * cell_hidden_size), batch5Size, inputMaxStep4, cell_hidden_size);
+
+  const std::vector<float> Y_h_data{};
+  const std::vector<float> Y_c_data{};
+
+  RunAttnLstmTest(
+      X_data, W_data, R_data, Y_data, Y_h_data, Y_c_data,
+      s_memory_layer_weight, s_query_layer_weight, s_attn_v, M_data, &mem_seq_lengths, &s_attn_layer_weight,
+      input_only_depth, batch5Size, cell_hidden_size, inputMaxStep4,
+      memory_max_step, memory_depth, am_attn_size, aw_attn_size,
+      &B_data, nullptr, nullptr, nullptr, &seq_lengths,
+      "forward", -9999.f, true, false);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
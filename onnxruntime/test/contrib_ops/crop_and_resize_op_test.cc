@@ -4,9 +4,100 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <cmath>
+#include <string>
+
 namespace onnxruntime {
 namespace test {
 
+// Position of crop sample p along an axis of the given size, for a normalized [start, end] ROI edge pair.
+static float CropSamplePosition(float start, float end, int64_t size, int32_t crop_size, int32_t p) {
+  if (crop_size == 1) {
+    return 0.5f * (start + end) * (size - 1);
+  }
+  if (p == crop_size - 1) {
+    return end * (size - 1);
+  }
+  const float scale = (end - start) * (size - 1) / (crop_size - 1);
+  return start * (size - 1) + p * scale;
+}
+
+// CropAndResize computed one output element at a time. Samples outside the image take extrapolation_value.
+static std::vector<float> CropAndResizeReference(const std::vector<float>& X, int64_t channels, int64_t height,
+                                                 int64_t width, const std::vector<float>& rois,
+                                                 const std::vector<int32_t>& batch_indices, int32_t crop_height,
+                                                 int32_t crop_width, float extrapolation_value, bool nearest) {
+  std::vector<float> Y;
+  for (size_t n = 0; n < batch_indices.size(); n++) {
+    const float* roi = rois.data() + n * 4;
+    for (int64_t c = 0; c < channels; c++) {
+      const float* plane = X.data() + (batch_indices[n] * channels + c) * height * width;
+      for (int32_t ph = 0; ph < crop_height; ph++) {
+        const float y = CropSamplePosition(roi[0], roi[2], height, crop_height, ph);
+        for (int32_t pw = 0; pw < crop_width; pw++) {
+          const float x = CropSamplePosition(roi[1], roi[3], width, crop_width, pw);
+          if (y < 0 || y > height - 1 || x < 0 || x > width - 1) {
+            Y.push_back(extrapolation_value);
+          } else if (nearest) {
+            Y.push_back(plane[static_cast<int64_t>(std::round(y)) * width + static_cast<int64_t>(std::round(x))]);
+          } else {
+            const auto y0 = static_cast<int64_t>(std::floor(y));
+            const auto y1 = static_cast<int64_t>(std::ceil(y));
+            const auto x0 = static_cast<int64_t>(std::floor(x));
+            const auto x1 = static_cast<int64_t>(std::ceil(x));
+            const float top = plane[y0 * width + x0] + (plane[y0 * width + x1] - plane[y0 * width + x0]) * (x - x0);
+            const float bottom =
+                plane[y1 * width + x0] + (plane[y1 * width + x1] - plane[y1 * width + x0]) * (x - x0);
+            Y.push_back(top + (bottom - top) * (y - y0));
+          }
+        }
+      }
+    }
+  }
+  return Y;
+}
+
+// Runs enough ROIs and channels that the output is split into several thread pool blocks. The ROIs mix boxes inside
+// the image, boxes reaching past its edges and flipped boxes (end before start) over two images.
+static void RunCropAndResizeManyRoisTest(const char* mode) {
+  const int64_t N = 2;
+  const int64_t C = 8;
+  const int64_t H = 9;
+  const int64_t W = 11;
+  const int64_t num_rois = 40;
+  const int32_t crop_height = 8;
+  const int32_t crop_width = 8;
+  const float extrapolation_value = -1.5f;
+
+  std::vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>((i * 7) % 23) * 0.5f - 3.f;
+  }
+
+  std::vector<float> rois;
+  std::vector<int32_t> batch_indices;
+  for (int64_t r = 0; r < num_rois; r++) {
+    const float y1 = static_cast<float>(r % 7) * 0.1f - 0.1f;
+    const float x1 = static_cast<float>(r % 5) * 0.12f - 0.1f;
+    const float y2 = y1 + (r % 4 == 0 ? -0.4f : 0.3f + 0.1f * (r % 6));
+    const float x2 = x1 + (r % 3 == 0 ? -0.35f : 0.45f + 0.15f * (r % 4));
+    rois.insert(rois.end(), {y1, x1, y2, x2});
+    batch_indices.push_back(static_cast<int32_t>(r % N));
+  }
+
+  OpTester test("CropAndResize", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("mode", mode);
+  test.AddAttribute("extrapolation_value", extrapolation_value);
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("rois", {num_rois, 4}, rois);
+  test.AddInput<int32_t>("batch_indices", {num_rois}, batch_indices);
+  test.AddInput<int32_t>("crop_size", {2}, {crop_height, crop_width});
+  test.AddOutput<float>("output", {num_rois, C, crop_height, crop_width},
+                        CropAndResizeReference(X, C, H, W, rois, batch_indices, crop_height, crop_width,
+                                               extrapolation_value, std::string(mode) == "nearest"));
+  test.Run();
+}
+
 TEST(CropAndResizeTest, CropAndResize_1122) {
   OpTester test1 ("CropAndResize", 1, onnxruntime::kMSDomain);
   test1.AddInput  <float> ("X",   {1, 1, 2, 2}, {1.1f, 2.2f, 3.3f, 4.4f});
@@ -98,7 +189,27 @@ TEST(CropAndResizeTest, CropAndResize_1133) {
 	test3.Run();
 }
 
+TEST(CropAndResizeTest, CropAndResize_NearestOutOfRange) {
+  OpTester test("CropAndResize", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {1, 1, 3, 3}, {1.1f, 2.2f, 3.3f, 4.4f, 5.5f, 6.6f, 7.7f, 8.8f, 9.9f});
+  // the last ROI samples rows -1 and 2 and columns 1 and 3, so only (2, 1) is inside the image
+  test.AddInput<float>("rois", {3, 4}, {0.0f, 0.0f, 1.0f, 1.0f, 0.25f, 0.25f, 0.75f, 0.75f, -0.5f, 0.5f, 1.0f, 1.5f});
+  test.AddInput<int32_t>("batch_indices", {3}, {0, 0, 0});
+  test.AddInput<int32_t>("crop_size", {2}, {2, 2});
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("extrapolation_value", 5.25f);
+  test.AddOutput<float>("output", {3, 1, 2, 2},
+                        {1.1f, 3.3f, 7.7f, 9.9f, 5.5f, 6.6f, 8.8f, 9.9f, 5.25f, 5.25f, 8.8f, 5.25f});
+  test.Run();
+}
 
+TEST(CropAndResizeTest, CropAndResize_BilinearManyRoisAndChannels) {
+  RunCropAndResizeManyRoisTest("bilinear");
+}
+
+TEST(CropAndResizeTest, CropAndResize_NearestManyRoisAndChannels) {
+  RunCropAndResizeManyRoisTest("nearest");
+}
 
 }  // namespace Test
 }  // namespace onnxruntime
@@ -153,5 +153,34 @@ TEST(GatherNDOpTest, GatherND_batched_3tensor_int64) {
   test3.Run();
 }
 
+TEST(GatherNDOpTest, GatherND_invalid_index) {
+  // past the end of the second dimension, although the flattened offset would still be inside the data
+  OpTester test1("GatherND", 1, onnxruntime::kMSDomain);
+  test1.AddInput<float>("data", {2,3}, {0.f,1.f,2.f,3.f,4.f,5.f});
+  test1.AddInput<int64_t>("indices", {2,2}, {0LL,1LL,0LL,3LL});
+  test1.AddOutput<float>("output", {2}, {1.f,3.f});
+  test1.Run(OpTester::ExpectResult::kExpectFailure, "invalid indice found, indice = 3");
+
+  OpTester test2("GatherND", 1, onnxruntime::kMSDomain);
+  test2.AddInput<std::string>("data", {2,2}, {"a","b","c","d"});
+  test2.AddInput<int32_t>("indices", {2,1}, {1,-1});
+  test2.AddOutput<std::string>("output", {2,2}, {"c","d","a","b"});
+  test2.Run(OpTester::ExpectResult::kExpectFailure, "invalid indice found, indice = -1");
+
+  // a single bad index at the end of a batch large enough to be split over the thread pool
+  std::vector<int64_t> indices(20000);
+  std::vector<int64_t> output(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<int64_t>(i % 4);
+    output[i] = static_cast<int64_t>(i % 4) * 10;
+  }
+  indices.back() = 4;
+  OpTester test3("GatherND", 1, onnxruntime::kMSDomain);
+  test3.AddInput<int64_t>("data", {4}, {0LL,10LL,20LL,30LL});
+  test3.AddInput<int64_t>("indices", {static_cast<int64_t>(indices.size()),1}, indices);
+  test3.AddOutput<int64_t>("output", {static_cast<int64_t>(output.size())}, output);
+  test3.Run(OpTester::ExpectResult::kExpectFailure, "invalid indice found, indice = 4");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ContribOpTest, MatMulWithHalfWeights_Float16) {
+  OpTester test("MatMulWithHalfWeights", 1, onnxruntime::kMSDomain);
+
+  std::vector<float> b_values{1.0f, 2.0f, 3.0f, -1.0f, 0.5f, -2.0f};
+  std::vector<MLFloat16> b(b_values.size());
+  ConvertFloatToMLFloat16(b_values.data(), b.data(), static_cast<int>(b_values.size()));
+
+  test.AddInput<float>("A", {2, 1, 2}, {1.0f, 2.0f, -3.0f, 0.25f});
+  test.AddInput<MLFloat16>("B", {2, 3}, b, true);
+  test.AddOutput<float>("Y", {2, 1, 3}, {-1.0f, 3.0f, -1.0f, -3.25f, -5.875f, -9.5f});
+  test.Run();
+}
+
+TEST(ContribOpTest, MatMulWithHalfWeights_BFloat16TransBBias) {
+  OpTester test("MatMulWithHalfWeights", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("transB", 1);
+  test.AddAttribute<float>("alpha", 2.0f);
+
+  // B is (N, K) = (3, 2)
+  test.AddInput<float>("A", {2, 2}, {1.0f, 2.0f, -3.0f, 0.25f});
+  test.AddInput<BFloat16>("B", {3, 2}, {BFloat16(1.0f), BFloat16(-1.0f),
+                                        BFloat16(2.0f), BFloat16(0.5f),
+                                        BFloat16(3.0f), BFloat16(-2.0f)},
+                          true);
+  test.AddInput<float>("C", {3}, {1.0f, 0.0f, -1.0f});
+  test.AddOutput<float>("Y", {2, 3}, {-1.0f, 6.0f, -3.0f, -5.5f, -11.75f, -20.0f});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
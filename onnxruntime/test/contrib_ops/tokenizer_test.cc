@@ -677,6 +677,33 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }  // namespace test
 
+TEST(ContribOpTest, TokenizerWithSeparators_SeparatorsMissingFromSomeRowsNC) {
+  // Rows where only some of the separators occur, including a separator
+  // that only matches at the start of a piece left by an earlier separator
+  std::vector<std::string> separators = {
+      u8" ",
+      u8",",
+      u8"^x"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 2);
+
+  std::vector<int64_t> dims{2, 2};
+  std::vector<std::string> input{u8"ab cd", u8"ab,cd", u8"abcd", u8"ab xcd,e"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(2));
+  std::vector<std::string> output{
+      u8"ab", u8"cd",
+      u8"ab", u8"cd",
+      u8"abcd", padval,
+      u8"ab", u8"cd"};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, TokenizerExpression_RegEx) {
   OpTester test("Tokenizer", opset_ver, domain);
   const std::string tokenexp(u8"a.");
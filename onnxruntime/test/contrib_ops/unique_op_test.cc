@@ -43,5 +43,50 @@ TEST(UniqueOpTest, Unique_AllUniqueElements) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+TEST(UniqueOpTest, Unique_Int32) {
+  OpTester test("Unique", 1, onnxruntime::kMSDomain);
+  test.AddInput<int32_t>("x", {7}, {-1, 5, 5, 0, -1, 7, 5});
+  test.AddOutput<int32_t>("uniques", {4}, {-1, 5, 0, 7});
+  test.AddOutput<int64_t>("idx", {7}, {0, 1, 1, 2, 0, 3, 1});
+  test.AddOutput<int64_t>("counts", {4}, {2, 3, 1, 1});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(UniqueOpTest, Unique_String) {
+  OpTester test("Unique", 1, onnxruntime::kMSDomain);
+  test.AddInput<std::string>("x", {6}, {"b", "a", "", "a", "b", "c"});
+  test.AddOutput<std::string>("uniques", {4}, {"b", "a", "", "c"});
+  test.AddOutput<int64_t>("idx", {6}, {0, 1, 2, 1, 0, 3});
+  test.AddOutput<int64_t>("counts", {4}, {2, 2, 1, 1});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+// large enough to be partitioned and to radix sort the partitions
+TEST(UniqueOpTest, Unique_Int64_Large) {
+  const int64_t num_elements = 100000;
+  const int64_t num_uniques = 30011;
+
+  std::vector<int64_t> x(num_elements);
+  std::vector<int64_t> idx(num_elements);
+  for (int64_t i = 0; i < num_elements; ++i) {
+    idx[i] = i % num_uniques;
+    x[i] = (num_uniques - idx[i]) * 1000000007LL;
+  }
+
+  std::vector<int64_t> uniques(num_uniques);
+  std::vector<int64_t> counts(num_uniques);
+  for (int64_t i = 0; i < num_uniques; ++i) {
+    uniques[i] = x[i];
+    counts[i] = num_elements / num_uniques + (i < num_elements % num_uniques ? 1 : 0);
+  }
+
+  OpTester test("Unique", 1, onnxruntime::kMSDomain);
+  test.AddInput<int64_t>("x", {num_elements}, x);
+  test.AddOutput<int64_t>("uniques", {num_uniques}, uniques);
+  test.AddOutput<int64_t>("idx", {num_elements}, idx);
+  test.AddOutput<int64_t>("counts", {num_uniques}, counts);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
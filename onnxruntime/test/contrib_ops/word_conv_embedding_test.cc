@@ -127,5 +127,48 @@ TEST(ContribOpTest, WordConvEmbedding_char_embedding_shape_conv_shape_not_match)
   test.Run(OpTester::ExpectResult::kExpectFailure);
 }
 
+TEST(ContribOpTest, WordConvEmbedding_repeated_and_empty_words) {
+  // with constant weights the convolutions of the char embeddings are precomputed
+  for (bool constant_weights : {false, true}) {
+    OpTester test("WordConvEmbedding", 1, onnxruntime::kMSDomain);
+
+    // repeated words are embedded once and empty words embed to zeros
+    std::vector<int64_t> seq_words_shape = {4, 5};
+    std::vector<int> seq_words{1, 2, 3, 4, 0,
+                               0, 0, 0, 0, 0,
+                               1, 2, 3, 4, 0,
+                               4, 3, 2, 1, 0};
+
+    std::vector<int64_t> W_char_embedding_shape = {5, 3};
+    std::vector<float> W_char_embedding{0.1f, 0.2f, 0.3f,
+                                        0.2f, 0.3f, 0.1f,
+                                        0.3f, 0.1f, 0.2f,
+                                        0.4f, 0.5f, 0.6f,
+                                        0.7f, 0.8f, 0.9f};
+
+    std::vector<int64_t> W_conv_shape = {2, 1, 2, 3};
+    std::vector<float> W_conv{0.1f, 0.2f, 0.3f,
+                              0.2f, 0.3f, 0.1f,
+                              0.3f, 0.1f, 0.2f,
+                              1.0f, 1.1f, 1.2f};
+
+    std::vector<int64_t> B_conv_shape = {2};
+    std::vector<float> B_conv{0.1f, 0.2f};
+
+    std::vector<int64_t> output_shape = {4, 2};
+    std::vector<float> output{0.711393774f, 0.996334076f,
+                              0.0f, 0.0f,
+                              0.711393774f, 0.996334076f,
+                              0.711393774f, 0.981612563f};
+
+    test.AddInput<int>("Sequence", seq_words_shape, seq_words);
+    test.AddInput<float>("W", W_conv_shape, W_conv, constant_weights);
+    test.AddInput<float>("B", B_conv_shape, B_conv);
+    test.AddInput<float>("C", W_char_embedding_shape, W_char_embedding, constant_weights);
+    test.AddOutput<float>("Y", output_shape, output);
+    test.Run();
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
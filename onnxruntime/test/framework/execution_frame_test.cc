@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/framework/bfc_arena.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
@@ -156,6 +157,186 @@ TEST(ExecutionFrameTest, FeedInDataTest) {
   EXPECT_EQ(p_tensor_arg_0->MutableData<float>(), value.GetMutable<Tensor>()->MutableData<float>());
 }
 
+TEST(ExecutionFrameTest, ResetTest) {
+  onnxruntime::Model model("test");
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Clip", "Clip operator", ArgMap{&input_def}, ArgMap{&output_def});
+  graph.Resolve();
+  auto cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  auto element_type = DataTypeImpl::GetType<float>();
+
+  auto create_value = [&](const TensorShape& shape) {
+    OrtValue value;
+    value.Init(std::make_unique<Tensor>(element_type, shape, cpu_allocator).release(),
+               DataTypeImpl::GetType<Tensor>(),
+               DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    return value;
+  };
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+
+  KernelRegistryManager kernel_registry_manager;
+  ExecutionProviders execution_providers;
+  execution_providers.Add(xp_typ, std::move(cpu_xp));
+  EXPECT_TRUE(kernel_registry_manager.RegisterKernels(execution_providers).IsOK());
+
+  SessionState state{execution_providers, true};
+  state.SetGraphViewer(std::make_unique<GraphViewer>(graph));
+
+  OrtValueNameIdxMap& mlvalue_name_idx_map{state.GetOrtValueNameIdxMap()};
+  auto x_idx = mlvalue_name_idx_map.Add("X");
+  auto y_idx = mlvalue_name_idx_map.Add("Y");
+
+  state.CalculateNodeIndexInfo();
+
+  OrtValue value = create_value(TensorShape({3, 2}));
+  OrtValue output = create_value(TensorShape({3, 2}));
+  vector<OrtValue> outputs{output};
+  ExecutionFrame frame({x_idx}, {value}, {y_idx}, outputs, {}, state);
+
+  EXPECT_EQ(frame.GetMutableNodeInputOrOutputMLValue(1)->GetMutable<Tensor>()->MutableData<float>(),
+            output.GetMutable<Tensor>()->MutableData<float>());
+
+  // reset with a new feed and no pre-allocated fetch. the previous values must not be visible.
+  OrtValue new_value = create_value(TensorShape({2, 2}));
+  frame.Reset({new_value}, {}, {});
+
+  Tensor* p_tensor_arg_0 = frame.GetMutableNodeInputOrOutputMLValue(0)->GetMutable<Tensor>();
+  EXPECT_EQ(p_tensor_arg_0->Shape(), TensorShape({2, 2}));
+  EXPECT_EQ(p_tensor_arg_0->MutableData<float>(), new_value.GetMutable<Tensor>()->MutableData<float>());
+  EXPECT_FALSE(frame.GetMutableNodeInputOrOutputMLValue(1)->IsAllocated());
+}
+
+TEST(ExecutionFrameTest, ResetMemPatternTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def1("X1", &tensor_float),
+      input_def2("X2", &tensor_float),
+      input_def3("X3", &tensor_float),
+      gemm1_out_def("T1", &tensor_float),
+      gemm2_out_def("T2", &tensor_float),
+      clip_out_def("T3", &tensor_float);
+
+  graph.AddNode("node1", "MatMul", "gemm1", ArgMap{&input_def1, &input_def2}, ArgMap{&gemm1_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node2", "MatMul", "gemm2", ArgMap{&gemm1_out_def, &input_def3}, ArgMap{&gemm2_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node3", "Clip", "clip1", ArgMap{&gemm2_out_def}, ArgMap{&clip_out_def})
+      .SetExecutionProviderType(xp_type);
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  execution_providers.Add(xp_type, std::move(cpu_xp));
+  kernel_registry_manager.RegisterKernels(execution_providers);
+  SessionState state{execution_providers, true};
+  state.SetGraphViewer(std::make_unique<GraphViewer>(graph));
+
+  OrtValueNameIdxMap& mlvalue_name_idx_map{state.GetOrtValueNameIdxMap()};
+
+  auto x1_idx = mlvalue_name_idx_map.Add("X1");
+  auto x2_idx = mlvalue_name_idx_map.Add("X2");
+  auto x3_idx = mlvalue_name_idx_map.Add("X3");
+  mlvalue_name_idx_map.Add("T1");
+  mlvalue_name_idx_map.Add("T2");
+  auto t3_idx = mlvalue_name_idx_map.Add("T3");
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->GetAllocator(0, OrtMemTypeDefault);
+
+  auto create_feeds = [&](int64_t rows) {
+    std::vector<OrtValue> feeds(3);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{rows, 2},
+                         std::vector<float>(static_cast<size_t>(rows * 2), 1.0f), &feeds[0]);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 2}, std::vector<float>(4, 1.0f), &feeds[1]);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 3}, std::vector<float>(6, 1.0f), &feeds[2]);
+    return feeds;
+  };
+
+  std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan = std::make_unique<SequentialExecutionPlan>();
+  SequentialPlannerContext context(false);
+  status = SequentialPlanner::CreatePlan(nullptr, GraphViewer(graph), {}, execution_providers, kernel_registry_manager,
+                                         mlvalue_name_idx_map, context, p_seq_exec_plan);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  state.SetExecutionPlan(std::move(p_seq_exec_plan));
+
+  state.CalculateNodeIndexInfo();
+
+  auto allocate_t1 = [&](ExecutionFrame& frame) {
+    OrtValue& mlvalue3 = *frame.GetMutableNodeInputOrOutputMLValue(3);
+    auto alloc_status = frame.AllocateMLValueTensorSelfOwnBuffer(mlvalue3, 3, DataTypeImpl::GetType<float>(),
+                                                                 cpu_allocator->Info(),
+                                                                 TensorShape(std::vector<int64_t>{2, 2}));
+    EXPECT_TRUE(alloc_status.IsOK()) << alloc_status.ErrorMessage();
+    return mlvalue3.GetMutable<Tensor>()->MutableData<float>();
+  };
+
+  // 1. no pattern is cached for the feed shapes yet, so the first execution traces its allocations
+  std::vector<OrtValue> feeds = create_feeds(1);
+  vector<OrtValue> outputs;
+  ExecutionFrame frame({x1_idx, x2_idx, x3_idx}, feeds, {t3_idx}, outputs, {}, state);
+  ASSERT_TRUE(frame.HasMemoryPatternPlanner());
+
+  allocate_t1(frame);
+  OrtValue& mlvalue4 = *frame.GetMutableNodeInputOrOutputMLValue(4);
+  status = frame.AllocateMLValueTensorSelfOwnBuffer(mlvalue4, 4, DataTypeImpl::GetType<float>(), cpu_allocator->Info(),
+                                                    TensorShape(std::vector<int64_t>{2, 3}));
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  auto pattern = std::make_unique<MemoryPatternGroup>();
+  status = frame.GeneratePatterns(pattern.get());
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  std::vector<TensorShape> input_shapes;
+  for (const auto& feed : feeds) {
+    input_shapes.push_back(feed.Get<Tensor>().Shape());
+  }
+  status = state.UpdateMemoryPatternGroupCache(input_shapes, std::move(pattern));
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  // 2. the previous execution traced allocations, so Reset looks up the pattern that is now cached and allocates
+  // its buffer. T1 is placed in that buffer.
+  frame.Reset(create_feeds(1), {}, {});
+  EXPECT_FALSE(frame.HasMemoryPatternPlanner());
+  float* t1_data = allocate_t1(frame);
+
+  // 3. same feed shapes again. the pattern is not looked up again and the buffer is neither released nor
+  // re-allocated, so T1 lands at the same address without any call to the allocator.
+  std::vector<OrtValue> same_shape_feeds = create_feeds(1);
+  auto* arena = dynamic_cast<BFCArena*>(cpu_allocator.get());
+  AllocatorStats stats_before;
+  if (arena) {
+    arena->GetStats(&stats_before);
+  }
+
+  frame.Reset(same_shape_feeds, {}, {});
+  EXPECT_FALSE(frame.HasMemoryPatternPlanner());
+  EXPECT_EQ(allocate_t1(frame), t1_data);
+
+  if (arena) {
+    AllocatorStats stats_after;
+    arena->GetStats(&stats_after);
+    EXPECT_EQ(stats_after.num_allocs, stats_before.num_allocs);
+  }
+
+  // 4. a new feed shape has no cached pattern, so the buffers are dropped and the allocations are traced again
+  frame.Reset(create_feeds(3), {}, {});
+  EXPECT_TRUE(frame.HasMemoryPatternPlanner());
+}
+
 TEST(ExecutionFrameTest, MemPatternTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
   auto xp_type = cpu_xp->Type();
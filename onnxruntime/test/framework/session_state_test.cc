@@ -93,7 +93,7 @@ TEST(SessionStateTest, TestInitializerProcessing) {
     ASSERT_TRUE(status.IsOK()) << status;
 
     SessionState session_state(execution_providers, enable_mem_pattern);
-    SessionStateInitializer session_initializer(enable_mem_pattern, ToWideString(model_path), graph,
+    SessionStateInitializer session_initializer(ToWideString(model_path), graph,
                                                 session_state, execution_providers, krm);
 
     GraphPartitioner partitioner(krm, execution_providers);
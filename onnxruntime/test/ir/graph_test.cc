@@ -647,6 +647,31 @@ TEST(ResolvingGraphTest, GraphConstruction_OnlyInitializer) {
   EXPECT_TRUE(iii.size() == 0);
 }
 
+TEST(ResolvingGraphTest, ReleaseInitializedTensorData) {
+  onnxruntime::Model model("graph");
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TensorProto weight;
+  weight.add_dims(2);
+  weight.add_dims(3);
+  weight.set_data_type(TensorProto_DataType_FLOAT);
+  weight.set_raw_data(std::string(6 * sizeof(float), '\0'));
+  weight.set_name("W");
+  graph.AddInitializedTensor(weight);
+
+  graph.ReleaseInitializedTensorData("W");
+  graph.ReleaseInitializedTensorData("not_an_initializer");
+
+  const ONNX_NAMESPACE::TensorProto* released = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("W", released));
+  EXPECT_EQ("W", released->name());
+  EXPECT_EQ(TensorProto_DataType_FLOAT, released->data_type());
+  ASSERT_EQ(2, released->dims_size());
+  EXPECT_EQ(2, released->dims(0));
+  EXPECT_EQ(3, released->dims(1));
+  EXPECT_FALSE(released->has_raw_data());
+}
+
 TEST(ResolvingGraphTest, GraphConstruction_TypeInference) {
   ASSERT_TRUE(kSchemasRegistered);
 
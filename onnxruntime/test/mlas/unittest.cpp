@@ -17,8 +17,10 @@ Abstract:
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <vector>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -442,6 +444,251 @@ public:
     }
 };
 
+template<typename BType>
+class MlasHalfSgemmTest : public MlasTestBase
+{
+private:
+    static
+    void
+    ConvertFromFloat(
+        float Value,
+        MLAS_FP16* Half
+        )
+    {
+        //
+        // The test values are small integers that are exactly representable
+        // as half precision values, so the conversion does not round.
+        //
+
+        uint32_t Bits;
+        memcpy(&Bits, &Value, sizeof(float));
+
+        uint32_t Sign = (Bits >> 16) & 0x8000;
+        uint32_t ExponentMantissa = Bits & 0x7FFFFFFF;
+
+        Half->Value = uint16_t((ExponentMantissa == 0) ? Sign : (Sign | ((ExponentMantissa - 0x38000000) >> 13)));
+    }
+
+    static
+    void
+    ConvertFromFloat(
+        float Value,
+        MLAS_BFLOAT16* BFloat16
+        )
+    {
+        uint32_t Bits;
+        memcpy(&Bits, &Value, sizeof(float));
+
+        BFloat16->Value = uint16_t(Bits >> 16);
+    }
+
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K
+        )
+    {
+        const float* A = BufferA.GetBuffer(K * M);
+        const float* B = BufferB.GetBuffer(N * K);
+        float* C = BufferC.GetBuffer(N * M);
+        float* CReference = BufferCReference.GetBuffer(N * M);
+
+        std::vector<BType> BHalf(N * K);
+
+        for (size_t f = 0; f < N * K; f++) {
+            ConvertFromFloat(B[f], &BHalf[f]);
+        }
+
+        Test(CblasNoTrans, M, N, K, A, B, BHalf.data(), N, C, CReference);
+        Test(CblasTrans, M, N, K, A, B, BHalf.data(), K, C, CReference);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        const float* A,
+        const float* B,
+        const BType* BHalf,
+        size_t ldb,
+        float* C,
+        float* CReference
+        )
+    {
+        std::fill_n(C, M * N, -0.5f);
+        std::fill_n(CReference, M * N, -0.5f);
+
+        //
+        // The converted matrix B is packed to the same values as the single
+        // precision matrix B, so the results must be identical.
+        //
+
+        MlasSgemm(CblasNoTrans, TransB, M, N, K, 1.0f, A, K, BHalf, ldb, 0.0f, C, N, nullptr);
+        MlasSgemm(CblasNoTrans, TransB, M, N, K, 1.0f, A, K, B, ldb, 0.0f, CReference, N, nullptr);
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch TransB=%d, M=%zd, N=%zd, K=%zd!\n", TransB, M, N, K);
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer BufferA;
+    MatrixGuardBuffer BufferB;
+    MatrixGuardBuffer BufferC;
+    MatrixGuardBuffer BufferCReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b);
+        }
+        for (size_t b = 16; b <= 256; b <<= 1) {
+            Test(b, b, b);
+        }
+        Test(2, 300, 260);
+        Test(33, 17, 400);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        for (size_t M = 1; M < 64; M += 7) {
+            for (size_t N = 1; N < 320; N += 13) {
+                for (size_t K = 1; K < 320; K += 11) {
+                    Test(M, N, K);
+                }
+            }
+        }
+    }
+};
+
+template<typename BType>
+class MlasQgemmTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        uint8_t offa,
+        BType offb
+        )
+    {
+        std::vector<uint8_t> A(M * K);
+        std::vector<BType> B(K * N);
+        std::vector<int32_t> C(M * N);
+        std::vector<int32_t> CReference(M * N);
+
+        for (size_t f = 0; f < A.size(); f++) {
+            A[f] = uint8_t((f * 7 + 3) % 256);
+        }
+
+        for (size_t f = 0; f < B.size(); f++) {
+            B[f] = BType((f * 13 + 5) % 256);
+        }
+
+        ReferenceQgemm(M, N, K, A.data(), K, offa, B.data(), N, offb, CReference.data(), N);
+
+        std::fill(C.begin(), C.end(), -1);
+
+        MlasQgemm(M, N, K, A.data(), K, offa, B.data(), N, offb, C.data(), N, nullptr);
+
+        if (C != CReference) {
+            printf("mismatch M=%zd, N=%zd, K=%zd, offa=%d, offb=%d!\n", M, N, K, int(offa), int(offb));
+        }
+
+        std::vector<uint8_t> PackedB(MlasQgemmPackBSize(N, K));
+
+        MlasQgemmPackB(N, K, B.data(), N, offb, PackedB.data());
+
+        std::fill(C.begin(), C.end(), -1);
+
+        MlasQgemmPacked(M, N, K, A.data(), K, offa, PackedB.data(), C.data(), N, nullptr);
+
+        if (C != CReference) {
+            printf("mismatch packed M=%zd, N=%zd, K=%zd, offa=%d, offb=%d!\n", M, N, K, int(offa), int(offb));
+        }
+    }
+
+    void
+    ReferenceQgemm(
+        size_t M,
+        size_t N,
+        size_t K,
+        const uint8_t* A,
+        size_t lda,
+        uint8_t offa,
+        const BType* B,
+        size_t ldb,
+        BType offb,
+        int32_t* C,
+        size_t ldc
+        )
+    {
+        for (size_t m = 0; m < M; m++) {
+
+            for (size_t n = 0; n < N; n++) {
+
+                int32_t sum = 0;
+
+                for (size_t k = 0; k < K; k++) {
+                    sum += (int32_t(A[m * lda + k]) - offa) * (int32_t(B[k * ldb + n]) - offb);
+                }
+
+                C[m * ldc + n] = sum;
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b, 7, BType(3));
+            Test(b, 16 + b, b + 7, 0, BType(0));
+            Test(1, b, 32 + b, 200, BType(1));
+        }
+
+        for (size_t b = 1; b < 96; b += 5) {
+            Test(b, 33 + b, 300 + b, 128, BType(100));
+        }
+
+        Test(1, 1, 0, 1, BType(1));
+        Test(67, 291, 523, 255, BType(255));
+        Test(160, 160, 160, 34, BType(1));
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        for (size_t M = 1; M < 160; M++) {
+            for (size_t N = 1; N < 160; N++) {
+                for (size_t K = 1; K < 160; K++) {
+                    Test(M, N, K, uint8_t(M + N), BType(K));
+                }
+            }
+            printf("M %zd\n", M);
+        }
+    }
+};
+
 class MlasConv2DTest : public MlasTestBase
 {
 protected:
@@ -1678,6 +1925,331 @@ public:
     }
 };
 
+class MlasTranscendentalTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        MLAS_TRANSCENDENTAL_KIND Kind,
+        size_t N,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N);
+        float* Output = BufferOutput.GetBuffer(N);
+        float* OutputReference = BufferOutputReference.GetBuffer(N);
+
+        for (size_t n = 0; n < N; n++) {
+            Input[n] = MinimumValue + (MaximumValue - MinimumValue) * float(n) / float(N);
+        }
+
+        MlasComputeTranscendental(Kind, Input, Output, N, nullptr);
+
+        for (size_t n = 0; n < N; n++) {
+            OutputReference[n] = ReferenceFunction(Kind, Input[n]);
+        }
+
+        constexpr float AbsoluteTolerance = 1e-6f;
+        constexpr float RelativeTolerance = 1e-5f;
+
+        for (size_t n = 0; n < N; n++) {
+            float diff = std::fabs(Output[n] - OutputReference[n]);
+            if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference[n]) * RelativeTolerance) {
+                printf("mismatch Kind=%d, N=%zd, n=%zd, input=%.8e, output=%.8e, expected=%.8e!\n",
+                    int(Kind), N, n, Input[n], Output[n], OutputReference[n]);
+                break;
+            }
+        }
+    }
+
+    void
+    TestSpecialValues(
+        void
+        )
+    {
+        const float Infinity = std::numeric_limits<float>::infinity();
+        const float NaN = std::numeric_limits<float>::quiet_NaN();
+
+        float* Input = BufferInput.GetBuffer(16);
+        float* Output = BufferOutput.GetBuffer(16);
+
+        //
+        // Check the vector and the scalar paths of the logarithm kernels.
+        //
+
+        static const float LogInputs[] = { 0.0f, -0.0f, -1.0f, Infinity, NaN, 1.0f, 1e-40f, 0.5f };
+
+        for (size_t n = 0; n < 16; n++) {
+            Input[n] = LogInputs[n % _countof(LogInputs)];
+        }
+
+        MlasComputeLog(Input, Output, 16);
+
+        for (size_t n = 0; n < 16; n++) {
+            float Expected = std::log(Input[n]);
+            bool Match = std::isnan(Expected) ? std::isnan(Output[n]) :
+                (Output[n] == Expected || std::fabs(Output[n] - Expected) <= 1e-4f * std::fabs(Expected) + 1e-6f);
+            if (!Match && Input[n] != 1e-40f) {
+                printf("mismatch Log input=%.8e, output=%.8e, expected=%.8e!\n", Input[n], Output[n], Expected);
+            }
+        }
+
+        static const float ExpInputs[] = { -Infinity, -100.0f, 0.0f, 88.0f, 100.0f, Infinity, -87.0f, 1.0f };
+
+        for (size_t n = 0; n < 16; n++) {
+            Input[n] = ExpInputs[n % _countof(ExpInputs)];
+        }
+
+        MlasComputeExp(Input, Output, 16);
+
+        for (size_t n = 0; n < 16; n++) {
+            if (Input[n] >= 88.5f) {
+                if (!(Output[n] > 1e38f)) {
+                    printf("mismatch Exp input=%.8e, output=%.8e!\n", Input[n], Output[n]);
+                }
+            } else if (Input[n] <= -88.5f) {
+                if (!(Output[n] >= 0.0f && Output[n] < 1e-37f)) {
+                    printf("mismatch Exp input=%.8e, output=%.8e!\n", Input[n], Output[n]);
+                }
+            } else if (std::fabs(Output[n] - std::exp(Input[n])) > 1e-5f * std::exp(Input[n])) {
+                printf("mismatch Exp input=%.8e, output=%.8e!\n", Input[n], Output[n]);
+            }
+        }
+    }
+
+    static
+    float
+    ReferenceFunction(
+        MLAS_TRANSCENDENTAL_KIND Kind,
+        float Value
+        )
+    {
+        switch (Kind) {
+            case MlasExpFunction:
+                return std::exp(Value);
+            case MlasLogFunction:
+                return std::log(Value);
+            case MlasLogisticFunction:
+                return 1.0f / (1.0f + std::exp(-Value));
+            case MlasTanhFunction:
+                return std::tanh(Value);
+            case MlasSqrtFunction:
+                return std::sqrt(Value);
+            case MlasErfFunction:
+            default:
+                return std::erf(Value);
+        }
+    }
+
+    MatrixGuardBuffer BufferInput;
+    MatrixGuardBuffer BufferOutput;
+    MatrixGuardBuffer BufferOutputReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t N = 1; N < 64; N++) {
+            Test(MlasExpFunction, N, -80.0f, 80.0f);
+            Test(MlasLogFunction, N, 1e-30f, 1e30f);
+            Test(MlasLogFunction, N, 0.25f, 4.0f);
+            Test(MlasLogisticFunction, N, -10.0f, 10.0f);
+            Test(MlasTanhFunction, N, -5.0f, 5.0f);
+            Test(MlasErfFunction, N, -5.0f, 5.0f);
+            Test(MlasSqrtFunction, N, 0.0f, 1e30f);
+        }
+
+        Test(MlasExpFunction, 100000, -20.0f, 20.0f);
+        Test(MlasSqrtFunction, 100000, 0.0f, 1e3f);
+        Test(MlasLogFunction, 100000, 1e-3f, 1e3f);
+
+        TestSpecialValues();
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        for (size_t N = 1; N < 4096; N++) {
+            Test(MlasExpFunction, N, -88.0f, 88.0f);
+            Test(MlasLogFunction, N, 1e-37f, 1e37f);
+        }
+    }
+};
+
+class MlasLstmCellTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t N,
+        bool UseBias
+        )
+    {
+        float* Gates = BufferGates.GetBuffer(4 * N);
+        float* Bias = BufferBias.GetBuffer(4 * N);
+        float* CellState = BufferCellState.GetBuffer(N);
+        float* CellStateReference = BufferCellStateReference.GetBuffer(N);
+        float* Output = BufferOutput.GetBuffer(N);
+
+        for (size_t n = 0; n < 4 * N; n++) {
+            Gates[n] = float(int(n % 23) - 11) * 0.375f;
+            Bias[n] = float(int(n % 7) - 3) * 0.125f;
+        }
+
+        for (size_t n = 0; n < N; n++) {
+            CellState[n] = float(int(n % 13) - 6) * 0.25f;
+            CellStateReference[n] = CellState[n];
+        }
+
+        MlasComputeLstmCell(Gates, UseBias ? Bias : nullptr, CellState, Output, N);
+
+        constexpr float AbsoluteTolerance = 1e-5f;
+
+        for (size_t n = 0; n < N; n++) {
+
+            float Value[4];
+
+            for (size_t gate = 0; gate < 4; gate++) {
+                Value[gate] = Gates[gate * N + n] + (UseBias ? Bias[gate * N + n] : 0.0f);
+            }
+
+            float i = 1.0f / (1.0f + std::exp(-Value[0]));
+            float o = 1.0f / (1.0f + std::exp(-Value[1]));
+            float f = 1.0f / (1.0f + std::exp(-Value[2]));
+            float c = std::tanh(Value[3]);
+
+            float Cell = f * CellStateReference[n] + i * c;
+            float Hidden = o * std::tanh(Cell);
+
+            if (std::fabs(CellState[n] - Cell) > AbsoluteTolerance ||
+                std::fabs(Output[n] - Hidden) > AbsoluteTolerance) {
+                printf("mismatch LstmCell N=%zd, n=%zd, bias=%d!\n", N, n, int(UseBias));
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer BufferGates;
+    MatrixGuardBuffer BufferBias;
+    MatrixGuardBuffer BufferCellState;
+    MatrixGuardBuffer BufferCellStateReference;
+    MatrixGuardBuffer BufferOutput;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t N = 1; N < 64; N++) {
+            Test(N, false);
+            Test(N, true);
+        }
+
+        Test(255, true);
+        Test(256, true);
+        Test(257, true);
+        Test(1000, true);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        for (size_t N = 1; N < 2048; N++) {
+            Test(N, true);
+        }
+    }
+};
+
+class MlasNormalizeTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t N,
+        float Offset
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N);
+        float* Output = BufferOutput.GetBuffer(N);
+
+        for (size_t n = 0; n < N; n++) {
+            Input[n] = Offset + float(int(n % 31) - 15) * 0.25f;
+        }
+
+        double ExpectedMean = 0.0;
+        for (size_t n = 0; n < N; n++) {
+            ExpectedMean += Input[n];
+        }
+        ExpectedMean /= double(N);
+
+        double ExpectedVariance = 0.0;
+        for (size_t n = 0; n < N; n++) {
+            ExpectedVariance += (Input[n] - ExpectedMean) * (Input[n] - ExpectedMean);
+        }
+        ExpectedVariance /= double(N);
+
+        float Mean;
+        float Variance;
+
+        MlasComputeMeanVariance(Input, N, &Mean, &Variance);
+
+        if (std::fabs(Mean - ExpectedMean) > 1e-5 * (1.0 + std::fabs(ExpectedMean)) ||
+            std::fabs(Variance - ExpectedVariance) > 1e-4 * (1.0 + ExpectedVariance)) {
+            printf("mismatch MeanVariance N=%zd, offset=%f, mean=%f/%f, variance=%f/%f!\n",
+                N, Offset, Mean, float(ExpectedMean), Variance, float(ExpectedVariance));
+        }
+
+        const float Scale = 0.75f;
+        const float Shift = -1.5f;
+
+        MlasComputeScaleShift(Input, Output, N, Scale, Shift);
+
+        for (size_t n = 0; n < N; n++) {
+            if (std::fabs(Output[n] - (Input[n] * Scale + Shift)) > 1e-5f * (1.0f + std::fabs(Output[n]))) {
+                printf("mismatch ScaleShift N=%zd, n=%zd!\n", N, n);
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer BufferInput;
+    MatrixGuardBuffer BufferOutput;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t N = 1; N < 64; N++) {
+            Test(N, 0.0f);
+        }
+
+        Test(1023, 1000.0f);
+        Test(1024, 1000.0f);
+        Test(1025, 1000.0f);
+        Test(100000, 10000.0f);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        for (size_t N = 1; N < 4096; N++) {
+            Test(N, 100.0f);
+        }
+    }
+};
+
 int
 #if defined(_WIN32)
 __cdecl
@@ -1688,6 +2260,12 @@ main(
 {
     printf("SGEMM tests.\n");
     std::make_unique<MlasSgemmTest>()->ExecuteShort();
+    std::make_unique<MlasHalfSgemmTest<MLAS_FP16>>()->ExecuteShort();
+    std::make_unique<MlasHalfSgemmTest<MLAS_BFLOAT16>>()->ExecuteShort();
+
+    printf("QGEMM tests.\n");
+    std::make_unique<MlasQgemmTest<uint8_t>>()->ExecuteShort();
+    std::make_unique<MlasQgemmTest<int8_t>>()->ExecuteShort();
 
     printf("Conv2D tests.\n");
     std::make_unique<MlasConv2DTest>()->ExecuteShort();
@@ -1700,6 +2278,15 @@ main(
     printf("Pool3D tests.\n");
     std::make_unique<MlasPool3DTest>()->ExecuteShort();
 
+    printf("Transcendental tests.\n");
+    std::make_unique<MlasTranscendentalTest>()->ExecuteShort();
+
+    printf("LSTM cell tests.\n");
+    std::make_unique<MlasLstmCellTest>()->ExecuteShort();
+
+    printf("Normalize tests.\n");
+    std::make_unique<MlasNormalizeTest>()->ExecuteShort();
+
     printf("Done.\n");
 
     return 0;
@@ -29,6 +29,8 @@
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/shape_to_initializer.h"
+#include "core/optimizer/qdq_fusion.h"
+#include "core/optimizer/matmul_half_weights_fusion.h"
 
 using namespace std;
 using namespace ONNX_NAMESPACE;
@@ -527,5 +529,196 @@ TEST(GraphTransformationTests, ReluClipFusion) {
   }
 }
 
+TEST(GraphTransformationTests, QDQFusion) {
+  Model model("QDQFusion");
+  auto& graph = model.MainGraph();
+
+  TypeProto uint8_tensor_type;
+  uint8_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto add_scalar_initializer = [&graph](const std::string& name, TensorProto_DataType data_type, float value) {
+    TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(data_type);
+    if (data_type == TensorProto_DataType_FLOAT) {
+      tensor_proto.add_float_data(value);
+    } else {
+      tensor_proto.add_int32_data(static_cast<int32_t>(value));
+    }
+    graph.AddInitializedTensor(tensor_proto);
+  };
+
+  auto add_uint8_initializer = [&graph](const std::string& name, const std::vector<int64_t>& dims) {
+    TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(TensorProto_DataType_UINT8);
+    int64_t size = 1;
+    for (auto dim : dims) {
+      tensor_proto.add_dims(dim);
+      size *= dim;
+    }
+    for (int64_t i = 0; i < size; i++) {
+      tensor_proto.add_int32_data(static_cast<int32_t>(i % 256));
+    }
+    graph.AddInitializedTensor(tensor_proto);
+  };
+
+  add_scalar_initializer("scale", TensorProto_DataType_FLOAT, 0.05f);
+  add_scalar_initializer("zero_point_0", TensorProto_DataType_UINT8, 0.f);
+  add_scalar_initializer("zero_point_128", TensorProto_DataType_UINT8, 128.f);
+  add_uint8_initializer("conv_w", {2, 1, 2, 2});
+  add_uint8_initializer("matmul_b", {4, 4});
+
+  auto& scale = graph.GetOrCreateNodeArg("scale", &float_tensor_type);
+  auto& zero_point_0 = graph.GetOrCreateNodeArg("zero_point_0", &uint8_tensor_type);
+  auto& zero_point_128 = graph.GetOrCreateNodeArg("zero_point_128", &uint8_tensor_type);
+  auto& conv_w = graph.GetOrCreateNodeArg("conv_w", &uint8_tensor_type);
+  auto& matmul_b = graph.GetOrCreateNodeArg("matmul_b", &uint8_tensor_type);
+
+  auto add_dequantize = [&](const std::string& name, NodeArg& input) -> NodeArg& {
+    auto& output = graph.GetOrCreateNodeArg(name + "_output", &float_tensor_type);
+    graph.AddNode(name, "DequantizeLinear", "", {&input, &scale, &zero_point_128}, {&output});
+    return output;
+  };
+
+  auto add_quantize = [&](const std::string& name, NodeArg& input, NodeArg& zero_point) {
+    auto& output = graph.GetOrCreateNodeArg(name + "_output", &uint8_tensor_type);
+    graph.AddNode(name, "QuantizeLinear", "", {&input, &scale, &zero_point}, {&output});
+  };
+
+  // 3 paths in the model:
+  // DQ -> Conv -> Relu -> Q with an output zero point of 0 (fused to QLinearConv)
+  // DQ -> MatMul -> Q (fused to QLinearMatMul)
+  // DQ -> MatMul -> Relu -> Q with an output zero point of 128 (not fused)
+  uint8_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  uint8_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  uint8_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  uint8_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto& conv_x = graph.GetOrCreateNodeArg("conv_x", &uint8_tensor_type);
+  auto& matmul_a0 = graph.GetOrCreateNodeArg("matmul_a0", &uint8_tensor_type);
+  auto& matmul_a1 = graph.GetOrCreateNodeArg("matmul_a1", &uint8_tensor_type);
+
+  auto& conv_output = graph.GetOrCreateNodeArg("conv_output", &float_tensor_type);
+  auto& conv_relu_output = graph.GetOrCreateNodeArg("conv_relu_output", &float_tensor_type);
+  graph.AddNode("conv", "Conv", "",
+                {&add_dequantize("conv_x_dq", conv_x), &add_dequantize("conv_w_dq", conv_w)},
+                {&conv_output});
+  graph.AddNode("conv_relu", "Relu", "", {&conv_output}, {&conv_relu_output});
+  add_quantize("conv_q", conv_relu_output, zero_point_0);
+
+  auto& matmul0_output = graph.GetOrCreateNodeArg("matmul0_output", &float_tensor_type);
+  graph.AddNode("matmul0", "MatMul", "",
+                {&add_dequantize("matmul_a0_dq", matmul_a0), &add_dequantize("matmul_b0_dq", matmul_b)},
+                {&matmul0_output});
+  add_quantize("matmul0_q", matmul0_output, zero_point_128);
+
+  auto& matmul1_output = graph.GetOrCreateNodeArg("matmul1_output", &float_tensor_type);
+  auto& matmul1_relu_output = graph.GetOrCreateNodeArg("matmul1_relu_output", &float_tensor_type);
+  graph.AddNode("matmul1", "MatMul", "",
+                {&add_dequantize("matmul_a1_dq", matmul_a1), &add_dequantize("matmul_b1_dq", matmul_b)},
+                {&matmul1_output});
+  graph.AddNode("matmul1_relu", "Relu", "", {&matmul1_output}, {&matmul1_relu_output});
+  add_quantize("matmul1_q", matmul1_relu_output, zero_point_128);
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["DequantizeLinear"] == 6);
+  ASSERT_TRUE(op_to_count["QuantizeLinear"] == 3);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<QDQFusion>(), TransformerLevel::Level2);
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["QLinearConv"] == 1);
+  ASSERT_TRUE(op_to_count["QLinearMatMul"] == 1);
+  ASSERT_TRUE(op_to_count["Conv"] == 0);
+  ASSERT_TRUE(op_to_count["MatMul"] == 1);
+  ASSERT_TRUE(op_to_count["Relu"] == 1);
+  ASSERT_TRUE(op_to_count["DequantizeLinear"] == 2);
+  ASSERT_TRUE(op_to_count["QuantizeLinear"] == 1);
+}
+
+#ifndef DISABLE_CONTRIB_OPS
+// Builds MatMul(matmul_a, Cast(float16 weights)) with both nodes assigned to the given execution provider.
+static void BuildMatMulWithHalfWeights(Graph& graph, const std::string& provider) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto half_tensor_type;
+  half_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+
+  TensorProto weights_proto;
+  weights_proto.set_name("weights");
+  weights_proto.set_data_type(TensorProto_DataType_FLOAT16);
+  weights_proto.add_dims(4);
+  weights_proto.add_dims(3);
+  for (int i = 0; i < 12; i++) {
+    weights_proto.add_int32_data(math::floatToHalf(static_cast<float>(i)));
+  }
+  graph.AddInitializedTensor(weights_proto);
+
+  auto& weights = graph.GetOrCreateNodeArg("weights", &half_tensor_type);
+  auto& cast_output = graph.GetOrCreateNodeArg("cast_output", &float_tensor_type);
+  auto& matmul_a = graph.GetOrCreateNodeArg("matmul_a", &float_tensor_type);
+  auto& matmul_output = graph.GetOrCreateNodeArg("matmul_output", &float_tensor_type);
+
+  auto& cast_node = graph.AddNode("cast", "Cast", "", {&weights}, {&cast_output});
+  cast_node.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+  cast_node.SetExecutionProviderType(provider);
+  auto& matmul_node = graph.AddNode("matmul", "MatMul", "", {&matmul_a, &cast_output}, {&matmul_output});
+  matmul_node.SetExecutionProviderType(provider);
+}
+
+TEST(GraphTransformationTests, MatMulHalfWeightsFusion) {
+  Model model("MatMulHalfWeightsFusion");
+  auto& graph = model.MainGraph();
+  BuildMatMulWithHalfWeights(graph, kCpuExecutionProvider);
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  // constant folding must leave the Cast for the fusion, which only runs for the CPU execution provider
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<ConstantFolding>(), TransformerLevel::Level1);
+  graph_transformation_mgr.Register(
+      std::make_unique<MatMulHalfWeightsFusion>(std::unordered_set<std::string>{kCpuExecutionProvider}),
+      TransformerLevel::Level2);
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1).IsOK());
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["MatMulWithHalfWeights"] == 1);
+  ASSERT_TRUE(op_to_count["Cast"] == 0);
+  ASSERT_TRUE(op_to_count["MatMul"] == 0);
+}
+
+TEST(GraphTransformationTests, MatMulHalfWeightsFusionOtherProvider) {
+  Model model("MatMulHalfWeightsFusionOtherProvider");
+  auto& graph = model.MainGraph();
+  BuildMatMulWithHalfWeights(graph, kCudaExecutionProvider);
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  // the fused op has no kernel outside the CPU execution provider, so the Cast is folded instead
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<ConstantFolding>(), TransformerLevel::Level1);
+  graph_transformation_mgr.Register(
+      std::make_unique<MatMulHalfWeightsFusion>(std::unordered_set<std::string>{kCpuExecutionProvider}),
+      TransformerLevel::Level2);
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1).IsOK());
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["MatMulWithHalfWeights"] == 0);
+  ASSERT_TRUE(op_to_count["Cast"] == 0);
+  ASSERT_TRUE(op_to_count["MatMul"] == 1);
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
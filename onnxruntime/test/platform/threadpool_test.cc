@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/threadpool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace test {
+
+// Runs ParallelForBlocks over [0, total) and checks that every item is visited exactly once, by non empty blocks
+// with valid block numbers.
+static void CheckBlocks(ThreadPool* tp, int64_t total, int64_t num_blocks) {
+  std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[total]);
+  for (int64_t i = 0; i < total; ++i) {
+    visits[i] = 0;
+  }
+  std::atomic<int64_t> blocks_run{0};
+  std::atomic<int> bad_blocks{0};
+
+  ThreadPool::ParallelForBlocks(tp, total, num_blocks, [&](int64_t block, int64_t first, int64_t last) {
+    if (block < 0 || block >= num_blocks || first > last || (total > 0 && first == last)) {
+      ++bad_blocks;
+    }
+    for (int64_t i = first; i < last; ++i) {
+      ++visits[i];
+    }
+    ++blocks_run;
+  });
+
+  EXPECT_EQ(bad_blocks, 0);
+  EXPECT_EQ(blocks_run, num_blocks);
+  for (int64_t i = 0; i < total; ++i) {
+    ASSERT_EQ(visits[i], 1) << "item " << i << " of " << total;
+  }
+}
+
+TEST(ThreadPoolTest, NumBlocks) {
+  ThreadPool tp("test", 3);
+
+  // no pool or a single item always runs as one block on the calling thread
+  EXPECT_EQ(ThreadPool::NumBlocks(nullptr, 1000, 1000 * ThreadPool::kMinElementsPerBlock,
+                                  ThreadPool::kMinElementsPerBlock),
+            1);
+  EXPECT_EQ(ThreadPool::NumBlocks(&tp, 1, ThreadPool::kMinElementsPerBlock * 100, ThreadPool::kMinElementsPerBlock),
+            1);
+
+  // too little work to pay for the dispatch
+  EXPECT_EQ(ThreadPool::NumBlocks(&tp, 1000, ThreadPool::kMinElementsPerBlock - 1, ThreadPool::kMinElementsPerBlock),
+            1);
+  EXPECT_EQ(ThreadPool::NumBlocks(&tp, 1000, 2 * ThreadPool::kMinElementsPerBlock, ThreadPool::kMinElementsPerBlock),
+            2);
+
+  // at most one block per pool thread plus the calling thread
+  EXPECT_EQ(ThreadPool::NumBlocks(&tp, 1000, 1000 * ThreadPool::kMinElementsPerBlock,
+                                  ThreadPool::kMinElementsPerBlock),
+            tp.NumThreads() + 1);
+
+  // and never more blocks than items, with no block left empty by rounding the block size up
+  EXPECT_EQ(ThreadPool::NumBlocks(&tp, 3, 3 * ThreadPool::kMinElementsPerBlock, ThreadPool::kMinElementsPerBlock), 3);
+  EXPECT_EQ(ThreadPool::NumBlocks(&tp, 6, 6 * ThreadPool::kMinElementsPerBlock, ThreadPool::kMinElementsPerBlock), 3);
+}
+
+TEST(ThreadPoolTest, ParallelForBlocksCoversRange) {
+  ThreadPool tp("test", 3);
+
+  for (int64_t total = 0; total < 100; ++total) {
+    for (int64_t work : {int64_t{0}, total * 1000, total * ThreadPool::kMinElementsPerBlock}) {
+      CheckBlocks(&tp, total, ThreadPool::NumBlocks(&tp, total, work, ThreadPool::kMinElementsPerBlock));
+    }
+    CheckBlocks(nullptr, total, 1);
+  }
+}
+
+TEST(ThreadPoolTest, TryParallelForBlocks) {
+  ThreadPool tp("test", 3);
+
+  const int64_t total = 12345;
+  std::vector<int> visits(total, 0);
+  ThreadPool::TryParallelForBlocks(&tp, total, total * ThreadPool::kMinElementsPerBlock,
+                                   ThreadPool::kMinElementsPerBlock, [&](int64_t first, int64_t last) {
+                                     for (int64_t i = first; i < last; ++i) {
+                                       ++visits[i];
+                                     }
+                                   });
+  for (int64_t i = 0; i < total; ++i) {
+    ASSERT_EQ(visits[i], 1) << "item " << i;
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <future>
+#include <numeric>
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -573,6 +575,86 @@ TEST(Loop, InfiniteLoopTermination) {
   terminator_thread.join();
 }
 
+// Run enough iterations for the loop carried variable to cycle through its buffers several times and for the
+// scan output to outgrow its initial buffer. If the subgraph passes cond_in straight through to cond_out the
+// number of iterations is known upfront and the outputs are written in place.
+static void RunManyIterations(bool cond_passthrough) {
+  auto create_subgraph = [cond_passthrough](const RunOptions&) {
+    Model model("Many iterations subgraph");
+    auto& graph = model.MainGraph();
+
+    /*
+            Inputs: iter_num, cond_in, loop carried state variables.
+
+         iter_num_in    cond_in         loop_var_0_in
+              |            |                 |
+         [Identity]   [Identity]           [Add] (loop_var_0_in + loop_var_0_in)
+              |            |                 |
+        loop_out_0     cond_out        loop_var_0_out
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_scalar;
+    float_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& loop_var_0_in = graph.GetOrCreateNodeArg("loop_var_0_in", &float_scalar);
+
+    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_scalar);
+    auto& loop_out_0 = graph.GetOrCreateNodeArg("loop_out_0", &int64_scalar);
+
+    graph.AddNode("loop_var_0_add", "Add", "Double loop_var_0", {&loop_var_0_in, &loop_var_0_in}, {&loop_var_0_out});
+    graph.AddNode("iter_num_identity", "Identity", "Forward iter_num to loop_out_0", {&iter_num_in}, {&loop_out_0});
+
+    auto* cond_out = &cond_in;
+    if (!cond_passthrough) {
+      cond_out = &graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+      graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {cond_out});
+    }
+
+    graph.SetInputs({&iter_num_in, &cond_in, &loop_var_0_in});
+    graph.SetOutputs({cond_out, &loop_var_0_out, &loop_out_0});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  const int64_t num_iterations = 40;
+
+  std::vector<int64_t> loop_out_0_final(num_iterations);
+  std::iota(loop_out_0_final.begin(), loop_out_0_final.end(), 0);
+
+  LoopOpTester test{{}, create_subgraph};
+
+  test.AddInput<int64_t>("M", {1}, {num_iterations});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("loop_var_0_orig", {1}, {1.f});
+
+  test.AddOutput<float>("loop_var_0_final", {1}, {std::ldexp(1.f, static_cast<int>(num_iterations))});
+  test.AddOutput<int64_t>("loop_out_0_final", {num_iterations, 1}, loop_out_0_final);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(Loop, ManyIterations) {
+  RunManyIterations(false);
+}
+
+TEST(Loop, ManyIterationsKnownTripCount) {
+  RunManyIterations(true);
+}
+
 #ifdef USE_CUDA
 // test that when part of the subgraph run on CUDA it executes successfully
 TEST(Loop, MixedExecutionProviders) {
@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 
 namespace onnxruntime {
 namespace test {
@@ -212,5 +213,36 @@ TEST(GemmOpTest, GemmEmptyTensor) {
   test.Run();
 }
 
+TEST(GemmOpTest, GemmDynamicQuantization) {
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", static_cast<int64_t>(0));
+  test.AddAttribute("transB", static_cast<int64_t>(1));
+  test.AddAttribute("alpha", 0.5f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<float>("A", {2, 4},
+                       {1.0f, 2.0f, 3.0f, 4.0f,
+                        -1.0f, -2.0f, -3.0f, -4.0f});
+  test.AddInput<float>("B", {3, 4},
+                       {0.5f, 1.0f, 1.5f, 2.0f,
+                        -1.0f, 0.0f, 1.0f, 2.0f,
+                        0.25f, -0.5f, 0.75f, -1.0f},
+                       true);
+  test.AddInput<float>("C", {3}, {1.0f, 2.0f, 3.0f});
+  test.AddOutput<float>("Y", {2, 3},
+                        {8.5f, 7.0f, 1.75f,
+                         -6.5f, -3.0f, 4.25f});
+
+  // the result is only approximate once A and B are quantized to 8 bits
+  test.SetOutputRelErr("Y", 0.02f);
+
+  CPUExecutionProviderInfo info;
+  info.enable_dynamic_quantization = true;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::make_unique<CPUExecutionProvider>(info));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -30,5 +30,25 @@ TEST(MatmulIntegerOpTest, MatMulInteger) {
   test.AddOutput<int32_t>("T3", {1, 1}, {-1});
   test.Run();
 }
+
+TEST(MatmulIntegerOpTest, MatMulInteger_Int8_t) {
+  OpTester test("MatMulInteger", 10);
+  test.AddInput<uint8_t>("T1", {4, 3}, {11, 7, 3, 10, 6, 2, 9, 5, 1, 8, 4, 0});
+  test.AddInput<int8_t>("T2", {3, 2}, {-1, 4, 2, -5, 3, 6});
+  test.AddInput<uint8_t>("a_zero_point", {}, {12});
+  test.AddInput<int8_t>("b_zero_point", {}, {-1});
+  test.AddOutput<int32_t>("T3", {4, 2}, {-51, -48, -58, -56, -65, -64, -72, -72});
+  test.Run();
+}
+
+TEST(MatmulIntegerOpTest, MatMulInteger_ConstantB) {
+  OpTester test("MatMulInteger", 10);
+  test.AddInput<uint8_t>("T1", {4, 3}, {11, 7, 3, 10, 6, 2, 9, 5, 1, 8, 4, 0});
+  test.AddInput<uint8_t>("T2", {3, 2}, {1, 4, 2, 5, 3, 6}, true);
+  test.AddInput<uint8_t>("a_zero_point", {}, {12});
+  test.AddInput<uint8_t>("b_zero_point", {}, {0}, true);
+  test.AddOutput<int32_t>("T3", {4, 2}, {-38, -83, -44, -98, -50, -113, -56, -128});
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 
 namespace onnxruntime {
 namespace test {
@@ -125,5 +126,22 @@ TEST(MathOpTest, MatMulUint64Type) {
   RunMatMulTest<uint64_t>(9);
 }
 
+TEST(MathOpTest, MatMulDynamicQuantization) {
+  OpTester test("MatMul", 9);
+
+  test.AddInput<float>("A", {3, 4}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+  test.AddInput<float>("B", {4, 3}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}, true);
+  test.AddOutput<float>("Y", {3, 3}, {42, 48, 54, 114, 136, 158, 186, 224, 262});
+
+  // the result is only approximate once A and B are quantized to 8 bits
+  test.SetOutputRelErr("Y", 0.01f);
+
+  CPUExecutionProviderInfo info;
+  info.enable_dynamic_quantization = true;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::make_unique<CPUExecutionProvider>(info));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -264,5 +264,34 @@ TEST(TopKOperator, Top1ExplicitAxisMultiDInputOpset10) {
   RunTest(10, 1, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, axis);
 }
 
+// The axis is long enough relative to k to select with the bounded heap, and has many ties.
+TEST(TopKOperator, TopKLongAxisWithTiesOpset10) {
+  const int64_t n = 200;
+  std::vector<float> input_vals;
+  for (int64_t i = 0; i < n; ++i) input_vals.push_back(static_cast<float>(i % 10));
+  for (int64_t i = 0; i < n; ++i) input_vals.push_back(static_cast<float>(-(i % 7)));
+
+  std::vector<float> expected_vals = {9, 9, 9, 0, 0, 0};
+  std::vector<int64_t> expected_indices = {9, 19, 29, 0, 7, 14};
+  RunTest(10, 3, input_vals, {2, n}, expected_vals, expected_indices, {2, 3});
+}
+
+// k is a large fraction of the axis, which selects with nth_element before sorting the k largest.
+TEST(TopKOperator, TopKLargeKWithTiesOpset10) {
+  const int64_t n = 200;
+  std::vector<float> input_vals;
+  for (int64_t i = 0; i < n; ++i) input_vals.push_back(static_cast<float>(i % 10));
+
+  std::vector<float> expected_vals;
+  std::vector<int64_t> expected_indices;
+  for (int64_t value = 9; value >= 7; --value) {
+    for (int64_t i = value; i < n && expected_vals.size() < 50; i += 10) {
+      expected_vals.push_back(static_cast<float>(value));
+      expected_indices.push_back(i);
+    }
+  }
+  RunTest(10, 50, input_vals, {n}, expected_vals, expected_indices, {50});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
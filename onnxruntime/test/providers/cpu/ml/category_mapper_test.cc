@@ -43,5 +43,36 @@ TEST(CategoryMapper, IntToString) {
 
   RunTest(dims, input, output);
 }
+
+TEST(CategoryMapper, ManyCategories) {
+  const int64_t num_categories = 5000;
+  std::vector<std::string> categories;
+  std::vector<int64_t> indexes;
+  for (int64_t i = 0; i < num_categories; ++i) {
+    categories.push_back("cat" + std::to_string(i));
+    indexes.push_back(i * 7 - 100);
+  }
+
+  std::vector<std::string> strings{"cat0", "cat4999", "cat5000", "cat123", "", "cat-1"};
+  std::vector<int64_t> ints{-100, 34893, -99, 761, 0, 35000};
+
+  OpTester string_to_int("CategoryMapper", 1, onnxruntime::kMLDomain);
+  string_to_int.AddAttribute("cats_strings", categories);
+  string_to_int.AddAttribute("cats_int64s", indexes);
+  string_to_int.AddAttribute("default_string", "default");
+  string_to_int.AddAttribute<int64_t>("default_int64", -1);
+  string_to_int.AddInput<std::string>("X", {2, 3}, strings);
+  string_to_int.AddOutput<int64_t>("Y", {2, 3}, {-100, 34893, -1, 761, -1, -1});
+  string_to_int.Run();
+
+  OpTester int_to_string("CategoryMapper", 1, onnxruntime::kMLDomain);
+  int_to_string.AddAttribute("cats_strings", categories);
+  int_to_string.AddAttribute("cats_int64s", indexes);
+  int_to_string.AddAttribute("default_string", "default");
+  int_to_string.AddAttribute<int64_t>("default_int64", -1);
+  int_to_string.AddInput<int64_t>("X", {2, 3}, ints);
+  int_to_string.AddOutput<std::string>("Y", {2, 3}, {"cat0", "cat4999", "default", "cat123", "default", "default"});
+  int_to_string.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
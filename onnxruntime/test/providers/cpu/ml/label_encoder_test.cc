@@ -4,6 +4,9 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <limits>
+#include <string>
+
 namespace onnxruntime {
 namespace test {
 
@@ -42,5 +45,132 @@ TEST(LabelEncoder, IntToString) {
   RunTest(dims, input, output);
 }
 
+TEST(LabelEncoder, DuplicateClasses) {
+  OpTester test("LabelEncoder", 1, onnxruntime::kMLDomain);
+
+  // the last occurrence of a repeated class determines its index
+  test.AddAttribute("classes_strings", std::vector<std::string>{"Beer", "Wine", "Beer"});
+  test.AddAttribute("default_string", "Water");
+  test.AddAttribute<int64_t>("default_int64", 99);
+
+  test.AddInput<std::string>("X", {4}, {"Beer", "Wine", "Juice", ""});
+  test.AddOutput<int64_t>("Y", {4}, {2, 1, 99, 99});
+
+  test.Run();
+}
+
+TEST(LabelEncoder, StringToIntOpset2) {
+  std::vector<int64_t> dims{2, 2, 2};
+
+  std::vector<std::string> input{"AA", "BB", "CC", "DD", "AA", "BB", "CC", "DD"};
+  std::vector<int64_t> output{9, 1, 5566, 4, 9, 1, 5566, 4};
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_strings", std::vector<std::string>{"AA", "BB", "DD"});
+  test.AddAttribute("values_int64s", std::vector<int64_t>{9, 1, 4});
+  test.AddAttribute<int64_t>("default_int64", 5566);
+
+  test.AddInput<std::string>("X", dims, input);
+  test.AddOutput<int64_t>("Y", dims, output);
+
+  test.Run();
+}
+
+TEST(LabelEncoder, IntToStringOpset2) {
+  std::vector<int64_t> dims{2, 3};
+
+  std::vector<int64_t> input{1, 2, 3, 5, 4, 1};
+  std::vector<std::string> output{"Alice", "Bob", "Charles", "Unknown", "_Unused", "Alice"};
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  // 4 is a key whose value happens to be the default of default_string
+  test.AddAttribute("keys_int64s", std::vector<int64_t>{1, 2, 3, 4});
+  test.AddAttribute("values_strings", std::vector<std::string>{"Alice", "Bob", "Charles", "_Unused"});
+  test.AddAttribute("default_string", "Unknown");
+
+  test.AddInput<int64_t>("X", dims, input);
+  test.AddOutput<std::string>("Y", dims, output);
+
+  test.Run();
+}
+
+TEST(LabelEncoder, FloatToIntOpset2) {
+  std::vector<int64_t> dims{2, 3};
+
+  // -0.0 matches the 0.0 key, and NaN never matches
+  std::vector<float> input{2.1f, -0.0f, 7.f, std::numeric_limits<float>::quiet_NaN(), 3.5f, -1.f};
+  std::vector<int64_t> output{5, 3, -1, -1, 6, 8};
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_floats", std::vector<float>{0.f, 2.1f, 3.5f, -1.f});
+  test.AddAttribute("values_int64s", std::vector<int64_t>{3, 5, 6, 8});
+
+  test.AddInput<float>("X", dims, input);
+  test.AddOutput<int64_t>("Y", dims, output);
+
+  test.Run();
+}
+
+TEST(LabelEncoder, IntToFloatOpset2) {
+  std::vector<int64_t> dims{2, 2};
+
+  std::vector<int64_t> input{1, 2, 1000, -1};
+  std::vector<float> output{-1.f, 2.5f, 7.f, 6.f};
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_int64s", std::vector<int64_t>{1, 2, 1000, 1});
+  test.AddAttribute("values_floats", std::vector<float>{1.f, 2.5f, 7.f, -1.f});
+  test.AddAttribute("default_float", 6.f);
+
+  test.AddInput<int64_t>("X", dims, input);
+  test.AddOutput<float>("Y", dims, output);
+
+  test.Run();
+}
+
+TEST(LabelEncoder, StringToFloatLargeOpset2) {
+  // enough lookups to be split over the thread pool
+  const int64_t size = 5000;
+  std::vector<std::string> keys;
+  std::vector<float> values;
+  for (int64_t i = 0; i < 1000; ++i) {
+    keys.push_back("key" + std::to_string(i));
+    values.push_back(static_cast<float>(i));
+  }
+
+  std::vector<std::string> input;
+  std::vector<float> output;
+  for (int64_t i = 0; i < size; ++i) {
+    input.push_back("key" + std::to_string(i % 1500));
+    output.push_back(i % 1500 < 1000 ? static_cast<float>(i % 1500) : -0.0f);
+  }
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_strings", keys);
+  test.AddAttribute("values_floats", values);
+
+  test.AddInput<std::string>("X", {size}, input);
+  test.AddOutput<float>("Y", {size}, output);
+
+  test.Run();
+}
+
+TEST(LabelEncoder, KeyValueCountMismatchOpset2) {
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_floats", std::vector<float>{1.f, 2.f, 3.f});
+  test.AddAttribute("values_strings", std::vector<std::string>{"a", "b"});
+
+  test.AddInput<float>("X", {2}, {1.f, 2.f});
+  test.AddOutput<std::string>("Y", {2}, {"a", "b"});
+
+  test.Run(OpTester::ExpectResult::kExpectFailure, "does not match number of values");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
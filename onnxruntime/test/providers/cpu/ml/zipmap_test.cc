@@ -55,6 +55,16 @@ TEST(MLOpTest, ZipMapOpInt64Float1D) {
   TestHelper<int64_t>({10, 20, 30, 40, 50, 60}, "int64_t", {6});
 }
 
+// the keys of each map are sorted, and a repeated label takes the value of its last column
+TEST(MLOpTest, ZipMapOpStringFloatUnsortedRepeatedLabels) {
+  OpTester test("ZipMap", 1, onnxruntime::kMLDomain);
+  test.AddAttribute("classlabels_strings", std::vector<std::string>{"c", "a", "b", "a"});
+  test.AddInput<float>("X", {2, 4}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f});
+  test.AddOutput<std::string, float>("Z", {{{"a", 4.f}, {"b", 3.f}, {"c", 1.f}},
+                                           {{"a", 8.f}, {"b", 7.f}, {"c", 5.f}}});
+  test.Run();
+}
+
 // Negative test cases
 TEST(MLOpTest, ZipMapOpStringFloatStrideMoreThanNumLabels) {
   TestHelper<string>({"class1", "class2", "class3"}, "string", {1, 6}, OpTester::ExpectResult::kExpectFailure);
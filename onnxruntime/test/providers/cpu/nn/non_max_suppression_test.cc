@@ -103,6 +103,43 @@ TEST(NonMaxSuppressionOpTest, TwoBathes) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, TwoBatchesTwoClasses) {
+  OpTester test("NonMaxSuppression", 10, kOnnxDomain);
+  test.AddInput<float>("boxes", {2, 6, 4},
+                       {0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 0.1f, 1.0f, 1.1f,
+                        0.0f, -0.1f, 1.0f, 0.9f,
+                        0.0f, 10.0f, 1.0f, 11.0f,
+                        0.0f, 10.1f, 1.0f, 11.1f,
+                        0.0f, 100.0f, 1.0f, 101.0f,
+
+                        0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 20.0f, 1.0f, 21.0f,
+                        0.0f, 40.0f, 1.0f, 41.0f,
+                        0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 60.0f, 1.0f, 61.0f,
+                        0.0f, 80.0f, 1.0f, 81.0f});
+  test.AddInput<float>("scores", {2, 2, 6},
+                       {0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f});
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {2L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {8, 3},
+                          {0L, 0L, 3L,
+                           0L, 0L, 0L,
+                           0L, 1L, 3L,
+                           0L, 1L, 0L,
+                           1L, 0L, 3L,
+                           1L, 0L, 1L,
+                           1L, 1L, 3L,
+                           1L, 1L, 1L});
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, WithScoreThreshold) {
   OpTester test("NonMaxSuppression", 10, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
@@ -201,5 +201,36 @@ TEST(ContribOpTest, StringNormalizerTest) {
   }
 }
 
+TEST(ContribOpTest, StringNormalizerMixedAsciiBatch) {
+  // - caseinsensitive approach
+  // - ASCII and non-ASCII strings in a batch large enough to be split into blocks
+  // - filter out monday and été in any case
+  // - LOWER
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "LOWER", false, {u8"Monday", u8"ÉTÉ"}, test_locale);
+
+  const std::vector<std::string> input_pattern = {std::string(u8"MONDAY"),
+                                                  std::string(u8"Tuesday, the 8th"),
+                                                  std::string(u8"été"),
+                                                  std::string(u8"École élémentaire"),
+                                                  std::string(u8"WEDNESDAY IN AUGUST"),
+                                                  std::string(u8"Été")};
+  const std::vector<std::string> output_pattern = {std::string(u8"tuesday, the 8th"),
+                                                   std::string(u8"école élémentaire"),
+                                                   std::string(u8"wednesday in august")};
+  const size_t repeats = 500;
+
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (size_t i = 0; i < repeats; ++i) {
+    input.insert(input.end(), input_pattern.cbegin(), input_pattern.cend());
+    output.insert(output.end(), output_pattern.cbegin(), output_pattern.cend());
+  }
+
+  test.AddInput<std::string>("T", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<std::string>("Y", {static_cast<int64_t>(output.size())}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -666,5 +666,29 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5_BatchedRows) {
+  OpTester test("TfIdfVectorizer", opset_ver, domain);
+  // s=5, Min=Max=2, weights specified, string, [B,C] input
+  InitTestAttr(test, "TFIDF", 2, 2, 5,
+               {0, 4},
+               {0, 1, 2, 3, 4, 5, 6},                //7 output indexes
+               {2.0, 2.0, 2.0, 2.0, 2.0, 3.0, 2.0},  // weights
+               {},
+               {"two", "three", "five", "four",                     //1-grams
+                "five", "six", "seven", "eight", "six", "seven"});  //bi-grams
+
+  std::vector<int64_t> dims{2, 6};
+  std::vector<std::string> input{"one", "one", "three", "three", "three", "seven",
+                                 "eight", "six", "seven", "five", "six", "eight"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> out_dims{2, 7};
+  std::vector<float> output = {0, 0, 0, 0, 0, 0, 0,
+                               0, 0, 0, 0, 2, 3, 2};
+  test.AddOutput<float>("Y", out_dims, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
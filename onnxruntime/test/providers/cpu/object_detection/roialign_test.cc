@@ -4,9 +4,119 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace onnxruntime {
 namespace test {
 
+// Bilinear sample of one plane at (y, x) with the RoiAlign border rules: samples more than one pixel outside the
+// plane are zero, the rest are clamped to the plane.
+static float RoiAlignBilinear(const float* plane, int64_t height, int64_t width, float y, float x) {
+  if (y < -1.0f || y > height || x < -1.0f || x > width) {
+    return 0.f;
+  }
+  y = std::max(y, 0.f);
+  x = std::max(x, 0.f);
+  auto y_low = static_cast<int64_t>(y);
+  auto x_low = static_cast<int64_t>(x);
+  int64_t y_high = y_low + 1;
+  int64_t x_high = x_low + 1;
+  if (y_low >= height - 1) {
+    y_high = y_low = height - 1;
+    y = static_cast<float>(y_low);
+  }
+  if (x_low >= width - 1) {
+    x_high = x_low = width - 1;
+    x = static_cast<float>(x_low);
+  }
+  const float ly = y - y_low;
+  const float lx = x - x_low;
+  const float hy = 1.f - ly;
+  const float hx = 1.f - lx;
+  return hy * hx * plane[y_low * width + x_low] + hy * lx * plane[y_low * width + x_high] +
+         ly * hx * plane[y_high * width + x_low] + ly * lx * plane[y_high * width + x_high];
+}
+
+// Avg mode RoiAlign computed one output element at a time, without the per-ROI sample tables of the kernel.
+static std::vector<float> RoiAlignAvgReference(const std::vector<float>& X, int64_t channels, int64_t height,
+                                               int64_t width, const std::vector<float>& rois,
+                                               const std::vector<int64_t>& batch_indices, int64_t pooled_height,
+                                               int64_t pooled_width, int64_t sampling_ratio, float spatial_scale) {
+  const auto num_rois = static_cast<int64_t>(batch_indices.size());
+  std::vector<float> Y;
+  Y.reserve(num_rois * channels * pooled_height * pooled_width);
+  for (int64_t n = 0; n < num_rois; n++) {
+    const float roi_start_w = rois[n * 4 + 0] * spatial_scale;
+    const float roi_start_h = rois[n * 4 + 1] * spatial_scale;
+    const float roi_width = std::max(rois[n * 4 + 2] * spatial_scale - roi_start_w, 1.f);
+    const float roi_height = std::max(rois[n * 4 + 3] * spatial_scale - roi_start_h, 1.f);
+    const float bin_size_h = roi_height / pooled_height;
+    const float bin_size_w = roi_width / pooled_width;
+    const int64_t grid_h =
+        sampling_ratio > 0 ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_height / pooled_height));
+    const int64_t grid_w =
+        sampling_ratio > 0 ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
+
+    for (int64_t c = 0; c < channels; c++) {
+      const float* plane = X.data() + (batch_indices[n] * channels + c) * height * width;
+      for (int64_t ph = 0; ph < pooled_height; ph++) {
+        for (int64_t pw = 0; pw < pooled_width; pw++) {
+          float sum = 0.f;
+          for (int64_t iy = 0; iy < grid_h; iy++) {
+            const float y = roi_start_h + ph * bin_size_h + (iy + .5f) * bin_size_h / grid_h;
+            for (int64_t ix = 0; ix < grid_w; ix++) {
+              const float x = roi_start_w + pw * bin_size_w + (ix + .5f) * bin_size_w / grid_w;
+              sum += RoiAlignBilinear(plane, height, width, y, x);
+            }
+          }
+          Y.push_back(sum / (grid_h * grid_w));
+        }
+      }
+    }
+  }
+  return Y;
+}
+
+// Runs avg mode RoiAlign over enough ROIs and channels that the output is split into several thread pool blocks.
+// The ROIs mix in-image, partly outside, fully outside and malformed (end before start) boxes over two images.
+static void RunRoiAlignAvgManyRoisTest(int64_t num_rois, int64_t channels, int64_t pooled_height,
+                                       int64_t pooled_width, int64_t sampling_ratio) {
+  const int64_t N = 2;
+  const int64_t H = 12;
+  const int64_t W = 12;
+  const float spatial_scale = 0.5f;
+
+  std::vector<float> X(N * channels * H * W);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>((i * 7) % 23) * 0.5f - 3.f;
+  }
+
+  std::vector<float> rois;
+  std::vector<int64_t> batch_indices;
+  for (int64_t r = 0; r < num_rois; r++) {
+    const float x1 = static_cast<float>((r * 5) % 30 - 4);
+    const float y1 = static_cast<float>((r * 3) % 28 - 2);
+    const float x2 = x1 + (r % 7) * 3.f + (r % 5 == 0 ? -2.f : 1.f);
+    const float y2 = y1 + (r % 6) * 4.f + 1.f;
+    rois.insert(rois.end(), {x1, y1, x2, y2});
+    batch_indices.push_back(r % N);
+  }
+
+  OpTester test("RoiAlign", 10);
+  test.AddAttribute<int64_t>("output_height", pooled_height);
+  test.AddAttribute<int64_t>("output_width", pooled_width);
+  test.AddAttribute<int64_t>("sampling_ratio", sampling_ratio);
+  test.AddAttribute<float>("spatial_scale", spatial_scale);
+  test.AddInput<float>("X", {N, channels, H, W}, X);
+  test.AddInput<float>("rois", {num_rois, 4}, rois);
+  test.AddInput<int64_t>("batch_indices", {num_rois}, batch_indices);
+  test.AddOutput<float>("Y", {num_rois, channels, pooled_height, pooled_width},
+                        RoiAlignAvgReference(X, channels, H, W, rois, batch_indices, pooled_height, pooled_width,
+                                             sampling_ratio, spatial_scale));
+  test.Run();
+}
+
 TEST(RoiAlignTest, AvgModePositive) {
   OpTester test("RoiAlign", 10);
   test.AddAttribute<int64_t>("output_height", 3);
@@ -343,5 +453,31 @@ TEST(RoiAlignTest, MismatchNumRois) {
 
   test.Run(OpTester::ExpectResult::kExpectFailure, "First dimension (num_rois) of batch_indices and rois don't match");
 }
+
+TEST(RoiAlignTest, AvgModeManyRoisAndChannels) {
+  // 40 ROIs x 8 channels x 8x8 bins is above the per-block element threshold of the kernel
+  RunRoiAlignAvgManyRoisTest(40, 8, 8, 8, 2);
+}
+
+TEST(RoiAlignTest, AvgModeAdaptiveSamplingRatio) {
+  OpTester test("RoiAlign", 10);
+  test.AddAttribute<int64_t>("output_height", 2);
+  test.AddAttribute<int64_t>("output_width", 2);
+  test.AddAttribute<int64_t>("sampling_ratio", 0);
+  test.AddAttribute<float>("spatial_scale", 1.0f);
+
+  // X is the linear ramp 4 * y + x, so every bilinear sample is exact and each bin is the ramp at the mean sample.
+  // The 2x2 ROI has one sample per bin at its center, the 3x3 ROI has 1.5 pixel bins sampled on a 2x2 grid.
+  test.AddInput<float>("X", {1, 1, 4, 4}, {0., 1., 2., 3., 4., 5., 6., 7., 8., 9., 10., 11., 12., 13., 14., 15.});
+  test.AddInput<float>("rois", {2, 4}, {0., 0., 2., 2., 0., 0., 3., 3.});
+  test.AddInput<int64_t>("batch_indices", {2}, {0, 0});
+  test.AddOutput<float>("Y", {2, 1, 2, 2}, {2.5f, 3.5f, 6.5f, 7.5f, 3.75f, 5.25f, 9.75f, 11.25f});
+
+  test.Run();
+}
+
+TEST(RoiAlignTest, AvgModeAdaptiveSamplingRatioManyRois) {
+  RunRoiAlignAvgManyRoisTest(80, 16, 4, 4, 0);
+}
 }  // namespace test
 }  // namespace onnxruntime
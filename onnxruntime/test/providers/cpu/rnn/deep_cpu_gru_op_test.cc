@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "test/providers/provider_test_utils.h"
 using namespace std;
 namespace onnxruntime {
@@ -195,6 +196,42 @@ TEST(GRUTest, BidirectionalDefaultActivationsSimpleWeightsNoBiasTwoRows) {
   DefaultActivationsSimpleWeightsNoBias("bidirectional", Y_data, Y_h_data);
 }
 
+// same data as ForwardDefaultActivationsSimpleWeightsNoBiasTwoRows, with the constant W and R quantized to 8 bits
+TEST(GRUTest, ForwardDefaultActivationsSimpleWeightsNoBiasDynamicQuantization) {
+  OpTester test("GRU");
+
+  const int64_t hidden_size = 3;
+  test.AddAttribute<std::vector<string>>("activations", {"sigmoid", "tanh"});
+  test.AddAttribute("direction", std::string("forward"));
+  test.AddAttribute("hidden_size", hidden_size);
+
+  test.AddInput<float>("X", {2, 2, 1}, {1.f, 2.f, 10.f, 11.f});
+  test.AddInput<float>("W", {1, 3 * hidden_size, 1},
+                       {0.1f, 0.2f, 0.3f, 1.f, 2.f, 3.f, 10.f, 11.f, 12.f}, true);
+  test.AddInput<float>("R", {1, 3 * hidden_size, hidden_size},
+                       std::vector<float>(3 * hidden_size * hidden_size, 0.1f), true);
+
+  test.AddOutput<float>("Y", {2, 1, 2, hidden_size},
+                        {0.4750208f, 0.450166f, 0.4255575f,
+                         0.45016602f, 0.40131235f, 0.35434368f,
+
+                         0.6027093f, 0.5083023f, 0.44950223f,
+                         0.5754369f, 0.45485455f, 0.3747841f});
+  test.AddOutput<float>("Y_h", {1, 2, hidden_size},
+                        {0.6027093f, 0.5083023f, 0.44950223f,
+                         0.5754369f, 0.45485455f, 0.3747841f});
+
+  // the quantization error of X and W is amplified by the large input weights
+  test.SetOutputAbsErr("Y", 0.03f);
+  test.SetOutputAbsErr("Y_h", 0.03f);
+
+  CPUExecutionProviderInfo info;
+  info.enable_dynamic_quantization = true;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::make_unique<CPUExecutionProvider>(info));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 void DefaultActivationsSimpleWeightsWithBias(std::string direction,
                                              const std::vector<float>& Y_data,
                                              bool linear_before_reset = false,
@@ -790,6 +827,36 @@ TEST(GRUTest, ONNXRuntime_TestGRUOpSequenceLengthWithBidirectionalLinearBeforeRe
   ctx.RunTest(X, batch_size, seq_length, sequence_length, &initial_h, expected_Y, expected_Y_h, true);
 }
 
+// Same as ONNXRuntime_TestGRUOpSequenceLengthWithBidirectionalLinearBeforeReset with the batch rows swapped, so the
+// sequence lengths are not in decreasing order and the kernel has to reorder the batch internally.
+TEST(GRUTest, ONNXRuntime_TestGRUOpSequenceLengthIncreasingOrder) {
+  const std::string direction = "bidirectional";
+  const std::vector<std::string> activations = {"sigmoid", "tanh", "sigmoid", "tanh"};
+
+  DeepCpuGruOpTestContext ctx(direction, activations);
+
+  const int batch_size = 2;
+  const int seq_length = 2;
+  std::vector<float> X = {0.855351f, 0.676391f,
+                          -0.455351f, -0.276391f,
+                          0.585934f, 0.669585f,
+                          -0.185934f, -0.269585f};
+  std::vector<int> sequence_length = {1, 2};
+  std::vector<float> initial_h = {0.0f, 0.0f, 0.0f, 0.0f,
+                                  0.0f, 0.0f, 0.0f, 0.0f};
+  std::vector<float> expected_Y = {-0.275918573f, -0.00228558504f, -0.0325528607f, 0.0774837881f,
+                                   -0.275918573f, -0.00228558504f, -0.0559310019f, 0.101836264f,
+
+                                   0.0f, 0.0f, -0.0577347837f, 0.0796165839f,
+                                   0.0f, 0.0f, -0.0456649922f, 0.0462125242f};
+  std::vector<float> expected_Y_h = {-0.275918573f, -0.00228558504f,
+                                     -0.0577347837f, 0.0796165839f,
+                                     -0.275918573f, -0.00228558504f,
+                                     -0.0559310019f, 0.101836264f};
+
+  ctx.RunTest(X, batch_size, seq_length, sequence_length, &initial_h, expected_Y, expected_Y_h, true);
+}
+
 TEST(GRUTest, ONNXRuntime_TestGRUOpSequenceLengthWithPartialZero) {
   const std::string direction = "bidirectional";
   const std::vector<std::string> activations = {"sigmoid", "tanh", "sigmoid", "tanh"};
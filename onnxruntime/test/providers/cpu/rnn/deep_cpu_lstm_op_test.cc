@@ -4,9 +4,11 @@
 #include "gtest/gtest.h"
 
 #include <iterator>
+#include <limits>
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_lstm.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "test/providers/provider_test_utils.h"
 using namespace std;
 namespace onnxruntime {
@@ -143,7 +145,8 @@ void SimpleWeightsNoBiasTwoRows(std::string direction,
                                 const std::vector<float>& Y_data,
                                 const std::vector<float>& Y_h_data,
                                 const std::vector<float>& Y_c_data,
-                                const std::vector<int>* seq_lengths = nullptr) {
+                                const std::vector<int>* seq_lengths = nullptr,
+                                float clip = 9999.f) {
   int64_t seq_length = 2;
   int batch_size = 2;
   int64_t input_size = 1;
@@ -167,14 +170,14 @@ void SimpleWeightsNoBiasTwoRows(std::string direction,
 
   RunLstmTest(X_data, W_data, R_data, Y_data, Y_h_data, Y_c_data,
               input_size, batch_size, hidden_size, seq_length,
-              nullptr, nullptr, nullptr, nullptr, seq_lengths, direction);
+              nullptr, nullptr, nullptr, nullptr, seq_lengths, direction, clip);
 
   // need at least one output, so we need Y_h or Y_c to be requested (non-empty output to compare against) in order
   // to test Y not being returned (output_sequence == false)
   if (!Y_h_data.empty() || !Y_c_data.empty())
     RunLstmTest(X_data, W_data, R_data, Y_data, Y_h_data, Y_c_data,
                 input_size, batch_size, hidden_size, seq_length,
-                nullptr, nullptr, nullptr, nullptr, seq_lengths, direction, 999.f, /* output_sequence*/ false);
+                nullptr, nullptr, nullptr, nullptr, seq_lengths, direction, clip, /* output_sequence*/ false);
 }
 
 TEST(LSTMTest, ForwardSimpleWeightsNoBiasTwoRows) {
@@ -199,6 +202,89 @@ TEST(LSTMTest, ForwardSimpleWeightsNoBiasTwoRows) {
   SimpleWeightsNoBiasTwoRows("forward", Y_data, {}, {});
 }
 
+// without clipping, peepholes or custom activations the cell is computed by MlasComputeLstmCell
+TEST(LSTMTest, ForwardSimpleWeightsNoBiasTwoRowsFusedCell) {
+  std::vector<float> Y_data{
+      0.28828835f, 0.36581863f, 0.45679406f,
+      0.34526032f, 0.47220859f, 0.55850911f,
+
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382453f};
+
+  std::vector<float> Y_h_data{
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382453f};
+
+  std::vector<float> Y_c_data{
+      1.27731147f, 1.44181041f, 1.53179041f,
+      1.3249796f, 1.51063104f, 1.61451544f};
+
+  SimpleWeightsNoBiasTwoRows("forward", Y_data, Y_h_data, Y_c_data, nullptr, std::numeric_limits<float>::max());
+
+  // a shorter sequence zero fills the rows it has finished
+  std::vector<int> seq_lengths{2, 1};
+
+  Y_data = {
+      0.28828835f, 0.36581863f, 0.45679406f,
+      0.34526032f, 0.47220859f, 0.55850911f,
+
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.f, 0.f, 0.f};
+
+  Y_h_data = {
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.34526032f, 0.47220859f, 0.55850911f};
+
+  Y_c_data = {
+      1.27731147f, 1.44181041f, 1.53179041f,
+      0.54983425f, 0.59868795f, 0.64565659f};
+
+  SimpleWeightsNoBiasTwoRows("forward", Y_data, Y_h_data, Y_c_data, &seq_lengths, std::numeric_limits<float>::max());
+}
+
+// same data as ForwardSimpleWeightsNoBiasTwoRows, with the constant W and R quantized to 8 bits
+TEST(LSTMTest, ForwardSimpleWeightsNoBiasTwoRowsDynamicQuantization) {
+  OpTester test("LSTM");
+
+  const int64_t hidden_size = 3;
+  test.AddAttribute<std::vector<string>>("activations", {"sigmoid", "tanh", "tanh"});
+  test.AddAttribute("direction", std::string("forward"));
+  test.AddAttribute("hidden_size", hidden_size);
+
+  test.AddInput<float>("X", {2, 2, 1}, {1.f, 2.f, 10.f, 11.f});
+  test.AddInput<float>("W", {1, 4 * hidden_size, 1},
+                       {0.1f, 0.2f, 0.3f, 0.4f,
+                        1.f, 2.f, 3.f, 4.f,
+                        10.f, 11.f, 12.f, 13.f},
+                       true);
+  test.AddInput<float>("R", {1, 4 * hidden_size, hidden_size},
+                       std::vector<float>(4 * hidden_size * hidden_size, 0.1f), true);
+
+  test.AddOutput<float>("Y", {2, 1, 2, hidden_size},
+                        {0.28828835f, 0.36581863f, 0.45679406f,
+                         0.34526032f, 0.47220859f, 0.55850911f,
+
+                         0.84196719f, 0.89402526f, 0.91073048f,
+                         0.85882828f, 0.90703777f, 0.92382453f});
+  test.AddOutput<float>("Y_h", {1, 2, hidden_size},
+                        {0.84196719f, 0.89402526f, 0.91073048f,
+                         0.85882828f, 0.90703777f, 0.92382453f});
+  test.AddOutput<float>("Y_c", {1, 2, hidden_size},
+                        {1.27731147f, 1.44181041f, 1.53179041f,
+                         1.3249796f, 1.51063104f, 1.61451544f});
+
+  // the result is only approximate once X, W and R are quantized to 8 bits
+  test.SetOutputRelErr("Y", 0.02f);
+  test.SetOutputRelErr("Y_h", 0.02f);
+  test.SetOutputRelErr("Y_c", 0.02f);
+
+  CPUExecutionProviderInfo info;
+  info.enable_dynamic_quantization = true;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::make_unique<CPUExecutionProvider>(info));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 TEST(LSTMTest, ReverseSimpleWeightsNoBiasTwoRows) {
   std::vector<float> Y_data{
       0.55391603f, 0.69201493f, 0.82696019f,
@@ -430,6 +516,9 @@ TEST(LSTMTest, LargeBatchNoClipping) {
       0.96105254f, 0.96391004f, 0.96402279f};
 
   LargeBatchWithClip(Y_h_data);
+
+  // the same batch through MlasComputeLstmCell, which is used when there is no clip
+  LargeBatchWithClip(Y_h_data, std::numeric_limits<float>::max());
 }
 
 // make sure GateComputations with clipping works correctly if batch_parallel_ is true due to large batch size
@@ -1059,6 +1148,54 @@ TEST(LSTMTest, ONNXRuntime_TestLSTMSequenceLengthPartialZeros) {
                   &sequence_length, use_bias, use_peepholes);
 }
 
+// Same as ONNXRuntime_TestLSTMSequenceLengthPartialZeros with the batch rows swapped, so the sequence lengths are
+// not in decreasing order and the kernel has to reorder the batch internally.
+TEST(LSTMTest, ONNXRuntime_TestLSTMSequenceLengthIncreasingOrder) {
+  const int seq_len = 2;
+  int batch_size = 2;
+  std::vector<std::string> activations = {"tanh", "sigmoid", "tanh", "tanh", "sigmoid", "tanh"};
+
+  bool use_bias = true;
+  bool use_peepholes = false;
+
+  std::vector<float> X_data = {0.0f, 0.0f,
+                               -0.455351f, -0.776391f,
+
+                               0.0f, 0.0f,
+                               -0.185934f, -0.169585f};
+
+  std::vector<int> sequence_length = {0, 2};
+
+  std::vector<float> Y_data = {0.0f, 0.0f,
+                               -0.1269719f, -0.01049645f,
+
+                               0.0f, 0.0f,
+                               -0.12206709f, -0.0051103f,
+
+                               0.0f, 0.0f,
+                               -0.02778835f, 0.00775075f,
+
+                               0.0f, 0.0f,
+                               -0.04350187f, 0.01127771f};
+
+  std::vector<float> Y_h_data = {0.0f, 0.0f,
+                                 -0.02778835f, 0.00775075f,
+
+                                 0.0f, 0.0f,
+                                 -0.12206709f, -0.0051103f};
+
+  std::vector<float> Y_c_data = {0.0f, 0.0f,
+                                 0.14675268f, 0.01759163f,
+
+                                 0.0f, 0.0f,
+                                 0.26577898f, -0.01694398f};
+
+  std::string direction = "bidirectional";
+  LstmOpContext2x1x2x2 context(direction, activations);
+  context.RunTest(X_data, batch_size, seq_len, nullptr, nullptr, Y_data, Y_h_data, Y_c_data,
+                  &sequence_length, use_bias, use_peepholes);
+}
+
 // TODO this test fails for nGraph - need to investigate why
 #ifndef USE_NGRAPH
 TEST(LSTMTest, ONNXRuntime_TestLSTMSequenceLengthShorterThanInputSequenceLength) {
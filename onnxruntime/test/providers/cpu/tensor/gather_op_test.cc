@@ -274,6 +274,22 @@ TEST(GatherOpTest, Gather_axis1_indices2d_string) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 3},
+                             {"0", "1", "2",
+                              "10", "11", "12",
+                              "20", "21", "22"});
+  test.AddInput<int64_t>("indices", {3},
+                         {2LL, 0LL, 2LL});
+  test.AddOutput<std::string>("output", {3, 3},
+                              {"20", "21", "22",
+                               "0", "1", "2",
+                               "20", "21", "22"});
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_indices2d_bool) {
   OpTester test("Gather");
   test.AddAttribute<int64_t>("axis", 1LL);
@@ -4,6 +4,8 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <limits>
+
 using namespace std;
 
 namespace onnxruntime {
@@ -178,5 +180,75 @@ TEST(OneHotOpTest, FloatString) {
                                                 "off", "off", "off", "off", "off", "off", "on", "off", "off", "off",});
   test.Run();
 }
+
+TEST(OneHotOpTest, FloatIndices_NaNAndOutOfRange) {
+  // only the last index selects a depth position, all the others are NaN, infinite or far outside the depth
+  OpTester test("OneHot", 9);
+  test.AddInput<float>("indices", {6}, {std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+                                        -std::numeric_limits<float>::infinity(), 1e20f, -1e20f, 2.f});
+  test.AddInput<int64_t>("depth", {1}, {3});
+  test.AddInput<int64_t>("values", {2}, {0, 1});
+  test.AddOutput<int64_t>("output", {6, 3}, {0, 0, 0,
+                                             0, 0, 0,
+                                             0, 0, 0,
+                                             0, 0, 0,
+                                             0, 0, 0,
+                                             0, 0, 1});
+  test.Run();
+}
+
+// The tests below have enough output elements for the kernel to split the work over the thread pool. Indices that are
+// negative, past the depth or not integral select no depth position and leave all of their outputs off.
+
+TEST(OneHotOpTest, Axis_0_FloatIndices_Large) {
+  const int64_t rows = 64, cols = 128, depth = 64;
+  std::vector<float> indices(rows * cols);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    // cycles through -3 .. 69 with a non integral value every 7th index
+    indices[i] = static_cast<float>(static_cast<int64_t>(i % 73) - 3) + (i % 7 == 6 ? 0.5f : 0.f);
+  }
+
+  // axis 0 puts the depth first, so the work is split over the indices
+  std::vector<float> output(depth * rows * cols, 0.f);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const float index = indices[i];
+    if (index >= 0 && index < depth && index == static_cast<float>(static_cast<int64_t>(index))) {
+      output[static_cast<size_t>(index) * rows * cols + i] = 1.f;
+    }
+  }
+
+  OpTester test("OneHot", 9);
+  int64_t axis = 0;
+  test.AddAttribute("axis", axis);
+  test.AddInput<float>("indices", {rows, cols}, indices);
+  test.AddInput<float>("depth", {1}, {static_cast<float>(depth)});
+  test.AddInput<float>("values", {2}, {0.f, 1.f});
+  test.AddOutput<float>("output", {depth, rows, cols}, output);
+  test.Run();
+}
+
+TEST(OneHotOpTest, DefaultAxis_NegativeIndices_Large) {
+  const int64_t rows = 256, cols = 32, depth = 40;
+  std::vector<int64_t> indices(rows * cols);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    // cycles through -10 .. 44
+    indices[i] = static_cast<int64_t>(i % 55) - 10;
+  }
+
+  // the default axis puts the depth last, so the work is split over the rows of the output
+  std::vector<int64_t> output(rows * cols * depth, 0);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    if (indices[i] >= 0 && indices[i] < depth) {
+      output[i * depth + static_cast<size_t>(indices[i])] = 1;
+    }
+  }
+
+  OpTester test("OneHot", 9);
+  test.AddInput<int64_t>("indices", {rows, cols}, indices);
+  test.AddInput<int64_t>("depth", {1}, {depth});
+  test.AddInput<int64_t>("values", {2}, {0, 1});
+  test.AddOutput<int64_t>("output", {rows, cols, depth}, output);
+  test.Run();
+}
 }
 }  // namespace onnxruntime
@@ -5,12 +5,73 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace onnxruntime {
 namespace test {
 
 // Some of the tests can't run on TensorrtExecutionProvider because TensorRT only supports "nearest" mode Upsample
 // and limited data types. Those tests will fallback to other EPs
 
+// Nearest mode reference, computed element by element: output coordinate i of an axis reads input coordinate
+// floor(i / scale) when upsampling and ceil(i / scale) when downsampling, clamped to the input.
+static std::vector<float> UpsampleNearestReference(const std::vector<int64_t>& X_dims, const std::vector<float>& X,
+                                                   const std::vector<float>& scales, std::vector<int64_t>& Y_dims) {
+  const size_t rank = X_dims.size();
+  Y_dims.resize(rank);
+  int64_t Y_size = 1;
+  for (size_t j = 0; j < rank; ++j) {
+    Y_dims[j] = static_cast<int64_t>(scales[j] * X_dims[j]);
+    Y_size *= Y_dims[j];
+  }
+
+  std::vector<float> Y(Y_size);
+  for (int64_t i = 0; i < Y_size; ++i) {
+    int64_t cur = i;
+    int64_t X_index = 0;
+    int64_t X_stride = 1;
+    for (auto j = static_cast<int64_t>(rank) - 1; j >= 0; --j) {
+      const int64_t y = cur % Y_dims[j];
+      cur /= Y_dims[j];
+      int64_t x = scales[j] < 1 ? static_cast<int64_t>(std::ceil(y / scales[j])) : static_cast<int64_t>(y / scales[j]);
+      x = std::min(x, X_dims[j] - 1);
+      X_index += x * X_stride;
+      X_stride *= X_dims[j];
+    }
+    Y[i] = X[X_index];
+  }
+  return Y;
+}
+
+static void RunUpsampleNearestTest(const std::vector<int64_t>& X_dims, const std::vector<float>& scales,
+                                   bool is_resize = false) {
+  OpTester test(is_resize ? "Resize" : "Upsample", is_resize ? 10 : 7);
+  test.AddAttribute("mode", "nearest");
+  if (!is_resize) {
+    test.AddAttribute("scales", scales);
+  }
+
+  int64_t X_size = 1;
+  for (auto dim : X_dims) {
+    X_size *= dim;
+  }
+  std::vector<float> X(X_size);
+  for (int64_t i = 0; i < X_size; ++i) {
+    X[i] = static_cast<float>(i);
+  }
+
+  test.AddInput<float>("X", X_dims, X);
+  if (is_resize) {
+    test.AddInput<float>("scales", {static_cast<int64_t>(scales.size())}, scales);
+  }
+
+  std::vector<int64_t> Y_dims;
+  std::vector<float> Y = UpsampleNearestReference(X_dims, X, scales, Y_dims);
+  test.AddOutput<float>("Y", Y_dims, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 TEST(UpsampleOpTest, UpsampleOpNearestTest) {
   OpTester test("Upsample");
 
@@ -332,6 +393,29 @@ TEST(UpsampleOpTest, UpsampleOpBilinearTest_int32) {
   test.Run();
 }
 
+TEST(UpsampleOpTest, UpsampleOpBilinearTest_NHWC) {
+  OpTester test("Upsample");
+
+  std::vector<float> scales{1.0f, 2.0f, 2.0f, 1.0f};
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("scales", scales);
+
+  const int64_t N = 1, H = 2, W = 2, C = 2;
+  std::vector<float> X = {1.0f, 2.0f, 3.0f, 4.0f,
+                          3.0f, 6.0f, 5.0f, 8.0f};
+
+  test.AddInput<float>("X", {N, H, W, C}, X);
+
+  std::vector<float> Y = {
+      1.0f, 2.0f, 2.0f, 3.0f, 3.0f, 4.0f, 3.0f, 4.0f,
+      2.0f, 4.0f, 3.0f, 5.0f, 4.0f, 6.0f, 4.0f, 6.0f,
+      3.0f, 6.0f, 4.0f, 7.0f, 5.0f, 8.0f, 5.0f, 8.0f,
+      3.0f, 6.0f, 4.0f, 7.0f, 5.0f, 8.0f, 5.0f, 8.0f};
+
+  test.AddOutput<float>("Y", {N, (int64_t)(H * scales[1]), (int64_t)(W * scales[2]), C}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider});
+}
+
 TEST(UpsampleOpTest, UpsampleOpNearestTest_1D) {
   OpTester test("Upsample");
 
@@ -384,5 +468,56 @@ TEST(UpsampleOpTest, UpsampleOpNearest2XTest_opset9) {
   test.AddOutput<int32_t>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
   test.Run();
 }
+
+TEST(UpsampleOpTest, UpsampleOpNearestTest_1D_NonIntegerScale) {
+  OpTester test("Upsample");
+
+  std::vector<float> scales{2.5f};
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("scales", scales);
+
+  test.AddInput<float>("X", {3}, {1.0f, 2.0f, 3.0f});
+  test.AddOutput<float>("Y", {7}, {1.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f});
+  test.Run();
+}
+
+TEST(UpsampleOpTest, UpsampleOpNearestTest_3D_NonIntegerScales) {
+  RunUpsampleNearestTest({2, 2, 3}, {1.0f, 1.5f, 2.0f});
+  RunUpsampleNearestTest({2, 3, 4}, {2.0f, 1.0f, 1.25f});
+}
+
+TEST(UpsampleOpTest, UpsampleOpNearestTest_5D) {
+  RunUpsampleNearestTest({1, 2, 2, 2, 3}, {1.0f, 2.0f, 1.5f, 1.0f, 2.0f});
+}
+
+// enough output rows to be split over the thread pool
+TEST(UpsampleOpTest, UpsampleOpNearestTest_3D_Large) {
+  RunUpsampleNearestTest({3, 40, 50}, {1.0f, 2.5f, 1.6f});
+}
+
+TEST(UpsampleOpTest, ResizeOpNearestDownsampleTest) {
+  OpTester test("Resize", 10);
+
+  std::vector<float> scales{1.0f, 1.0f, 0.5f, 0.6f};
+  test.AddAttribute("mode", "nearest");
+
+  std::vector<float> X(20);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(i);
+  }
+
+  test.AddInput<float>("X", {1, 1, 4, 5}, X);
+  test.AddInput<float>("scales", {4}, scales);
+
+  // rows 0 and 2, columns 0, 2 and 4
+  test.AddOutput<float>("Y", {1, 1, 2, 3}, {0.0f, 2.0f, 4.0f, 10.0f, 12.0f, 14.0f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(UpsampleOpTest, ResizeOpNearestDownsampleTest_MixedScales) {
+  RunUpsampleNearestTest({2, 4, 3}, {1.0f, 0.5f, 2.0f}, true);
+  RunUpsampleNearestTest({1, 3, 5, 7}, {1.0f, 2.0f, 0.4f, 0.75f}, true);
+  RunUpsampleNearestTest({6}, {0.5f}, true);
+}
 }  // namespace test
 }  // namespace onnxruntime
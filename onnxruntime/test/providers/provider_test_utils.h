@@ -211,11 +211,14 @@ class OpTester {
   // Add non tensor output
   template <typename TKey, typename TVal>
   void AddOutput(const char* name, const std::vector<std::map<TKey, TVal>>& val) {
-    auto ptr = std::make_unique<std::vector<std::map<TKey, TVal>>>(val);
+    auto ptr = std::make_unique<MapSequence<TKey, TVal>>();
+    for (const auto& map : val) {
+      ptr->push_back(map);
+    }
     OrtValue ml_value;
     ml_value.Init(ptr.release(),
-                  DataTypeImpl::GetType<std::vector<std::map<TKey, TVal>>>(),
-                  DataTypeImpl::GetType<std::vector<std::map<TKey, TVal>>>()->GetDeleteFunc());
+                  DataTypeImpl::GetType<MapSequence<TKey, TVal>>(),
+                  DataTypeImpl::GetType<MapSequence<TKey, TVal>>()->GetDeleteFunc());
     output_data_.push_back({{name, &s_vec_map_type_proto<TKey, TVal>}, ml_value, optional<float>(), optional<float>()});
   }
 
@@ -271,6 +271,32 @@ TEST_F(CApiTest, create_tensor) {
   tensor.GetStringTensorContent((void*)result.data(), data_len, offsets.data(), offsets.size());
 }
 
+TEST_F(CApiTest, fill_string_tensor_from_buffer) {
+  const std::string chars = "abcdefghij";
+  const size_t offsets[] = {0, 3, 3};
+  int64_t expected_len = 3;
+  auto default_allocator = std::make_unique<MockedOrtAllocator>();
+
+  Ort::Value tensor = Ort::Value::CreateTensor(default_allocator.get(), &expected_len, 1, ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
+  tensor.FillStringTensor(chars.data(), chars.size(), offsets, 3);
+
+  ASSERT_EQ(tensor.GetStringTensorDataLength(), chars.size());
+
+  size_t length;
+  const char* element = tensor.GetStringTensorElement(0, &length);
+  ASSERT_EQ(std::string(element, length), "abc");
+  element = tensor.GetStringTensorElement(1, &length);
+  ASSERT_EQ(length, 0u);
+  element = tensor.GetStringTensorElement(2, &length);
+  ASSERT_EQ(std::string(element, length), "defghij");
+
+  std::string result(chars.size(), '\0');
+  std::vector<size_t> result_offsets(expected_len);
+  tensor.GetStringTensorContent((void*)result.data(), result.size(), result_offsets.data(), result_offsets.size());
+  ASSERT_EQ(result, chars);
+  ASSERT_EQ(result_offsets, std::vector<size_t>(offsets, offsets + 3));
+}
+
 TEST_F(CApiTest, create_tensor_with_data) {
   float values[] = {3.0f, 1.0f, 2.f, 0.f};
   constexpr size_t values_length = sizeof(values) / sizeof(values[0]);
@@ -148,3 +148,47 @@ TEST_F(CApiTest, CreateGetVectorOfMapsStringFloat) {  // support zipmap output t
               std::set<float>(std::begin(values), std::end(values)));
   }
 }
+
+TEST_F(CApiTest, CreateVectorOfMapsFromFetchedMaps) {
+  auto default_allocator = std::make_unique<MockedOrtAllocator>();
+  Ort::AllocatorInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+
+  const int N = 3;
+  const int NUM_KV_PAIRS = 4;
+  std::vector<Ort::Value> in;
+  std::vector<int64_t> keys{3, 1, 2, 0};
+  std::vector<int64_t> dims = {NUM_KV_PAIRS};
+  std::vector<std::vector<float>> values{{3.f, 1.f, 2.f, 0.f}, {13.f, 11.f, 12.f, 10.f}, {23.f, 21.f, 22.f, 20.f}};
+  for (int i = 0; i < N; ++i) {
+    Ort::Value keys_tensor = Ort::Value::CreateTensor(info, keys.data(), keys.size() * sizeof(int64_t),
+                                                      dims.data(), dims.size(), ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64);
+    Ort::Value values_tensor = Ort::Value::CreateTensor(info, values[i].data(), values[i].size() * sizeof(float),
+                                                        dims.data(), dims.size(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+    in.emplace_back(Ort::Value::CreateMap(keys_tensor, values_tensor));
+  }
+  Ort::Value seq_ort = Ort::Value::CreateSequence(in);
+
+  // the maps fetched from a sequence can be used to create another one, here in reverse order
+  std::vector<Ort::Value> fetched;
+  for (int idx = N - 1; idx >= 0; --idx) {
+    fetched.emplace_back(seq_ort.GetValue(idx, default_allocator.get()));
+    ASSERT_EQ(fetched.back().GetCount(), 2u);
+  }
+  Ort::Value reversed = Ort::Value::CreateSequence(fetched);
+  ASSERT_EQ(reversed.GetCount(), static_cast<size_t>(N));
+
+  for (int idx = 0; idx < N; ++idx) {
+    Ort::Value map_out = reversed.GetValue(idx, default_allocator.get());
+
+    // the keys are returned in increasing order and the values in the order of their keys
+    Ort::Value keys_ort = map_out.GetValue(0, default_allocator.get());
+    int64_t* keys_ret = keys_ort.GetTensorMutableData<int64_t>();
+    ASSERT_EQ(std::vector<int64_t>(keys_ret, keys_ret + NUM_KV_PAIRS), std::vector<int64_t>({0, 1, 2, 3}));
+
+    Ort::Value values_ort = map_out.GetValue(1, default_allocator.get());
+    float* values_ret = values_ort.GetTensorMutableData<float>();
+    const float base = 10.f * (N - 1 - idx);
+    ASSERT_EQ(std::vector<float>(values_ret, values_ret + NUM_KV_PAIRS),
+              std::vector<float>({base, base + 1, base + 2, base + 3}));
+  }
+}
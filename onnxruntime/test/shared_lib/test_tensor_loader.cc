@@ -125,6 +125,51 @@ TEST_F(CApiTest, load_float_tensor_with_external_data) {
   run_external_data_test<false>();
 }
 
+TEST_F(CApiTest, load_float_tensor_with_external_data_at_offset) {
+  FILE* fp;
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  CreateTestFile(fp, filename);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+  float test_data[] = {-1.0f, 1.0f, 2.2f, 3.5f, -1.0f};
+  ASSERT_EQ(sizeof(test_data), fwrite(test_data, 1, sizeof(test_data), fp));
+  ASSERT_EQ(0, fclose(fp));
+  // construct a tensor proto with the data in the middle of the file
+  onnx::TensorProto p;
+  onnx::StringStringEntryProto* location = p.mutable_external_data()->Add();
+  location->set_key("location");
+  location->set_value(ToMBString(filename));
+  onnx::StringStringEntryProto* offset = p.mutable_external_data()->Add();
+  offset->set_key("offset");
+  offset->set_value(std::to_string(sizeof(float)));
+  onnx::StringStringEntryProto* length = p.mutable_external_data()->Add();
+  length->set_key("length");
+  length->set_value(std::to_string(3 * sizeof(float)));
+  p.mutable_dims()->Add(3);
+  p.set_data_location(onnx::TensorProto_DataLocation_EXTERNAL);
+  p.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  std::string s;
+  // save it to a buffer
+  ASSERT_TRUE(p.SerializeToString(&s));
+  // deserialize it, the data is read from the file straight into 'output'
+  std::vector<float> output(3);
+  OrtValue* value;
+  OrtCallback* deleter;
+  auto st = OrtTensorProtoToOrtValue(s.data(), static_cast<int>(s.size()), nullptr, output.data(),
+                                     output.size() * sizeof(float), &value, &deleter);
+  ASSERT_EQ(st, nullptr) << OrtGetErrorMessage(st);
+  float* real_output;
+  st = OrtGetTensorMutableData(value, (void**)&real_output);
+  ASSERT_EQ(st, nullptr) << OrtGetErrorMessage(st);
+  // check the result
+  ASSERT_EQ(real_output, output.data());
+  ASSERT_EQ(real_output[0], 1.0f);
+  ASSERT_EQ(real_output[1], 2.2f);
+  ASSERT_EQ(real_output[2], 3.5f);
+  OrtReleaseValue(value);
+  OrtRunCallback(deleter);
+}
+
 #if defined(__amd64__) || defined(_M_X64)
 
 TEST_F(CApiTest, load_huge_tensor_with_external_data) {